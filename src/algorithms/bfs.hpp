@@ -38,6 +38,7 @@
 
 #include <limits>
 #include <tuple>
+#include <vector>
 
 #include <graphblas/graphblas.hpp>
 
@@ -70,28 +71,32 @@ namespace
     }
 
     //************************************************************************
-    //convert each stored entry of a vector to its 1-based index
+    //convert each stored entry of a vector to its index plus offset (only
+    //the stored entries are visited, so a small frontier stays cheap)
     template <typename VectorT>
-    void index_of_0based(VectorT &vec)
+    void index_of(VectorT &vec, GraphBLAS::IndexType offset)
     {
         using T = typename VectorT::ScalarType;
 
-        GraphBLAS::IndexArrayType i, j, v;
-        for (GraphBLAS::IndexType ix = 0; ix < vec.size(); ++ix)
+        GraphBLAS::IndexArrayType indices(vec.nvals());
+        std::vector<T> values(vec.nvals());
+        vec.extractTuples(indices, values);
+
+        for (GraphBLAS::IndexType ix = 0; ix < indices.size(); ++ix)
         {
-            i.push_back(ix);
-            j.push_back(ix);
-            v.push_back(ix);
+            values[ix] = static_cast<T>(indices[ix] + offset);
         }
 
-        GraphBLAS::Matrix<T> identity_ramp(vec.size(), vec.size());
-
-        identity_ramp.build(i,j,v);
+        vec.clear();
+        vec.build(indices, values);
+    }
 
-        GraphBLAS::vxm(vec,
-                       GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
-                       GraphBLAS::MinSelect2ndSemiring<T>(),
-                       vec, identity_ramp, true);
+    //************************************************************************
+    //convert each stored entry of a vector to its 0-based index
+    template <typename VectorT>
+    void index_of_0based(VectorT &vec)
+    {
+        index_of(vec, 0);
     }
 
     //************************************************************************
@@ -99,24 +104,7 @@ namespace
     template <typename VectorT>
     void index_of_1based(VectorT &vec)
     {
-        using T = typename VectorT::ScalarType;
-
-        GraphBLAS::IndexArrayType i, j, v;
-        for (GraphBLAS::IndexType ix = 0; ix < vec.size(); ++ix)
-        {
-            i.push_back(ix);
-            j.push_back(ix);
-            v.push_back(ix + 1);
-        }
-
-        GraphBLAS::Matrix<T> identity_ramp(vec.size(), vec.size());
-
-        identity_ramp.build(i,j,v);
-
-        GraphBLAS::vxm(vec,
-                       GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
-                       GraphBLAS::MinSelect2ndSemiring<T>(),
-                       vec, identity_ramp, true);
+        index_of(vec, 1);
     }
 
 }
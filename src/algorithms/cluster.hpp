@@ -31,6 +31,7 @@
 #define ALGORITHMS_CLUSTER_HPP
 
 #include <vector>
+#include <utility>
 #include <math.h>
 #include <graphblas/graphblas.hpp>
 
@@ -207,7 +208,7 @@ namespace algorithms
 
         //GraphBLAS::print_matrix(std::cerr, C, "cluster_approx");
 
-        GraphBLAS::Vector<RealT> m(num_vertices);
+        GraphBLAS::Vector<RealT, GraphBLAS::DenseTag> m(num_vertices);
         GraphBLAS::Matrix<bool>  Cf(num_vertices, num_vertices);
         GraphBLAS::Matrix<RealT> Tally(num_vertices, num_vertices);
 
@@ -269,7 +270,7 @@ namespace algorithms
                 break;
             }
 
-            C = Cf;
+            C.swap(Cf);  // Cf is recomputed from scratch
         }
         // MAX_ITERS EXCEEDED
     }
@@ -379,7 +380,7 @@ namespace algorithms
         //GraphBLAS::normalize_rows(A);
         //GraphBLAS::print_matrix(std::cout, A, "Row normalized graph");
 
-        GraphBLAS::Vector<RealT> m(num_vertices);
+        GraphBLAS::Vector<RealT, GraphBLAS::DenseTag> m(num_vertices);
         GraphBLAS::Matrix<bool>  Cf(num_vertices, num_vertices);
         GraphBLAS::Matrix<RealT> Tally(num_vertices, num_vertices);
 
@@ -433,7 +434,7 @@ namespace algorithms
                 break;
             }
 
-            C = Cf;
+            C.swap(Cf);  // Cf is recomputed from scratch
         }
 
         // MAX_ITERS EXCEEDED
@@ -541,7 +542,7 @@ namespace algorithms
                 return Ainfl;
             }
 
-            Anorm = Ainfl;
+            Anorm = std::move(Ainfl);
         }
 
         //std::cout << "Exceeded max interations." << std::endl;
@@ -32,6 +32,7 @@
 
 #include <iostream>
 #include <memory>
+#include <utility>
 
 #include <graphblas/graphblas.hpp>
 
@@ -223,7 +224,7 @@ namespace algorithms
                                GraphBLAS::AllIndices(),
                                true);
             //GraphBLAS::print_matrix(std::cout, *Enew, "Enew");
-            E = Enew;
+            E = std::move(Enew);
             if (num_edges == 0)
             {
                 break;
@@ -239,7 +240,7 @@ namespace algorithms
                                GraphBLAS::AllIndices(),
                                true);
             //GraphBLAS::print_matrix(std::cout, *Rnew, "Rnew");
-            R = Rnew;
+            R = std::move(Rnew);
 
             // R := R - E[Ex'*Ex - diag(dx)]
             //
@@ -258,13 +259,13 @@ namespace algorithms
                            GraphBLAS::NoMask(),
                            GraphBLAS::Minus<EdgeType>(),
                            GraphBLAS::ArithmeticSemiring<EdgeType>(),
-                           *Enew, ExT_Ex, true);
+                           *E, ExT_Ex, true);
             //GraphBLAS::print_matrix(std::cout, *R, "R -= E*[Ex'*Ex - diag]");
 
             s = std::make_shared<GraphBLAS::Vector<EdgeType>>(num_edges);
             GraphBLAS::mxv(*s, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
                            Support2Semiring<EdgeType>(),
-                           *Rnew, OnesN, true);
+                           *R, OnesN, true);
             //GraphBLAS::print_vector(std::cout, *s, "support");
 
             // 4. Determine edges which lack enough support for k-truss
@@ -281,7 +282,7 @@ namespace algorithms
         }
 
         // return incidence matrix containing all edges in k-trusses
-        return *E;
+        return std::move(*E);
     }
 
     //************************************************************************
@@ -134,7 +134,8 @@ namespace algorithms
 
         using T = typename MatrixT::ScalarType;
         using RealT = float;
-        typedef GraphBLAS::Vector<RealT> RealVector;
+        // Dense storage: the probabilities cover most of the candidates
+        typedef GraphBLAS::Vector<RealT, GraphBLAS::DenseTag> RealVector;
         typedef GraphBLAS::Vector<bool> BoolVector;
 
         RealVector prob(num_vertices);
@@ -107,27 +107,28 @@ namespace algorithms
             add_scaled_teleport((1.0 - damping_factor)/
                                 static_cast<T>(rows));
 
-        GraphBLAS::assign(page_rank,
+        // Every vertex has a rank, so the work vectors use dense storage
+        GraphBLAS::Vector<RealT, GraphBLAS::DenseTag> rank(rows);
+        GraphBLAS::Vector<RealT, GraphBLAS::DenseTag> new_rank(rows);
+        GraphBLAS::Vector<RealT, GraphBLAS::DenseTag> delta(rows);
+        GraphBLAS::assign(rank,
                           GraphBLAS::NoMask(),
                           GraphBLAS::NoAccumulate(),
                           1.0 / static_cast<RealT>(rows),
                           GraphBLAS::AllIndices());
 
-
-        GraphBLAS::Vector<RealT> new_rank(rows);
-        GraphBLAS::Vector<RealT> delta(rows);
         for (GraphBLAS::IndexType i = 0; i < max_iters; ++i)
         {
             //std::cout << "============= ITERATION " << i << " ============"
             //          << std::endl;
-            //print_vector(std::cout, page_rank, "rank");
+            //print_vector(std::cout, rank, "rank");
 
             // Compute the new rank: [1 x M][M x N] = [1 x N]
             GraphBLAS::vxm(new_rank,
                            GraphBLAS::NoMask(),
                            GraphBLAS::Second<RealT>(),
                            GraphBLAS::ArithmeticSemiring<RealT>(),
-                           page_rank, m);
+                           rank, m);
             //print_vector(std::cout, new_rank, "step 1:");
 
             // [1 x M][M x 1] = [1 x 1] = always (1 - damping_factor)
@@ -147,7 +148,7 @@ namespace algorithms
                                 GraphBLAS::NoMask(),
                                 GraphBLAS::NoAccumulate(),
                                 GraphBLAS::Minus<RealT>(),
-                                page_rank, new_rank);
+                                rank, new_rank);
             GraphBLAS::eWiseMult(delta,
                                  GraphBLAS::NoMask(),
                                  GraphBLAS::NoAccumulate(),
@@ -160,7 +161,9 @@ namespace algorithms
 
             //std::cout << "Squared error = " << r2 << std::endl;
 
-            page_rank = new_rank;
+            // A copy, not a swap: the next vxm accumulates (Second) into
+            // new_rank, so it has to start out equal to rank.
+            rank = new_rank;
             // check mean-squared error
             if (squared_error/((RealT)rows) < threshold)
             {
@@ -175,12 +178,16 @@ namespace algorithms
                           GraphBLAS::NoAccumulate(),
                           (1.0 - damping_factor) / static_cast<T>(rows),
                           GraphBLAS::AllIndices());
-        GraphBLAS::eWiseAdd(page_rank,
-                            GraphBLAS::complement(page_rank),
+        GraphBLAS::eWiseAdd(rank,
+                            GraphBLAS::complement(rank),
                             GraphBLAS::NoAccumulate(),
                             GraphBLAS::Plus<RealT>(),
-                            page_rank,
+                            rank,
                             new_rank);
+        GraphBLAS::apply(page_rank,
+                         GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                         GraphBLAS::Identity<RealT>(),
+                         rank);
     }
 } // algorithms
 
@@ -106,20 +106,72 @@ namespace algorithms
         GraphBLAS::IndexType rows(L.nrows());
         GraphBLAS::IndexType cols(L.ncols());
 
-        MatrixT B(rows, cols);
-        GraphBLAS::mxm(B,
-                       L, GraphBLAS::NoAccumulate(),
-                       GraphBLAS::ArithmeticSemiring<T>(),
-                       L, GraphBLAS::transpose(L));
-
+        // sum of B<L> = L * L', reduced without building B
         T sum = 0;
-        GraphBLAS::reduce(sum,
-                          GraphBLAS::NoAccumulate(),
-                          GraphBLAS::PlusMonoid<T>(),
-                          B);
+        GraphBLAS::mxm_reduce(sum,
+                              L, GraphBLAS::NoAccumulate(),
+                              GraphBLAS::PlusMonoid<T>(),
+                              GraphBLAS::ArithmeticSemiring<T>(),
+                              L, GraphBLAS::transpose(L));
         return sum;
     }
 
+    /// x * (x - 1): the number of ordered pairs from x items
+    template <typename T>
+    struct OrderedPairs
+    {
+        typedef T result_type;
+        inline T operator()(T x) { return x * (x - static_cast<T>(1)); }
+    };
+
+    /**
+     * @brief Count the 4-cycles (squares) in an undirected graph.
+     *
+     * For i != j, B = A * A holds the number of paths i-k-j in B(i,j), and
+     * any two of them form a 4-cycle.  Each 4-cycle is found once for each
+     * of its two diagonals in each direction, and each pair twice as an
+     * ordered pair, so the count is the sum of B(i,j)(B(i,j) - 1) over
+     * i != j, divided by 8.  B is reduced as it is computed.
+     *
+     * @param[in] graph  Must be undirected graph with no self-loops; i.e.,
+     *                   matrix is symmetric with zeros on the diagonal.
+     *
+     * @return The number of 4-cycles in graph.
+     */
+    template<typename MatrixT>
+    typename MatrixT::ScalarType four_cycle_count(MatrixT const &graph)
+    {
+        using T = typename MatrixT::ScalarType;
+        GraphBLAS::IndexType rows(graph.nrows());
+        GraphBLAS::IndexType cols(graph.ncols());
+
+        if (rows != cols)
+        {
+            throw GraphBLAS::DimensionException(
+                "four_cycle_count matrix is not square");
+        }
+
+        GraphBLAS::Matrix<bool> DiagMask(rows, cols);
+        GraphBLAS::IndexArrayType I_n;
+        std::vector<bool> v_n(rows, true);
+        I_n.reserve(rows);
+        for (GraphBLAS::IndexType ix = 0; ix < rows; ++ix)
+        {
+            I_n.push_back(ix);
+        }
+        DiagMask.build(I_n, I_n, v_n);
+
+        T sum = 0;
+        GraphBLAS::mxm_reduce(sum,
+                              GraphBLAS::complement(DiagMask),
+                              GraphBLAS::NoAccumulate(),
+                              GraphBLAS::PlusMonoid<T>(),
+                              OrderedPairs<T>(),
+                              GraphBLAS::ArithmeticSemiring<T>(),
+                              graph, graph);
+        return sum / static_cast<T>(8);
+    }
+
     //************************************************************************
     /**
      * From TzeMeng Low, the FLAME approach #1 to triangle counting
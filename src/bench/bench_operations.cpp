@@ -0,0 +1,675 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Times each operation in operations.hpp over random operands of several
+ * sizes and densities, with no mask, a mask and a complemented mask, and
+ * writes the timings of every repetition (and their statistics) as JSON.
+ *
+ * usage: bench_operations [--sizes n1,n2,...] [--degrees d1,d2,...]
+ *                         [--reps r] [--warmup w] [--seed s]
+ *                         [--filter substring] [--out file.json]
+ *
+ * An n x n operand has degree entries per row on average, at uniformly
+ * random columns; vectors have one entry in four.  --filter keeps the
+ * cases whose name ("mxm/plus_times/mask", say) contains the substring.
+ * The JSON goes to stdout unless --out is given; progress goes to stderr.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <graphblas/graphblas.hpp>
+
+#ifndef GB_PLATFORM_NAME
+#define GB_PLATFORM_NAME "unknown"
+#endif
+
+namespace
+{
+    using GraphBLAS::IndexType;
+    using GraphBLAS::IndexArrayType;
+
+    typedef double                      ScalarType;
+    typedef GraphBLAS::Matrix<ScalarType> MatrixType;
+    typedef GraphBLAS::Vector<ScalarType> VectorType;
+
+    //************************************************************************
+    struct Options
+    {
+        std::vector<IndexType> sizes   = {1000, 10000};
+        std::vector<IndexType> degrees = {4, 16};
+        unsigned int           reps    = 5;
+        unsigned int           warmup  = 1;
+        unsigned long          seed    = 20180801;
+        std::string            filter;
+        std::string            out;
+    };
+
+    std::vector<IndexType> parse_list(std::string const &arg)
+    {
+        std::vector<IndexType> values;
+        std::istringstream     iss(arg);
+        std::string            token;
+        while (std::getline(iss, token, ','))
+        {
+            values.push_back(std::stoull(token));
+        }
+        return values;
+    }
+
+    Options parse_options(int argc, char **argv)
+    {
+        Options opts;
+        for (int ix = 1; ix < argc; ++ix)
+        {
+            std::string arg(argv[ix]);
+            if (ix + 1 == argc)
+            {
+                std::cerr << "ERROR: missing value for " << arg << std::endl;
+                exit(1);
+            }
+            std::string value(argv[++ix]);
+
+            if      (arg == "--sizes")   opts.sizes   = parse_list(value);
+            else if (arg == "--degrees") opts.degrees = parse_list(value);
+            else if (arg == "--reps")    opts.reps    = std::stoul(value);
+            else if (arg == "--warmup")  opts.warmup  = std::stoul(value);
+            else if (arg == "--seed")    opts.seed    = std::stoul(value);
+            else if (arg == "--filter")  opts.filter  = value;
+            else if (arg == "--out")     opts.out     = value;
+            else
+            {
+                std::cerr << "ERROR: unknown argument " << arg << std::endl;
+                exit(1);
+            }
+        }
+
+        if (opts.reps == 0)
+        {
+            std::cerr << "ERROR: --reps must be at least 1" << std::endl;
+            exit(1);
+        }
+        return opts;
+    }
+
+    //************************************************************************
+    MatrixType random_matrix(IndexType n, IndexType degree,
+                             std::mt19937_64 &gen)
+    {
+        std::uniform_int_distribution<IndexType> col(0, n - 1);
+        std::uniform_real_distribution<ScalarType> val(1.0, 10.0);
+
+        IndexArrayType          rows, cols;
+        std::vector<ScalarType> vals;
+        for (IndexType i = 0; i < n; ++i)
+        {
+            for (IndexType k = 0; k < degree; ++k)
+            {
+                rows.push_back(i);
+                cols.push_back(col(gen));
+                vals.push_back(val(gen));
+            }
+        }
+
+        MatrixType A(n, n);
+        A.build(rows, cols, vals);
+        return A;
+    }
+
+    VectorType random_vector(IndexType n, std::mt19937_64 &gen)
+    {
+        std::uniform_int_distribution<IndexType> index(0, n - 1);
+        std::uniform_real_distribution<ScalarType> val(1.0, 10.0);
+
+        IndexArrayType          indices;
+        std::vector<ScalarType> vals;
+        for (IndexType k = 0; k < n/4; ++k)
+        {
+            indices.push_back(index(gen));
+            vals.push_back(val(gen));
+        }
+
+        VectorType u(n);
+        u.build(indices, vals);
+        return u;
+    }
+
+    //************************************************************************
+    /// The inputs shared by all of the operations for one (n, degree).
+    struct Operands
+    {
+        Operands(IndexType n, IndexType degree, std::mt19937_64 &gen)
+            : n(n),
+              degree(degree),
+              A(random_matrix(n, degree, gen)),
+              B(random_matrix(n, degree, gen)),
+              M(random_matrix(n, degree, gen)),
+              u(random_vector(n, gen)),
+              v(random_vector(n, gen)),
+              m(random_vector(n, gen)),
+              perm(n)
+        {
+            for (IndexType ix = 0; ix < n; ++ix)
+            {
+                perm[ix] = ix;
+            }
+            std::shuffle(perm.begin(), perm.end(), gen);
+        }
+
+        IndexType      n;
+        IndexType      degree;
+        MatrixType     A, B;
+        MatrixType     M;       // matrix mask
+        VectorType     u, v;
+        VectorType     m;       // vector mask
+        IndexArrayType perm;    // random permutation for extract/assign
+    };
+
+    //************************************************************************
+    // One functor per operation: operator() runs it once with the given
+    // mask, and nvals() is the number of stored values in the result.
+    //************************************************************************
+
+    template<typename SemiringT>
+    struct Mxm
+    {
+        Mxm(Operands const &in) : in(in), C(in.n, in.n) {}
+        template<typename MaskT> void operator()(MaskT const &mask)
+        {
+            GraphBLAS::mxm(C, mask, GraphBLAS::NoAccumulate(), SemiringT(),
+                           in.A, in.B, true);
+        }
+        IndexType nvals() const { return C.nvals(); }
+
+        Operands const &in;
+        MatrixType      C;
+    };
+
+    template<typename SemiringT>
+    struct Mxv
+    {
+        Mxv(Operands const &in) : in(in), w(in.n) {}
+        template<typename MaskT> void operator()(MaskT const &mask)
+        {
+            GraphBLAS::mxv(w, mask, GraphBLAS::NoAccumulate(), SemiringT(),
+                           in.A, in.u, true);
+        }
+        IndexType nvals() const { return w.nvals(); }
+
+        Operands const &in;
+        VectorType      w;
+    };
+
+    template<typename SemiringT>
+    struct Vxm
+    {
+        Vxm(Operands const &in) : in(in), w(in.n) {}
+        template<typename MaskT> void operator()(MaskT const &mask)
+        {
+            GraphBLAS::vxm(w, mask, GraphBLAS::NoAccumulate(), SemiringT(),
+                           in.u, in.A, true);
+        }
+        IndexType nvals() const { return w.nvals(); }
+
+        Operands const &in;
+        VectorType      w;
+    };
+
+    template<typename BinaryOpT>
+    struct EWiseAddMatrix
+    {
+        EWiseAddMatrix(Operands const &in) : in(in), C(in.n, in.n) {}
+        template<typename MaskT> void operator()(MaskT const &mask)
+        {
+            GraphBLAS::eWiseAdd(C, mask, GraphBLAS::NoAccumulate(),
+                                BinaryOpT(), in.A, in.B, true);
+        }
+        IndexType nvals() const { return C.nvals(); }
+
+        Operands const &in;
+        MatrixType      C;
+    };
+
+    template<typename BinaryOpT>
+    struct EWiseMultMatrix
+    {
+        EWiseMultMatrix(Operands const &in) : in(in), C(in.n, in.n) {}
+        template<typename MaskT> void operator()(MaskT const &mask)
+        {
+            GraphBLAS::eWiseMult(C, mask, GraphBLAS::NoAccumulate(),
+                                 BinaryOpT(), in.A, in.B, true);
+        }
+        IndexType nvals() const { return C.nvals(); }
+
+        Operands const &in;
+        MatrixType      C;
+    };
+
+    template<typename BinaryOpT>
+    struct EWiseAddVector
+    {
+        EWiseAddVector(Operands const &in) : in(in), w(in.n) {}
+        template<typename MaskT> void operator()(MaskT const &mask)
+        {
+            GraphBLAS::eWiseAdd(w, mask, GraphBLAS::NoAccumulate(),
+                                BinaryOpT(), in.u, in.v, true);
+        }
+        IndexType nvals() const { return w.nvals(); }
+
+        Operands const &in;
+        VectorType      w;
+    };
+
+    template<typename BinaryOpT>
+    struct EWiseMultVector
+    {
+        EWiseMultVector(Operands const &in) : in(in), w(in.n) {}
+        template<typename MaskT> void operator()(MaskT const &mask)
+        {
+            GraphBLAS::eWiseMult(w, mask, GraphBLAS::NoAccumulate(),
+                                 BinaryOpT(), in.u, in.v, true);
+        }
+        IndexType nvals() const { return w.nvals(); }
+
+        Operands const &in;
+        VectorType      w;
+    };
+
+    template<typename UnaryOpT>
+    struct ApplyMatrix
+    {
+        ApplyMatrix(Operands const &in) : in(in), C(in.n, in.n) {}
+        template<typename MaskT> void operator()(MaskT const &mask)
+        {
+            GraphBLAS::apply(C, mask, GraphBLAS::NoAccumulate(),
+                             UnaryOpT(), in.A, true);
+        }
+        IndexType nvals() const { return C.nvals(); }
+
+        Operands const &in;
+        MatrixType      C;
+    };
+
+    template<typename UnaryOpT>
+    struct ApplyVector
+    {
+        ApplyVector(Operands const &in) : in(in), w(in.n) {}
+        template<typename MaskT> void operator()(MaskT const &mask)
+        {
+            GraphBLAS::apply(w, mask, GraphBLAS::NoAccumulate(),
+                             UnaryOpT(), in.u, true);
+        }
+        IndexType nvals() const { return w.nvals(); }
+
+        Operands const &in;
+        VectorType      w;
+    };
+
+    template<typename MonoidT>
+    struct ReduceMatrixToVector
+    {
+        ReduceMatrixToVector(Operands const &in) : in(in), w(in.n) {}
+        template<typename MaskT> void operator()(MaskT const &mask)
+        {
+            GraphBLAS::reduce(w, mask, GraphBLAS::NoAccumulate(),
+                              MonoidT(), in.A, true);
+        }
+        IndexType nvals() const { return w.nvals(); }
+
+        Operands const &in;
+        VectorType      w;
+    };
+
+    /// The scalar variant takes no mask; it is run with NoMask only.
+    template<typename MonoidT>
+    struct ReduceMatrixToScalar
+    {
+        ReduceMatrixToScalar(Operands const &in) : in(in), val(0) {}
+        void operator()(GraphBLAS::NoMask const &)
+        {
+            val = 0;
+            GraphBLAS::reduce(val, GraphBLAS::NoAccumulate(), MonoidT(),
+                              in.A);
+        }
+        IndexType nvals() const { return 1; }
+
+        Operands const &in;
+        ScalarType      val;
+    };
+
+    struct AssignMatrix
+    {
+        AssignMatrix(Operands const &in) : in(in), C(in.n, in.n) {}
+        template<typename MaskT> void operator()(MaskT const &mask)
+        {
+            GraphBLAS::assign(C, mask, GraphBLAS::NoAccumulate(),
+                              in.A, in.perm, in.perm, true);
+        }
+        IndexType nvals() const { return C.nvals(); }
+
+        Operands const &in;
+        MatrixType      C;
+    };
+
+    struct AssignVector
+    {
+        AssignVector(Operands const &in) : in(in), w(in.n) {}
+        template<typename MaskT> void operator()(MaskT const &mask)
+        {
+            GraphBLAS::assign(w, mask, GraphBLAS::NoAccumulate(),
+                              in.u, in.perm, true);
+        }
+        IndexType nvals() const { return w.nvals(); }
+
+        Operands const &in;
+        VectorType      w;
+    };
+
+    struct ExtractMatrix
+    {
+        ExtractMatrix(Operands const &in) : in(in), C(in.n, in.n) {}
+        template<typename MaskT> void operator()(MaskT const &mask)
+        {
+            GraphBLAS::extract(C, mask, GraphBLAS::NoAccumulate(),
+                               in.A, in.perm, in.perm, true);
+        }
+        IndexType nvals() const { return C.nvals(); }
+
+        Operands const &in;
+        MatrixType      C;
+    };
+
+    struct ExtractVector
+    {
+        ExtractVector(Operands const &in) : in(in), w(in.n) {}
+        template<typename MaskT> void operator()(MaskT const &mask)
+        {
+            GraphBLAS::extract(w, mask, GraphBLAS::NoAccumulate(),
+                               in.u, in.perm, true);
+        }
+        IndexType nvals() const { return w.nvals(); }
+
+        Operands const &in;
+        VectorType      w;
+    };
+
+    struct Transpose
+    {
+        Transpose(Operands const &in) : in(in), C(in.n, in.n) {}
+        template<typename MaskT> void operator()(MaskT const &mask)
+        {
+            GraphBLAS::transpose(C, mask, GraphBLAS::NoAccumulate(),
+                                 in.A, true);
+        }
+        IndexType nvals() const { return C.nvals(); }
+
+        Operands const &in;
+        MatrixType      C;
+    };
+
+    //************************************************************************
+    struct Result
+    {
+        std::string         name;
+        IndexType           n;
+        IndexType           degree;
+        IndexType           nvals_in;
+        IndexType           nvals_out;
+        std::vector<double> times_ms;
+    };
+
+    class Runner
+    {
+    public:
+        Runner(Options const &opts) : m_opts(opts) {}
+
+        /// Time op with no mask, with mask and with its complement.
+        template<typename OpT, typename MaskT>
+        void run(std::string const &name, Operands const &in,
+                 MaskT const &mask)
+        {
+            time<OpT>(name + "/none", in, GraphBLAS::NoMask());
+            time<OpT>(name + "/mask", in, mask);
+            time<OpT>(name + "/complement", in, GraphBLAS::complement(mask));
+        }
+
+        template<typename OpT, typename MaskT>
+        void time(std::string const &name, Operands const &in,
+                  MaskT const &mask)
+        {
+            if (name.find(m_opts.filter) == std::string::npos)
+            {
+                return;
+            }
+
+            OpT op(in);
+            for (unsigned int ix = 0; ix < m_opts.warmup; ++ix)
+            {
+                op(mask);
+                GraphBLAS::wait();
+            }
+
+            Result result;
+            result.name     = name;
+            result.n        = in.n;
+            result.degree   = in.degree;
+            result.nvals_in = in.A.nvals();
+            for (unsigned int ix = 0; ix < m_opts.reps; ++ix)
+            {
+                auto start = std::chrono::steady_clock::now();
+                op(mask);
+                GraphBLAS::wait();
+                std::chrono::duration<double, std::milli> elapsed(
+                    std::chrono::steady_clock::now() - start);
+                result.times_ms.push_back(elapsed.count());
+            }
+            result.nvals_out = op.nvals();
+
+            std::cerr << name << " n=" << in.n << " degree=" << in.degree
+                      << ": " << *std::min_element(result.times_ms.begin(),
+                                                   result.times_ms.end())
+                      << " msec (min)" << std::endl;
+            m_results.push_back(result);
+        }
+
+        void write_json(std::ostream &os) const;
+
+    private:
+        Options             m_opts;
+        std::vector<Result> m_results;
+    };
+
+    //************************************************************************
+    void write_json(std::ostream &os, Result const &result)
+    {
+        std::vector<double> sorted(result.times_ms);
+        std::sort(sorted.begin(), sorted.end());
+        std::size_t count(sorted.size());
+
+        double sum(0.0);
+        for (auto t : sorted) sum += t;
+        double mean(sum/count);
+
+        double sq(0.0);
+        for (auto t : sorted) sq += (t - mean)*(t - mean);
+        double stddev((count > 1) ? std::sqrt(sq/(count - 1)) : 0.0);
+
+        double median((count % 2) ? sorted[count/2]
+                      : 0.5*(sorted[count/2 - 1] + sorted[count/2]));
+
+        std::string name(result.name);
+        std::size_t op_end(name.find('/'));
+        std::size_t mask_begin(name.rfind('/'));
+
+        os << "    {\"name\": \"" << name << "\""
+           << ", \"op\": \"" << name.substr(0, op_end) << "\""
+           << ", \"variant\": \""
+           << ((op_end == mask_begin) ? std::string("")
+               : name.substr(op_end + 1, mask_begin - op_end - 1)) << "\""
+           << ", \"mask\": \"" << name.substr(mask_begin + 1) << "\""
+           << ", \"n\": " << result.n
+           << ", \"degree\": " << result.degree
+           << ", \"nvals_in\": " << result.nvals_in
+           << ", \"nvals_out\": " << result.nvals_out
+           << ",\n     \"times_ms\": [";
+        for (std::size_t ix = 0; ix < result.times_ms.size(); ++ix)
+        {
+            os << ((ix == 0) ? "" : ", ") << result.times_ms[ix];
+        }
+        os << "]"
+           << ",\n     \"min_ms\": " << sorted.front()
+           << ", \"max_ms\": " << sorted.back()
+           << ", \"mean_ms\": " << mean
+           << ", \"median_ms\": " << median
+           << ", \"stddev_ms\": " << stddev << "}";
+    }
+
+    void Runner::write_json(std::ostream &os) const
+    {
+#ifdef _OPENMP
+        int threads(omp_get_max_threads());
+#else
+        int threads(1);
+#endif
+#ifdef __OPTIMIZE__
+        bool optimized(true);
+#else
+        bool optimized(false);
+#endif
+
+        os.precision(6);
+        os << "{\n"
+           << "  \"library\": \"GBTL 2.0\",\n"
+           << "  \"platform\": \"" << GB_PLATFORM_NAME << "\",\n"
+           << "  \"threads\": " << threads << ",\n"
+           << "  \"optimized\": " << (optimized ? "true" : "false") << ",\n"
+           << "  \"scalar_type\": \"double\",\n"
+           << "  \"seed\": " << m_opts.seed << ",\n"
+           << "  \"warmup\": " << m_opts.warmup << ",\n"
+           << "  \"repetitions\": " << m_opts.reps << ",\n"
+           << "  \"results\": [\n";
+        for (std::size_t ix = 0; ix < m_results.size(); ++ix)
+        {
+            ::write_json(os, m_results[ix]);
+            os << ((ix + 1 < m_results.size()) ? ",\n" : "\n");
+        }
+        os << "  ]\n}" << std::endl;
+    }
+}
+
+//****************************************************************************
+int main(int argc, char **argv)
+{
+    using namespace GraphBLAS;
+
+    Options opts(parse_options(argc, argv));
+    Runner  runner(opts);
+
+#ifndef __OPTIMIZE__
+    std::cerr << "WARNING: built without optimization "
+              << "(configure with -DCMAKE_BUILD_TYPE=Release)" << std::endl;
+#endif
+
+    for (auto n : opts.sizes)
+    {
+        for (auto degree : opts.degrees)
+        {
+            std::mt19937_64 gen(opts.seed + 7919*n + degree);
+            Operands in(n, degree, gen);
+
+            runner.run<Mxm<ArithmeticSemiring<ScalarType>>>(
+                "mxm/plus_times", in, in.M);
+            runner.run<Mxm<MinPlusSemiring<ScalarType>>>(
+                "mxm/min_plus", in, in.M);
+            runner.run<Mxv<ArithmeticSemiring<ScalarType>>>(
+                "mxv/plus_times", in, in.m);
+            runner.run<Mxv<MinPlusSemiring<ScalarType>>>(
+                "mxv/min_plus", in, in.m);
+            runner.run<Vxm<ArithmeticSemiring<ScalarType>>>(
+                "vxm/plus_times", in, in.m);
+            runner.run<Vxm<MinPlusSemiring<ScalarType>>>(
+                "vxm/min_plus", in, in.m);
+
+            runner.run<EWiseAddMatrix<Plus<ScalarType>>>(
+                "eWiseAdd_matrix/plus", in, in.M);
+            runner.run<EWiseMultMatrix<Times<ScalarType>>>(
+                "eWiseMult_matrix/times", in, in.M);
+            runner.run<EWiseAddVector<Plus<ScalarType>>>(
+                "eWiseAdd_vector/plus", in, in.m);
+            runner.run<EWiseMultVector<Times<ScalarType>>>(
+                "eWiseMult_vector/times", in, in.m);
+
+            runner.run<ApplyMatrix<AdditiveInverse<ScalarType>>>(
+                "apply_matrix/ainv", in, in.M);
+            runner.run<ApplyVector<AdditiveInverse<ScalarType>>>(
+                "apply_vector/ainv", in, in.m);
+
+            runner.run<ReduceMatrixToVector<PlusMonoid<ScalarType>>>(
+                "reduce_matrix_vector/plus", in, in.m);
+            runner.time<ReduceMatrixToScalar<PlusMonoid<ScalarType>>>(
+                "reduce_matrix_scalar/plus/none", in, NoMask());
+
+            runner.run<AssignMatrix>("assign_matrix", in, in.M);
+            runner.run<AssignVector>("assign_vector", in, in.m);
+            runner.run<ExtractMatrix>("extract_matrix", in, in.M);
+            runner.run<ExtractVector>("extract_vector", in, in.m);
+            runner.run<Transpose>("transpose", in, in.M);
+        }
+    }
+
+    if (opts.out.empty())
+    {
+        runner.write_json(std::cout);
+    }
+    else
+    {
+        std::ofstream ofs(opts.out);
+        if (!ofs)
+        {
+            std::cerr << "ERROR: cannot open " << opts.out << std::endl;
+            return 1;
+        }
+        runner.write_json(ofs);
+        std::cerr << "Wrote " << opts.out << std::endl;
+    }
+    return 0;
+}
@@ -28,12 +28,12 @@
  */
 
 #include <iostream>
-#include <fstream>
 #include <chrono>
 
 #define GRAPHBLAS_DEBUG 1
 
 #include <graphblas/graphblas.hpp>
+#include <graphblas/io/edge_list.hpp>
 #include <algorithms/triangle_count.hpp>
 
 //****************************************************************************
@@ -47,24 +47,16 @@ int main(int argc, char **argv)
 
     // Read the edgelist and create the tuple arrays
     std::string pathname(argv[1]);
-    std::ifstream infile(pathname);
+    GraphBLAS::IndexArrayType iEdges, jEdges;
+    std::vector<int32_t> vEdges;
+    GraphBLAS::IndexType num_nodes(
+        GraphBLAS::io::read_edge_list(pathname, iEdges, jEdges, vEdges));
+
     GraphBLAS::IndexArrayType iL, iU, iA;
     GraphBLAS::IndexArrayType jL, jU, jA;
-    int64_t num_rows = 0;
-    int64_t max_id = 0;
-    uint64_t src, dst;
-//    for (std::string row; getline(infile, row, '\n');)
-//    {
-//        std::cout << "Row: " << row << std::endl;
-//        sscanf(row.c_str(), "%ld\t%ld", &src, &dst);
-    while (true)
+    for (GraphBLAS::IndexType ix = 0; ix < iEdges.size(); ++ix)
     {
-        infile >> src >> dst;
-        if (infile.eof()) break;
-        //std::cout << "Read: " << src << ", " << dst << std::endl;
-        if (src > max_id) max_id = src;
-        if (dst > max_id) max_id = dst;
-
+        GraphBLAS::IndexType src(iEdges[ix]), dst(jEdges[ix]);
         if (src < dst)
         {
             iA.push_back(src);
@@ -82,13 +74,11 @@ int main(int argc, char **argv)
             jL.push_back(dst);
         }
         // else ignore self loops
-
-        ++num_rows;
     }
-    std::cout << "Read " << num_rows << " rows." << std::endl;
-    std::cout << "#Nodes = " << (max_id + 1) << std::endl;
+    std::cout << "Read " << iEdges.size() << " rows." << std::endl;
+    std::cout << "#Nodes = " << num_nodes << std::endl;
 
-    GraphBLAS::IndexType NUM_NODES(max_id + 1);
+    GraphBLAS::IndexType NUM_NODES(num_nodes);
     typedef int32_t T;
     std::vector<T> v(iA.size(), 1);
 
@@ -73,7 +73,7 @@ namespace GraphBLAS
         template <typename OtherMatrixT>
         bool operator==(OtherMatrixT const &rhs) const
         {
-            return (m_mat == rhs);
+            return (completed() == rhs);
         }
 
         template <typename OtherMatrixT>
@@ -84,16 +84,16 @@ namespace GraphBLAS
 
         IndexType nrows() const { return m_mat.nrows(); }
         IndexType ncols() const { return m_mat.ncols(); }
-        IndexType nvals() const { return m_mat.nvals(); }
+        IndexType nvals() const { return completed().nvals(); }
 
         bool hasElement(IndexType row, IndexType col) const
         {
-            return (m_mat.hasElement(row,col));
+            return (completed().hasElement(row,col));
         }
 
         ScalarType extractElement(IndexType row, IndexType col) const
         {
-            return m_mat.extractElement(row, col);
+            return completed().extractElement(row, col);
         }
 
         template<typename RAIteratorIT,
@@ -104,7 +104,7 @@ namespace GraphBLAS
                                   RAIteratorJT        col_it,
                                   RAIteratorVT        values)
         {
-            m_mat.extractTuples(row_it, col_it, values);
+            completed().extractTuples(row_it, col_it, values);
         }
 
         template<typename ValueT,
@@ -115,7 +115,7 @@ namespace GraphBLAS
                                   ColSequenceT              &col_indices,
                                   std::vector<ValueT>       &values)
         {
-            m_mat.extractTuples(row_indices, col_indices, values);
+            completed().extractTuples(row_indices, col_indices, values);
         }
 
         //other methods that may or may not belong here:
@@ -123,7 +123,7 @@ namespace GraphBLAS
         void printInfo(std::ostream &os) const
         {
             os << "Frontend MatrixComplementView of:";
-            m_mat.printInfo(os);
+            completed().printInfo(os);
         }
 
         /// @todo This does not need to be a friend
@@ -137,6 +137,14 @@ namespace GraphBLAS
     private:
         BackendType m_mat;
 
+        // The view reads the underlying container, so finish any pending
+        // operations on it first.
+        BackendType const &completed() const
+        {
+            detail::completed(m_mat.getMatrix());
+            return m_mat;
+        }
+
         // PUT ALL FRIEND DECLARATIONS (that use matrix masks) HERE
 
         // 4.3.1:
@@ -282,6 +290,26 @@ namespace GraphBLAS
 
         //--------------------------------------------------------------------
 
+        // fused mxm and reduce
+        template<typename ValueT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename MonoidT,
+                 typename UnaryOpT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        friend inline void mxm_reduce(ValueT           &val,
+                                      MaskT      const &Mask,
+                                      AccumT            accum,
+                                      MonoidT           monoid,
+                                      UnaryOpT          apply_op,
+                                      SemiringT         op,
+                                      AMatrixT   const &A,
+                                      BMatrixT   const &B);
+
+        //--------------------------------------------------------------------
+
     };
 
     //************************************************************************
@@ -331,16 +359,16 @@ namespace GraphBLAS
         }
 
         IndexType size() const  { return m_vec.size(); }
-        IndexType nvals() const { return m_vec.nvals(); }
+        IndexType nvals() const { return completed().nvals(); }
 
         bool hasElement(IndexType index) const
         {
-            return m_vec.hasElement(index);
+            return completed().hasElement(index);
         }
 
         ScalarType extractElement(IndexType index) const
         {
-            return m_vec.extractElement(index);
+            return completed().extractElement(index);
         }
 
         template<typename RAIteratorIT,
@@ -348,7 +376,7 @@ namespace GraphBLAS
         inline void extractTuples(RAIteratorIT        i_it,
                                   RAIteratorVT        v_it)
         {
-            m_vec.extractTuples(i_it, v_it);
+            completed().extractTuples(i_it, v_it);
         }
 
         // @TODO: Should this be const Indices
@@ -357,7 +385,7 @@ namespace GraphBLAS
         inline void extractTuples(SequenceT                 &indices,
                                   std::vector<ValueT>       &values)
         {
-            m_vec.extractTuples(indices, values);
+            completed().extractTuples(indices, values);
         }
 
         //other methods that may or may not belong here:
@@ -365,7 +393,7 @@ namespace GraphBLAS
         void printInfo(std::ostream &os) const
         {
             os << "Frontend VectorComplementView of:";
-            m_vec.printInfo(os);
+            completed().printInfo(os);
         }
 
         /// @todo This does not need to be a friend
@@ -379,6 +407,14 @@ namespace GraphBLAS
     private:
         BackendType m_vec;
 
+        // The view reads the underlying container, so finish any pending
+        // operations on it first.
+        BackendType const &completed() const
+        {
+            detail::completed(m_vec.getVector());
+            return m_vec;
+        }
+
         // PUT ALL FRIEND DECLARATIONS (that use vector masks) HERE
 
         //--------------------------------------------------------------------
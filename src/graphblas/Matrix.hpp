@@ -31,8 +31,11 @@
 
 #include <cstddef>
 #include <type_traits>
+#include <string>
+#include <utility>
 #include <graphblas/detail/config.hpp>
 #include <graphblas/detail/param_unpack.hpp>
+#include <graphblas/detail/pending.hpp>
 
 #define GB_INCLUDE_BACKEND_MATRIX 1
 #include <backend_include.hpp>
@@ -78,6 +81,7 @@ namespace GraphBLAS
             ScalarT,
             detail::SparsenessCategoryTag,
             detail::DirectednessCategoryTag,
+            detail::StorageCategoryTag,
             TagsT... ,
             detail::NullTag,
             detail::NullTag >::type BackendType;
@@ -96,13 +100,36 @@ namespace GraphBLAS
         {
         }
 
+        /**
+         * @brief Construct a matrix from a file in the binary format written
+         *        by io::write_binary_matrix().  The storage must support
+         *        this (MappedCsrStorageTag, which uses the file in place).
+         *
+         * @param[in] filename  Path of the binary file
+         */
+        explicit Matrix(std::string const &filename)
+            : m_mat(filename)
+        {
+        }
+
         /**
          * @brief Copy constructor.
          *
          * @param[in] rhs   The matrix to copy.
          */
         Matrix(Matrix<ScalarT, TagsT...> const &rhs)
-            : m_mat(rhs.m_mat)
+            : m_mat(detail::completed(rhs.m_mat))
+        {
+        }
+
+        /**
+         * @brief Move constructor.
+         *
+         * @param[in] rhs   The matrix to take the contents of; it is left
+         *                  empty, with the same dimensions.
+         */
+        Matrix(Matrix<ScalarT, TagsT...> &&rhs)
+            : m_mat(std::move(detail::released(rhs.m_mat)))
         {
         }
 
@@ -134,7 +161,7 @@ namespace GraphBLAS
         {
         }
 
-        ~Matrix() { }
+        ~Matrix() { detail::discarded(m_mat); }
 
         /// @todo Should assignment work only if dimensions are same?
         Matrix<ScalarT, TagsT...> &
@@ -143,16 +170,39 @@ namespace GraphBLAS
             if (this != &rhs)
             {
                 // backend currently doing dimension check.
-                m_mat = rhs.m_mat;
+                detail::released(m_mat) = detail::completed(rhs.m_mat);
             }
             return *this;
         }
 
+        /// Move assignment (same dimensions); rhs is left empty.
+        Matrix<ScalarT, TagsT...> &
+        operator=(Matrix<ScalarT, TagsT...> &&rhs)
+        {
+            if (this != &rhs)
+            {
+                detail::released(m_mat) =
+                    std::move(detail::released(rhs.m_mat));
+            }
+            return *this;
+        }
+
+        /// Exchange the contents (and dimensions) of two matrices in
+        /// constant time.
+        void swap(Matrix<ScalarT, TagsT...> &rhs)
+        {
+            if (this != &rhs)
+            {
+                detail::released(m_mat).swap(detail::released(rhs.m_mat));
+            }
+        }
+
 
         /// @todo need to change to mix and match internal types
         bool operator==(Matrix<ScalarT, TagsT...> const &rhs) const
         {
-            return (m_mat == rhs.m_mat);
+            return (detail::completed(m_mat) ==
+                    detail::completed(rhs.m_mat));
         }
 
         bool operator!=(Matrix<ScalarT, TagsT...> const &rhs) const
@@ -185,7 +235,7 @@ namespace GraphBLAS
                    IndexType    num_vals,
                    BinaryOpT    dup = BinaryOpT())
         {
-            m_mat.build(i_it, j_it, v_it, num_vals, dup);
+            detail::released(m_mat).build(i_it, j_it, v_it, num_vals, dup);
         }
 
         /**
@@ -214,31 +264,32 @@ namespace GraphBLAS
                 throw DimensionException("Matrix::build");
             }
 
-            m_mat.build(row_indices.begin(), col_indices.begin(),
-                        values.begin(), values.size(), dup);
+            detail::released(m_mat).build(row_indices.begin(),
+                                          col_indices.begin(),
+                                          values.begin(), values.size(), dup);
         }
 
-        void clear() { m_mat.clear(); }
+        void clear() { detail::released(m_mat).clear(); }
 
         IndexType nrows() const  { return m_mat.nrows(); }
         IndexType ncols() const  { return m_mat.ncols(); }
-        IndexType nvals() const  { return m_mat.nvals(); }
+        IndexType nvals() const  { return detail::completed(m_mat).nvals(); }
 
         bool hasElement(IndexType row, IndexType col) const
         {
-            return m_mat.hasElement(row, col);
+            return detail::completed(m_mat).hasElement(row, col);
         }
 
         /// @todo I don't think this is a valid interface for sparse
         void setElement(IndexType row, IndexType col, ScalarT const &val)
         {
-            m_mat.setElement(row, col, val);
+            detail::released(m_mat).setElement(row, col, val);
         }
 
         /// @throw NoValueException if there is no value stored at (row,col)
         ScalarT extractElement(IndexType row, IndexType col) const
         {
-            return m_mat.extractElement(row, col);
+            return detail::completed(m_mat).extractElement(row, col);
         }
 
         template<typename RAIteratorIT,
@@ -248,7 +299,7 @@ namespace GraphBLAS
                                   RAIteratorJT        col_it,
                                   RAIteratorVT        values) const
         {
-            m_mat.extractTuples(row_it, col_it, values);
+            detail::completed(m_mat).extractTuples(row_it, col_it, values);
         }
 
         template <typename RowSequenceT,
@@ -257,16 +308,16 @@ namespace GraphBLAS
                                   ColSequenceT            &col_indices,
                                   std::vector<ScalarT>    &values) const
         {
-            m_mat.extractTuples(row_indices.begin(),
-                                col_indices.begin(),
-                                values.begin());
+            detail::completed(m_mat).extractTuples(row_indices.begin(),
+                                                   col_indices.begin(),
+                                                   values.begin());
         }
 
         /// This replaces operator<< and outputs implementation specific
         /// information.
         void printInfo(std::ostream &os) const
         {
-            m_mat.printInfo(os);
+            detail::completed(m_mat).printInfo(os);
         }
 
     private:
@@ -521,6 +572,26 @@ namespace GraphBLAS
 
         //--------------------------------------------------------------------
 
+        // fused mxm and reduce
+        template<typename ValueT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename MonoidT,
+                 typename UnaryOpT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        friend inline void mxm_reduce(ValueT           &val,
+                                      MaskT      const &Mask,
+                                      AccumT            accum,
+                                      MonoidT           monoid,
+                                      UnaryOpT          apply_op,
+                                      SemiringT         op,
+                                      AMatrixT   const &A,
+                                      BMatrixT   const &B);
+
+        //--------------------------------------------------------------------
+
         template<typename MatrixT>
         friend inline GraphBLAS::TransposeView<MatrixT> transpose(MatrixT const &A);
 
@@ -582,7 +653,7 @@ namespace GraphBLAS
         // ostr << label << ": zero = " << mat.m_mat.get_zero() << std::endl;
         ostr << label << " (" << mat.nrows() << "x" << mat.ncols() << ")"
              << std::endl;
-        backend::pretty_print_matrix(ostr, mat.m_mat);
+        backend::pretty_print_matrix(ostr, detail::completed(mat.m_mat));
     }
 
 
@@ -593,4 +664,11 @@ namespace GraphBLAS
         return os;
     }
 
+    template<typename ScalarT, typename... TagsT>
+    inline void swap(Matrix<ScalarT, TagsT...> &lhs,
+                     Matrix<ScalarT, TagsT...> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+
 } // end namespace GraphBLAS
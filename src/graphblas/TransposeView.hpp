@@ -76,7 +76,7 @@ namespace GraphBLAS
         template <typename OtherMatrixT>
         bool operator==(OtherMatrixT const &rhs) const
         {
-            return (m_mat == rhs);
+            return (completed() == rhs);
         }
 
         template <typename OtherMatrixT>
@@ -87,16 +87,16 @@ namespace GraphBLAS
 
         IndexType nrows() const { return m_mat.nrows(); }
         IndexType ncols() const { return m_mat.ncols(); }
-        IndexType nvals() const { return m_mat.nvals(); }
+        IndexType nvals() const { return completed().nvals(); }
 
         bool hasElement(IndexType row, IndexType col) const
         {
-            return m_mat.hasElement(row, col);
+            return completed().hasElement(row, col);
         }
 
         ScalarType extractElement(IndexType row, IndexType col) const
         {
-            return m_mat.extractElement(row, col);
+            return completed().extractElement(row, col);
         }
 
         template<typename RAIteratorIT,
@@ -107,7 +107,7 @@ namespace GraphBLAS
                                   RAIteratorJT        col_it,
                                   RAIteratorVT        values)
         {
-            m_mat.extractTuples(row_it, col_it, values);
+            completed().extractTuples(row_it, col_it, values);
         }
 
         // @TODO: Should these be const referneces to the sequence
@@ -119,7 +119,7 @@ namespace GraphBLAS
                                   ColSequenceT            &col_indices,
                                   std::vector<ValueT>     &values)
         {
-            m_mat.extractTuples(row_indices, col_indices, values);
+            completed().extractTuples(row_indices, col_indices, values);
         }
 
         //other methods that may or may not belong here:
@@ -127,7 +127,7 @@ namespace GraphBLAS
         void printInfo(std::ostream &os) const
         {
             os << "Frontend TransposeView of:" << std::endl;
-            m_mat.printInfo(os);
+            completed().printInfo(os);
         }
 
         /// @todo This does not need to be a friend
@@ -140,6 +140,14 @@ namespace GraphBLAS
     private:
         BackendType m_mat;
 
+        // The view reads the underlying container, so finish any pending
+        // operations on it first.
+        BackendType const &completed() const
+        {
+            detail::completed(m_mat.getMatrix());
+            return m_mat;
+        }
+
         // PUT ALL FRIEND DECLARATIONS HERE
         template<typename CMatrixT,
                  typename MaskT,
@@ -346,6 +354,26 @@ namespace GraphBLAS
                                      AccumT          accum,
                                      AMatrixT const &A,
                                      bool            replace_flag);
+
+        //--------------------------------------------------------------------
+
+        // fused mxm and reduce
+        template<typename ValueT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename MonoidT,
+                 typename UnaryOpT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        friend inline void mxm_reduce(ValueT           &val,
+                                      MaskT      const &Mask,
+                                      AccumT            accum,
+                                      MonoidT           monoid,
+                                      UnaryOpT          apply_op,
+                                      SemiringT         op,
+                                      AMatrixT   const &A,
+                                      BMatrixT   const &B);
     };
 
 } // end namespace GraphBLAS
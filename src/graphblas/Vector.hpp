@@ -31,8 +31,10 @@
 
 #include <cstddef>
 #include <type_traits>
+#include <utility>
 #include <graphblas/detail/config.hpp>
 #include <graphblas/detail/param_unpack.hpp>
+#include <graphblas/detail/pending.hpp>
 
 #define GB_INCLUDE_BACKEND_VECTOR 1
 #include <backend_include.hpp>
@@ -103,8 +105,29 @@ namespace GraphBLAS
             : m_vec(values, zero)
         {
         }
+        /**
+         * @brief Copy constructor.
+         *
+         * @param[in] rhs   The vector to copy.
+         */
+        Vector(Vector<ScalarT, TagsT...> const &rhs)
+            : m_vec(detail::completed(rhs.m_vec))
+        {
+        }
+
+        /**
+         * @brief Move constructor.
+         *
+         * @param[in] rhs   The vector to take the contents of; it is left
+         *                  empty, with the same size.
+         */
+        Vector(Vector<ScalarT, TagsT...> &&rhs)
+            : m_vec(std::move(detail::released(rhs.m_vec)))
+        {
+        }
+
         /// Destructor
-        ~Vector() { }
+        ~Vector() { detail::discarded(m_vec); }
 
         /**
          * @brief Assignment from another vector
@@ -114,16 +137,43 @@ namespace GraphBLAS
          * @todo Should assignment work only if dimensions are same?
          * @note This clears any previous information
          */
-        Vector<ScalarT, TagsT...>
+        Vector<ScalarT, TagsT...>&
         operator=(Vector<ScalarT, TagsT...> const &rhs)
         {
             if (this != &rhs)
             {
-                m_vec = rhs.m_vec;
+                detail::released(m_vec) = detail::completed(rhs.m_vec);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Move assignment from another vector of the same size
+         *
+         * @param[in]  rhs  The vector to take the contents of; it is left
+         *                  empty.
+         */
+        Vector<ScalarT, TagsT...>&
+        operator=(Vector<ScalarT, TagsT...> &&rhs)
+        {
+            if (this != &rhs)
+            {
+                detail::released(m_vec) =
+                    std::move(detail::released(rhs.m_vec));
             }
             return *this;
         }
 
+        /// Exchange the contents (and sizes) of two vectors in constant
+        /// time.
+        void swap(Vector<ScalarT, TagsT...> &rhs)
+        {
+            if (this != &rhs)
+            {
+                detail::released(m_vec).swap(detail::released(rhs.m_vec));
+            }
+        }
+
         /**
          * @brief Assignment from dense data
          *
@@ -134,14 +184,15 @@ namespace GraphBLAS
          */
         Vector<ScalarT, TagsT...>& operator=(std::vector<ScalarT> const &rhs)
         {
-            m_vec = rhs;
+            detail::released(m_vec) = rhs;
             return *this;
         }
 
         /// @todo need to change to mix and match internal types
         bool operator==(Vector<ScalarT, TagsT...> const &rhs) const
         {
-            return (m_vec == rhs.m_vec);
+            return (detail::completed(m_vec) ==
+                    detail::completed(rhs.m_vec));
         }
 
         bool operator!=(Vector<ScalarT, TagsT...> const &rhs) const
@@ -170,7 +221,7 @@ namespace GraphBLAS
                    IndexType    num_vals,
                    BinaryOpT    dup = BinaryOpT())
         {
-            m_vec.build(i_it, v_it, num_vals, dup);
+            detail::released(m_vec).build(i_it, v_it, num_vals, dup);
         }
 
         /**
@@ -195,29 +246,30 @@ namespace GraphBLAS
             {
                 throw DimensionException("Vector::build");
             }
-            m_vec.build(indices.begin(), values.begin(), values.size(), dup);
+            detail::released(m_vec).build(indices.begin(), values.begin(),
+                                          values.size(), dup);
         }
 
-        void clear() { m_vec.clear(); }
+        void clear() { detail::released(m_vec).clear(); }
 
         IndexType size() const   { return m_vec.size(); }
-        IndexType nvals() const  { return m_vec.nvals(); }
+        IndexType nvals() const  { return detail::completed(m_vec).nvals(); }
 
         bool hasElement(IndexType index) const
         {
-            return m_vec.hasElement(index);
+            return detail::completed(m_vec).hasElement(index);
         }
 
         void setElement(IndexType      index,
                         ScalarT const &new_val)
         {
-            m_vec.setElement(index, new_val);
+            detail::released(m_vec).setElement(index, new_val);
         }
 
         /// @throw NoValueException if there is no value stored at (row,col)
         ScalarT extractElement(IndexType index) const
         {
-            return m_vec.extractElement(index);
+            return detail::completed(m_vec).extractElement(index);
         }
 
         template<typename RAIteratorIT,
@@ -225,20 +277,20 @@ namespace GraphBLAS
         void extractTuples(RAIteratorIT        i_it,
                            RAIteratorVT        v_it) const
         {
-            m_vec.extractTuples(i_it, v_it);
+            detail::completed(m_vec).extractTuples(i_it, v_it);
         }
 
         void extractTuples(IndexArrayType        &indices,
                            std::vector<ScalarT>  &values) const
         {
-            m_vec.extractTuples(indices, values);
+            detail::completed(m_vec).extractTuples(indices, values);
         }
 
         /// This replaces operator<< and outputs implementation specific
         /// information.
         void printInfo(std::ostream &os) const
         {
-            m_vec.printInfo(os);
+            detail::completed(m_vec).printInfo(os);
         }
 
     private:
@@ -499,4 +551,11 @@ namespace GraphBLAS
         return os;
     }
 
+    template<typename ScalarT, typename... TagsT>
+    inline void swap(Vector<ScalarT, TagsT...> &lhs,
+                     Vector<ScalarT, TagsT...> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+
 } // end namespace GraphBLAS
@@ -0,0 +1,76 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Concatenation of results computed in parts on separate (OpenMP) threads,
+ * shared by the text readers and the graph generators.
+ */
+
+#ifndef GB_CONCAT_PARTS_HPP
+#define GB_CONCAT_PARTS_HPP
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include <graphblas/types.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace detail
+    {
+        /// Concatenate the per-part results in order.
+        template <typename T>
+        void concat_parts(std::vector<std::vector<T> > const &parts,
+                          std::vector<T>                     &result)
+        {
+            std::vector<IndexType> offsets(parts.size() + 1, 0);
+            for (IndexType part = 0; part < parts.size(); ++part)
+            {
+                offsets[part + 1] = offsets[part] + parts[part].size();
+            }
+            result.resize(offsets.back());
+
+#ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic, 1)
+#endif
+            for (IndexType part = 0; part < parts.size(); ++part)
+            {
+                std::copy(parts[part].begin(), parts[part].end(),
+                          result.begin() + offsets[part]);
+            }
+        }
+
+    } // namespace detail
+} // namespace GraphBLAS
+
+#endif // GB_CONCAT_PARTS_HPP
@@ -39,11 +39,30 @@ namespace GraphBLAS
     struct DenseTag {};
     struct SparseTag {};
 
+    // The default sparse matrix storage is list-of-lists (LIL); these tags
+    // select a different storage layout in the backend.
+    struct LilStorageTag {};
+    struct CsrStorageTag {};
+    struct CsrCscStorageTag {};
+
+    // CSR storage that can be constructed from (and read in place from) a
+    // memory mapped binary file; see io/binary_format.hpp.
+    struct MappedCsrStorageTag {};
+
+    // Hypersparse (doubly compressed, DCSR) storage that only holds the
+    // non-empty rows, for very large or tall-skinny dimensions.
+    struct HypersparseStorageTag {};
+
+    // CSR structure with one value shared by every element (e.g., unweighted
+    // graphs); switches to one value per element if they stop being equal.
+    struct IsoValuedStorageTag {};
+
     namespace detail
     {
         // add category tags in the detail namespace
         struct SparsenessCategoryTag {};
         struct DirectednessCategoryTag {};
+        struct StorageCategoryTag {};
         struct NullTag {};
     } //end detail
 }//end GraphBLAS
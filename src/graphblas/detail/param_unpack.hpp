@@ -80,6 +80,36 @@ namespace GraphBLAS
             using type = DirectedMatrixTag;
         };
 
+        template<>
+        struct substitute<detail::StorageCategoryTag, LilStorageTag> {
+            using type = LilStorageTag;
+        };
+
+        template<>
+        struct substitute<detail::StorageCategoryTag, CsrStorageTag> {
+            using type = CsrStorageTag;
+        };
+
+        template<>
+        struct substitute<detail::StorageCategoryTag, CsrCscStorageTag> {
+            using type = CsrCscStorageTag;
+        };
+
+        template<>
+        struct substitute<detail::StorageCategoryTag, MappedCsrStorageTag> {
+            using type = MappedCsrStorageTag;
+        };
+
+        template<>
+        struct substitute<detail::StorageCategoryTag, HypersparseStorageTag> {
+            using type = HypersparseStorageTag;
+        };
+
+        template<>
+        struct substitute<detail::StorageCategoryTag, IsoValuedStorageTag> {
+            using type = IsoValuedStorageTag;
+        };
+
         template<>
         struct substitute<detail::DirectednessCategoryTag, detail::NullTag> {
             //default values
@@ -91,6 +121,11 @@ namespace GraphBLAS
             using type = SparseTag; // default sparseness
         };
 
+        template<>
+        struct substitute<detail::StorageCategoryTag, detail::NullTag> {
+            using type = LilStorageTag; // default storage
+        };
+
 
         // hidden part in the frontend (detail namespace somewhere) to unroll
         // template parameter pack
@@ -99,30 +134,36 @@ namespace GraphBLAS
             // recursive call: shaves off one of the tags and puts it in the right
             // place (no error checking yet)
             template<typename ScalarT, typename Sparseness, typename Directedness,
-                typename InputTag, typename... Tags>
+                typename Storage, typename InputTag, typename... Tags>
             struct result {
                 using type = typename result<ScalarT,
                       typename detail::substitute<Sparseness, InputTag >::type,
                       typename detail::substitute<Directedness, InputTag >::type,
+                      typename detail::substitute<Storage, InputTag >::type,
                       Tags... >::type;
             };
 
             //null tag shortcut:
-            template<typename ScalarT, typename Sparseness, typename Directedness>
-            struct result<ScalarT, Sparseness, Directedness, detail::NullTag, detail::NullTag>
+            template<typename ScalarT, typename Sparseness, typename Directedness,
+                typename Storage>
+            struct result<ScalarT, Sparseness, Directedness, Storage,
+                          detail::NullTag, detail::NullTag>
             {
                 using type = typename backend::Matrix<ScalarT,
                       typename detail::substitute<Sparseness, detail::NullTag >::type,
-                      typename detail::substitute<Directedness, detail::NullTag >::type >;
+                      typename detail::substitute<Directedness, detail::NullTag >::type,
+                      typename detail::substitute<Storage, detail::NullTag >::type >;
             };
 
             // base case returns the matrix from the backend
-            template<typename ScalarT, typename Sparseness, typename Directedness, typename InputTag>
-            struct result<ScalarT, Sparseness, Directedness, InputTag>
+            template<typename ScalarT, typename Sparseness, typename Directedness,
+                typename Storage, typename InputTag>
+            struct result<ScalarT, Sparseness, Directedness, Storage, InputTag>
             {
                 using type = typename backend::Matrix<ScalarT,
                       typename detail::substitute<Sparseness, InputTag >::type,
-                      typename detail::substitute<Directedness, InputTag >::type > ;
+                      typename detail::substitute<Directedness, InputTag >::type,
+                      typename detail::substitute<Storage, InputTag >::type > ;
             };
         };
 
@@ -0,0 +1,283 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#ifndef GB_DETAIL_PENDING_HPP
+#define GB_DETAIL_PENDING_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <set>
+#include <vector>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace detail
+    {
+        //********************************************************************
+        /**
+         * @brief The operations recorded in nonblocking mode, in program
+         *        order, each with the object it writes and the objects it
+         *        reads.  Objects are identified by the address of their
+         *        backend container.
+         *
+         * Work is only run when something needs it: reading an object runs
+         * the operations its value depends on, modifying or destroying it
+         * runs the ones that still need its old value.  Everything else
+         * stays pending, and an operation whose output is overwritten or
+         * destroyed before anyone reads it is dropped without running.
+         */
+        class PendingQueue
+        {
+        public:
+            typedef void const *ObjectId;
+
+            PendingQueue() : m_deferring(false) {}
+
+            bool deferring() const { return m_deferring; }
+            void set_deferring(bool flag) { m_deferring = flag; }
+
+            std::size_t size() const { return m_nodes.size(); }
+
+            /**
+             * @brief Record an operation.
+             *
+             * @param[in] run         Performs the operation
+             * @param[in] output      The object written
+             * @param[in] inputs      The objects read (null ids are ignored)
+             * @param[in] overwrites  True if the old value of output is not
+             *                        used (no accumulator and either no
+             *                        mask or replace).
+             */
+            void defer(std::function<void()>  run,
+                       ObjectId               output,
+                       std::vector<ObjectId>  inputs,
+                       bool                   overwrites)
+            {
+                if (!overwrites)
+                {
+                    inputs.push_back(output);
+                }
+
+                if (std::find(inputs.begin(), inputs.end(), output) ==
+                    inputs.end())
+                {
+                    drop_dead_writes(output);
+                }
+
+                m_nodes.push_back(Node(run, output, inputs));
+            }
+
+            /// Run everything that the value of the object depends on.
+            void complete(ObjectId id) { run_needed(id, false); }
+
+            /// Run everything that must see the object before it is modified.
+            void release(ObjectId id) { run_needed(id, true); }
+
+            /// The object is going away: drop its unread writes and run the
+            /// operations that still read it.
+            void discard(ObjectId id)
+            {
+                if (m_nodes.empty())
+                {
+                    return;
+                }
+
+                drop_dead_writes(id);
+                run_needed(id, true);
+            }
+
+            /// Run everything that is pending.
+            void wait()
+            {
+                std::vector<Node> nodes;
+                nodes.swap(m_nodes);
+                run_all(nodes);
+            }
+
+        private:
+            struct Node
+            {
+                Node(std::function<void()>        run,
+                     ObjectId                     output,
+                     std::vector<ObjectId> const &inputs)
+                    : m_run(run), m_output(output), m_inputs(inputs)
+                {
+                }
+
+                bool reads(ObjectId id) const
+                {
+                    return (std::find(m_inputs.begin(), m_inputs.end(), id) !=
+                            m_inputs.end());
+                }
+
+                std::function<void()>  m_run;
+                ObjectId               m_output;
+                std::vector<ObjectId>  m_inputs;
+            };
+
+            // Remove the writes of id that are not read by a later node.
+            void drop_dead_writes(ObjectId id)
+            {
+                for (std::size_t ix = m_nodes.size(); ix-- > 0; )
+                {
+                    if (m_nodes[ix].reads(id))
+                    {
+                        break;
+                    }
+                    if (m_nodes[ix].m_output == id)
+                    {
+                        m_nodes.erase(m_nodes.begin() + ix);
+                    }
+                }
+            }
+
+            // Walk backwards collecting the nodes that must run before id is
+            // read (or written): the writers of everything they read and,
+            // for everything they write, the earlier readers and writers.
+            void run_needed(ObjectId id, bool writing)
+            {
+                if (m_nodes.empty())
+                {
+                    return;
+                }
+
+                std::set<ObjectId> read_ids, written_ids;
+                read_ids.insert(id);
+                if (writing)
+                {
+                    written_ids.insert(id);
+                }
+
+                std::vector<bool> needed(m_nodes.size(), false);
+                bool any_needed = false;
+                for (std::size_t ix = m_nodes.size(); ix-- > 0; )
+                {
+                    Node const &node(m_nodes[ix]);
+                    bool need = (read_ids.count(node.m_output) ||
+                                 written_ids.count(node.m_output));
+                    for (auto input : node.m_inputs)
+                    {
+                        need = need || written_ids.count(input);
+                    }
+
+                    if (need)
+                    {
+                        needed[ix] = true;
+                        any_needed = true;
+                        read_ids.insert(node.m_inputs.begin(),
+                                        node.m_inputs.end());
+                        written_ids.insert(node.m_output);
+                    }
+                }
+
+                if (!any_needed)
+                {
+                    return;
+                }
+
+                std::vector<Node> ready, rest;
+                for (std::size_t ix = 0; ix < m_nodes.size(); ++ix)
+                {
+                    (needed[ix] ? ready : rest).push_back(m_nodes[ix]);
+                }
+                m_nodes.swap(rest);
+                run_all(ready);
+            }
+
+            static void run_all(std::vector<Node> const &nodes)
+            {
+                for (auto const &node : nodes)
+                {
+                    node.m_run();
+                }
+            }
+
+            bool               m_deferring;
+            std::vector<Node>  m_nodes;
+        };
+
+        //********************************************************************
+        inline PendingQueue &pending_queue()
+        {
+            static PendingQueue queue;
+            return queue;
+        }
+
+        inline bool deferring()
+        {
+            return pending_queue().deferring();
+        }
+
+        inline void defer(std::function<void()>                     run,
+                          PendingQueue::ObjectId                    output,
+                          std::vector<PendingQueue::ObjectId> const &inputs,
+                          bool                                      overwrites)
+        {
+            pending_queue().defer(run, output, inputs, overwrites);
+        }
+
+        /// Return obj after running the pending work its value depends on.
+        template<typename ObjectT>
+        inline ObjectT const &completed(ObjectT const &obj)
+        {
+            pending_queue().complete(&obj);
+            return obj;
+        }
+
+        /// Return obj after running the pending work that reads or writes it.
+        template<typename ObjectT>
+        inline ObjectT &released(ObjectT &obj)
+        {
+            pending_queue().release(&obj);
+            return obj;
+        }
+
+        /// Called from destructors.  Errors from operations that have not
+        /// been run yet cannot be reported from here, so they are dropped.
+        template<typename ObjectT>
+        inline void discarded(ObjectT const &obj)
+        {
+            try
+            {
+                pending_queue().discard(&obj);
+            }
+            catch (...)
+            {
+            }
+        }
+    } // detail
+} // GraphBLAS
+
+#endif // GB_DETAIL_PENDING_HPP
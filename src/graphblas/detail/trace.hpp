@@ -0,0 +1,399 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Operation tracing.
+ *
+ * When GRAPHBLAS_TRACE is defined to 1 (the TRACE cmake option) every
+ * operation in operations.hpp records an event with its name, the
+ * dimensions and nvals of its output and inputs, its mask, accumulate and
+ * replace flags, the kernel the backend chose (GRB_TRACE_KERNEL) and its
+ * wall time.  write_trace() writes the events in the Chrome trace event
+ * format (open it with chrome://tracing or https://ui.perfetto.dev); if
+ * the GRAPHBLAS_TRACE_FILE environment variable is set the trace is also
+ * written to that file at exit.
+ *
+ * In NONBLOCKING mode an operation is traced when it runs, not when it is
+ * called, and its event has "deferred": true.
+ *
+ * Without GRAPHBLAS_TRACE the GRB_TRACE_ macros expand to nothing and
+ * write_trace() writes an empty trace.
+ */
+
+#ifndef GB_TRACE_HPP
+#define GB_TRACE_HPP
+
+#pragma once
+
+#include <fstream>
+#include <ostream>
+#include <string>
+
+#if GRAPHBLAS_TRACE
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <graphblas/types.hpp>
+#include <graphblas/detail/pending.hpp>
+#endif
+
+//****************************************************************************
+
+#if GRAPHBLAS_TRACE
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        class NoMask;
+        template<typename MatrixT> class TransposeView;
+        template<typename MatrixT> class MatrixComplementView;
+        template<typename VectorT> class VectorComplementView;
+    }
+
+    namespace detail
+    {
+        //********************************************************************
+        struct TraceEvent
+        {
+            char const   *name;
+            std::string   args;       // members of the JSON "args" object
+            double        start_us;
+            double        duration_us;
+            unsigned int  thread;
+        };
+
+        /// The events recorded by all threads.
+        class Tracer
+        {
+        public:
+            static Tracer &instance()
+            {
+                static Tracer tracer;
+                return tracer;
+            }
+
+            ~Tracer()
+            {
+                char const *filename(std::getenv("GRAPHBLAS_TRACE_FILE"));
+                if (filename != nullptr)
+                {
+                    std::ofstream ofs(filename);
+                    write(ofs);
+                }
+            }
+
+            /// Microseconds since the first use of the tracer.
+            double now_us() const
+            {
+                return std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - m_epoch).count();
+            }
+
+            void record(TraceEvent &&event)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_events.push_back(std::move(event));
+            }
+
+            void clear()
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_events.clear();
+            }
+
+            void write(std::ostream &os)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                std::ios::fmtflags flags(os.flags());
+                os << std::fixed;
+                os.precision(3);
+
+                os << "{\"traceEvents\": [";
+                for (std::size_t ix = 0; ix < m_events.size(); ++ix)
+                {
+                    TraceEvent const &event(m_events[ix]);
+                    os << ((ix == 0) ? "\n" : ",\n")
+                       << "  {\"name\": \"" << event.name << "\""
+                       << ", \"cat\": \"GraphBLAS\", \"ph\": \"X\""
+                       << ", \"ts\": " << event.start_us
+                       << ", \"dur\": " << event.duration_us
+                       << ", \"pid\": 0, \"tid\": " << event.thread
+                       << ", \"args\": {" << event.args << "}}";
+                }
+                os << "\n], \"displayTimeUnit\": \"ms\"}" << std::endl;
+                os.flags(flags);
+            }
+
+        private:
+            Tracer() : m_epoch(std::chrono::steady_clock::now()) {}
+
+            std::chrono::steady_clock::time_point m_epoch;
+            std::mutex                            m_mutex;
+            std::vector<TraceEvent>               m_events;
+        };
+
+        /// Small sequential ids for the threads, for the "tid" field.
+        inline unsigned int trace_thread_id()
+        {
+            static std::atomic<unsigned int> next_id(0);
+            static thread_local unsigned int id(next_id++);
+            return id;
+        }
+
+        /// Where GRB_TRACE_KERNEL stores the kernel name: the innermost
+        /// operation being traced on this thread, or nullptr.
+        inline char const **&trace_kernel_slot()
+        {
+            static thread_local char const **slot(nullptr);
+            return slot;
+        }
+
+        inline void trace_kernel(char const *kernel)
+        {
+            if (trace_kernel_slot() != nullptr)
+            {
+                *trace_kernel_slot() = kernel;
+            }
+        }
+
+        //********************************************************************
+        // JSON descriptions of the operands
+        //********************************************************************
+
+        template<typename MatrixT>
+        inline auto trace_operand(std::ostream &os, MatrixT const &A, int)
+            -> decltype(A.nrows(), void())
+        {
+            os << "{\"nrows\": " << A.nrows() << ", \"ncols\": " << A.ncols()
+               << ", \"nvals\": " << A.nvals() << "}";
+        }
+
+        template<typename VectorT>
+        inline auto trace_operand(std::ostream &os, VectorT const &v, long)
+            -> decltype(v.size(), void())
+        {
+            os << "{\"size\": " << v.size()
+               << ", \"nvals\": " << v.nvals() << "}";
+        }
+
+        /// Scalars (the output of reduce to scalar and mxm_reduce)
+        template<typename ScalarT>
+        inline void trace_operand(std::ostream &os, ScalarT const &, ...)
+        {
+            os << "\"scalar\"";
+        }
+
+        template<typename MatrixT>
+        inline void trace_operand(std::ostream                          &os,
+                                  backend::TransposeView<MatrixT> const &A,
+                                  int)
+        {
+            os << "{\"nrows\": " << A.nrows() << ", \"ncols\": " << A.ncols()
+               << ", \"nvals\": " << A.nvals() << ", \"transpose\": true}";
+        }
+
+        inline void trace_inputs(std::ostream &, char const *)
+        {
+        }
+
+        template<typename InputT, typename... InputsT>
+        inline void trace_inputs(std::ostream        &os,
+                                 char const          *separator,
+                                 InputT      const   &input,
+                                 InputsT     const &...inputs)
+        {
+            os << separator;
+            trace_operand(os, input, 0);
+            trace_inputs(os, ", ", inputs...);
+        }
+
+        //********************************************************************
+        // The nvals of a complement are not stored, so masks are described
+        // by the nvals of the structure they look at.
+        //********************************************************************
+
+        inline void trace_mask(std::ostream &os, backend::NoMask const &)
+        {
+            os << "\"mask\": \"none\"";
+        }
+
+        template<typename MatrixT>
+        inline void trace_mask(
+            std::ostream                                 &os,
+            backend::MatrixComplementView<MatrixT> const &mask)
+        {
+            os << "\"mask\": \"complement\", \"mask_nvals\": "
+               << mask.getMatrix().nvals();
+        }
+
+        template<typename VectorT>
+        inline void trace_mask(
+            std::ostream                                 &os,
+            backend::VectorComplementView<VectorT> const &mask)
+        {
+            os << "\"mask\": \"complement\", \"mask_nvals\": "
+               << mask.getVector().nvals();
+        }
+
+        template<typename MaskT>
+        inline void trace_mask(std::ostream &os, MaskT const &mask)
+        {
+            os << "\"mask\": \"mask\", \"mask_nvals\": " << mask.nvals();
+        }
+
+        //********************************************************************
+        /**
+         * @brief Records one operation: the operands are described when it
+         *        is constructed (before the operation runs) and the output,
+         *        kernel and time when it is destroyed.
+         */
+        template<typename OutT>
+        class TraceScope
+        {
+        public:
+            template<typename MaskT, typename AccumT, typename... InputsT>
+            TraceScope(char const        *name,
+                       OutT      const   &out,
+                       MaskT     const   &mask,
+                       AccumT    const   &,
+                       bool               replace_flag,
+                       InputsT   const &...inputs)
+                : m_name(name),
+                  m_out(out),
+                  m_kernel(nullptr),
+                  m_outer_kernel(trace_kernel_slot())
+            {
+                std::ostringstream oss;
+                trace_mask(oss, mask);
+                oss << ", \"accum\": "
+                    << (std::is_same<AccumT, NoAccumulate>::value ?
+                        "false" : "true")
+                    << ", \"replace\": " << (replace_flag ? "true" : "false")
+                    << ", \"deferred\": " << (deferring() ? "true" : "false")
+                    << ", \"inputs\": [";
+                trace_inputs(oss, "", inputs...);
+                oss << "]";
+                m_args = oss.str();
+
+                trace_kernel_slot() = &m_kernel;
+                m_start_us = Tracer::instance().now_us();
+            }
+
+            ~TraceScope()
+            {
+                double end_us(Tracer::instance().now_us());
+                trace_kernel_slot() = m_outer_kernel;
+
+                std::ostringstream oss;
+                oss << m_args << ", \"output\": ";
+                trace_operand(oss, m_out, 0);
+                if (m_kernel != nullptr)
+                {
+                    oss << ", \"kernel\": \"" << m_kernel << "\"";
+                }
+
+                Tracer::instance().record(
+                    TraceEvent{m_name, oss.str(), m_start_us,
+                               end_us - m_start_us, trace_thread_id()});
+            }
+
+        private:
+            TraceScope(TraceScope const &) = delete;
+            TraceScope &operator=(TraceScope const &) = delete;
+
+            char const    *m_name;
+            OutT   const  &m_out;
+            char const    *m_kernel;
+            char const   **m_outer_kernel;
+            std::string    m_args;
+            double         m_start_us;
+        };
+    } // namespace detail
+} // namespace GraphBLAS
+
+/// Trace the rest of the enclosing scope as the operation name:
+/// GRB_TRACE_OP(name, output, mask, accum, replace_flag, inputs...)
+#define GRB_TRACE_OP(name, out, ...)                                    \
+    ::GraphBLAS::detail::TraceScope<                                    \
+        typename std::decay<decltype(out)>::type>                       \
+        grb_trace_scope(name, out, __VA_ARGS__)
+
+/// Called by the backend to name the kernel it chose.
+#define GRB_TRACE_KERNEL(kernel) ::GraphBLAS::detail::trace_kernel(kernel)
+
+#else
+
+#define GRB_TRACE_OP(name, out, ...)
+#define GRB_TRACE_KERNEL(kernel)
+
+#endif
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    /// Write the events traced so far as Chrome trace event JSON.
+    inline void write_trace(std::ostream &os)
+    {
+#if GRAPHBLAS_TRACE
+        detail::Tracer::instance().write(os);
+#else
+        os << "{\"traceEvents\": []}" << std::endl;
+#endif
+    }
+
+    /// @return false if the file could not be opened.
+    inline bool write_trace(std::string const &filename)
+    {
+        std::ofstream ofs(filename);
+        if (!ofs)
+        {
+            return false;
+        }
+        write_trace(ofs);
+        return true;
+    }
+
+    /// Discard the events traced so far.
+    inline void clear_trace()
+    {
+#if GRAPHBLAS_TRACE
+        detail::Tracer::instance().clear();
+#endif
+    }
+} // namespace GraphBLAS
+
+#endif // GB_TRACE_HPP
@@ -0,0 +1,85 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#ifndef GB_EXECUTION_HPP
+#define GB_EXECUTION_HPP
+
+#pragma once
+
+#include <graphblas/detail/pending.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    /**
+     * @brief In BLOCKING mode (the default) every operation has completed
+     *        when it returns.  In NONBLOCKING mode operations are recorded
+     *        and only run when a result is needed: when a Matrix or Vector
+     *        is read (nvals, hasElement, extractElement, extractTuples,
+     *        printInfo, comparison, copy), modified directly (setElement,
+     *        build, clear, assignment), destroyed, or reduced to a scalar,
+     *        or when wait() is called.  Only the operations the result
+     *        depends on are run; one whose output is overwritten or
+     *        destroyed before it is read is never run.
+     *
+     * @note Dimension errors are still thrown by the call itself; errors
+     *       found while computing (e.g. index out of bounds) are thrown by
+     *       the read that runs the operation.
+     */
+    enum ExecutionMode
+    {
+        BLOCKING,
+        NONBLOCKING
+    };
+
+    inline ExecutionMode getExecutionMode()
+    {
+        return (detail::deferring() ? NONBLOCKING : BLOCKING);
+    }
+
+    /// Run all pending operations.
+    inline void wait()
+    {
+        detail::pending_queue().wait();
+    }
+
+    /// Switching back to BLOCKING runs everything that is pending first.
+    inline void setExecutionMode(ExecutionMode mode)
+    {
+        if (mode == BLOCKING)
+        {
+            wait();
+        }
+        detail::pending_queue().set_deferring(mode == NONBLOCKING);
+    }
+} // GraphBLAS
+
+#endif // GB_EXECUTION_HPP
@@ -45,6 +45,7 @@
 #include <graphblas/TransposeView.hpp>
 
 #include <graphblas/operations.hpp>
+#include <graphblas/execution.hpp>
 #include <graphblas/matrix_utils.hpp>
 
 #define GB_INCLUDE_BACKEND_ALL 1
@@ -0,0 +1,474 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Versioned binary file format for GBTL matrices and vectors.
+ *
+ * A file is a fixed size header followed by sections for the row offsets
+ * (matrices only), the indices and the values, in that order.  Each
+ * section starts at a multiple of BINARY_ALIGNMENT bytes from the start of
+ * the file:
+ *
+ *   matrix: header | row_ptr[nrows + 1] | col_idx[nvals] | vals[nvals]
+ *   vector: header | idx[nvals] | vals[nvals]
+ *
+ * Row offsets and indices are 64 bit, and the rows of a matrix are stored
+ * in increasing row and column order (CSR), so the sections of a mapped
+ * file can be used in place by the MappedCsrStorageTag matrix storage.
+ * All data is in the byte order of the machine that wrote it; files with
+ * the other byte order are rejected.
+ */
+
+#ifndef GB_IO_BINARY_FORMAT_HPP
+#define GB_IO_BINARY_FORMAT_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+
+#include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
+#include <graphblas/io/mapped_file.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace io
+    {
+        static char const     BINARY_MAGIC[8] = {'G','B','T','L','B','I','N','\0'};
+        static uint32_t const BINARY_VERSION    = 1;
+        static uint32_t const BINARY_BYTE_ORDER = 0x01020304;
+        static uint64_t const BINARY_ALIGNMENT  = 64;
+
+        static uint32_t const BINARY_MATRIX = 1;
+        static uint32_t const BINARY_VECTOR = 2;
+
+        //********************************************************************
+        /// Codes for the value types in a file (0 for other types, which
+        /// are only checked by size).
+        template <typename ScalarT>
+        struct binary_value_type { static uint32_t const value = 0; };
+
+        template <> struct binary_value_type<bool>     { static uint32_t const value = 1; };
+        template <> struct binary_value_type<int8_t>   { static uint32_t const value = 2; };
+        template <> struct binary_value_type<uint8_t>  { static uint32_t const value = 3; };
+        template <> struct binary_value_type<int16_t>  { static uint32_t const value = 4; };
+        template <> struct binary_value_type<uint16_t> { static uint32_t const value = 5; };
+        template <> struct binary_value_type<int32_t>  { static uint32_t const value = 6; };
+        template <> struct binary_value_type<uint32_t> { static uint32_t const value = 7; };
+        template <> struct binary_value_type<int64_t>  { static uint32_t const value = 8; };
+        template <> struct binary_value_type<uint64_t> { static uint32_t const value = 9; };
+        template <> struct binary_value_type<float>    { static uint32_t const value = 10; };
+        template <> struct binary_value_type<double>   { static uint32_t const value = 11; };
+
+        //********************************************************************
+        struct BinaryHeader
+        {
+            char     magic[8];
+            uint32_t version;
+            uint32_t byte_order;
+            uint32_t kind;           // BINARY_MATRIX or BINARY_VECTOR
+            uint32_t index_size;     // bytes per row offset and index
+            uint32_t value_type;     // binary_value_type<ScalarT>::value
+            uint32_t value_size;     // sizeof(ScalarT)
+            uint64_t nrows;          // size, for a vector
+            uint64_t ncols;          // 1, for a vector
+            uint64_t nvals;
+            uint64_t row_ptr_offset; // 0, for a vector
+            uint64_t index_offset;
+            uint64_t value_offset;
+            uint64_t file_size;
+            uint64_t reserved[5];
+        };
+
+        static_assert(sizeof(BinaryHeader) == 128,
+                      "BinaryHeader must have the same size on all platforms");
+        static_assert(sizeof(IndexType) == sizeof(uint64_t),
+                      "The binary format stores 64 bit indices");
+
+        inline uint64_t binary_align(uint64_t offset)
+        {
+            return (offset + BINARY_ALIGNMENT - 1) / BINARY_ALIGNMENT *
+                BINARY_ALIGNMENT;
+        }
+
+        /// Fill in the header (including the section layout) for a matrix
+        /// or vector of the given type and shape.
+        template <typename ScalarT>
+        BinaryHeader make_binary_header(uint32_t  kind,
+                                        IndexType nrows,
+                                        IndexType ncols,
+                                        IndexType nvals)
+        {
+            BinaryHeader header;
+            std::memset(&header, 0, sizeof(header));
+            std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+            header.version    = BINARY_VERSION;
+            header.byte_order = BINARY_BYTE_ORDER;
+            header.kind       = kind;
+            header.index_size = sizeof(IndexType);
+            header.value_type = binary_value_type<ScalarT>::value;
+            header.value_size = sizeof(ScalarT);
+            header.nrows      = nrows;
+            header.ncols      = ncols;
+            header.nvals      = nvals;
+
+            uint64_t offset(binary_align(sizeof(BinaryHeader)));
+            if (kind == BINARY_MATRIX)
+            {
+                header.row_ptr_offset = offset;
+                offset = binary_align(offset + (nrows + 1)*sizeof(IndexType));
+            }
+            header.index_offset = offset;
+            offset = binary_align(offset + nvals*sizeof(IndexType));
+            header.value_offset = offset;
+            header.file_size = offset + nvals*sizeof(ScalarT);
+            return header;
+        }
+
+        /**
+         * @brief Check that a header read from a file of the given size
+         *        describes a well formed file of the expected kind that
+         *        holds values of type ScalarT.
+         *
+         * @throw InvalidValueException if it does not.
+         */
+        template <typename ScalarT>
+        void check_binary_header(BinaryHeader const &header,
+                                 uint64_t            file_size,
+                                 uint32_t            kind,
+                                 std::string const  &filename)
+        {
+            std::string where("binary file " + filename + ": ");
+            if (std::memcmp(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)))
+            {
+                throw InvalidValueException(where + "not a GBTL binary file");
+            }
+            if (header.version != BINARY_VERSION)
+            {
+                throw InvalidValueException(where + "unsupported version");
+            }
+            if (header.byte_order != BINARY_BYTE_ORDER)
+            {
+                throw InvalidValueException(where + "wrong byte order");
+            }
+            if (header.kind != kind)
+            {
+                throw InvalidValueException(
+                    where + ((kind == BINARY_MATRIX) ? "not a matrix"
+                                                     : "not a vector"));
+            }
+            if ((header.index_size != sizeof(IndexType)) ||
+                (header.value_size != sizeof(ScalarT)) ||
+                (header.value_type != binary_value_type<ScalarT>::value))
+            {
+                throw InvalidValueException(where + "wrong value type");
+            }
+
+            // Every section has to fit in the file, which also keeps the
+            // layout computed below from overflowing.
+            if ((header.nvals > file_size/sizeof(IndexType)) ||
+                (header.nvals > file_size/sizeof(ScalarT)) ||
+                ((kind == BINARY_MATRIX) &&
+                 (header.nrows >= file_size/sizeof(IndexType))))
+            {
+                throw InvalidValueException(where + "corrupt or truncated");
+            }
+
+            // The layout is fully determined by the shape; anything else
+            // is a truncated or corrupt file.
+            BinaryHeader expected(make_binary_header<ScalarT>(
+                kind, header.nrows, header.ncols, header.nvals));
+            if ((header.row_ptr_offset != expected.row_ptr_offset) ||
+                (header.index_offset != expected.index_offset) ||
+                (header.value_offset != expected.value_offset) ||
+                (header.file_size != expected.file_size) ||
+                (file_size < header.file_size))
+            {
+                throw InvalidValueException(where + "corrupt or truncated");
+            }
+        }
+
+        /// The header of a mapped binary file (which is at least as large
+        /// as a header).
+        inline BinaryHeader const &mapped_binary_header(
+            MappedFile const &file, std::string const &filename)
+        {
+            if (file.size() < sizeof(BinaryHeader))
+            {
+                throw InvalidValueException(
+                    "binary file " + filename + ": too small");
+            }
+            return *file.section<BinaryHeader>(0);
+        }
+
+        //********************************************************************
+        namespace detail
+        {
+            inline void write_padding(std::ostream &os, uint64_t offset)
+            {
+                static char const zeros[BINARY_ALIGNMENT] = {0};
+                uint64_t pos(os.tellp());
+                if (offset > pos)
+                {
+                    os.write(zeros, offset - pos);
+                }
+            }
+
+            template <typename T>
+            void write_array(std::ostream &os, std::vector<T> const &data)
+            {
+                if (!data.empty())
+                {
+                    os.write(reinterpret_cast<char const *>(data.data()),
+                             data.size()*sizeof(T));
+                }
+            }
+
+            // std::vector<bool> has no contiguous storage
+            inline void write_array(std::ostream &os, std::vector<bool> const &data)
+            {
+                for (bool val : data)
+                {
+                    os.put(val ? 1 : 0);
+                }
+            }
+
+            template <typename ScalarT>
+            void write_binary(std::string            const &filename,
+                              BinaryHeader           const &header,
+                              std::vector<IndexType> const &row_ptr,
+                              std::vector<IndexType> const &indices,
+                              std::vector<ScalarT>   const &values)
+            {
+                std::ofstream os(filename, std::ios::out | std::ios::binary |
+                                           std::ios::trunc);
+                if (!os)
+                {
+                    throw PanicException("write_binary: cannot open " + filename);
+                }
+
+                os.write(reinterpret_cast<char const *>(&header), sizeof(header));
+                if (header.kind == BINARY_MATRIX)
+                {
+                    write_padding(os, header.row_ptr_offset);
+                    write_array(os, row_ptr);
+                }
+                write_padding(os, header.index_offset);
+                write_array(os, indices);
+                write_padding(os, header.value_offset);
+                write_array(os, values);
+
+                if (!os)
+                {
+                    throw PanicException("write_binary: error writing " + filename);
+                }
+            }
+        } // namespace detail
+
+        //********************************************************************
+        /**
+         * @brief Write a matrix (any storage) to a file in the binary
+         *        format.
+         */
+        template <typename MatrixT>
+        void write_binary_matrix(std::string const &filename,
+                                 MatrixT     const &A)
+        {
+            typedef typename MatrixT::ScalarType ScalarType;
+
+            IndexType nvals(A.nvals());
+            IndexArrayType i(nvals), j(nvals);
+            std::vector<ScalarType> v(nvals);
+            A.extractTuples(i, j, v);
+
+            // Counting sort by row, then sort each row by column
+            std::vector<IndexType> row_ptr(A.nrows() + 1, 0);
+            for (IndexType row : i)
+            {
+                ++row_ptr[row + 1];
+            }
+            for (IndexType row = 0; row < A.nrows(); ++row)
+            {
+                row_ptr[row + 1] += row_ptr[row];
+            }
+
+            std::vector<IndexType> order(nvals);
+            std::vector<IndexType> next(row_ptr.begin(), row_ptr.end() - 1);
+            for (IndexType ix = 0; ix < nvals; ++ix)
+            {
+                order[next[i[ix]]++] = ix;
+            }
+            for (IndexType row = 0; row < A.nrows(); ++row)
+            {
+                std::sort(order.begin() + row_ptr[row],
+                          order.begin() + row_ptr[row + 1],
+                          [&](IndexType a, IndexType b) { return j[a] < j[b]; });
+            }
+
+            IndexArrayType col_idx(nvals);
+            std::vector<ScalarType> vals(nvals);
+            for (IndexType ix = 0; ix < nvals; ++ix)
+            {
+                col_idx[ix] = j[order[ix]];
+                vals[ix] = v[order[ix]];
+            }
+
+            detail::write_binary(
+                filename,
+                make_binary_header<ScalarType>(
+                    BINARY_MATRIX, A.nrows(), A.ncols(), nvals),
+                row_ptr, col_idx, vals);
+        }
+
+        /**
+         * @brief Write a vector to a file in the binary format.
+         */
+        template <typename VectorT>
+        void write_binary_vector(std::string const &filename,
+                                 VectorT     const &u)
+        {
+            typedef typename VectorT::ScalarType ScalarType;
+
+            IndexType nvals(u.nvals());
+            IndexArrayType indices(nvals);
+            std::vector<ScalarType> values(nvals);
+            u.extractTuples(indices, values);
+
+            detail::write_binary(
+                filename,
+                make_binary_header<ScalarType>(BINARY_VECTOR, u.size(), 1, nvals),
+                IndexArrayType(), indices, values);
+        }
+
+        //********************************************************************
+        /**
+         * @brief Read the header of a binary file (to find the shape of
+         *        the matrix or vector it holds).
+         */
+        inline BinaryHeader read_binary_header(std::string const &filename)
+        {
+            BinaryHeader header;
+            std::ifstream is(filename, std::ios::in | std::ios::binary);
+            if (!is.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+                std::memcmp(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)))
+            {
+                throw InvalidValueException(
+                    "read_binary_header: " + filename +
+                    " is not a GBTL binary file");
+            }
+            return header;
+        }
+
+        /**
+         * @brief Replace the contents of A (any storage) with a copy of the
+         *        matrix in a binary file.  To use the file in place, construct
+         *        a Matrix<ScalarT, MappedCsrStorageTag> from the file name
+         *        instead.
+         *
+         * @throw DimensionException if the shape of A does not match the file.
+         */
+        template <typename MatrixT>
+        void read_binary_matrix(std::string const &filename,
+                                MatrixT           &A)
+        {
+            typedef typename MatrixT::ScalarType ScalarType;
+
+            MappedFile file(filename);
+            BinaryHeader const &header(mapped_binary_header(file, filename));
+            check_binary_header<ScalarType>(header, file.size(),
+                                            BINARY_MATRIX, filename);
+            if ((header.nrows != A.nrows()) || (header.ncols != A.ncols()))
+            {
+                throw DimensionException("read_binary_matrix: " + filename);
+            }
+
+            IndexType const *row_ptr(file.section<IndexType>(header.row_ptr_offset));
+            if ((row_ptr[0] != 0) || (row_ptr[header.nrows] != header.nvals))
+            {
+                throw InvalidValueException(
+                    "read_binary_matrix: " + filename + " is corrupt");
+            }
+
+            IndexArrayType rows(header.nvals);
+            for (IndexType row = 0; row < header.nrows; ++row)
+            {
+                if (row_ptr[row] > row_ptr[row + 1])
+                {
+                    throw InvalidValueException(
+                        "read_binary_matrix: " + filename + " is corrupt");
+                }
+                std::fill(rows.begin() + row_ptr[row],
+                          rows.begin() + row_ptr[row + 1], row);
+            }
+
+            A.clear();
+            A.build(rows.begin(),
+                    file.section<IndexType>(header.index_offset),
+                    file.section<ScalarType>(header.value_offset),
+                    header.nvals);
+        }
+
+        /**
+         * @brief Replace the contents of u with a copy of the vector in a
+         *        binary file.
+         *
+         * @throw DimensionException if the size of u does not match the file.
+         */
+        template <typename VectorT>
+        void read_binary_vector(std::string const &filename,
+                                VectorT           &u)
+        {
+            typedef typename VectorT::ScalarType ScalarType;
+
+            MappedFile file(filename);
+            BinaryHeader const &header(mapped_binary_header(file, filename));
+            check_binary_header<ScalarType>(header, file.size(),
+                                            BINARY_VECTOR, filename);
+            if (header.nrows != u.size())
+            {
+                throw DimensionException("read_binary_vector: " + filename);
+            }
+
+            u.clear();
+            u.build(file.section<IndexType>(header.index_offset),
+                    file.section<ScalarType>(header.value_offset),
+                    header.nvals);
+        }
+
+    } // namespace io
+} // namespace GraphBLAS
+
+#endif // GB_IO_BINARY_FORMAT_HPP
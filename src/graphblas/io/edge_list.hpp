@@ -0,0 +1,169 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+/**
+ * Reader for edge list files: one "src dst [weight]" edge per line with
+ * 0-based vertex ids separated by tabs or spaces (the .tsv files used by
+ * the demos).  Lines starting with '#' or '%' are comments.
+ *
+ * The file is mapped, the lines are parsed in chunks on separate (OpenMP)
+ * threads, and the results are concatenated in file order.
+ */
+
+#ifndef GB_IO_EDGE_LIST_HPP
+#define GB_IO_EDGE_LIST_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
+#include <graphblas/io/mapped_file.hpp>
+#include <graphblas/io/text_helpers.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace io
+    {
+        /**
+         * @brief Read the edges of an edge list file into tuple arrays
+         *        (suitable for Matrix::build).  Edges without a weight get
+         *        the weight 1.
+         *
+         * @return The number of vertices (one more than the largest id).
+         * @throw InvalidValueException if a line cannot be parsed or has
+         *        more than three fields.
+         */
+        template <typename ValueT>
+        IndexType read_edge_list(std::string const   &filename,
+                                 IndexArrayType      &rows,
+                                 IndexArrayType      &cols,
+                                 std::vector<ValueT> &vals)
+        {
+            MappedFile file(filename);
+            char const *begin(file.data());
+            char const *end(begin + file.size());
+
+            std::vector<char const *> bounds(
+                detail::split_lines(begin, end, detail::num_parse_chunks()));
+            IndexType num_parts(bounds.size() - 1);
+            std::vector<IndexArrayType>      row_parts(num_parts);
+            std::vector<IndexArrayType>      col_parts(num_parts);
+            std::vector<std::vector<double> > val_parts(num_parts);
+            std::vector<IndexType>           max_ids(num_parts, 0);
+            std::vector<char>                errors(num_parts, 0);
+
+#ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic, 1)
+#endif
+            for (IndexType part = 0; part < num_parts; ++part)
+            {
+                char const *p(bounds[part]);
+                char const *last(bounds[part + 1]);
+                while (p != last)
+                {
+                    if ((*p == '#') || (*p == '%') ||
+                        detail::at_line_end(p, last))
+                    {
+                        detail::skip_line(p, last);
+                        continue;
+                    }
+
+                    IndexType src, dst;
+                    double    weight(1);
+                    if (!detail::parse_index(p, last, src) ||
+                        !detail::parse_index(p, last, dst) ||
+                        (!detail::at_line_end(p, last) &&
+                         !detail::parse_real(p, last, weight)) ||
+                        !detail::at_line_end(p, last))
+                    {
+                        errors[part] = 1;
+                        break;
+                    }
+                    detail::skip_line(p, last);
+
+                    row_parts[part].push_back(src);
+                    col_parts[part].push_back(dst);
+                    val_parts[part].push_back(weight);
+                    max_ids[part] = std::max(max_ids[part],
+                                             std::max(src, dst) + 1);
+                }
+            }
+
+            if (std::find(errors.begin(), errors.end(), 1) != errors.end())
+            {
+                throw InvalidValueException(
+                    "read_edge_list: " + filename + ": bad line");
+            }
+
+            detail::concat_parts(row_parts, rows);
+            detail::concat_parts(col_parts, cols);
+
+            std::vector<double> weights;
+            detail::concat_parts(val_parts, weights);
+            vals.resize(weights.size());
+            for (IndexType ix = 0; ix < weights.size(); ++ix)
+            {
+                vals[ix] = static_cast<ValueT>(weights[ix]);
+            }
+
+            return *std::max_element(max_ids.begin(), max_ids.end());
+        }
+
+        /**
+         * @brief Replace the contents of A with the edges of an edge list
+         *        file.  Edges listed more than once are combined with Second
+         *        (the last one listed wins).
+         *
+         * @return The number of vertices (one more than the largest id).
+         * @throw IndexOutOfBoundsException if a vertex id does not fit in A.
+         */
+        template <typename MatrixT>
+        IndexType read_edge_list(std::string const &filename, MatrixT &A)
+        {
+            IndexArrayType rows, cols;
+            std::vector<typename MatrixT::ScalarType> vals;
+            IndexType num_vertices(read_edge_list(filename, rows, cols, vals));
+
+            A.clear();
+            A.build(rows, cols, vals);
+            return num_vertices;
+        }
+
+    } // namespace io
+} // namespace GraphBLAS
+
+#endif // GB_IO_EDGE_LIST_HPP
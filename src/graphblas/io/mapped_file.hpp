@@ -0,0 +1,124 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#ifndef GB_IO_MAPPED_FILE_HPP
+#define GB_IO_MAPPED_FILE_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <graphblas/exceptions.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace io
+    {
+        /**
+         * @brief A read only memory mapping of a whole file.  Pages are read
+         *        in by the OS on first access, so mapping a large file costs
+         *        the same as mapping a small one.
+         *
+         * @throw PanicException if the file cannot be opened or mapped.
+         */
+        class MappedFile
+        {
+        public:
+            MappedFile(std::string const &filename)
+                : m_data(nullptr),
+                  m_size(0)
+            {
+                int fd(::open(filename.c_str(), O_RDONLY));
+                if (fd < 0)
+                {
+                    throw PanicException("MappedFile: cannot open " + filename);
+                }
+
+                struct stat info;
+                if (::fstat(fd, &info) != 0)
+                {
+                    ::close(fd);
+                    throw PanicException("MappedFile: cannot stat " + filename);
+                }
+                m_size = info.st_size;
+
+                // An empty file cannot be mapped (and has nothing to read)
+                if (m_size > 0)
+                {
+                    void *addr(::mmap(nullptr, m_size, PROT_READ, MAP_SHARED,
+                                      fd, 0));
+                    if (addr == MAP_FAILED)
+                    {
+                        ::close(fd);
+                        throw PanicException("MappedFile: cannot map " + filename);
+                    }
+                    m_data = static_cast<char const *>(addr);
+                }
+                ::close(fd);
+            }
+
+            ~MappedFile()
+            {
+                if (m_data)
+                {
+                    ::munmap(const_cast<char *>(m_data), m_size);
+                }
+            }
+
+            char const *data() const { return m_data; }
+            uint64_t    size() const { return m_size; }
+
+            /// Section of the file starting at offset bytes, as an array
+            template <typename T>
+            T const *section(uint64_t offset) const
+            {
+                return reinterpret_cast<T const *>(m_data + offset);
+            }
+
+        private:
+            MappedFile(MappedFile const &);
+            MappedFile &operator=(MappedFile const &);
+
+            char const *m_data;
+            uint64_t    m_size;
+        };
+
+    } // namespace io
+} // namespace GraphBLAS
+
+#endif // GB_IO_MAPPED_FILE_HPP
@@ -0,0 +1,425 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+/**
+ * Reader for Matrix Market (.mtx) files: coordinate and array formats,
+ * pattern, integer and real fields, and general, symmetric, skew-symmetric
+ * and (real valued) hermitian matrices.  Symmetric matrices are expanded to
+ * both triangles.  Complex fields are not supported.
+ *
+ * The file is mapped, the entries are parsed in chunks of lines on separate
+ * (OpenMP) threads, and the matrix is filled with one bulk build().
+ */
+
+#ifndef GB_IO_MATRIX_MARKET_HPP
+#define GB_IO_MATRIX_MARKET_HPP
+
+#pragma once
+
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
+#include <graphblas/io/mapped_file.hpp>
+#include <graphblas/io/text_helpers.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace io
+    {
+        /// The banner and size line of a Matrix Market file
+        struct MatrixMarketHeader
+        {
+            IndexType   nrows;
+            IndexType   ncols;
+            IndexType   nentries;    // entries listed in the file
+            bool        coordinate;  // false for the array format
+            std::string field;       // pattern, integer or real
+            std::string symmetry;    // general, symmetric, skew-symmetric
+                                     // or hermitian
+        };
+
+        namespace detail
+        {
+            inline std::string mm_word(char const *&p, char const *end)
+            {
+                skip_blanks(p, end);
+                std::string word;
+                while ((p != end) && !is_blank(*p) && (*p != '\n'))
+                {
+                    word.push_back((char)std::tolower(*p));
+                    ++p;
+                }
+                return word;
+            }
+
+            /// Parse the banner, comments and size line.  p is left at the
+            /// first entry.
+            inline MatrixMarketHeader parse_mm_header(char const       *&p,
+                                                      char const        *end,
+                                                      std::string const &filename)
+            {
+                std::string where("read_matrix_market: " + filename + ": ");
+                MatrixMarketHeader header;
+
+                if ((mm_word(p, end) != "%%matrixmarket") ||
+                    (mm_word(p, end) != "matrix"))
+                {
+                    throw InvalidValueException(where + "not a Matrix Market matrix");
+                }
+                std::string format(mm_word(p, end));
+                header.field    = mm_word(p, end);
+                header.symmetry = mm_word(p, end);
+                skip_line(p, end);
+
+                if ((format != "coordinate") && (format != "array"))
+                {
+                    throw InvalidValueException(where + "unknown format " + format);
+                }
+                header.coordinate = (format == "coordinate");
+
+                if ((header.field != "pattern") && (header.field != "integer") &&
+                    (header.field != "real") && (header.field != "double"))
+                {
+                    throw InvalidValueException(
+                        where + "unsupported field " + header.field);
+                }
+                if ((header.field == "pattern") && !header.coordinate)
+                {
+                    throw InvalidValueException(where + "pattern array");
+                }
+                if ((header.symmetry != "general") &&
+                    (header.symmetry != "symmetric") &&
+                    (header.symmetry != "skew-symmetric") &&
+                    (header.symmetry != "hermitian"))
+                {
+                    throw InvalidValueException(
+                        where + "unsupported symmetry " + header.symmetry);
+                }
+
+                // Comments and blank lines
+                while ((p != end) && ((*p == '%') || at_line_end(p, end)))
+                {
+                    skip_line(p, end);
+                }
+
+                bool ok(parse_index(p, end, header.nrows) &&
+                        parse_index(p, end, header.ncols));
+                if (header.coordinate)
+                {
+                    ok = ok && parse_index(p, end, header.nentries);
+                }
+                else
+                {
+                    header.nentries = header.nrows*header.ncols;
+                    if (header.symmetry == "skew-symmetric")
+                    {
+                        header.nentries = header.nrows*(header.nrows - 1)/2;
+                    }
+                    else if (header.symmetry != "general")
+                    {
+                        header.nentries = header.nrows*(header.nrows + 1)/2;
+                    }
+                }
+                if (!ok || !at_line_end(p, end))
+                {
+                    throw InvalidValueException(where + "bad size line");
+                }
+                if ((header.symmetry != "general") &&
+                    (header.nrows != header.ncols))
+                {
+                    throw InvalidValueException(where + "symmetric but not square");
+                }
+                skip_line(p, end);
+                return header;
+            }
+
+            /// Entries parsed from one chunk of a file
+            template <typename ValueT>
+            struct EntryPart
+            {
+                IndexArrayType      rows;
+                IndexArrayType      cols;
+                std::vector<ValueT> vals;
+                IndexType           num_listed = 0;
+                bool                error = false;
+            };
+
+            /// Parse the coordinate entries in [begin, end), converting to
+            /// 0-based indices and adding the mirror image of off-diagonal
+            /// entries of symmetric matrices.
+            template <typename ValueT>
+            void parse_mm_coordinate(char const                 *begin,
+                                     char const                 *end,
+                                     MatrixMarketHeader const   &header,
+                                     EntryPart<ValueT>          &part)
+            {
+                bool pattern(header.field == "pattern");
+                bool symmetric(header.symmetry != "general");
+                bool skew(header.symmetry == "skew-symmetric");
+
+                char const *p(begin);
+                while (p != end)
+                {
+                    if ((*p == '%') || at_line_end(p, end))
+                    {
+                        skip_line(p, end);
+                        continue;
+                    }
+
+                    IndexType row, col;
+                    ValueT    val(1);
+                    if (!parse_index(p, end, row) || !parse_index(p, end, col) ||
+                        (!pattern && !parse_value(p, end, val)) ||
+                        !at_line_end(p, end) ||
+                        (row == 0) || (row > header.nrows) ||
+                        (col == 0) || (col > header.ncols) ||
+                        (skew && (row == col) && (val != ValueT(0))))
+                    {
+                        part.error = true;
+                        return;
+                    }
+                    skip_line(p, end);
+                    ++part.num_listed;
+
+                    // The diagonal of a skew-symmetric matrix is implicitly 0
+                    if (skew && (row == col))
+                    {
+                        continue;
+                    }
+
+                    part.rows.push_back(row - 1);
+                    part.cols.push_back(col - 1);
+                    part.vals.push_back(val);
+                    if (symmetric && (row != col))
+                    {
+                        part.rows.push_back(col - 1);
+                        part.cols.push_back(row - 1);
+                        part.vals.push_back(skew ? ValueT(-val) : val);
+                    }
+                }
+            }
+
+            /// Parse the values listed in [begin, end) (array format).
+            template <typename ValueT>
+            void parse_mm_array(char const          *begin,
+                                char const          *end,
+                                EntryPart<ValueT>   &part)
+            {
+                char const *p(begin);
+                while (p != end)
+                {
+                    if ((*p == '%') || at_line_end(p, end))
+                    {
+                        skip_line(p, end);
+                        continue;
+                    }
+
+                    ValueT val;
+                    if (!parse_value(p, end, val) || !at_line_end(p, end))
+                    {
+                        part.error = true;
+                        return;
+                    }
+                    skip_line(p, end);
+                    part.vals.push_back(val);
+                }
+            }
+
+            template <typename MatrixT, typename ValueT>
+            void read_mm_entries(MappedFile         const &file,
+                                 char const               *first,
+                                 MatrixMarketHeader const &header,
+                                 std::string        const &filename,
+                                 MatrixT                  &A)
+            {
+                char const *end(file.data() + file.size());
+                std::vector<char const *> bounds(
+                    split_lines(first, end, num_parse_chunks()));
+                IndexType num_parts(bounds.size() - 1);
+                std::vector<EntryPart<ValueT> > parts(num_parts);
+
+#ifdef _OPENMP
+                #pragma omp parallel for schedule(dynamic, 1)
+#endif
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    if (header.coordinate)
+                    {
+                        parse_mm_coordinate(bounds[part], bounds[part + 1],
+                                            header, parts[part]);
+                    }
+                    else
+                    {
+                        parse_mm_array(bounds[part], bounds[part + 1],
+                                       parts[part]);
+                    }
+                }
+
+                std::string where("read_matrix_market: " + filename + ": ");
+                for (auto&& part : parts)
+                {
+                    if (part.error)
+                    {
+                        throw InvalidValueException(where + "bad entry");
+                    }
+                }
+
+                IndexArrayType      rows, cols;
+                std::vector<ValueT> vals;
+                std::vector<std::vector<ValueT> > val_parts(num_parts);
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    val_parts[part].swap(parts[part].vals);
+                }
+                concat_parts(val_parts, vals);
+
+                if (header.coordinate)
+                {
+                    std::vector<IndexArrayType> row_parts(num_parts);
+                    std::vector<IndexArrayType> col_parts(num_parts);
+                    IndexType num_listed(0);
+                    for (IndexType part = 0; part < num_parts; ++part)
+                    {
+                        row_parts[part].swap(parts[part].rows);
+                        col_parts[part].swap(parts[part].cols);
+                        num_listed += parts[part].num_listed;
+                    }
+                    if (num_listed != header.nentries)
+                    {
+                        throw InvalidValueException(where + "wrong number of entries");
+                    }
+                    concat_parts(row_parts, rows);
+                    concat_parts(col_parts, cols);
+                }
+                else
+                {
+                    // Values are listed in column major order (only the
+                    // lower triangle of symmetric matrices)
+                    if (vals.size() != header.nentries)
+                    {
+                        throw InvalidValueException(where + "wrong number of entries");
+                    }
+
+                    std::vector<ValueT> listed;
+                    listed.swap(vals);
+                    IndexType ix(0);
+                    for (IndexType col = 0; col < header.ncols; ++col)
+                    {
+                        IndexType first_row(0);
+                        if (header.symmetry == "skew-symmetric")
+                        {
+                            first_row = col + 1;
+                        }
+                        else if (header.symmetry != "general")
+                        {
+                            first_row = col;
+                        }
+
+                        for (IndexType row = first_row; row < header.nrows; ++row)
+                        {
+                            rows.push_back(row);
+                            cols.push_back(col);
+                            vals.push_back(listed[ix]);
+                            if ((header.symmetry != "general") && (row != col))
+                            {
+                                rows.push_back(col);
+                                cols.push_back(row);
+                                vals.push_back(
+                                    (header.symmetry == "skew-symmetric") ?
+                                    ValueT(-listed[ix]) : listed[ix]);
+                            }
+                            ++ix;
+                        }
+                    }
+                }
+
+                A.clear();
+                A.build(rows.begin(), cols.begin(), vals.begin(), vals.size());
+            }
+        } // namespace detail
+
+        //********************************************************************
+        /**
+         * @brief Read the banner and size line of a Matrix Market file (to
+         *        find the shape of the matrix it holds).
+         */
+        inline MatrixMarketHeader read_matrix_market_header(
+            std::string const &filename)
+        {
+            MappedFile file(filename);
+            char const *p(file.data());
+            return detail::parse_mm_header(p, p + file.size(), filename);
+        }
+
+        /**
+         * @brief Replace the contents of A with the matrix in a Matrix
+         *        Market file.  Pattern matrices get the value 1.  Values
+         *        listed more than once are combined with Second (the last
+         *        one listed wins).
+         *
+         * @throw DimensionException if the shape of A does not match the file.
+         * @throw InvalidValueException if the file is malformed.
+         */
+        template <typename MatrixT>
+        void read_matrix_market(std::string const &filename, MatrixT &A)
+        {
+            MappedFile file(filename);
+            char const *p(file.data());
+            MatrixMarketHeader header(
+                detail::parse_mm_header(p, p + file.size(), filename));
+
+            if ((header.nrows != A.nrows()) || (header.ncols != A.ncols()))
+            {
+                throw DimensionException("read_matrix_market: " + filename);
+            }
+
+            if (header.field == "integer" || header.field == "pattern")
+            {
+                detail::read_mm_entries<MatrixT, int64_t>(
+                    file, p, header, filename, A);
+            }
+            else
+            {
+                detail::read_mm_entries<MatrixT, double>(
+                    file, p, header, filename, A);
+            }
+        }
+
+    } // namespace io
+} // namespace GraphBLAS
+
+#endif // GB_IO_MATRIX_MARKET_HPP
@@ -0,0 +1,310 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+/**
+ * Helpers shared by the text readers: splitting a mapped file into chunks
+ * of whole lines that are parsed on separate (OpenMP) threads, and
+ * hand-rolled number parsers that work directly on the mapped bytes.
+ */
+
+#ifndef GB_IO_TEXT_HELPERS_HPP
+#define GB_IO_TEXT_HELPERS_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
+#include <graphblas/detail/concat_parts.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace io
+    {
+        namespace detail
+        {
+            //****************************************************************
+            /// Number of chunks to split a file into (a few per thread so
+            /// that uneven lines still balance).
+            inline int num_parse_chunks()
+            {
+#ifdef _OPENMP
+                return 4*omp_get_max_threads();
+#else
+                return 1;
+#endif
+            }
+
+            /// Split [begin, end) into num_chunks ranges that each start at
+            /// the beginning of a line.  Returns the num_chunks + 1 range
+            /// boundaries.
+            inline std::vector<char const *> split_lines(char const *begin,
+                                                         char const *end,
+                                                         int         num_chunks)
+            {
+                std::vector<char const *> bounds(1, begin);
+                IndexType chunk_size((end - begin) / num_chunks + 1);
+                for (int chunk = 1; chunk < num_chunks; ++chunk)
+                {
+                    char const *p(std::max(bounds.back(),
+                                           std::min(end, begin + chunk*chunk_size)));
+                    while ((p != end) && (p != begin) && (p[-1] != '\n'))
+                    {
+                        ++p;
+                    }
+                    bounds.push_back(p);
+                }
+                bounds.push_back(end);
+                return bounds;
+            }
+
+            //****************************************************************
+            inline bool is_blank(char c)
+            {
+                return (c == ' ') || (c == '\t') || (c == '\r');
+            }
+
+            inline void skip_blanks(char const *&p, char const *end)
+            {
+                while ((p != end) && is_blank(*p))
+                {
+                    ++p;
+                }
+            }
+
+            /// Advance p past the end of the current line.
+            inline void skip_line(char const *&p, char const *end)
+            {
+                while ((p != end) && (*p != '\n'))
+                {
+                    ++p;
+                }
+                if (p != end)
+                {
+                    ++p;
+                }
+            }
+
+            /// True if the rest of the line is blank.
+            inline bool at_line_end(char const *p, char const *end)
+            {
+                skip_blanks(p, end);
+                return (p == end) || (*p == '\n');
+            }
+
+            //****************************************************************
+            /// Parse an unsigned decimal integer.  Returns false (leaving p
+            /// alone) if there is none.
+            inline bool parse_index(char const *&p, char const *end,
+                                    IndexType &val)
+            {
+                char const *q(p);
+                skip_blanks(q, end);
+                if ((q == end) || (*q < '0') || (*q > '9'))
+                {
+                    return false;
+                }
+
+                IndexType result(0);
+                while ((q != end) && (*q >= '0') && (*q <= '9'))
+                {
+                    result = 10*result + (*q - '0');
+                    ++q;
+                }
+                val = result;
+                p = q;
+                return true;
+            }
+
+            /// Parse an optionally signed decimal integer.
+            inline bool parse_integer(char const *&p, char const *end,
+                                      int64_t &val)
+            {
+                char const *q(p);
+                skip_blanks(q, end);
+                bool negative((q != end) && (*q == '-'));
+                if ((q != end) && ((*q == '-') || (*q == '+')))
+                {
+                    ++q;
+                }
+
+                IndexType magnitude;
+                if (!parse_index(q, end, magnitude))
+                {
+                    return false;
+                }
+                val = negative ? -(int64_t)magnitude : (int64_t)magnitude;
+                p = q;
+                return true;
+            }
+
+            /// Parse a floating point number.  Numbers with at most 15
+            /// significant digits and small exponents are converted exactly
+            /// with one multiply or divide; anything else (long mantissas,
+            /// large exponents, inf and nan) falls back to strtod.
+            inline bool parse_real(char const *&p, char const *end, double &val)
+            {
+                static double const powers[] = {
+                    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+                char const *q(p);
+                skip_blanks(q, end);
+                char const *start(q);
+
+                bool negative((q != end) && (*q == '-'));
+                if ((q != end) && ((*q == '-') || (*q == '+')))
+                {
+                    ++q;
+                }
+
+                uint64_t mantissa(0);
+                int      digits(0);
+                int      exponent(0);
+                bool     any_digits(false);
+                for (; (q != end) && (*q >= '0') && (*q <= '9'); ++q)
+                {
+                    any_digits = true;
+                    if ((mantissa != 0) || (*q != '0'))
+                    {
+                        if (digits < 19)
+                        {
+                            mantissa = 10*mantissa + (*q - '0');
+                        }
+                        else
+                        {
+                            ++exponent;
+                        }
+                        ++digits;
+                    }
+                }
+                if ((q != end) && (*q == '.'))
+                {
+                    for (++q; (q != end) && (*q >= '0') && (*q <= '9'); ++q)
+                    {
+                        any_digits = true;
+                        if ((mantissa != 0) || (*q != '0'))
+                        {
+                            if (digits < 19)
+                            {
+                                mantissa = 10*mantissa + (*q - '0');
+                                --exponent;
+                            }
+                            ++digits;
+                        }
+                        else
+                        {
+                            --exponent;
+                        }
+                    }
+                }
+
+                bool fast(any_digits && (digits <= 15));
+                if (any_digits && (q != end) && ((*q == 'e') || (*q == 'E')))
+                {
+                    char const *r(q + 1);
+                    int64_t exp_val;
+                    if ((r != end) && !is_blank(*r) &&
+                        parse_integer(r, end, exp_val))
+                    {
+                        if ((exp_val > 1000) || (exp_val < -1000))
+                        {
+                            fast = false;
+                        }
+                        else
+                        {
+                            exponent += (int)exp_val;
+                        }
+                        q = r;
+                    }
+                }
+
+                if (fast && (exponent >= -22) && (exponent <= 22))
+                {
+                    double result((double)mantissa);
+                    result = (exponent < 0) ? result / powers[-exponent]
+                                            : result * powers[exponent];
+                    val = negative ? -result : result;
+                    p = q;
+                    return true;
+                }
+
+                // Slow path: copy the token so strtod cannot run off the
+                // end of the mapped data.
+                char const *token_end(start);
+                while ((token_end != end) && !is_blank(*token_end) &&
+                       (*token_end != '\n'))
+                {
+                    ++token_end;
+                }
+                std::string token(start, token_end);
+                char *parse_end;
+                double result(std::strtod(token.c_str(), &parse_end));
+                if (parse_end == token.c_str())
+                {
+                    return false;
+                }
+                val = result;
+                p = start + (parse_end - token.c_str());
+                return true;
+            }
+
+            //****************************************************************
+            /// Parse a value of the given (arithmetic) type.
+            inline bool parse_value(char const *&p, char const *end, double &val)
+            {
+                return parse_real(p, end, val);
+            }
+
+            inline bool parse_value(char const *&p, char const *end, int64_t &val)
+            {
+                return parse_integer(p, end, val);
+            }
+
+            //****************************************************************
+            using GraphBLAS::detail::concat_parts;
+
+        } // namespace detail
+    } // namespace io
+} // namespace GraphBLAS
+
+#endif // GB_IO_TEXT_HELPERS_HPP
@@ -30,10 +30,15 @@
 #ifndef GB_MATRIX_UTILS_HPP
 #define GB_MATRIX_UTILS_HPP
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <functional>
+#include <random>
 #include <vector>
 
 #include <graphblas/graphblas.hpp>
+#include <graphblas/detail/concat_parts.hpp>
 
 #define GB_INCLUDE_BACKEND_UTILITY 1
 #include <backend_include.hpp>
@@ -209,6 +214,402 @@ namespace GraphBLAS
                        GraphBLAS::ArithmeticSemiring<T>(),
                        A, Adiag);
     }
+
+    //************************************************************************
+    // Random graph generators
+    //
+    // The generators fill tuple arrays (suitable for Matrix::build) with the
+    // edges of a graph; every edge gets the value 1.  The *_graph versions
+    // build the adjacency matrix directly, keeping one copy of repeated
+    // edges.
+    //
+    // The edges are generated in blocks of GB_GENERATOR_BLOCK edges (or
+    // rows, for erdos_renyi_edges) that are spread over the OpenMP threads.
+    // Each block has its own random number generator, seeded from the seed
+    // and the block number, so the same seed gives the same graph whatever
+    // the number of threads.
+    //************************************************************************
+
+#ifndef GB_GENERATOR_BLOCK
+#define GB_GENERATOR_BLOCK 65536
+#endif
+
+    namespace detail
+    {
+        /// The random number generator of one block of a generator.
+        inline std::mt19937_64 block_generator(unsigned long seed,
+                                               IndexType     block)
+        {
+            std::seed_seq seq{static_cast<unsigned long>(seed >> 32),
+                              static_cast<unsigned long>(seed & 0xffffffff),
+                              static_cast<unsigned long>(block >> 32),
+                              static_cast<unsigned long>(block & 0xffffffff)};
+            return std::mt19937_64(seq);
+        }
+
+        /// Relabel the vertices with a random permutation (so that the
+        /// high degree vertices are not the low numbered ones).
+        inline void scramble_vertices(IndexType       num_vertices,
+                                      IndexArrayType &rows,
+                                      IndexArrayType &cols,
+                                      unsigned long   seed)
+        {
+            IndexArrayType perm(num_vertices);
+            for (IndexType ix = 0; ix < num_vertices; ++ix)
+            {
+                perm[ix] = ix;
+            }
+            std::mt19937_64 gen(block_generator(seed, ~IndexType(0)));
+            std::shuffle(perm.begin(), perm.end(), gen);
+
+            IndexType num_edges(rows.size());
+#ifdef _OPENMP
+            #pragma omp parallel for schedule(static)
+#endif
+            for (IndexType ix = 0; ix < num_edges; ++ix)
+            {
+                rows[ix] = perm[rows[ix]];
+                cols[ix] = perm[cols[ix]];
+            }
+        }
+
+        /// Sample num_edges edges whose endpoints are drawn by sample(gen);
+        /// block b writes edges [b*GB_GENERATOR_BLOCK, ...).
+        template<typename SampleT>
+        void sample_edges(IndexType       num_edges,
+                          IndexArrayType &rows,
+                          IndexArrayType &cols,
+                          unsigned long   seed,
+                          SampleT         sample)
+        {
+            rows.resize(num_edges);
+            cols.resize(num_edges);
+
+            IndexType num_blocks((num_edges + GB_GENERATOR_BLOCK - 1)/
+                                 GB_GENERATOR_BLOCK);
+#ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic, 1)
+#endif
+            for (IndexType block = 0; block < num_blocks; ++block)
+            {
+                std::mt19937_64 gen(block_generator(seed, block));
+                IndexType last(std::min(num_edges,
+                                        (block + 1)*GB_GENERATOR_BLOCK));
+                for (IndexType ix = block*GB_GENERATOR_BLOCK; ix < last; ++ix)
+                {
+                    sample(gen, rows[ix], cols[ix]);
+                }
+            }
+        }
+
+        template<typename MatrixT>
+        MatrixT build_graph(IndexType                                      n,
+                            IndexArrayType                          const &rows,
+                            IndexArrayType                          const &cols,
+                            std::vector<typename MatrixT::ScalarType> const &vals)
+        {
+            MatrixT A(n, n);
+            A.build(rows.begin(), cols.begin(), vals.begin(), vals.size());
+            return A;
+        }
+    } // namespace detail
+
+    //************************************************************************
+    /**
+     * @brief Generate an R-MAT (recursive matrix) graph with the Graph500
+     *        Kronecker parameters by default: 2^scale vertices and
+     *        edge_factor*2^scale directed edges.  Each edge picks one of
+     *        the four quadrants of the adjacency matrix with probabilities
+     *        a, b, c and 1-a-b-c, scale times over.
+     *
+     * Repeated edges and self loops are kept.  With scramble (as in
+     * Graph500) the vertex ids are randomly permuted afterwards.
+     *
+     * @return The number of vertices.
+     * @throw InvalidValueException if a, b, c are not probabilities or
+     *        the number of edges does not fit in an IndexArrayType.
+     */
+    template<typename ValueT>
+    IndexType rmat_edges(unsigned int         scale,
+                         IndexType            edge_factor,
+                         IndexArrayType      &rows,
+                         IndexArrayType      &cols,
+                         std::vector<ValueT> &vals,
+                         unsigned long        seed,
+                         double               a = 0.57,
+                         double               b = 0.19,
+                         double               c = 0.19,
+                         bool                 scramble = true)
+    {
+        if ((a < 0.0) || (b < 0.0) || (c < 0.0) || (a + b + c > 1.0) ||
+            (scale >= 64))
+        {
+            throw InvalidValueException("rmat_edges: bad parameters");
+        }
+
+        IndexType num_vertices(IndexType(1) << scale);
+        if (edge_factor > rows.max_size()/num_vertices)
+        {
+            throw InvalidValueException("rmat_edges: too many edges");
+        }
+
+        // Each level uses 16 bits of a 64-bit random number, compared with
+        // the cumulative quadrant probabilities scaled to 2^16.
+        std::uint64_t const one(1 << 16);
+        std::uint64_t t_a(a*one), t_ab((a + b)*one), t_abc((a + b + c)*one);
+
+        detail::sample_edges(
+            edge_factor*num_vertices, rows, cols, seed,
+            [scale, t_a, t_ab, t_abc](std::mt19937_64 &gen,
+                                      IndexType &row, IndexType &col)
+            {
+                row = 0;
+                col = 0;
+                std::uint64_t bits(0);
+                for (unsigned int level = 0; level < scale; ++level)
+                {
+                    if (level % 4 == 0)
+                    {
+                        bits = gen();
+                    }
+                    std::uint64_t r(bits & 0xffff);
+                    bits >>= 16;
+
+                    row = (row << 1) | ((r >= t_ab) ? 1 : 0);
+                    col = (col << 1) | ((((r >= t_a) && (r < t_ab)) ||
+                                         (r >= t_abc)) ? 1 : 0);
+                }
+            });
+
+        if (scramble)
+        {
+            detail::scramble_vertices(num_vertices, rows, cols, seed);
+        }
+
+        vals.assign(rows.size(), static_cast<ValueT>(1));
+        return num_vertices;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Generate an Erdos-Renyi G(n, p) graph: each of the n(n-1)
+     *        directed edges (i, j), i != j, is present with probability p.
+     *        Rows are generated by skipping a geometrically distributed
+     *        number of columns between edges, so the cost is proportional
+     *        to the number of edges rather than n^2.
+     *
+     * @return The number of vertices.
+     * @throw InvalidValueException if p is not in [0, 1].
+     */
+    template<typename ValueT>
+    IndexType erdos_renyi_edges(IndexType            n,
+                                double               p,
+                                IndexArrayType      &rows,
+                                IndexArrayType      &cols,
+                                std::vector<ValueT> &vals,
+                                unsigned long        seed)
+    {
+        if ((p < 0.0) || (p > 1.0))
+        {
+            throw InvalidValueException("erdos_renyi_edges: bad p");
+        }
+
+        // Rows per block, so that a block has about GB_GENERATOR_BLOCK
+        // edges.
+        IndexType block_rows(std::max<IndexType>(
+            1, std::min<IndexType>(n, GB_GENERATOR_BLOCK/
+                                   std::max(1.0, p*n))));
+        IndexType num_blocks((n + block_rows - 1)/block_rows);
+        std::vector<IndexArrayType> row_parts(num_blocks);
+        std::vector<IndexArrayType> col_parts(num_blocks);
+        double log_q(std::log1p(-p));
+
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (IndexType block = 0; block < num_blocks; ++block)
+        {
+            if (p == 0.0) continue;
+
+            std::mt19937_64 gen(detail::block_generator(seed, block));
+            std::uniform_real_distribution<double> uniform(0.0, 1.0);
+            IndexType last(std::min(n, (block + 1)*block_rows));
+            for (IndexType i = block*block_rows; i < last; ++i)
+            {
+                // Column candidates are [0, n-1) with j >= i shifted by one
+                // to skip the diagonal.
+                double col(-1.0);
+                while (true)
+                {
+                    col += 1.0 + ((p == 1.0) ? 0.0 :
+                                  std::floor(std::log1p(-uniform(gen))/log_q));
+                    if (col >= double(n - 1)) break;
+
+                    IndexType j(static_cast<IndexType>(col));
+                    row_parts[block].push_back(i);
+                    col_parts[block].push_back((j < i) ? j : j + 1);
+                }
+            }
+        }
+
+        detail::concat_parts(row_parts, rows);
+        detail::concat_parts(col_parts, cols);
+        vals.assign(rows.size(), static_cast<ValueT>(1));
+        return n;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Generate the nrows x ncols 2D grid graph: vertex (r, c) has id
+     *        r*ncols + c and an edge to and from each of its (up to four)
+     *        horizontal and vertical neighbours.
+     *
+     * @return The number of vertices.
+     */
+    template<typename ValueT>
+    IndexType grid_2d_edges(IndexType            nrows,
+                            IndexType            ncols,
+                            IndexArrayType      &rows,
+                            IndexArrayType      &cols,
+                            std::vector<ValueT> &vals)
+    {
+        // Edges contributed by each grid row (the last has no down edges).
+        IndexType per_row(2*(ncols - 1) + 2*ncols);
+        IndexType num_edges((nrows == 0) || (ncols == 0) ? 0 :
+                            nrows*per_row - 2*ncols);
+        rows.resize(num_edges);
+        cols.resize(num_edges);
+
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static)
+#endif
+        for (IndexType r = 0; r < nrows; ++r)
+        {
+            IndexType ix(r*per_row);
+            for (IndexType c = 0; c < ncols; ++c)
+            {
+                IndexType v(r*ncols + c);
+                if (c + 1 < ncols)
+                {
+                    rows[ix] = v;     cols[ix++] = v + 1;
+                    rows[ix] = v + 1; cols[ix++] = v;
+                }
+                if (r + 1 < nrows)
+                {
+                    rows[ix] = v;         cols[ix++] = v + ncols;
+                    rows[ix] = v + ncols; cols[ix++] = v;
+                }
+            }
+        }
+
+        vals.assign(num_edges, static_cast<ValueT>(1));
+        return nrows*ncols;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Generate a Chung-Lu graph with a power-law degree
+     *        distribution: num_edges directed edges whose endpoints are
+     *        both drawn with probability proportional to the weight
+     *        (i + 1)^(-1/(exponent - 1)) of vertex i, which gives degrees
+     *        distributed as d^-exponent.  The vertex ids are then randomly
+     *        permuted.
+     *
+     * @return The number of vertices.
+     * @throw InvalidValueException if exponent <= 1 or n is zero.
+     */
+    template<typename ValueT>
+    IndexType power_law_edges(IndexType            n,
+                              IndexType            num_edges,
+                              double               exponent,
+                              IndexArrayType      &rows,
+                              IndexArrayType      &cols,
+                              std::vector<ValueT> &vals,
+                              unsigned long        seed)
+    {
+        if ((exponent <= 1.0) || (n == 0))
+        {
+            throw InvalidValueException("power_law_edges: bad parameters");
+        }
+
+        // Cumulative weights, for sampling by binary search.
+        std::vector<double> cumulative(n);
+        double sum(0.0);
+        for (IndexType i = 0; i < n; ++i)
+        {
+            sum += std::pow(double(i + 1), -1.0/(exponent - 1.0));
+            cumulative[i] = sum;
+        }
+
+        detail::sample_edges(
+            num_edges, rows, cols, seed,
+            [&cumulative, sum, n](std::mt19937_64 &gen,
+                                  IndexType &row, IndexType &col)
+            {
+                std::uniform_real_distribution<double> uniform(0.0, sum);
+                row = std::min<IndexType>(
+                    n - 1, std::upper_bound(cumulative.begin(),
+                                            cumulative.end(),
+                                            uniform(gen)) -
+                    cumulative.begin());
+                col = std::min<IndexType>(
+                    n - 1, std::upper_bound(cumulative.begin(),
+                                            cumulative.end(),
+                                            uniform(gen)) -
+                    cumulative.begin());
+            });
+
+        detail::scramble_vertices(n, rows, cols, seed);
+        vals.assign(rows.size(), static_cast<ValueT>(1));
+        return n;
+    }
+
+    //************************************************************************
+    /// Build the adjacency matrix of rmat_edges(scale, edge_factor, seed).
+    template<typename MatrixT>
+    MatrixT rmat_graph(unsigned int  scale,
+                       IndexType     edge_factor,
+                       unsigned long seed)
+    {
+        IndexArrayType rows, cols;
+        std::vector<typename MatrixT::ScalarType> vals;
+        IndexType n(rmat_edges(scale, edge_factor, rows, cols, vals, seed));
+        return detail::build_graph<MatrixT>(n, rows, cols, vals);
+    }
+
+    /// Build the adjacency matrix of erdos_renyi_edges(n, p, seed).
+    template<typename MatrixT>
+    MatrixT erdos_renyi_graph(IndexType n, double p, unsigned long seed)
+    {
+        IndexArrayType rows, cols;
+        std::vector<typename MatrixT::ScalarType> vals;
+        erdos_renyi_edges(n, p, rows, cols, vals, seed);
+        return detail::build_graph<MatrixT>(n, rows, cols, vals);
+    }
+
+    /// Build the adjacency matrix of grid_2d_edges(nrows, ncols).
+    template<typename MatrixT>
+    MatrixT grid_2d_graph(IndexType nrows, IndexType ncols)
+    {
+        IndexArrayType rows, cols;
+        std::vector<typename MatrixT::ScalarType> vals;
+        IndexType n(grid_2d_edges(nrows, ncols, rows, cols, vals));
+        return detail::build_graph<MatrixT>(n, rows, cols, vals);
+    }
+
+    /// Build the adjacency matrix of power_law_edges(n, num_edges,
+    /// exponent, seed).
+    template<typename MatrixT>
+    MatrixT power_law_graph(IndexType     n,
+                            IndexType     num_edges,
+                            double        exponent,
+                            unsigned long seed)
+    {
+        IndexArrayType rows, cols;
+        std::vector<typename MatrixT::ScalarType> vals;
+        power_law_edges(n, num_edges, exponent, rows, cols, vals, seed);
+        return detail::build_graph<MatrixT>(n, rows, cols, vals);
+    }
 }
 
 #endif // GB_MATRIX_UTILS_HPP
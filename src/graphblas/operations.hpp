@@ -44,8 +44,10 @@
 #include <graphblas/indices.hpp>
 
 #include <graphblas/detail/logging.h>
+#include <graphblas/detail/trace.hpp>
 #include <graphblas/detail/config.hpp>
 #include <graphblas/detail/checks.hpp>
+#include <graphblas/detail/pending.hpp>
 
 #define GB_INCLUDE_BACKEND_TRANSPOSE_VIEW 1
 #define GB_INCLUDE_BACKEND_COMPLEMENT_VIEW 1
@@ -58,6 +60,108 @@
 
 namespace GraphBLAS
 {
+    namespace detail
+    {
+        //********************************************************************
+        // Arguments of operations recorded in nonblocking mode (see
+        // execution.hpp).  Matrices and vectors are held by reference: the
+        // pending queue runs (or drops) the operation before they can be
+        // modified or destroyed.  Views and masks are often temporaries, so
+        // they are copied; their id is that of the container they look at.
+        //********************************************************************
+        template<typename ObjectT>
+        class DeferredRef
+        {
+        public:
+            DeferredRef(ObjectT &obj) : m_obj(&obj) {}
+
+            ObjectT &get() const { return *m_obj; }
+            PendingQueue::ObjectId id() const { return m_obj; }
+
+        private:
+            ObjectT *m_obj;
+        };
+
+        template<typename ViewT>
+        class DeferredView
+        {
+        public:
+            DeferredView(ViewT const &view, PendingQueue::ObjectId id)
+                : m_view(view), m_id(id)
+            {
+            }
+
+            ViewT const &get() const { return m_view; }
+            PendingQueue::ObjectId id() const { return m_id; }
+
+        private:
+            ViewT                   m_view;
+            PendingQueue::ObjectId  m_id;
+        };
+
+        template<typename ObjectT>
+        inline DeferredRef<ObjectT> deferred_arg(ObjectT &obj)
+        {
+            return DeferredRef<ObjectT>(obj);
+        }
+
+        template<typename MatrixT>
+        inline DeferredView<backend::TransposeView<MatrixT> > deferred_arg(
+            backend::TransposeView<MatrixT> const &view)
+        {
+            return DeferredView<backend::TransposeView<MatrixT> >(
+                view, &view.getMatrix());
+        }
+
+        template<typename MatrixT>
+        inline DeferredView<backend::MatrixComplementView<MatrixT> >
+        deferred_arg(backend::MatrixComplementView<MatrixT> const &view)
+        {
+            return DeferredView<backend::MatrixComplementView<MatrixT> >(
+                view, &view.getMatrix());
+        }
+
+        template<typename VectorT>
+        inline DeferredView<backend::VectorComplementView<VectorT> >
+        deferred_arg(backend::VectorComplementView<VectorT> const &view)
+        {
+            return DeferredView<backend::VectorComplementView<VectorT> >(
+                view, &view.getVector());
+        }
+
+        inline DeferredView<backend::NoMask> deferred_arg(
+            backend::NoMask const &mask)
+        {
+            return DeferredView<backend::NoMask>(mask, nullptr);
+        }
+
+        //********************************************************************
+        // True if the operation does not read the old value of its output.
+        inline bool overwrites(NoAccumulate, backend::NoMask const &, bool)
+        {
+            return true;
+        }
+
+        template<typename MaskT>
+        inline bool overwrites(NoAccumulate, MaskT const &, bool replace_flag)
+        {
+            return replace_flag;
+        }
+
+        template<typename AccumT, typename MaskT>
+        inline bool overwrites(AccumT, MaskT const &, bool)
+        {
+            return false;
+        }
+
+        /// For operations that read their inputs right away.
+        template<typename ObjectT>
+        inline void complete_arg(ObjectT const &obj)
+        {
+            pending_queue().complete(deferred_arg(obj).id());
+        }
+    } // detail
+
     //************************************************************************
     // mxm, vxm, mxv
     //************************************************************************
@@ -92,6 +196,26 @@ namespace GraphBLAS
         check_ncols_ncols(C, B, "mxm: C.ncols != B.ncols");
         check_ncols_nrows(A, B, "mxm: A.ncols != B.nrows");
 
+        if (detail::deferring())
+        {
+            auto C_arg(detail::deferred_arg(C.m_mat));
+            auto Mask_arg(detail::deferred_arg(Mask.m_mat));
+            auto A_arg(detail::deferred_arg(A.m_mat));
+            auto B_arg(detail::deferred_arg(B.m_mat));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("mxm", C_arg.get(), Mask_arg.get(), accum,
+                                 replace_flag, A_arg.get(), B_arg.get());
+                    backend::mxm(C_arg.get(), Mask_arg.get(), accum, op,
+                                 A_arg.get(), B_arg.get(), replace_flag);
+                },
+                C_arg.id(), {Mask_arg.id(), A_arg.id(), B_arg.id()},
+                detail::overwrites(accum, Mask.m_mat, replace_flag));
+            return;
+        }
+
+        GRB_TRACE_OP("mxm", C.m_mat, Mask.m_mat, accum, replace_flag, A.m_mat,
+                     B.m_mat);
         backend::mxm(C.m_mat, Mask.m_mat, accum, op, A.m_mat, B.m_mat,
                      replace_flag);
 
@@ -129,6 +253,26 @@ namespace GraphBLAS
         check_size_ncols(w, A, "vxm: w.size != A.ncols");
         check_size_nrows(u, A, "vxm: u.size != A.nrows");
 
+        if (detail::deferring())
+        {
+            auto w_arg(detail::deferred_arg(w.m_vec));
+            auto mask_arg(detail::deferred_arg(mask.m_vec));
+            auto u_arg(detail::deferred_arg(u.m_vec));
+            auto A_arg(detail::deferred_arg(A.m_mat));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("vxm", w_arg.get(), mask_arg.get(), accum,
+                                 replace_flag, u_arg.get(), A_arg.get());
+                    backend::vxm(w_arg.get(), mask_arg.get(), accum, op,
+                                 u_arg.get(), A_arg.get(), replace_flag);
+                },
+                w_arg.id(), {mask_arg.id(), u_arg.id(), A_arg.id()},
+                detail::overwrites(accum, mask.m_vec, replace_flag));
+            return;
+        }
+
+        GRB_TRACE_OP("vxm", w.m_vec, mask.m_vec, accum, replace_flag, u.m_vec,
+                     A.m_mat);
         backend::vxm(w.m_vec, mask.m_vec, accum, op, u.m_vec, A.m_mat,
                      replace_flag);
 
@@ -166,6 +310,26 @@ namespace GraphBLAS
         check_size_nrows(w, A, "mxv: w.size != A.nrows");
         check_size_ncols(u, A, "mxv: u.size != A.ncols");
 
+        if (detail::deferring())
+        {
+            auto w_arg(detail::deferred_arg(w.m_vec));
+            auto mask_arg(detail::deferred_arg(mask.m_vec));
+            auto A_arg(detail::deferred_arg(A.m_mat));
+            auto u_arg(detail::deferred_arg(u.m_vec));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("mxv", w_arg.get(), mask_arg.get(), accum,
+                                 replace_flag, A_arg.get(), u_arg.get());
+                    backend::mxv(w_arg.get(), mask_arg.get(), accum, op,
+                                 A_arg.get(), u_arg.get(), replace_flag);
+                },
+                w_arg.id(), {mask_arg.id(), A_arg.id(), u_arg.id()},
+                detail::overwrites(accum, mask.m_vec, replace_flag));
+            return;
+        }
+
+        GRB_TRACE_OP("mxv", w.m_vec, mask.m_vec, accum, replace_flag, A.m_mat,
+                     u.m_vec);
         backend::mxv(w.m_vec, mask.m_vec, accum, op, A.m_mat, u.m_vec,
                      replace_flag);
         GRB_LOG_VERBOSE("w out :" << w.m_vec);
@@ -210,6 +374,27 @@ namespace GraphBLAS
         check_size_size(w, u, "eWiseMult(vec): w.size != u.size");
         check_size_size(u, v, "eWiseMult(vec): u.size != v.size");
 
+        if (detail::deferring())
+        {
+            auto w_arg(detail::deferred_arg(w.m_vec));
+            auto mask_arg(detail::deferred_arg(mask.m_vec));
+            auto u_arg(detail::deferred_arg(u.m_vec));
+            auto v_arg(detail::deferred_arg(v.m_vec));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("eWiseMult", w_arg.get(), mask_arg.get(),
+                                 accum, replace_flag, u_arg.get(),
+                                 v_arg.get());
+                    backend::eWiseMult(w_arg.get(), mask_arg.get(), accum, op,
+                                       u_arg.get(), v_arg.get(), replace_flag);
+                },
+                w_arg.id(), {mask_arg.id(), u_arg.id(), v_arg.id()},
+                detail::overwrites(accum, mask.m_vec, replace_flag));
+            return;
+        }
+
+        GRB_TRACE_OP("eWiseMult", w.m_vec, mask.m_vec, accum, replace_flag,
+                     u.m_vec, v.m_vec);
         backend::eWiseMult(w.m_vec, mask.m_vec, accum, op, u.m_vec, v.m_vec,
                            replace_flag);
 
@@ -249,6 +434,27 @@ namespace GraphBLAS
         check_ncols_ncols(A, B, "eWiseMult(mat): A.ncols != B.ncols");
         check_nrows_nrows(A, B, "eWiseMult(mat): A.nrows != B.nrows");
 
+        if (detail::deferring())
+        {
+            auto C_arg(detail::deferred_arg(C.m_mat));
+            auto Mask_arg(detail::deferred_arg(Mask.m_mat));
+            auto A_arg(detail::deferred_arg(A.m_mat));
+            auto B_arg(detail::deferred_arg(B.m_mat));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("eWiseMult", C_arg.get(), Mask_arg.get(),
+                                 accum, replace_flag, A_arg.get(),
+                                 B_arg.get());
+                    backend::eWiseMult(C_arg.get(), Mask_arg.get(), accum, op,
+                                       A_arg.get(), B_arg.get(), replace_flag);
+                },
+                C_arg.id(), {Mask_arg.id(), A_arg.id(), B_arg.id()},
+                detail::overwrites(accum, Mask.m_mat, replace_flag));
+            return;
+        }
+
+        GRB_TRACE_OP("eWiseMult", C.m_mat, Mask.m_mat, accum, replace_flag,
+                     A.m_mat, B.m_mat);
         backend::eWiseMult(C.m_mat, Mask.m_mat, accum, op, A.m_mat, B.m_mat,
                            replace_flag);
 
@@ -291,6 +497,27 @@ namespace GraphBLAS
         check_size_size(w, u, "eWiseAdd(vec): w.size != u.size");
         check_size_size(u, v, "eWiseAdd(vec): u.size != v.size");
 
+        if (detail::deferring())
+        {
+            auto w_arg(detail::deferred_arg(w.m_vec));
+            auto mask_arg(detail::deferred_arg(mask.m_vec));
+            auto u_arg(detail::deferred_arg(u.m_vec));
+            auto v_arg(detail::deferred_arg(v.m_vec));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("eWiseAdd", w_arg.get(), mask_arg.get(),
+                                 accum, replace_flag, u_arg.get(),
+                                 v_arg.get());
+                    backend::eWiseAdd(w_arg.get(), mask_arg.get(), accum, op,
+                                      u_arg.get(), v_arg.get(), replace_flag);
+                },
+                w_arg.id(), {mask_arg.id(), u_arg.id(), v_arg.id()},
+                detail::overwrites(accum, mask.m_vec, replace_flag));
+            return;
+        }
+
+        GRB_TRACE_OP("eWiseAdd", w.m_vec, mask.m_vec, accum, replace_flag,
+                     u.m_vec, v.m_vec);
         backend::eWiseAdd(w.m_vec, mask.m_vec, accum, op, u.m_vec, v.m_vec,
                           replace_flag);
 
@@ -330,6 +557,27 @@ namespace GraphBLAS
         check_ncols_ncols(A, B, "eWiseAdd(mat): A.ncols != B.ncols");
         check_nrows_nrows(A, B, "eWiseAdd(mat): A.nrows != B.nrows");
 
+        if (detail::deferring())
+        {
+            auto C_arg(detail::deferred_arg(C.m_mat));
+            auto Mask_arg(detail::deferred_arg(Mask.m_mat));
+            auto A_arg(detail::deferred_arg(A.m_mat));
+            auto B_arg(detail::deferred_arg(B.m_mat));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("eWiseAdd", C_arg.get(), Mask_arg.get(),
+                                 accum, replace_flag, A_arg.get(),
+                                 B_arg.get());
+                    backend::eWiseAdd(C_arg.get(), Mask_arg.get(), accum, op,
+                                      A_arg.get(), B_arg.get(), replace_flag);
+                },
+                C_arg.id(), {Mask_arg.id(), A_arg.id(), B_arg.id()},
+                detail::overwrites(accum, Mask.m_mat, replace_flag));
+            return;
+        }
+
+        GRB_TRACE_OP("eWiseAdd", C.m_mat, Mask.m_mat, accum, replace_flag,
+                     A.m_mat, B.m_mat);
         backend::eWiseAdd(C.m_mat, Mask.m_mat, accum, op, A.m_mat, B.m_mat,
                           replace_flag);
 
@@ -367,6 +615,25 @@ namespace GraphBLAS
         check_size_nindices(w, indices,
                             "extract(std vec): w.size != indicies.size");
 
+        if (detail::deferring())
+        {
+            auto w_arg(detail::deferred_arg(w.m_vec));
+            auto mask_arg(detail::deferred_arg(mask.m_vec));
+            auto u_arg(detail::deferred_arg(u.m_vec));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("extract", w_arg.get(), mask_arg.get(),
+                                 accum, replace_flag, u_arg.get());
+                    backend::extract(w_arg.get(), mask_arg.get(), accum,
+                                     u_arg.get(), indices, replace_flag);
+                },
+                w_arg.id(), {mask_arg.id(), u_arg.id()},
+                detail::overwrites(accum, mask.m_vec, replace_flag));
+            return;
+        }
+
+        GRB_TRACE_OP("extract", w.m_vec, mask.m_vec, accum, replace_flag,
+                     u.m_vec);
         backend::extract(w.m_vec, mask.m_vec, accum, u.m_vec,
                          indices, replace_flag);
 
@@ -406,6 +673,26 @@ namespace GraphBLAS
         check_ncols_nindices(C, col_indices,
                              "extract(std mat): C.ncols != col_indices");
 
+        if (detail::deferring())
+        {
+            auto C_arg(detail::deferred_arg(C.m_mat));
+            auto Mask_arg(detail::deferred_arg(Mask.m_mat));
+            auto A_arg(detail::deferred_arg(A.m_mat));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("extract", C_arg.get(), Mask_arg.get(),
+                                 accum, replace_flag, A_arg.get());
+                    backend::extract(C_arg.get(), Mask_arg.get(), accum,
+                                     A_arg.get(), row_indices, col_indices,
+                                     replace_flag);
+                },
+                C_arg.id(), {Mask_arg.id(), A_arg.id()},
+                detail::overwrites(accum, Mask.m_mat, replace_flag));
+            return;
+        }
+
+        GRB_TRACE_OP("extract", C.m_mat, Mask.m_mat, accum, replace_flag,
+                     A.m_mat);
         backend::extract(C.m_mat, Mask.m_mat, accum, A.m_mat,
                          row_indices, col_indices, replace_flag);
 
@@ -444,6 +731,26 @@ namespace GraphBLAS
         check_index_within_ncols(col_index, A,
                                  "extract(col): col_index >= A.ncols");
 
+        if (detail::deferring())
+        {
+            auto w_arg(detail::deferred_arg(w.m_vec));
+            auto mask_arg(detail::deferred_arg(mask.m_vec));
+            auto A_arg(detail::deferred_arg(A.m_mat));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("extract", w_arg.get(), mask_arg.get(),
+                                 accum, replace_flag, A_arg.get());
+                    backend::extract(w_arg.get(), mask_arg.get(), accum,
+                                     A_arg.get(), row_indices, col_index,
+                                     replace_flag);
+                },
+                w_arg.id(), {mask_arg.id(), A_arg.id()},
+                detail::overwrites(accum, mask.m_vec, replace_flag));
+            return;
+        }
+
+        GRB_TRACE_OP("extract", w.m_vec, mask.m_vec, accum, replace_flag,
+                     A.m_mat);
         backend::extract(w.m_vec, mask.m_vec, accum, A.m_mat, row_indices,
                          col_index, replace_flag);
         GRB_LOG_FN_END("extract - 4.3.6.3 - column (and row) variant");
@@ -483,6 +790,25 @@ namespace GraphBLAS
         check_size_nindices(u, indices,
                             "assign(std vec): u.size != |indicies|");
 
+        if (detail::deferring())
+        {
+            auto w_arg(detail::deferred_arg(w.m_vec));
+            auto mask_arg(detail::deferred_arg(mask.m_vec));
+            auto u_arg(detail::deferred_arg(u.m_vec));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("assign", w_arg.get(), mask_arg.get(), accum,
+                                 replace_flag, u_arg.get());
+                    backend::assign(w_arg.get(), mask_arg.get(), accum,
+                                    u_arg.get(), indices, replace_flag);
+                },
+                w_arg.id(), {mask_arg.id(), u_arg.id()},
+                false);
+            return;
+        }
+
+        GRB_TRACE_OP("assign", w.m_vec, mask.m_vec, accum, replace_flag,
+                     u.m_vec);
         backend::assign(w.m_vec, mask.m_vec, accum, u.m_vec, indices,
                         replace_flag);
 
@@ -526,6 +852,26 @@ namespace GraphBLAS
         check_ncols_nindices(A, col_indices,
                              "assign(std mat): A.ncols != |col_indices|");
 
+        if (detail::deferring())
+        {
+            auto C_arg(detail::deferred_arg(C.m_mat));
+            auto Mask_arg(detail::deferred_arg(Mask.m_mat));
+            auto A_arg(detail::deferred_arg(A.m_mat));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("assign", C_arg.get(), Mask_arg.get(), accum,
+                                 replace_flag, A_arg.get());
+                    backend::assign(C_arg.get(), Mask_arg.get(), accum,
+                                    A_arg.get(), row_indices, col_indices,
+                                    replace_flag);
+                },
+                C_arg.id(), {Mask_arg.id(), A_arg.id()},
+                false);
+            return;
+        }
+
+        GRB_TRACE_OP("assign", C.m_mat, Mask.m_mat, accum, replace_flag,
+                     A.m_mat);
         backend::assign(C.m_mat, Mask.m_mat, accum, A.m_mat,
                         row_indices, col_indices, replace_flag);
 
@@ -564,6 +910,26 @@ namespace GraphBLAS
         check_index_within_ncols(col_index, C,
                                  "assign(col): col_index >= C.ncols");
 
+        if (detail::deferring())
+        {
+            auto C_arg(detail::deferred_arg(C.m_mat));
+            auto mask_arg(detail::deferred_arg(mask.m_vec));
+            auto u_arg(detail::deferred_arg(u.m_vec));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("assign", C_arg.get(), mask_arg.get(), accum,
+                                 replace_flag, u_arg.get());
+                    backend::assign(C_arg.get(), mask_arg.get(), accum,
+                                    u_arg.get(), row_indices, col_index,
+                                    replace_flag);
+                },
+                C_arg.id(), {mask_arg.id(), u_arg.id()},
+                false);
+            return;
+        }
+
+        GRB_TRACE_OP("assign", C.m_mat, mask.m_vec, accum, replace_flag,
+                     u.m_vec);
         backend::assign(C.m_mat, mask.m_vec, accum, u.m_vec,
                         row_indices, col_index, replace_flag);
 
@@ -601,6 +967,26 @@ namespace GraphBLAS
         check_index_within_nrows(row_index, C,
                                  "assign(col): row_index >= C.nrows");
 
+        if (detail::deferring())
+        {
+            auto C_arg(detail::deferred_arg(C.m_mat));
+            auto mask_arg(detail::deferred_arg(mask.m_vec));
+            auto u_arg(detail::deferred_arg(u.m_vec));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("assign", C_arg.get(), mask_arg.get(), accum,
+                                 replace_flag, u_arg.get());
+                    backend::assign(C_arg.get(), mask_arg.get(), accum,
+                                    u_arg.get(), row_index, col_indices,
+                                    replace_flag);
+                },
+                C_arg.id(), {mask_arg.id(), u_arg.id()},
+                false);
+            return;
+        }
+
+        GRB_TRACE_OP("assign", C.m_mat, mask.m_vec, accum, replace_flag,
+                     u.m_vec);
         backend::assign(C.m_mat, mask.m_vec, accum, u.m_vec,
                         row_index, col_indices, replace_flag);
 
@@ -637,6 +1023,25 @@ namespace GraphBLAS
         check_nindices_within_size(indices, w,
                                    "assign(const vec): indicies.size !<= w.size");
 
+        if (detail::deferring())
+        {
+            auto w_arg(detail::deferred_arg(w.m_vec));
+            auto mask_arg(detail::deferred_arg(mask.m_vec));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("assign_constant", w_arg.get(),
+                                 mask_arg.get(), accum, replace_flag);
+                    backend::assign_constant(w_arg.get(), mask_arg.get(),
+                                             accum, val, indices,
+                                             replace_flag);
+                },
+                w_arg.id(), {mask_arg.id()},
+                false);
+            return;
+        }
+
+        GRB_TRACE_OP("assign_constant", w.m_vec, mask.m_vec, accum,
+                     replace_flag);
         backend::assign_constant(w.m_vec, mask.m_vec, accum, val, indices,
                                  replace_flag);
 
@@ -681,6 +1086,25 @@ namespace GraphBLAS
         check_nindices_within_ncols(
             col_indices, C,
             "assign(const mat): indicies.size !<= C.ncols");
+        if (detail::deferring())
+        {
+            auto C_arg(detail::deferred_arg(C.m_mat));
+            auto Mask_arg(detail::deferred_arg(Mask.m_mat));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("assign_constant", C_arg.get(),
+                                 Mask_arg.get(), accum, replace_flag);
+                    backend::assign_constant(C_arg.get(), Mask_arg.get(),
+                                             accum, val, row_indices,
+                                             col_indices, replace_flag);
+                },
+                C_arg.id(), {Mask_arg.id()},
+                false);
+            return;
+        }
+
+        GRB_TRACE_OP("assign_constant", C.m_mat, Mask.m_mat, accum,
+                     replace_flag);
         backend::assign_constant(C.m_mat, Mask.m_mat, accum, val,
                                  row_indices, col_indices, replace_flag);
 
@@ -717,6 +1141,25 @@ namespace GraphBLAS
         check_size_size(w, mask, "apply(vec): w.size != mask.size");
         check_size_size(w, u, "apply(vec): w.size != u.size");
 
+        if (detail::deferring())
+        {
+            auto w_arg(detail::deferred_arg(w.m_vec));
+            auto mask_arg(detail::deferred_arg(mask.m_vec));
+            auto u_arg(detail::deferred_arg(u.m_vec));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("apply", w_arg.get(), mask_arg.get(), accum,
+                                 replace_flag, u_arg.get());
+                    backend::apply(w_arg.get(), mask_arg.get(), accum, op,
+                                   u_arg.get(), replace_flag);
+                },
+                w_arg.id(), {mask_arg.id(), u_arg.id()},
+                detail::overwrites(accum, mask.m_vec, replace_flag));
+            return;
+        }
+
+        GRB_TRACE_OP("apply", w.m_vec, mask.m_vec, accum, replace_flag,
+                     u.m_vec);
         backend::apply(w.m_vec, mask.m_vec, accum, op, u.m_vec, replace_flag);
 
         GRB_LOG_VERBOSE("w out: " << w.m_vec);
@@ -751,6 +1194,25 @@ namespace GraphBLAS
         check_ncols_ncols(C, A, "apply(mat): C.ncols != A.ncols");
         check_nrows_nrows(C, A, "apply(mat): C.nrows != A.nrows");
 
+        if (detail::deferring())
+        {
+            auto C_arg(detail::deferred_arg(C.m_mat));
+            auto Mask_arg(detail::deferred_arg(Mask.m_mat));
+            auto A_arg(detail::deferred_arg(A.m_mat));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("apply", C_arg.get(), Mask_arg.get(), accum,
+                                 replace_flag, A_arg.get());
+                    backend::apply(C_arg.get(), Mask_arg.get(), accum, op,
+                                   A_arg.get(), replace_flag);
+                },
+                C_arg.id(), {Mask_arg.id(), A_arg.id()},
+                detail::overwrites(accum, Mask.m_mat, replace_flag));
+            return;
+        }
+
+        GRB_TRACE_OP("apply", C.m_mat, Mask.m_mat, accum, replace_flag,
+                     A.m_mat);
         backend::apply(C.m_mat, Mask.m_mat, accum, op, A.m_mat, replace_flag);
 
         GRB_LOG_VERBOSE("C out: " << C.m_mat);
@@ -786,6 +1248,25 @@ namespace GraphBLAS
         check_size_size(w, mask, "reduce(mat2vec): w.size != mask.size");
         check_size_nrows(w, A, "reduce(mat2vec): w.size != A.nrows");
 
+        if (detail::deferring())
+        {
+            auto w_arg(detail::deferred_arg(w.m_vec));
+            auto mask_arg(detail::deferred_arg(mask.m_vec));
+            auto A_arg(detail::deferred_arg(A.m_mat));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("reduce", w_arg.get(), mask_arg.get(), accum,
+                                 replace_flag, A_arg.get());
+                    backend::reduce(w_arg.get(), mask_arg.get(), accum, op,
+                                    A_arg.get(), replace_flag);
+                },
+                w_arg.id(), {mask_arg.id(), A_arg.id()},
+                detail::overwrites(accum, mask.m_vec, replace_flag));
+            return;
+        }
+
+        GRB_TRACE_OP("reduce", w.m_vec, mask.m_vec, accum, replace_flag,
+                     A.m_mat);
         backend::reduce(w.m_vec, mask.m_vec, accum, op, A.m_mat, replace_flag);
 
         GRB_LOG_VERBOSE("w out: " << w.m_vec);
@@ -810,7 +1291,10 @@ namespace GraphBLAS
         GRB_LOG_VERBOSE_OP(op);
         GRB_LOG_VERBOSE("u in: " << u.m_vec);
 
-        backend::reduce_vector_to_scalar(val, accum, op, u.m_vec);
+        GRB_TRACE_OP("reduce_vector_to_scalar", val, backend::NoMask(), accum,
+                     false, detail::completed(u.m_vec));
+        backend::reduce_vector_to_scalar(val, accum, op,
+                                         detail::completed(u.m_vec));
 
         GRB_LOG_VERBOSE("val out: " << val);
         GRB_LOG_FN_END("reduce - 4.3.9.2 - vector to scalar variant");
@@ -836,12 +1320,89 @@ namespace GraphBLAS
         GRB_LOG_VERBOSE_OP(op);
         GRB_LOG_VERBOSE("A in: " << A.m_mat);
 
-        backend::reduce_matrix_to_scalar(val, accum, op, A.m_mat);
+        GRB_TRACE_OP("reduce_matrix_to_scalar", val, backend::NoMask(), accum,
+                     false, detail::completed(A.m_mat));
+        backend::reduce_matrix_to_scalar(val, accum, op,
+                                         detail::completed(A.m_mat));
 
         GRB_LOG_VERBOSE("val out: " << val);
         GRB_LOG_FN_END("reduce - 4.3.9.3 - matrix to scalar variant");
     }
 
+    //************************************************************************
+    // Fused mxm and reduce (not in the spec)
+    //************************************************************************
+
+    /**
+     * @brief val = accum(val, reduce(monoid, apply_op((A +.* B)<Mask>)))
+     *        computed without storing the product, for when only a total
+     *        is wanted: e.g., triangles are the sum of (L +.* L')<L>, and
+     *        4-cycles are found from apply_op(x) = x(x-1) over A +.* A.
+     */
+    template<typename ValueT,
+             typename MaskT,
+             typename AccumT,
+             typename MonoidT, // monoid only
+             typename UnaryOpT,
+             typename SemiringT,
+             typename AMatrixT,
+             typename BMatrixT>
+    inline void mxm_reduce(ValueT           &val,
+                           MaskT      const &Mask,
+                           AccumT            accum,
+                           MonoidT           monoid,
+                           UnaryOpT          apply_op,
+                           SemiringT         op,
+                           AMatrixT   const &A,
+                           BMatrixT   const &B)
+    {
+        GRB_LOG_FN_BEGIN("mxm_reduce - fused matrix-matrix multiply and reduce");
+        GRB_LOG_VERBOSE("val in: " << val);
+        GRB_LOG_VERBOSE("Mask in : " << Mask.m_mat);
+        GRB_LOG_VERBOSE_ACCUM(accum);
+        GRB_LOG_VERBOSE_OP(op);
+        GRB_LOG_VERBOSE("A in :" << A.m_mat);
+        GRB_LOG_VERBOSE("B in :" << B.m_mat);
+
+        check_nrows_nrows(A, Mask, "mxm_reduce: A.nrows != Mask.nrows");
+        check_ncols_ncols(B, Mask, "mxm_reduce: B.ncols != Mask.ncols");
+        check_ncols_nrows(A, B, "mxm_reduce: A.ncols != B.nrows");
+
+        detail::complete_arg(Mask.m_mat);
+        detail::complete_arg(A.m_mat);
+        detail::complete_arg(B.m_mat);
+
+        GRB_TRACE_OP("mxm_reduce", val, Mask.m_mat, accum, false, A.m_mat,
+                     B.m_mat);
+        backend::mxm_reduce(val, Mask.m_mat, accum, monoid, apply_op, op,
+                            A.m_mat, B.m_mat);
+
+        GRB_LOG_VERBOSE("val out: " << val);
+        GRB_LOG_FN_END("mxm_reduce - fused matrix-matrix multiply and reduce");
+    }
+
+    /// val = accum(val, reduce(monoid, (A +.* B)<Mask>))
+    template<typename ValueT,
+             typename MaskT,
+             typename AccumT,
+             typename MonoidT, // monoid only
+             typename SemiringT,
+             typename AMatrixT,
+             typename BMatrixT>
+    inline void mxm_reduce(ValueT           &val,
+                           MaskT      const &Mask,
+                           AccumT            accum,
+                           MonoidT           monoid,
+                           SemiringT         op,
+                           AMatrixT   const &A,
+                           BMatrixT   const &B)
+    {
+        mxm_reduce(val, Mask, accum, monoid,
+                   Identity<typename SemiringT::result_type,
+                            typename MonoidT::result_type>(),
+                   op, A, B);
+    }
+
     //************************************************************************
     // Transpose
     //************************************************************************
@@ -869,6 +1430,25 @@ namespace GraphBLAS
         check_ncols_nrows(C, A, "transpose: C.ncols != A.nrows");
         check_ncols_nrows(A, C, "transpose: A.ncols != C.nrows");
 
+        if (detail::deferring())
+        {
+            auto C_arg(detail::deferred_arg(C.m_mat));
+            auto Mask_arg(detail::deferred_arg(Mask.m_mat));
+            auto A_arg(detail::deferred_arg(A.m_mat));
+            detail::defer(
+                [=]() {
+                    GRB_TRACE_OP("transpose", C_arg.get(), Mask_arg.get(),
+                                 accum, replace_flag, A_arg.get());
+                    backend::transpose(C_arg.get(), Mask_arg.get(), accum,
+                                       A_arg.get(), replace_flag);
+                },
+                C_arg.id(), {Mask_arg.id(), A_arg.id()},
+                detail::overwrites(accum, Mask.m_mat, replace_flag));
+            return;
+        }
+
+        GRB_TRACE_OP("transpose", C.m_mat, Mask.m_mat, accum, replace_flag,
+                     A.m_mat);
         backend::transpose(C.m_mat, Mask.m_mat, accum, A.m_mat, replace_flag);
 
         GRB_LOG_VERBOSE("C out: " << C.m_mat);
@@ -0,0 +1,62 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * The OpenMP (multicore CPU) platform uses the storage, views and utilities
+ * of the sequential platform with operations whose loops over the rows of
+ * the result are parallelized with OpenMP.
+ */
+
+#ifndef GB_OMP_HPP
+#define GB_OMP_HPP
+
+#pragma once
+
+#include <graphblas/platforms/sequential/Matrix.hpp>
+#include <graphblas/platforms/sequential/Vector.hpp>
+
+#include <graphblas/platforms/sequential/utility.hpp>
+
+#include <graphblas/platforms/sequential/TransposeView.hpp>
+#include <graphblas/platforms/sequential/ComplementView.hpp>
+
+#include <graphblas/platforms/omp/operations.hpp>
+
+#include <graphblas/platforms/sequential/BitmapSparseVector.hpp>
+#include <graphblas/platforms/sequential/HybridSparseVector.hpp>
+#include <graphblas/platforms/sequential/DenseVector.hpp>
+#include <graphblas/platforms/sequential/LilSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/CsrSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/CsrCscSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/MappedCsrSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/HypersparseMatrix.hpp>
+#include <graphblas/platforms/sequential/IsoSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/DenseMatrix.hpp>
+
+#endif // GB_OMP_HPP
@@ -0,0 +1,443 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Row-partitioned parallel versions of the helpers used by the OpenMP
+ * (multicore CPU) backend.  The sequential helpers are reused for everything
+ * that works on a single row or vector.
+ *
+ * Each row of a result is computed independently into a separate buffer and
+ * the buffers are copied into the (non thread safe) matrix in row order
+ * afterwards.  Inside a parallel region the operands are only read through
+ * getRow()/getCol(); see prime_row_access().
+ */
+
+#ifndef GB_OMP_PARALLEL_HELPERS_HPP
+#define GB_OMP_PARALLEL_HELPERS_HPP
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <iostream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <graphblas/algebra.hpp>
+#include <graphblas/indices.hpp>
+
+#include <graphblas/platforms/sequential/sparse_helpers.hpp>
+#include <graphblas/platforms/sequential/LilSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/TransposeView.hpp>
+
+/// Number of rows handed to a thread at a time by the dynamically
+/// scheduled row loops.
+#ifndef GB_OMP_ROW_CHUNK
+#define GB_OMP_ROW_CHUNK 64
+#endif
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //**********************************************************************
+        /// Number of threads a parallel region will use (1 when compiled
+        /// without OpenMP).
+        inline int omp_num_threads()
+        {
+#ifdef _OPENMP
+            return omp_get_max_threads();
+#else
+            return 1;
+#endif
+        }
+
+        /// Index of the calling thread within the current parallel region.
+        inline int omp_thread_index()
+        {
+#ifdef _OPENMP
+            return omp_get_thread_num();
+#else
+            return 0;
+#endif
+        }
+
+        //**********************************************************************
+        /// Some storage builds data inside const accessors the first time
+        /// they are called (e.g., the column copy of a CsrCscSparseMatrix,
+        /// which is also the row access of its TransposeView).  Make one
+        /// call before entering a parallel region so that all of the calls
+        /// within it only read.
+        template<typename MatrixT>
+        inline void prime_row_access(MatrixT const &A)
+        {
+            if (A.nrows() > 0)
+            {
+                A.getRow(0);
+            }
+        }
+
+        inline void prime_row_access(NoMask const &)
+        {
+        }
+
+        template<typename MatrixT>
+        inline void prime_col_access(MatrixT const &A)
+        {
+            if (A.ncols() > 0)
+            {
+                A.getCol(0);
+            }
+        }
+
+        //**********************************************************************
+        /// Compute every row of a result: row_function(rows[i], i) is called
+        /// for each i in parallel.
+        template<typename RowT, typename RowFunctionT>
+        inline void parallel_rows(std::vector<RowT> &rows,
+                                  RowFunctionT       row_function)
+        {
+            IndexType num_rows(rows.size());
+
+            #pragma omp parallel for schedule(dynamic, GB_OMP_ROW_CHUNK)
+            for (IndexType row_idx = 0; row_idx < num_rows; ++row_idx)
+            {
+                row_function(rows[row_idx], row_idx);
+            }
+        }
+
+        /// Compute the rows of a result in row_set (see stored_rows()):
+        /// row_function(rows[i], row_set[i]) is called for each i in
+        /// parallel.
+        template<typename RowT, typename RowFunctionT>
+        inline void parallel_rows(std::vector<RowT> &rows,
+                                  RowSet      const &row_set,
+                                  RowFunctionT       row_function)
+        {
+            IndexType num_rows(row_set.size());
+            rows.resize(num_rows);
+
+            #pragma omp parallel for schedule(dynamic, GB_OMP_ROW_CHUNK)
+            for (IndexType ix = 0; ix < num_rows; ++ix)
+            {
+                row_function(rows[ix], row_set[ix]);
+            }
+        }
+
+        /// Compute a sparse vector (vector<tuple(index,value)>) in parallel:
+        /// element_function(part, i) appends the element at i (if any) to
+        /// part.  The index range is split into chunks with separate parts,
+        /// which are concatenated in order so the result stays sorted.
+        template<typename ElementT, typename ElementFunctionT>
+        inline void parallel_append(std::vector<ElementT> &result,
+                                    IndexType              size,
+                                    ElementFunctionT       element_function)
+        {
+            IndexType chunk_size(GB_OMP_ROW_CHUNK);
+            IndexType num_chunks((size + chunk_size - 1) / chunk_size);
+            std::vector<std::vector<ElementT> > parts(num_chunks);
+
+            #pragma omp parallel for schedule(dynamic, 1)
+            for (IndexType chunk = 0; chunk < num_chunks; ++chunk)
+            {
+                IndexType last(std::min(size, (chunk + 1) * chunk_size));
+                for (IndexType idx = chunk * chunk_size; idx < last; ++idx)
+                {
+                    element_function(parts[chunk], idx);
+                }
+            }
+
+            for (auto&& part : parts)
+            {
+                result.insert(result.end(), part.begin(), part.end());
+            }
+        }
+
+        /// Fold the rows of a result into sink (a MonoidReduceSink holding
+        /// the identity) without storing them: row_function(row, row_set[i])
+        /// fills an empty row buffer for each i.  Each thread folds a
+        /// contiguous block of rows into its own copy of the sink and the
+        /// copies are merged in row order.  row_function is copied for each
+        /// thread, so it can carry its own workspace.
+        template<typename RowT, typename SinkT, typename RowFunctionT>
+        inline void parallel_reduce_rows(SinkT               &sink,
+                                         RowSet       const  &row_set,
+                                         RowFunctionT         row_function)
+        {
+            IndexType num_rows(row_set.size());
+            std::vector<SinkT> partials(omp_num_threads(), sink);
+
+            #pragma omp parallel firstprivate(row_function)
+            {
+                SinkT &partial(partials[omp_thread_index()]);
+                RowT   row;
+
+                #pragma omp for schedule(static)
+                for (IndexType ix = 0; ix < num_rows; ++ix)
+                {
+                    row_function(row, row_set[ix]);
+                    if (!row.empty())
+                    {
+                        partial.setRow(row_set[ix], row);
+                        row.clear();
+                    }
+                }
+            }
+
+            sink = partials[0];
+            for (std::size_t ix = 1; ix < partials.size(); ++ix)
+            {
+                sink.merge(partials[ix]);
+            }
+        }
+
+        //**********************************************************************
+        template < typename ZMatrixT,
+                   typename CMatrixT,
+                   typename TMatrixT,
+                   typename BinaryOpT >
+        void parallel_ewise_or_opt_accum(ZMatrixT         &Z,
+                                         CMatrixT const   &C,
+                                         TMatrixT const   &T,
+                                         BinaryOpT         accum)
+        {
+            typedef typename ZMatrixT::ScalarType ZScalarType;
+            typedef std::vector<std::tuple<IndexType,ZScalarType> > ZRowType;
+
+            prime_row_access(C);
+            prime_row_access(T);
+
+            RowSet row_set(stored_rows(C, T));
+            std::vector<ZRowType> rows;
+            parallel_rows(rows, row_set, [&](ZRowType &z_row, IndexType row_idx)
+            {
+                ewise_or(z_row, C.getRow(row_idx), T.getRow(row_idx), accum);
+            });
+            set_rows(Z, rows, row_set);
+        }
+
+        //**********************************************************************
+        // Specialized version that gets used when we don't have an accumulator
+        template < typename ZMatrixT,
+                   typename CMatrixT,
+                   typename TMatrixT>
+        void parallel_ewise_or_opt_accum(ZMatrixT                    &Z,
+                                         CMatrixT const              &C,
+                                         TMatrixT const              &T,
+                                         GraphBLAS::NoAccumulate )
+        {
+            sparse_copy(Z, T);
+        }
+
+        //**********************************************************************
+        template < typename ZMatrixT,
+                   typename CMatrixT,
+                   typename TMatrixT,
+                   typename RowSequenceT,
+                   typename ColSequenceT,
+                   typename BinaryOpT >
+        void parallel_ewise_or_stencil_opt_accum(ZMatrixT           &Z,
+                                                 CMatrixT const     &C,
+                                                 TMatrixT const     &T,
+                                                 RowSequenceT const &,
+                                                 ColSequenceT const &,
+                                                 BinaryOpT           accum)
+        {
+            // If there is an accumulate operations, do nothing with the stencil
+            parallel_ewise_or_opt_accum(Z, C, T, accum);
+        }
+
+        //**********************************************************************
+        template < typename ZMatrixT,
+                   typename CMatrixT,
+                   typename TMatrixT,
+                   typename RowSequenceT,
+                   typename ColSequenceT>
+        void parallel_ewise_or_stencil_opt_accum(ZMatrixT           &Z,
+                                                 CMatrixT const     &C,
+                                                 TMatrixT const     &T,
+                                                 RowSequenceT const &row_indices,
+                                                 ColSequenceT const &col_indices,
+                                                 GraphBLAS::NoAccumulate)
+        {
+            // If there is no accumulate we need to annihilate stored values
+            // in C that fall in the stencil
+            typedef typename ZMatrixT::ScalarType ZScalarType;
+            typedef std::vector<std::tuple<IndexType,ZScalarType> > ZRowType;
+
+            prime_row_access(C);
+            prime_row_access(T);
+
+            std::vector<ZRowType> rows(Z.nrows());
+            parallel_rows(rows, [&](ZRowType &z_row, IndexType row_idx)
+            {
+                if (searchIndices(row_indices, row_idx))
+                {
+                    ewise_or_stencil(z_row, C.getRow(row_idx),
+                                     T.getRow(row_idx), col_indices);
+                }
+                else
+                {
+                    // Row not stenciled.  Take row from C only
+                    for (auto&& elt : C.getRow(row_idx))
+                    {
+                        z_row.push_back(std::make_tuple(
+                            std::get<0>(elt),
+                            static_cast<ZScalarType>(std::get<1>(elt))));
+                    }
+                }
+            });
+            set_rows(Z, rows);
+        }
+
+        //**********************************************************************
+        template < typename CMatrixT,
+                   typename ZMatrixT,
+                   typename MMatrixT>
+        void parallel_write_with_opt_mask(CMatrixT           &C,
+                                          ZMatrixT   const   &Z,
+                                          MMatrixT   const   &mask,
+                                          bool               replace)
+        {
+            typedef typename CMatrixT::ScalarType CScalarType;
+            typedef std::vector<std::tuple<IndexType, CScalarType> > CRowType;
+
+            prime_row_access(C);
+            prime_row_access(Z);
+            prime_row_access(mask);
+
+            // Rows without values in C or Z stay empty whatever the mask
+            RowSet row_set(stored_rows(C, Z));
+            std::vector<CRowType> rows;
+            parallel_rows(rows, row_set, [&](CRowType &c_row, IndexType row_idx)
+            {
+                apply_with_mask(c_row, C.getRow(row_idx), Z.getRow(row_idx),
+                                mask.getRow(row_idx), replace);
+            });
+            set_rows(C, rows, row_set);
+        }
+
+        //**********************************************************************
+        // Specialized version for no mask
+        template < typename CMatrixT,
+                   typename ZMatrixT >
+        void parallel_write_with_opt_mask(CMatrixT                   &C,
+                                          ZMatrixT           const   &Z,
+                                          backend::NoMask    const   &,
+                                          bool                       )
+        {
+            sparse_copy(C, Z);
+        }
+
+        //**********************************************************************
+        /// C<M> = accum(C, T) without building Z (see
+        /// write_with_opt_accum_mask()): the rows of Z are formed and
+        /// masked within the parallel row loop.
+        template < typename ZScalarT,
+                   typename CMatrixT,
+                   typename TMatrixT,
+                   typename MMatrixT,
+                   typename BinaryOpT >
+        void parallel_write_with_opt_accum_mask(CMatrixT           &C,
+                                                TMatrixT   const   &T,
+                                                MMatrixT   const   &mask,
+                                                BinaryOpT           accum,
+                                                bool                replace)
+        {
+            typedef typename CMatrixT::ScalarType CScalarType;
+            typedef std::vector<std::tuple<IndexType, ZScalarT> >    ZRowType;
+            typedef std::vector<std::tuple<IndexType, CScalarType> > CRowType;
+
+            prime_row_access(C);
+            prime_row_access(T);
+            prime_row_access(mask);
+
+            // Rows without values in C or T stay empty whatever the mask
+            RowSet row_set(stored_rows(C, T));
+            std::vector<CRowType> rows;
+            parallel_rows(rows, row_set, [&](CRowType &c_row, IndexType row_idx)
+            {
+                typename CMatrixT::RowType C_row(C.getRow(row_idx));
+                ZRowType z_row;
+                ewise_or_opt_accum_row(z_row, C_row, T.getRow(row_idx), accum);
+                apply_with_mask(c_row, C_row, z_row, mask.getRow(row_idx),
+                                replace);
+            });
+            set_rows(C, rows, row_set);
+        }
+
+        /// Without a mask the rows of Z are the rows of the result.
+        template < typename ZScalarT,
+                   typename CMatrixT,
+                   typename TMatrixT,
+                   typename BinaryOpT >
+        void parallel_write_with_opt_accum_mask(CMatrixT                   &C,
+                                                TMatrixT           const   &T,
+                                                backend::NoMask    const   &,
+                                                BinaryOpT                   accum,
+                                                bool                        )
+        {
+            typedef std::vector<std::tuple<IndexType, ZScalarT> > ZRowType;
+
+            prime_row_access(C);
+            prime_row_access(T);
+
+            RowSet row_set(stored_rows(C, T));
+            std::vector<ZRowType> rows;
+            parallel_rows(rows, row_set, [&](ZRowType &z_row, IndexType row_idx)
+            {
+                ewise_or(z_row, C.getRow(row_idx), T.getRow(row_idx), accum);
+            });
+            set_rows(C, rows, row_set);
+        }
+
+        /// Without a mask or an accumulator C is a copy of T.
+        template < typename ZScalarT,
+                   typename CMatrixT,
+                   typename TMatrixT >
+        void parallel_write_with_opt_accum_mask(CMatrixT                   &C,
+                                                TMatrixT           const   &T,
+                                                backend::NoMask    const   &,
+                                                GraphBLAS::NoAccumulate      ,
+                                                bool                        )
+        {
+            sparse_copy(C, T);
+        }
+
+    } // backend
+} // GraphBLAS
+
+#endif // GB_OMP_PARALLEL_HELPERS_HPP
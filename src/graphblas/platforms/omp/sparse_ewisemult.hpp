@@ -0,0 +1,186 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Implementations of all GraphBLAS functions optimized for the OpenMP
+ * (multicore CPU) backend.
+ */
+
+#ifndef GB_OMP_SPARSE_EWISEMULT_HPP
+#define GB_OMP_SPARSE_EWISEMULT_HPP
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <iostream>
+#include <graphblas/types.hpp>
+#include <graphblas/algebra.hpp>
+
+#include "parallel_helpers.hpp"
+#include <graphblas/platforms/sequential/LilSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/dense_ewise.hpp>
+
+#include <graphblas/detail/logging.h>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //**********************************************************************
+        /// Implementation of 4.3.4.1 eWiseMult: Vector variant
+        template<typename WScalarT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename BinaryOpT,  //can be BinaryOp, Monoid (not Semiring)
+                 typename UVectorT,
+                 typename VVectorT,
+                 typename... WTagsT>
+        inline void eWiseMult(
+            GraphBLAS::backend::Vector<WScalarT, WTagsT...> &w,
+            MaskT                                     const &mask,
+            AccumT                                           accum,
+            BinaryOpT                                        op,
+            UVectorT                                  const &u,
+            VVectorT                                  const &v,
+            bool                                             replace_flag = false)
+        {
+            // A dense w without a mask or an accumulator is written in
+            // place (see dense_ewise.hpp)
+            if (dense_ewise_mult(w, mask, accum, op, u, v))
+            {
+                return;
+            }
+
+            // =================================================================
+            // Do the basic ewise-and work: t = u .* v
+            typedef typename BinaryOpT::result_type D3ScalarType;
+            ScratchVector<std::tuple<IndexType,D3ScalarType> > t_contents;
+
+            if ((u.nvals() > 0) && (v.nvals() > 0))
+            {
+                auto u_contents(u.getContents());
+                auto v_contents(v.getContents());
+
+                ewise_and(*t_contents, u_contents, v_contents, op);
+            }
+
+            // =================================================================
+            // Accumulate into Z
+            ScratchVector<std::tuple<IndexType,WScalarT> > z_contents;
+            ewise_or_opt_accum_1D(*z_contents, w, *t_contents, accum);
+
+            // =================================================================
+            // Copy Z into the final output considering mask and replace
+            write_with_opt_mask_1D(w, *z_contents, mask, replace_flag);
+        }
+
+        //**********************************************************************
+        /// Implementation of 4.3.4.2 eWiseMult: Matrix variant
+        template<typename CScalarT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename BinaryOpT,  //can be BinaryOp, Monoid (not Semiring)
+                 typename AMatrixT,
+                 typename BMatrixT,
+                 typename... CTagsT>
+        inline void eWiseMult(
+            GraphBLAS::backend::Matrix<CScalarT, CTagsT...> &C,
+            MaskT                                     const &Mask,
+            AccumT                                           accum,
+            BinaryOpT                                        op,
+            AMatrixT                                  const &A,
+            BMatrixT                                  const &B,
+            bool                                             replace_flag = false)
+        {
+            IndexType num_rows(A.nrows());
+            IndexType num_cols(A.ncols());
+
+            typedef typename AMatrixT::ScalarType AScalarType;
+            typedef typename BMatrixT::ScalarType BScalarType;
+
+            typedef typename AMatrixT::RowType ARowType;
+            typedef typename BMatrixT::RowType BRowType;
+            typedef std::vector<std::tuple<IndexType,CScalarT> > CRowType;
+
+            // =================================================================
+            // Do the basic ewise-and work: T = A .* B
+            typedef typename BinaryOpT::result_type D3ScalarType;
+            typedef std::vector<std::tuple<IndexType,D3ScalarType> > TRowType;
+            typedef GraphBLAS::backend::Matrix<CScalarT, CTagsT...> CMatrixType;
+            typename scratch_matrix<CMatrixType, D3ScalarType>::type
+                T(num_rows, num_cols);
+
+            if ((A.nvals() > 0) && (B.nvals() > 0))
+            {
+                prime_row_access(A);
+                prime_row_access(B);
+
+                // create the rows of the result in parallel
+                RowSet row_set(common_rows(A, B));
+                std::vector<TRowType> rows;
+                parallel_rows(rows, row_set,
+                              [&](TRowType &T_row, IndexType row_idx)
+                {
+                    BRowType B_row(B.getRow(row_idx));
+
+                    if (!B_row.empty())
+                    {
+                        ARowType A_row(A.getRow(row_idx));
+                        if (!A_row.empty())
+                        {
+                            ewise_and(T_row, A_row, B_row, op);
+                        }
+                    }
+                });
+                set_rows(T, rows, row_set);
+            }
+
+//            GRB_LOG_E(">>> T <<<");
+//            GRB_LOG_E(T);
+
+            // =================================================================
+            // Accumulate T via C and write the result through the mask,
+            // without forming Z
+            parallel_write_with_opt_accum_mask<CScalarT>(C, T, Mask, accum,
+                                                         replace_flag);
+
+//            GRB_LOG_E(">>> C <<< ");
+//            GRB_LOG_E(C);
+
+        } // ewisemult
+
+    } // backend
+} // GraphBLAS
+
+#endif
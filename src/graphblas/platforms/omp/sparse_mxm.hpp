@@ -0,0 +1,726 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Implementation of sparse mxm for the OpenMP (multicore CPU) backend.
+ */
+
+#ifndef GB_OMP_SPARSE_MXM_HPP
+#define GB_OMP_SPARSE_MXM_HPP
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+#include <type_traits>
+
+#include <graphblas/detail/logging.h>
+#include <graphblas/detail/trace.hpp>
+#include <graphblas/types.hpp>
+#include <graphblas/algebra.hpp>
+
+#include "parallel_helpers.hpp"
+#include <graphblas/platforms/sequential/LilSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/TransposeView.hpp>
+#include <graphblas/platforms/sequential/ComplementView.hpp>
+
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //**********************************************************************
+        /// Compute T = A +.* B one dot product per (row of A, column of B).
+        /// The rows of T are computed in parallel against a row major copy
+        /// of the transpose of B.
+        template<typename TMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_dot(TMatrixT            &T,
+                            SemiringT            op,
+                            AMatrixT    const   &A_in,
+                            BMatrixT    const   &B)
+        {
+            GRB_TRACE_KERNEL("mxm_dot");
+
+            auto const &A(row_major(A_in));
+            typedef typename std::decay<decltype(A)>::type ARowMajorType;
+
+            typedef typename BMatrixT::ScalarType BScalarType;
+            typedef typename scratch_matrix<BMatrixT, BScalarType>::type
+                BTMatrixType;
+            BTMatrixType BT(row_major(TransposeView<BMatrixT>(B)));
+
+            IndexType ncol_B(B.ncols());
+
+            typedef typename SemiringT::result_type D3ScalarType;
+            typedef std::vector<std::tuple<IndexType,D3ScalarType> > TRowType;
+
+            RowSet row_set(stored_rows(A));
+            std::vector<TRowType> rows;
+            parallel_rows(rows, row_set, [&](TRowType &T_row, IndexType row_idx)
+            {
+                typename ARowMajorType::RowType A_row(A.getRow(row_idx));
+                if (A_row.empty())
+                {
+                    return;
+                }
+
+                for (IndexType col_idx = 0; col_idx < ncol_B; ++col_idx)
+                {
+                    typename BTMatrixType::RowType B_col(
+                        BT.getRow(col_idx));
+                    if (!B_col.empty())
+                    {
+                        D3ScalarType T_val;
+                        if (dot(T_val, A_row, B_col, op))
+                        {
+                            T_row.push_back(std::make_tuple(col_idx, T_val));
+                        }
+                    }
+                }
+            });
+            set_rows(T, rows, row_set);
+        }
+
+        //**********************************************************************
+        /// Flag the columns of the stored true values in a row of the mask.
+        template<typename MMatrixT>
+        inline void mark_mask_row(ScratchFlags           &marks,
+                                  MMatrixT       const   &M,
+                                  IndexType               row_idx)
+        {
+            typename MMatrixT::RowType M_row(M.getRow(row_idx));
+            for (auto&& M_elt : M_row)
+            {
+                if (static_cast<bool>(std::get<1>(M_elt)))
+                {
+                    marks.set(std::get<0>(M_elt));
+                }
+            }
+        }
+
+        inline void mark_mask_row(ScratchFlags           &,
+                                  NoMask         const   &,
+                                  IndexType)
+        {
+        }
+
+        //**********************************************************************
+        /// Gustavson's algorithm with the products of each row sorted and
+        /// combined (see mxm_sorted_row()); used when the dense accumulator
+        /// would be larger than the operands (e.g., for hypersparse
+        /// matrices).  Masking is as in mxm_gustavson().
+        template<typename TMatrixT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_gustavson_sorted(TMatrixT            &T,
+                                         MMatrixT    const   &M,
+                                         bool                 complement,
+                                         SemiringT            op,
+                                         AMatrixT    const   &A,
+                                         BMatrixT    const   &B)
+        {
+            GRB_TRACE_KERNEL("mxm_gustavson_sorted");
+
+            typedef typename SemiringT::result_type D3ScalarType;
+            typedef std::vector<std::tuple<IndexType,D3ScalarType> > TRowType;
+
+            prime_row_access(M);
+
+            RowSet    row_set(stored_rows(A));
+            IndexType num_rows(row_set.size());
+            std::vector<TRowType> rows(num_rows);
+
+            #pragma omp parallel
+            {
+                TRowType               products;
+                std::vector<IndexType> mask_cols;
+
+                #pragma omp for schedule(dynamic, GB_OMP_ROW_CHUNK)
+                for (IndexType ix = 0; ix < num_rows; ++ix)
+                {
+                    mxm_sorted_row(rows[ix], products, mask_cols,
+                                   M, complement, op, A, B, row_set[ix]);
+                }
+            }
+
+            set_rows(T, rows, row_set);
+        }
+
+        //**********************************************************************
+        /// Compute T = A +.* B with Gustavson's algorithm: each row of T is
+        /// the sum of the rows of B selected by the row of A, scattered into
+        /// a sparse accumulator (dense values, flags and a list of the
+        /// columns touched).  Each thread owns one accumulator and computes
+        /// whole rows with it.
+        ///
+        /// Only the positions in M (or, if complement is set, the positions
+        /// not in M) are computed.  With NoMask and complement set, every
+        /// position is computed.
+        template<typename TMatrixT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_gustavson(TMatrixT            &T,
+                                  MMatrixT    const   &M,
+                                  bool                 complement,
+                                  SemiringT            op,
+                                  AMatrixT    const   &A_in,
+                                  BMatrixT    const   &B_in)
+        {
+            GRB_TRACE_KERNEL("mxm_gustavson");
+
+            auto const &A(row_major(A_in));
+            auto const &B(row_major(B_in));
+            typedef typename std::decay<decltype(A)>::type ARowMajorType;
+            typedef typename std::decay<decltype(B)>::type BRowMajorType;
+
+            IndexType ncol_B(B.ncols());
+            if (ncol_B > A.nvals() + B.nvals())
+            {
+                mxm_gustavson_sorted(T, M, complement, op, A, B);
+                return;
+            }
+
+            typedef typename SemiringT::result_type D3ScalarType;
+            typedef std::vector<std::tuple<IndexType,D3ScalarType> > TRowType;
+
+            prime_row_access(M);
+
+            RowSet    row_set(stored_rows(A));
+            IndexType num_rows(row_set.size());
+            std::vector<TRowType> rows(num_rows);
+
+            #pragma omp parallel
+            {
+                SparseAccumulator<D3ScalarType> spa(ncol_B);
+
+                ScratchFlags mask_flags(ncol_B);
+
+                #pragma omp for schedule(dynamic, GB_OMP_ROW_CHUNK)
+                for (IndexType ix = 0; ix < num_rows; ++ix)
+                {
+                    IndexType row_idx(row_set[ix]);
+                    mark_mask_row(mask_flags, M, row_idx);
+                    if (!complement && mask_flags.empty())
+                    {
+                        continue;
+                    }
+
+                    typename ARowMajorType::RowType A_row(A.getRow(row_idx));
+
+                    for (auto&& A_elt : A_row)
+                    {
+                        typename BRowMajorType::RowType B_row(
+                            B.getRow(std::get<0>(A_elt)));
+
+                        // An iso row of B has one product
+                        typedef typename row_scalar_type<
+                            typename BRowMajorType::RowType>::type BIsoType;
+                        BIsoType B_iso = BIsoType();
+                        bool iso(iso_value(B_row, B_iso));
+                        D3ScalarType iso_prod(op.zero());
+                        if (iso)
+                        {
+                            iso_prod = op.mult(std::get<1>(A_elt), B_iso);
+                        }
+
+                        for (auto&& B_elt : B_row)
+                        {
+                            IndexType col_idx(std::get<0>(B_elt));
+                            if (mask_flags[col_idx] == complement)
+                            {
+                                continue;
+                            }
+
+                            D3ScalarType prod(
+                                iso ? iso_prod
+                                    : op.mult(std::get<1>(A_elt),
+                                              std::get<1>(B_elt)));
+                            spa.accumulate(col_idx, prod, op);
+                        }
+                    }
+
+                    mask_flags.reset();
+
+                    spa.gather(rows[ix]);
+                }
+            }
+
+            set_rows(T, rows, row_set);
+        }
+
+        //**********************************************************************
+        /// Compute T<M> = A +.* B with one dot product per stored true value
+        /// in the mask, so the work is proportional to nvals(M).
+        template<typename TMatrixT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_masked_dot(TMatrixT                      &T,
+                                   MMatrixT              const   &M,
+                                   SemiringT                      op,
+                                   AMatrixT              const   &A_in,
+                                   TransposeView<BMatrixT> const &B)
+        {
+            GRB_TRACE_KERNEL("mxm_masked_dot");
+
+            auto const &A(row_major(A_in));
+
+            typedef typename SemiringT::result_type D3ScalarType;
+            typedef std::vector<std::tuple<IndexType,D3ScalarType> > TRowType;
+
+            prime_row_access(M);
+            prime_col_access(B);
+
+            RowSet row_set(stored_rows(M));
+            std::vector<TRowType> rows;
+            parallel_rows(rows, row_set, [&](TRowType &T_row, IndexType row_idx)
+            {
+                mxm_masked_dot_row(T_row, M, op, A, B, row_idx);
+            });
+            set_rows(T, rows, row_set);
+        }
+
+        /// Column access on a matrix that is not a TransposeView searches
+        /// every row, so transpose B once and take its rows instead.
+        template<typename TMatrixT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_masked_dot(TMatrixT            &T,
+                                   MMatrixT    const   &M,
+                                   SemiringT            op,
+                                   AMatrixT    const   &A,
+                                   BMatrixT    const   &B)
+        {
+            typedef typename BMatrixT::ScalarType BScalarType;
+            typedef typename scratch_matrix<BMatrixT, BScalarType>::type
+                BTMatrixType;
+            BTMatrixType BT(row_major(TransposeView<BMatrixT>(B)));
+            mxm_masked_dot(T, M, op, A, TransposeView<BTMatrixType>(BT));
+        }
+
+        //**********************************************************************
+        /// Estimated number of multiplies in A +.* B
+        template<typename AMatrixT,
+                 typename BMatrixT>
+        inline double mxm_flops(AMatrixT const &A, BMatrixT const &B)
+        {
+            return ((double)A.nvals() * (double)B.nvals() /
+                    (double)std::max<IndexType>(B.nrows(), 1));
+        }
+
+        /// Gustavson's algorithm does work proportional to the number of
+        /// multiplies; the dot product version tests every (row, col) pair.
+        /// Use Gustavson unless the estimated multiplies exceed the number of
+        /// output positions (i.e., the result is expected to be dense).
+        template<typename AMatrixT,
+                 typename BMatrixT>
+        inline bool mxm_use_gustavson(AMatrixT const &A, BMatrixT const &B)
+        {
+            return (mxm_flops(A, B) < (double)A.nrows() * (double)B.ncols());
+        }
+
+        /// One dot product per mask value costs about the average row length
+        /// of A plus the average column length of B; prefer that when it is
+        /// less than the multiplies of the whole product.
+        template<typename MMatrixT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline bool mxm_use_masked_dot(MMatrixT const &M,
+                                       AMatrixT const &A,
+                                       BMatrixT const &B)
+        {
+            double dot_ops((double)M.nvals() *
+                           ((double)A.nvals() /
+                            (double)std::max<IndexType>(A.nrows(), 1) +
+                            (double)B.nvals() /
+                            (double)std::max<IndexType>(B.ncols(), 1)));
+
+            return (dot_ops < mxm_flops(A, B));
+        }
+
+        //**********************************************************************
+        /// Choose the kernel for T<M> = A +.* B based on the mask.
+
+        template<typename TMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_compute(TMatrixT            &T,
+                                NoMask      const   &M,
+                                SemiringT            op,
+                                AMatrixT    const   &A,
+                                BMatrixT    const   &B)
+        {
+            if (mxm_use_gustavson(A, B))
+            {
+                mxm_gustavson(T, M, true, op, A, B);
+            }
+            else
+            {
+                mxm_dot(T, op, A, B);
+            }
+        }
+
+        /// A complemented mask removes positions from the result, so skip
+        /// them in the Gustavson accumulation.
+        template<typename TMatrixT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_compute(TMatrixT                           &T,
+                                MatrixComplementView<MMatrixT> const &M,
+                                SemiringT                           op,
+                                AMatrixT                   const   &A,
+                                BMatrixT                   const   &B)
+        {
+            if (mxm_use_gustavson(A, B))
+            {
+                mxm_gustavson(T, M.getMatrix(), true, op, A, B);
+            }
+            else
+            {
+                mxm_dot(T, op, A, B);
+            }
+        }
+
+        /// With a mask only the masked positions are needed: one dot product
+        /// per mask value, or Gustavson restricted to the mask when that is
+        /// expected to take fewer operations.
+        template<typename TMatrixT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_compute(TMatrixT            &T,
+                                MMatrixT    const   &M,
+                                SemiringT            op,
+                                AMatrixT    const   &A,
+                                BMatrixT    const   &B)
+        {
+            if (mxm_use_masked_dot(M, A, B))
+            {
+                mxm_masked_dot(T, M, op, A, B);
+            }
+            else
+            {
+                mxm_gustavson(T, M, false, op, A, B);
+            }
+        }
+
+        //**********************************************************************
+        /// Fold (A +.* B)<M> into sink with one dot product per mask value.
+        template<typename SinkT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_reduce_masked_dot(SinkT                         &sink,
+                                          MMatrixT              const   &M,
+                                          SemiringT                      op,
+                                          AMatrixT              const   &A_in,
+                                          TransposeView<BMatrixT> const &B)
+        {
+            GRB_TRACE_KERNEL("mxm_reduce_masked_dot");
+
+            auto const &A(row_major(A_in));
+
+            typedef typename SemiringT::result_type D3ScalarType;
+            typedef std::vector<std::tuple<IndexType,D3ScalarType> > TRowType;
+
+            prime_row_access(M);
+            prime_col_access(B);
+
+            parallel_reduce_rows<TRowType>(
+                sink, stored_rows(M),
+                [&](TRowType &T_row, IndexType row_idx)
+                {
+                    mxm_masked_dot_row(T_row, M, op, A, B, row_idx);
+                });
+        }
+
+        template<typename SinkT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_reduce_masked_dot(SinkT               &sink,
+                                          MMatrixT    const   &M,
+                                          SemiringT            op,
+                                          AMatrixT    const   &A,
+                                          BMatrixT    const   &B)
+        {
+            typedef typename BMatrixT::ScalarType BScalarType;
+            typedef typename scratch_matrix<BMatrixT, BScalarType>::type
+                BTMatrixType;
+            BTMatrixType BT(row_major(TransposeView<BMatrixT>(B)));
+            mxm_reduce_masked_dot(sink, M, op, A,
+                                  TransposeView<BTMatrixType>(BT));
+        }
+
+        /// Fold (A +.* B)<M> (or, if complement is set, the positions not in
+        /// M) into sink, one row of products at a time (see
+        /// mxm_sorted_row()).
+        template<typename SinkT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_reduce_rows(SinkT               &sink,
+                                    MMatrixT    const   &M,
+                                    bool                 complement,
+                                    SemiringT            op,
+                                    AMatrixT    const   &A_in,
+                                    BMatrixT    const   &B_in)
+        {
+            GRB_TRACE_KERNEL("mxm_reduce_rows");
+
+            auto const &A(row_major(A_in));
+            auto const &B(row_major(B_in));
+
+            typedef typename SemiringT::result_type D3ScalarType;
+            typedef std::vector<std::tuple<IndexType,D3ScalarType> > TRowType;
+
+            prime_row_access(M);
+
+            // products and mask_cols are per thread workspace
+            TRowType               products;
+            std::vector<IndexType> mask_cols;
+            parallel_reduce_rows<TRowType>(
+                sink, stored_rows(A),
+                [=, &M, &A, &B](TRowType &T_row, IndexType row_idx) mutable
+                {
+                    mxm_sorted_row(T_row, products, mask_cols,
+                                   M, complement, op, A, B, row_idx);
+                });
+        }
+
+        template<typename SinkT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_reduce_compute(SinkT               &sink,
+                                       NoMask      const   &M,
+                                       SemiringT            op,
+                                       AMatrixT    const   &A,
+                                       BMatrixT    const   &B)
+        {
+            mxm_reduce_rows(sink, M, true, op, A, B);
+        }
+
+        template<typename SinkT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_reduce_compute(
+            SinkT                                &sink,
+            MatrixComplementView<MMatrixT> const &M,
+            SemiringT                             op,
+            AMatrixT                     const   &A,
+            BMatrixT                     const   &B)
+        {
+            mxm_reduce_rows(sink, M.getMatrix(), true, op, A, B);
+        }
+
+        template<typename SinkT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_reduce_compute(SinkT               &sink,
+                                       MMatrixT    const   &M,
+                                       SemiringT            op,
+                                       AMatrixT    const   &A,
+                                       BMatrixT    const   &B)
+        {
+            if (mxm_use_masked_dot(M, A, B))
+            {
+                mxm_reduce_masked_dot(sink, M, op, A, B);
+            }
+            else
+            {
+                mxm_reduce_rows(sink, M, false, op, A, B);
+            }
+        }
+
+        //**********************************************************************
+        /// Fused mxm and reduce to scalar:
+        ///     val = accum(val, reduce(monoid, apply_op((A +.* B)<M>)))
+        /// Each thread folds the rows it computes into its own partial result
+        /// (see parallel_reduce_rows()), so the product is never stored.
+        template<typename ValueT,
+                 typename MMatrixT,
+                 typename AccumT,
+                 typename MonoidT,
+                 typename UnaryOpT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_reduce(ValueT              &val,
+                               MMatrixT    const   &M,
+                               AccumT               accum,
+                               MonoidT              monoid,
+                               UnaryOpT             apply_op,
+                               SemiringT            op,
+                               AMatrixT    const   &A,
+                               BMatrixT    const   &B)
+        {
+            MonoidReduceSink<MonoidT, UnaryOpT> sink(monoid, apply_op);
+            mxm_reduce_compute(sink, M, op, A, B);
+
+            ValueT z;
+            opt_accum_scalar(z, val, sink.value(), accum);
+            val = z;
+        }
+
+        //**********************************************************************
+        /// Without a mask or an accumulator C is the product itself.  When
+        /// the kernels would have kept T in the storage of C anyway, and C
+        /// is not one of the operands, compute the product straight into C.
+        template<typename CMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline bool mxm_into(CMatrixT            &C,
+                             SemiringT            op,
+                             AMatrixT    const   &A,
+                             BMatrixT    const   &B,
+                             std::true_type)
+        {
+            if (is_aliased(C, A) || is_aliased(C, B))
+            {
+                return false;
+            }
+
+            C.clear();
+            if ((A.nvals() > 0) && (B.nvals() > 0))
+            {
+                mxm_compute(C, NoMask(), op, A, B);
+            }
+            return true;
+        }
+
+        template<typename CMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline bool mxm_into(CMatrixT            &,
+                             SemiringT             ,
+                             AMatrixT    const   &,
+                             BMatrixT    const   &,
+                             std::false_type)
+        {
+            return false;
+        }
+
+        //**********************************************************************
+        /// Implementation of 4.3.1 mxm: Matrix-matrix multiply
+        template<typename CMatrixT,
+                 typename MMatrixT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm(CMatrixT            &C,
+                        MMatrixT    const   &M,
+                        AccumT      const   &accum,
+                        SemiringT            op,
+                        AMatrixT    const   &A,
+                        BMatrixT    const   &B,
+                        bool                 replace_flag = false)
+        {
+            // Dimension checks happen in front end
+            IndexType nrow_A(A.nrows());
+            IndexType ncol_B(B.ncols());
+
+            typedef typename SemiringT::result_type D3ScalarType;
+            typedef typename CMatrixT::ScalarType   CScalarType;
+
+            // =================================================================
+            // C = A +.* B needs no temporaries (see mxm_into)
+            if (mxm_into(C, op, A, B,
+                         std::integral_constant<
+                             bool,
+                             std::is_same<MMatrixT, NoMask>::value &&
+                             std::is_same<AccumT, NoAccumulate>::value &&
+                             std::is_base_of<
+                                 typename scratch_matrix<CMatrixT,
+                                                         CScalarType>::type,
+                                 CMatrixT>::value>()))
+            {
+                return;
+            }
+
+            // =================================================================
+            // Do the basic multiply work with the semi-ring.
+            typename scratch_matrix<CMatrixT, D3ScalarType>::type
+                T(nrow_A, ncol_B);
+
+            // Build this completely based on the semiring
+            if ((A.nvals() > 0) && (B.nvals() > 0))
+            {
+                mxm_compute(T, M, op, A, B);
+            }
+
+            GRB_LOG_VERBOSE("T: " << T);
+
+            // =================================================================
+            // Accumulate T via C and write the result through the mask,
+            // without forming Z
+            typedef typename std::conditional<
+                std::is_same<AccumT, NoAccumulate>::value,
+                D3ScalarType,
+                typename AccumT::result_type>::type ZScalarType;
+
+            parallel_write_with_opt_accum_mask<ZScalarType>(C, T, M, accum,
+                                                            replace_flag);
+
+        } // mxm
+    } // backend
+} // GraphBLAS
+
+#endif
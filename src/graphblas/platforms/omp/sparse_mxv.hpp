@@ -0,0 +1,279 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Implementation of all sparse mxv for the OpenMP (multicore CPU) backend.
+ */
+
+#ifndef GB_OMP_SPARSE_MXV_HPP
+#define GB_OMP_SPARSE_MXV_HPP
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <iostream>
+#include <algorithm>
+#include <graphblas/algebra.hpp>
+#include <graphblas/detail/trace.hpp>
+
+#include "parallel_helpers.hpp"
+
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //********************************************************************
+        /// Pull: one dot product of u with each row of A that passes the
+        /// mask, computed in parallel over the rows.
+        template<typename D3ScalarT,
+                 typename MaskT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UContentsT>
+        inline void mxv_pull(
+            std::vector<std::tuple<IndexType, D3ScalarT> >       &t,
+            MaskT                                          const &mask,
+            SemiringT                                             op,
+            AMatrixT                                       const &A,
+            UContentsT                                     const &u_contents)
+        {
+            GRB_TRACE_KERNEL("mxv_pull");
+
+            typedef typename AMatrixT::RowType ARowType;
+            typedef std::vector<std::tuple<IndexType, D3ScalarT> >   TVectorType;
+
+            ScratchFlags mask_flags(A.nrows());
+            mask_flags_1D(mask_flags, mask);
+
+            prime_row_access(A);
+
+            parallel_append(t, A.nrows(), [&](TVectorType &t_part,
+                                              IndexType    row_idx)
+            {
+                if (!mask_flags[row_idx])
+                {
+                    return;
+                }
+
+                ARowType const &A_row(A.getRow(row_idx));
+
+                if (!A_row.empty())
+                {
+                    D3ScalarT t_val;
+                    if (dot(t_val, A_row, u_contents, op))
+                    {
+                        t_part.push_back(std::make_tuple(row_idx, t_val));
+                    }
+                }
+            });
+        }
+
+        //********************************************************************
+        /// Push: scatter each stored value of u times the corresponding
+        /// column of A into a sparse accumulator.  A must have cheap column
+        /// access (see mxv_push()).
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UContentsT>
+        inline void mxv_push_cols(
+            std::vector<std::tuple<IndexType, D3ScalarT> >       &t,
+            SemiringT                                             op,
+            AMatrixT                                       const &A,
+            UContentsT                                     const &u_contents)
+        {
+            GRB_TRACE_KERNEL("mxv_push");
+
+            SparseAccumulator<D3ScalarT> spa(A.nrows());
+
+            for (auto&& u_elt : u_contents)
+            {
+                typename AMatrixT::ColType A_col(
+                    A.getCol(std::get<0>(u_elt)));
+
+                for (auto&& A_elt : A_col)
+                {
+                    IndexType idx(std::get<0>(A_elt));
+                    D3ScalarT prod(op.mult(std::get<1>(A_elt),
+                                           std::get<1>(u_elt)));
+                    spa.accumulate(idx, prod, op);
+                }
+            }
+
+            spa.gather(t);
+        }
+
+        /// The columns of a TransposeView are rows of the underlying
+        /// matrix.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UContentsT>
+        inline void mxv_push(
+            std::vector<std::tuple<IndexType, D3ScalarT> >       &t,
+            SemiringT                                             op,
+            TransposeView<AMatrixT>                        const &A,
+            UContentsT                                     const &u_contents)
+        {
+            mxv_push_cols(t, op, A, u_contents);
+        }
+
+        /// The columns of a CsrCscSparseMatrix are read from its CSC copy.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UContentsT>
+        inline void mxv_push(
+            std::vector<std::tuple<IndexType, D3ScalarT> >       &t,
+            SemiringT                                             op,
+            AMatrixT                                       const &A,
+            UContentsT                                     const &u_contents,
+            std::true_type)
+        {
+            mxv_push_cols(t, op, A, u_contents);
+        }
+
+        /// Column access on other matrices searches every row, so
+        /// transpose A once and take its rows instead.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UContentsT>
+        inline void mxv_push(
+            std::vector<std::tuple<IndexType, D3ScalarT> >       &t,
+            SemiringT                                             op,
+            AMatrixT                                       const &A,
+            UContentsT                                     const &u_contents,
+            std::false_type)
+        {
+            typedef typename scratch_matrix<
+                AMatrixT, typename AMatrixT::ScalarType>::type ATMatrixType;
+            ATMatrixType AT(row_major(TransposeView<AMatrixT>(A)));
+            mxv_push(t, op, TransposeView<ATMatrixType>(AT), u_contents);
+        }
+
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UContentsT>
+        inline void mxv_push(
+            std::vector<std::tuple<IndexType, D3ScalarT> >       &t,
+            SemiringT                                             op,
+            AMatrixT                                       const &A,
+            UContentsT                                     const &u_contents)
+        {
+            mxv_push(t, op, A, u_contents,
+                     typename has_csc_copy<AMatrixT>::type());
+        }
+
+        //********************************************************************
+        /// Push does work proportional to the columns of A selected by u;
+        /// pull does a dot product (a lookup per stored value when u is held
+        /// as a bitmap, a merge with u otherwise) for every row that passes
+        /// the mask.  Pick the direction with the smaller estimate.
+        template<typename MaskT,
+                 typename AMatrixT,
+                 typename UContentsT>
+        inline bool mxv_use_push(MaskT      const &mask,
+                                 AMatrixT   const &A,
+                                 UContentsT const &u_contents)
+        {
+            double nvals_A((double)A.nvals());
+            double push_ops((double)u_contents.size() * nvals_A /
+                            (double)std::max<IndexType>(A.ncols(), 1));
+            if (col_access_cost(A) > 0.)
+            {
+                push_ops += nvals_A;   // transposed copy
+            }
+
+            double pull_ops((double)mask_nvals_1D(mask, A.nrows()) *
+                            (nvals_A / (double)std::max<IndexType>(A.nrows(), 1) +
+                             row_access_cost(A) + lookup_cost(u_contents)));
+
+            return (push_ops < pull_ops);
+        }
+
+        //********************************************************************
+        /// Implementation of 4.3.3 mxv: Matrix-Vector variant
+        template<typename WVectorT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UVectorT>
+        inline void mxv(WVectorT        &w,
+                        MaskT     const &mask,
+                        AccumT           accum,
+                        SemiringT        op,
+                        AMatrixT  const &A,
+                        UVectorT  const &u,
+                        bool             replace_flag = false)
+        {
+            // =================================================================
+            // Do the basic multiply work with the semi-ring.
+            typedef typename SemiringT::result_type D3ScalarType;
+
+            ScratchVector<std::tuple<IndexType, D3ScalarType> > t;
+
+            if ((A.nvals() > 0) && (u.nvals() > 0))
+            {
+                auto u_contents(u.getContents());
+                if (mxv_use_push(mask, A, u_contents))
+                {
+                    mxv_push(*t, op, A, u_contents);
+                }
+                else
+                {
+                    mxv_pull(*t, mask, op, A, u_contents);
+                }
+            }
+
+            // =================================================================
+            // Accumulate into Z
+            typedef typename std::conditional<std::is_same<AccumT, NoAccumulate>::value,
+                                              D3ScalarType,
+                                              typename AccumT::result_type>::type ZScalarType;
+            ScratchVector<std::tuple<IndexType, ZScalarType> > z;
+            ewise_or_opt_accum_1D(*z, w, *t, accum);
+
+            // =================================================================
+            // Copy Z into the final output, w, considering mask and replace
+            write_with_opt_mask_1D(w, *z, mask, replace_flag);
+        }
+
+    } // backend
+} // GraphBLAS
+
+#endif
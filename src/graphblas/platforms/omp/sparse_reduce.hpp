@@ -0,0 +1,221 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Implementation of all sparse reduce variants for the OpenMP (multicore CPU) backend.
+ */
+
+#ifndef GB_OMP_SPARSE_REDUCE_HPP
+#define GB_OMP_SPARSE_REDUCE_HPP
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <iostream>
+#include <graphblas/algebra.hpp>
+
+#include "parallel_helpers.hpp"
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //********************************************************************
+        /// Implementation of 4.3.9.1 reduce: Standard Matrix to Vector variant
+        template<typename WVectorT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename BinaryOpT,  // monoid or binary op only
+                 typename AMatrixT>
+        inline void reduce(WVectorT        &w,
+                           MaskT     const &mask,
+                           AccumT           accum,
+                           BinaryOpT        op,
+                           AMatrixT  const &A,
+                           bool             replace_flag = false)
+        {
+            // =================================================================
+            // Do the basic reduction work with the binary op
+            typedef typename BinaryOpT::result_type D3ScalarType;
+            typedef typename AMatrixT::RowType ARowType;
+
+            std::vector<std::tuple<IndexType, D3ScalarType> > t;
+
+            if (A.nvals() > 0)
+            {
+                typedef std::vector<std::tuple<IndexType, D3ScalarType> > TVectorType;
+
+                prime_row_access(A);
+
+                RowSet rows(stored_rows(A));
+                parallel_append(t, rows.size(), [&](TVectorType &t_part,
+                                                    IndexType    ix)
+                {
+                    IndexType row_idx(rows[ix]);
+                    ARowType A_row(A.getRow(row_idx));
+
+                    /// @todo There is something hinky with domains here.  How
+                    /// does one perform the reduction in A domain but produce
+                    /// partial results in D3(op)?
+                    D3ScalarType t_val;
+                    if (reduction(t_val, A_row, op))
+                    {
+                        t_part.push_back(std::make_tuple(row_idx, t_val));
+                    }
+                });
+            }
+
+            // =================================================================
+            // Accumulate into Z
+            // Type generator for z: D3(accum), or D(w) if no accum.
+            typedef typename std::conditional<
+                std::is_same<AccumT, NoAccumulate>::value,
+                D3ScalarType,
+                typename AccumT::result_type>::type  ZScalarType;
+            std::vector<std::tuple<IndexType, ZScalarType> > z;
+            ewise_or_opt_accum_1D(z, w, t, accum);
+
+            // =================================================================
+            // Copy Z into the final output, w, considering mask and replace
+            write_with_opt_mask_1D(w, z, mask, replace_flag);
+        }
+
+        //********************************************************************
+        /// Implementation of 4.3.9.2 reduce: Vector to scalar variant
+        template<typename ValueT,
+                 typename AccumT,
+                 typename MonoidT, // monoid only
+                 typename UVectorT>
+        inline void reduce_vector_to_scalar(ValueT         &val,
+                                            AccumT          accum,
+                                            MonoidT         op,
+                                            UVectorT const &u)
+        {
+            // =================================================================
+            // Do the basic reduction work with the monoid
+            typedef typename MonoidT::result_type D3ScalarType;
+            typedef typename UVectorT::ContentsType UColType;
+
+            D3ScalarType t = op.identity();
+
+            if (u.nvals() > 0)
+            {
+                UColType u_col(u.getContents());
+
+                reduction(t, u_col, op);
+            }
+
+            // =================================================================
+            // Accumulate into Z
+            /// @todo Do we need a type generator for z: D(w) if no accum,
+            /// or D3(accum). I think that D(z) := D(val) should be equivalent, but
+            /// still need to work the proof.
+            ValueT z;
+            opt_accum_scalar(z, val, t, accum);
+
+            // Copy Z into the final output
+            val = z;
+        }
+
+        //********************************************************************
+        /// Implementation of 4.3.9.3 reduce: Matrix to scalar variant
+        template<typename ValueT,
+                 typename AccumT,
+                 typename MonoidT, // monoid only
+                 typename AMatrixT>
+        inline void reduce_matrix_to_scalar(ValueT         &val,
+                                            AccumT          accum,
+                                            MonoidT         op,
+                                            AMatrixT const &A)
+        {
+            // =================================================================
+            // Do the basic reduction work with the monoid
+            typedef typename MonoidT::result_type D3ScalarType;
+            typedef typename AMatrixT::RowType ARowType;
+
+            D3ScalarType t = op.identity();
+
+            if (A.nvals() > 0)
+            {
+                prime_row_access(A);
+
+                // One partial result per thread over a contiguous block of
+                // rows, combined in row order.  (Each is wrapped in a tuple
+                // so that bool results are not packed into a vector<bool>.)
+                RowSet    rows(stored_rows(A));
+                IndexType num_rows(rows.size());
+                std::vector<std::tuple<D3ScalarType> > partials(
+                    omp_num_threads(), std::make_tuple(op.identity()));
+
+                #pragma omp parallel
+                {
+                    D3ScalarType partial(op.identity());
+
+                    #pragma omp for schedule(static)
+                    for (IndexType ix = 0; ix < num_rows; ++ix)
+                    {
+                        ARowType A_row(A.getRow(rows[ix]));
+
+                        D3ScalarType tmp;
+                        if (reduction(tmp, A_row, op))
+                        {
+                            partial = op(partial, tmp); // reduce each row
+                        }
+                    }
+
+                    std::get<0>(partials[omp_thread_index()]) = partial;
+                }
+
+                for (auto&& partial : partials)
+                {
+                    t = op(t, std::get<0>(partial));
+                }
+            }
+
+            // =================================================================
+            // Accumulate into Z
+            /// @todo Do we need a type generator for z: D(w) if no accum,
+            /// or D3(accum). I think that D(z) := D(val) should be equivalent, but
+            /// still need to work the proof.
+            ValueT z;
+            opt_accum_scalar(z, val, t, accum);
+
+            // Copy Z into the final output
+            val = z;
+        }
+
+    } // backend
+} // GraphBLAS
+
+#endif
@@ -0,0 +1,227 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Implementation of the sparse matrix apply function.
+ */
+
+#ifndef GB_OMP_SPARSE_TRANSPOSE_HPP
+#define GB_OMP_SPARSE_TRANSPOSE_HPP
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <iostream>
+#include <algorithm>
+#include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
+#include <graphblas/algebra.hpp>
+#include <graphblas/detail/trace.hpp>
+
+#include "parallel_helpers.hpp"
+#include <graphblas/platforms/sequential/LilSparseMatrix.hpp>
+
+//******************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //**********************************************************************
+        /// Fill T (empty) with the transpose of A by a counting sort with
+        /// the stored rows of A split into contiguous blocks, one per thread.
+        /// Each block counts its entries in every column of A, and a prefix
+        /// sum of the counts over the blocks gives each block its offset
+        /// within every row of T.  The blocks are then scattered at the
+        /// same time, and every row of T is still sorted.
+        ///
+        /// The counts take ncols words per block, so there are no more
+        /// blocks than needed to keep them within about twice the number
+        /// of entries; a very sparse A uses the sequential counting sort.
+        template<typename TScalarT,
+                 typename AMatrixT>
+        inline void parallel_transpose_into(LilSparseMatrix<TScalarT> &T,
+                                            AMatrixT            const &A)
+        {
+            typedef std::vector<std::tuple<IndexType, TScalarT> > TRowType;
+
+            IndexType ncols(A.ncols());
+            IndexType num_blocks(std::min<IndexType>(
+                omp_num_threads(),
+                2 * A.nvals() / std::max<IndexType>(ncols, 1)));
+            if (num_blocks < 2)
+            {
+                GRB_TRACE_KERNEL("transpose_counting_sort");
+                transpose_into(T, A);
+                return;
+            }
+
+            GRB_TRACE_KERNEL("transpose_counting_sort_parallel");
+
+            prime_row_access(A);
+
+            RowSet    row_set(stored_rows(A));
+            IndexType num_rows(row_set.size());
+            std::vector<std::vector<IndexType> > offsets(num_blocks);
+
+            // Count the entries of each block by column
+            #pragma omp parallel for schedule(static, 1)
+            for (IndexType block = 0; block < num_blocks; ++block)
+            {
+                std::vector<IndexType> &counts(offsets[block]);
+                counts.assign(ncols, 0);
+
+                IndexType last((block + 1) * num_rows / num_blocks);
+                for (IndexType ix = block * num_rows / num_blocks;
+                     ix < last; ++ix)
+                {
+                    for (auto&& elt : A.getRow(row_set[ix]))
+                    {
+                        ++counts[std::get<0>(elt)];
+                    }
+                }
+            }
+
+            // Turn the counts into offsets within each row of T
+            std::vector<TRowType> rows(ncols);
+
+            #pragma omp parallel for schedule(dynamic, GB_OMP_ROW_CHUNK)
+            for (IndexType col_idx = 0; col_idx < ncols; ++col_idx)
+            {
+                IndexType total(0);
+                for (IndexType block = 0; block < num_blocks; ++block)
+                {
+                    IndexType count(offsets[block][col_idx]);
+                    offsets[block][col_idx] = total;
+                    total += count;
+                }
+                rows[col_idx].resize(total);
+            }
+
+            // Scatter each block into its part of the rows of T
+            #pragma omp parallel for schedule(static, 1)
+            for (IndexType block = 0; block < num_blocks; ++block)
+            {
+                std::vector<IndexType> &next(offsets[block]);
+
+                IndexType last((block + 1) * num_rows / num_blocks);
+                for (IndexType ix = block * num_rows / num_blocks;
+                     ix < last; ++ix)
+                {
+                    IndexType row_idx(row_set[ix]);
+                    for (auto&& elt : A.getRow(row_idx))
+                    {
+                        IndexType col_idx(std::get<0>(elt));
+                        rows[col_idx][next[col_idx]++] =
+                            std::make_tuple(row_idx,
+                                            static_cast<TScalarT>(
+                                                std::get<1>(elt)));
+                    }
+                }
+            }
+
+            for (IndexType col_idx = 0; col_idx < ncols; ++col_idx)
+            {
+                if (!rows[col_idx].empty())
+                {
+                    T.setRow(col_idx, std::move(rows[col_idx]));
+                }
+            }
+        }
+
+        /// The transpose of a TransposeView is a copy of the rows of the
+        /// underlying matrix.
+        template<typename TScalarT,
+                 typename MatrixT>
+        inline void parallel_transpose_into(LilSparseMatrix<TScalarT>      &T,
+                                            TransposeView<MatrixT>   const &A)
+        {
+            GRB_TRACE_KERNEL("transpose_counting_sort");
+            transpose_into(T, A);
+        }
+
+        /// Hypersparse: build from the swapped tuples of A.
+        template<typename TScalarT,
+                 typename AMatrixT>
+        inline void parallel_transpose_into(HypersparseMatrix<TScalarT> &T,
+                                            AMatrixT              const &A)
+        {
+            GRB_TRACE_KERNEL("transpose_build");
+            transpose_into(T, A);
+        }
+
+        //**********************************************************************
+        // Implementation of 4.3.10 Matrix transpose
+        template<typename CMatrixT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename AMatrixT>
+        inline void transpose(CMatrixT       &C,
+                              MaskT    const &mask,
+                              AccumT          accum,
+                              AMatrixT const &A,
+                              bool            replace_flag = false)
+        {
+            typedef typename AMatrixT::ScalarType                   AScalarType;
+            typedef std::vector<std::tuple<IndexType,AScalarType> > ARowType;
+
+            typedef typename CMatrixT::ScalarType                   CScalarType;
+            typedef std::vector<std::tuple<IndexType,CScalarType> > CRowType;
+
+            IndexType nrows(A.nrows());
+            IndexType ncols(A.ncols());
+
+            // =================================================================
+            // Transpose A into T: a counting sort by column with the rows of
+            // A split between the threads, or a build when C is hypersparse.
+            typename scratch_matrix<CMatrixT, AScalarType>::type T(ncols, nrows);
+            parallel_transpose_into(T, A);
+
+            GRB_LOG_VERBOSE("T: " << T);
+
+            // =================================================================
+            // Accumulate T via C and write the result through the mask,
+            // without forming Z
+            typedef typename std::conditional<
+                std::is_same<AccumT, NoAccumulate>::value,
+                AScalarType,
+                typename AccumT::result_type>::type  ZScalarType;
+
+            parallel_write_with_opt_accum_mask<ZScalarType>(C, T, mask, accum,
+                                                            replace_flag);
+        }
+    }
+}
+
+
+
+#endif //GB_OMP_SPARSE_TRANSPOSE_HPP
@@ -0,0 +1,234 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Implementations of sparse vxm for the OpenMP (multicore CPU) backend.
+ */
+
+#ifndef GB_OMP_SPARSE_VXM_HPP
+#define GB_OMP_SPARSE_VXM_HPP
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <iostream>
+#include <algorithm>
+#include <type_traits>
+#include <graphblas/algebra.hpp>
+#include <graphblas/detail/trace.hpp>
+
+#include "parallel_helpers.hpp"
+
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //********************************************************************
+        /// Pull: one dot product of u with each column of A that passes the
+        /// mask, computed in parallel over the columns.
+        template<typename D3ScalarT,
+                 typename MaskT,
+                 typename SemiringT,
+                 typename UContentsT,
+                 typename AMatrixT>
+        inline void vxm_pull(
+            std::vector<std::tuple<IndexType, D3ScalarT> >       &t,
+            MaskT                                          const &mask,
+            SemiringT                                             op,
+            UContentsT                                     const &u_contents,
+            AMatrixT                                       const &A)
+        {
+            GRB_TRACE_KERNEL("vxm_pull");
+
+            typedef typename AMatrixT::ColType AColType;
+            typedef std::vector<std::tuple<IndexType, D3ScalarT> >  TVectorType;
+
+            ScratchFlags mask_flags(A.ncols());
+            mask_flags_1D(mask_flags, mask);
+
+            prime_col_access(A);
+
+            parallel_append(t, A.ncols(), [&](TVectorType &t_part,
+                                              IndexType    col_idx)
+            {
+                if (!mask_flags[col_idx])
+                {
+                    return;
+                }
+
+                AColType const &A_col(A.getCol(col_idx));
+
+                if (!A_col.empty())
+                {
+                    D3ScalarT t_val;
+                    if (dot(t_val, u_contents, A_col, op))
+                    {
+                        t_part.push_back(std::make_tuple(col_idx, t_val));
+                    }
+                }
+            });
+        }
+
+        //********************************************************************
+        /// Push: scatter each stored value of u times the corresponding row
+        /// of A into a sparse accumulator.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename UContentsT,
+                 typename AMatrixT>
+        inline void vxm_push(
+            std::vector<std::tuple<IndexType, D3ScalarT> >       &t,
+            SemiringT                                             op,
+            UContentsT                                     const &u_contents,
+            AMatrixT                                       const &A_in)
+        {
+            GRB_TRACE_KERNEL("vxm_push");
+
+            auto const &A(row_major(A_in));
+            typedef typename std::decay<decltype(A)>::type ARowMajorType;
+
+            SparseAccumulator<D3ScalarT> spa(A.ncols());
+
+            for (auto&& u_elt : u_contents)
+            {
+                typename ARowMajorType::RowType A_row(
+                    A.getRow(std::get<0>(u_elt)));
+
+                // An iso row has one product
+                typedef typename row_scalar_type<
+                    typename ARowMajorType::RowType>::type AIsoType;
+                AIsoType A_iso = AIsoType();
+                bool iso(iso_value(A_row, A_iso));
+                D3ScalarT iso_prod(op.zero());
+                if (iso)
+                {
+                    iso_prod = op.mult(std::get<1>(u_elt), A_iso);
+                }
+
+                for (auto&& A_elt : A_row)
+                {
+                    IndexType idx(std::get<0>(A_elt));
+                    D3ScalarT prod(iso ? iso_prod
+                                       : op.mult(std::get<1>(u_elt),
+                                                 std::get<1>(A_elt)));
+                    spa.accumulate(idx, prod, op);
+                }
+            }
+
+            spa.gather(t);
+        }
+
+        //********************************************************************
+        /// Push does work proportional to the rows of A selected by u; pull
+        /// does a dot product (a lookup per stored value when u is held as a
+        /// bitmap, a merge with u otherwise) for every column that passes
+        /// the mask.  Pick the direction with the smaller estimate (e.g.,
+        /// push for the small frontiers early and late in a BFS, pull for
+        /// the large ones).
+        template<typename MaskT,
+                 typename AMatrixT,
+                 typename UContentsT>
+        inline bool vxm_use_push(MaskT      const &mask,
+                                 UContentsT const &u_contents,
+                                 AMatrixT   const &A)
+        {
+            double nvals_A((double)A.nvals());
+            double push_ops((double)u_contents.size() * nvals_A /
+                            (double)std::max<IndexType>(A.nrows(), 1));
+            if (row_access_cost(A) > 0.)
+            {
+                push_ops += nvals_A;   // row major copy
+            }
+
+            double pull_ops((double)mask_nvals_1D(mask, A.ncols()) *
+                            (nvals_A / (double)std::max<IndexType>(A.ncols(), 1) +
+                             col_access_cost(A) + lookup_cost(u_contents)));
+
+            return (push_ops < pull_ops);
+        }
+
+        //********************************************************************
+        /// Implementation of 4.3.2 vxm: Vector-Matrix multiply
+        template<typename WVectorT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UVectorT>
+        inline void vxm(WVectorT        &w,
+                        MaskT     const &mask,
+                        AccumT           accum,
+                        SemiringT        op,
+                        UVectorT  const &u,
+                        AMatrixT  const &A,
+                        bool             replace_flag = false)
+        {
+            // =================================================================
+            // Do the basic multiply work with the semi-ring.
+            typedef typename SemiringT::result_type D3ScalarType;
+
+            ScratchVector<std::tuple<IndexType, D3ScalarType> > t;
+
+            if ((A.nvals() > 0) && (u.nvals() > 0))
+            {
+                auto u_contents(u.getContents());
+                if (vxm_use_push(mask, u_contents, A))
+                {
+                    vxm_push(*t, op, u_contents, A);
+                }
+                else
+                {
+                    vxm_pull(*t, mask, op, u_contents, A);
+                }
+            }
+
+            // =================================================================
+            // Accumulate into Z
+            /// @todo Do we need a type generator for z: D(w) if no accum,
+            /// or D3(accum). I think that output type should be equivalent, but
+            /// still need to work the proof.
+            typedef typename WVectorT::ScalarType WScalarType;
+            ScratchVector<std::tuple<IndexType, WScalarType> > z;
+            ewise_or_opt_accum_1D(*z, w, *t, accum);
+
+            // =================================================================
+            // Copy Z into the final output, w, considering mask and replace
+            write_with_opt_mask_1D(w, *z, mask, replace_flag);
+        }
+
+    } // backend
+} // GraphBLAS
+
+#endif
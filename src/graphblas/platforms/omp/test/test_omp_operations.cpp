@@ -0,0 +1,196 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#include <iostream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE omp_operations_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    static std::vector<int> const THREAD_COUNTS = {1, 2, 3, 8};
+
+    void set_threads(int num_threads)
+    {
+#ifdef _OPENMP
+        omp_set_num_threads(num_threads);
+#endif
+    }
+
+    /// Pseudo random matrix with roughly the given number of values per row
+    /// (more rows than one chunk of the parallel loops).
+    template <typename MatrixT>
+    void fill_matrix(MatrixT &A, IndexType vals_per_row, unsigned int seed)
+    {
+        IndexArrayType i, j;
+        std::vector<typename MatrixT::ScalarType> v;
+        unsigned int state(seed);
+        for (IndexType row = 0; row < A.nrows(); ++row)
+        {
+            for (IndexType k = 0; k < vals_per_row; ++k)
+            {
+                state = state * 1103515245u + 12345u;
+                i.push_back(row);
+                j.push_back((state >> 8) % A.ncols());
+                v.push_back((state >> 4) % 7 + 1);
+            }
+        }
+        A.build(i, j, v, Second<typename MatrixT::ScalarType>());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(omp_test_mxm_thread_counts)
+{
+    Matrix<double> A(300, 200), B(200, 250), M(300, 250), MT(250, 300);
+    fill_matrix(A, 3, 1);
+    fill_matrix(B, 4, 2);
+    fill_matrix(M, 20, 3);
+    fill_matrix(MT, 20, 4);
+
+    set_threads(1);
+    Matrix<double> C1(300, 250), CM1(300, 250), CT1(250, 300);
+    mxm(C1, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, B);
+    mxm(CM1, M, Plus<double>(), ArithmeticSemiring<double>(), A, B);
+    mxm(CT1, complement(MT), NoAccumulate(),
+        ArithmeticSemiring<double>(), transpose(B), transpose(A));
+
+    for (int num_threads : THREAD_COUNTS)
+    {
+        set_threads(num_threads);
+        Matrix<double> C(300, 250), CM(300, 250), CT(250, 300);
+        mxm(C, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, B);
+        mxm(CM, M, Plus<double>(), ArithmeticSemiring<double>(), A, B);
+        mxm(CT, complement(MT), NoAccumulate(),
+            ArithmeticSemiring<double>(), transpose(B), transpose(A));
+        BOOST_CHECK_EQUAL(C, C1);
+        BOOST_CHECK_EQUAL(CM, CM1);
+        BOOST_CHECK_EQUAL(CT, CT1);
+    }
+    set_threads(1);
+    BOOST_CHECK(C1.nvals() > 0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(omp_test_mxv_vxm_reduce_thread_counts)
+{
+    Matrix<double> A(300, 300);
+    fill_matrix(A, 5, 4);
+
+    Vector<double> u(300);
+    for (IndexType idx = 0; idx < 300; idx += 3)
+    {
+        u.setElement(idx, idx % 5 + 1);
+    }
+    Vector<bool> mask(300);
+    mask.setElement(7, true);
+    mask.setElement(150, true);
+
+    set_threads(1);
+    Vector<double> w1(300), wt1(300), wm1(300), r1(300);
+    double s1(0.);
+    vxm(w1, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), u, A);
+    vxm(wt1, mask, NoAccumulate(), ArithmeticSemiring<double>(),
+        u, transpose(A));
+    mxv(wm1, mask, NoAccumulate(), ArithmeticSemiring<double>(), A, u);
+    reduce(r1, NoMask(), NoAccumulate(), Plus<double>(), A);
+    reduce(s1, NoAccumulate(), PlusMonoid<double>(), A);
+
+    for (int num_threads : THREAD_COUNTS)
+    {
+        set_threads(num_threads);
+        Vector<double> w(300), wt(300), wm(300), r(300);
+        double s(0.);
+        vxm(w, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), u, A);
+        vxm(wt, mask, NoAccumulate(), ArithmeticSemiring<double>(),
+            u, transpose(A));
+        mxv(wm, mask, NoAccumulate(), ArithmeticSemiring<double>(), A, u);
+        reduce(r, NoMask(), NoAccumulate(), Plus<double>(), A);
+        reduce(s, NoAccumulate(), PlusMonoid<double>(), A);
+        BOOST_CHECK_EQUAL(w, w1);
+        BOOST_CHECK_EQUAL(wt, wt1);
+        BOOST_CHECK_EQUAL(wm, wm1);
+        BOOST_CHECK_EQUAL(r, r1);
+        BOOST_CHECK_EQUAL(s, s1);
+    }
+    set_threads(1);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(omp_test_ewise_apply_extract_assign_thread_counts)
+{
+    Matrix<double, CsrStorageTag> A(300, 200), B(300, 200);
+    fill_matrix(A, 4, 5);
+    fill_matrix(B, 4, 6);
+
+    IndexArrayType rows, cols;
+    for (IndexType idx = 0; idx < 150; ++idx)
+    {
+        rows.push_back(299 - 2*idx);
+        cols.push_back(idx % 100);
+    }
+
+    set_threads(1);
+    Matrix<double, CsrStorageTag> C1(300, 200), D1(300, 200), E1(150, 150);
+    eWiseAdd(C1, NoMask(), NoAccumulate(), Plus<double>(), A, B);
+    eWiseMult(C1, A, Plus<double>(), Times<double>(), A, B);
+    apply(D1, B, NoAccumulate(), AdditiveInverse<double>(), C1);
+    extract(E1, NoMask(), NoAccumulate(), A, rows, cols);
+    assign(D1, NoMask(), Plus<double>(), E1, rows, cols);
+
+    for (int num_threads : THREAD_COUNTS)
+    {
+        set_threads(num_threads);
+        Matrix<double, CsrStorageTag> C(300, 200), D(300, 200), E(150, 150);
+        eWiseAdd(C, NoMask(), NoAccumulate(), Plus<double>(), A, B);
+        eWiseMult(C, A, Plus<double>(), Times<double>(), A, B);
+        apply(D, B, NoAccumulate(), AdditiveInverse<double>(), C);
+        extract(E, NoMask(), NoAccumulate(), A, rows, cols);
+        assign(D, NoMask(), Plus<double>(), E, rows, cols);
+        BOOST_CHECK_EQUAL(C, C1);
+        BOOST_CHECK_EQUAL(D, D1);
+        BOOST_CHECK_EQUAL(E, E1);
+    }
+    set_threads(1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
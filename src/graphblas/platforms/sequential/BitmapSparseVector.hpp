@@ -33,6 +33,9 @@
 #include <iostream>
 #include <vector>
 #include <typeinfo>
+#include <utility>
+
+#include <graphblas/platforms/sequential/SparseView.hpp>
 
 namespace GraphBLAS
 {
@@ -180,6 +183,18 @@ namespace GraphBLAS
             {
             }
 
+            /**
+             * @brief Move constructor for BitmapSparseVector.
+             *
+             * @param[in] rhs  The BitmapSparseVector to take the contents of;
+             *                 it is left empty, with the same size.
+             */
+            BitmapSparseVector(BitmapSparseVector<ScalarT> &&rhs)
+                : BitmapSparseVector(rhs.m_size)
+            {
+                swap(rhs);
+            }
+
             ~BitmapSparseVector() {}
 
             /**
@@ -206,6 +221,41 @@ namespace GraphBLAS
                 return *this;
             }
 
+            /**
+             * @brief Move assignment; rhs is left empty.
+             *
+             * @param[in] rhs  The BitmapSparseVector to move into this
+             *
+             * @return *this.
+             */
+            BitmapSparseVector<ScalarT>& operator=(
+                BitmapSparseVector<ScalarT> &&rhs)
+            {
+                if (this != &rhs)
+                {
+                    if (m_size != rhs.m_size)
+                    {
+                        throw DimensionException();
+                    }
+
+                    swap(rhs);
+                    rhs.clear();
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Exchange the contents (and sizes) of two vectors in
+             *        constant time.
+             */
+            void swap(BitmapSparseVector<ScalarT> &rhs)
+            {
+                std::swap(m_size, rhs.m_size);
+                std::swap(m_nvals, rhs.m_nvals);
+                m_vals.swap(rhs.m_vals);
+                m_bitmap.swap(rhs.m_bitmap);
+            }
+
             /**
              * @brief Assignment from a dense vector.
              *
@@ -419,18 +469,10 @@ namespace GraphBLAS
             std::vector<bool> const &get_bitmap() const { return m_bitmap; }
             std::vector<ScalarT> const &get_vals() const { return m_vals; }
 
-            std::vector<std::tuple<IndexType,ScalarT> > getContents() const
+            typedef BitmapView<ScalarT> const ContentsType;
+            ContentsType getContents() const
             {
-                std::vector<std::tuple<IndexType,ScalarT> > contents;
-                contents.reserve(m_nvals);
-                for (IndexType idx = 0; idx < m_size; ++idx)
-                {
-                    if (m_bitmap[idx])
-                    {
-                        contents.push_back(std::make_tuple(idx, m_vals[idx]));
-                    }
-                }
-                return contents;
+                return ContentsType(m_bitmap, m_vals, m_nvals);
             }
 
             template <typename OtherScalarT>
@@ -447,7 +489,7 @@ namespace GraphBLAS
             }
 
         private:
-            IndexType const       m_size;   // immutable after construction
+            IndexType             m_size;   // only changed by swap()
             IndexType             m_nvals;
             std::vector<ScalarT>  m_vals;
             std::vector<bool>     m_bitmap;
@@ -31,11 +31,140 @@
 #define GB_SEQUENTIAL_NEW_COMPLEMENT_VIEW_HPP
 
 #include <graphblas/platforms/sequential/Matrix.hpp>
+#include <graphblas/platforms/sequential/SparseView.hpp>
 
 namespace GraphBLAS
 {
     namespace backend
     {
+        //************************************************************************
+        /**
+         * @brief The structural complement of a sparse row (or column, or
+         *        vector contents) of the given size: every index that has no
+         *        stored value, or a stored value that evaluates to false,
+         *        with the value true.
+         *
+         * @tparam RowT  The type returned by getRow()/getCol()/getContents()
+         *               of the complemented container (possibly a const
+         *               reference).
+         */
+        template<typename RowT>
+        class ComplementSparseView
+        {
+        private:
+            typedef typename std::decay<RowT>::type::const_iterator RowIterator;
+
+        public:
+            typedef std::tuple<IndexType, bool> value_type;
+
+            class const_iterator
+            {
+            public:
+                typedef std::forward_iterator_tag    iterator_category;
+                typedef std::tuple<IndexType, bool>  value_type;
+                typedef std::ptrdiff_t               difference_type;
+                typedef void                         pointer;
+                typedef value_type                   reference;
+
+                const_iterator(RowIterator row_it,
+                               RowIterator row_end,
+                               IndexType   idx,
+                               IndexType   size)
+                    : m_row_it(row_it), m_row_end(row_end),
+                      m_idx(idx), m_size(size)
+                {
+                    skip_stored();
+                }
+
+                value_type operator*() const
+                {
+                    return value_type(m_idx, true);
+                }
+
+                const_iterator &operator++()
+                {
+                    ++m_idx;
+                    skip_stored();
+                    return *this;
+                }
+
+                const_iterator operator++(int)
+                {
+                    const_iterator tmp(*this);
+                    ++(*this);
+                    return tmp;
+                }
+
+                bool operator==(const_iterator const &rhs) const
+                {
+                    return m_idx == rhs.m_idx;
+                }
+
+                bool operator!=(const_iterator const &rhs) const
+                {
+                    return m_idx != rhs.m_idx;
+                }
+
+            private:
+                // Advance to the next index without a stored true value.
+                void skip_stored()
+                {
+                    while (m_idx < m_size)
+                    {
+                        while ((m_row_it != m_row_end) &&
+                               (std::get<0>(*m_row_it) < m_idx))
+                        {
+                            ++m_row_it;
+                        }
+                        if ((m_row_it == m_row_end) ||
+                            (std::get<0>(*m_row_it) != m_idx) ||
+                            !static_cast<bool>(std::get<1>(*m_row_it)))
+                        {
+                            return;
+                        }
+                        ++m_idx;
+                    }
+                }
+
+                RowIterator m_row_it;
+                RowIterator m_row_end;
+                IndexType   m_idx;
+                IndexType   m_size;
+            };
+
+            typedef const_iterator iterator;
+
+            ComplementSparseView(RowT row, IndexType size)
+                : m_row(row), m_size(size), m_nvals(size)
+            {
+                for (auto&& elt : m_row)
+                {
+                    if (static_cast<bool>(std::get<1>(elt)))
+                    {
+                        --m_nvals;
+                    }
+                }
+            }
+
+            const_iterator begin() const
+            {
+                return const_iterator(m_row.begin(), m_row.end(), 0, m_size);
+            }
+
+            const_iterator end() const
+            {
+                return const_iterator(m_row.end(), m_row.end(), m_size, m_size);
+            }
+
+            IndexType size() const  { return m_nvals; }
+            bool      empty() const { return m_nvals == 0; }
+
+        private:
+            RowT      m_row;
+            IndexType m_size;
+            IndexType m_nvals;
+        };
+
         //************************************************************************
         /**
          * @brief View a matrix as if it were structurally complemented; that is,
@@ -78,6 +207,9 @@ namespace GraphBLAS
             {
             }
 
+            /// The matrix whose structure is complemented.
+            MatrixT const &getMatrix() const { return m_matrix; }
+
             IndexType nrows() const { return m_matrix.nrows(); }
             IndexType ncols() const { return m_matrix.ncols(); }
             IndexType nvals() const
@@ -91,7 +223,7 @@ namespace GraphBLAS
                 for (IndexType ix = 0; ix < nrows(); ++ix)
                 {
                     auto row = getRow(ix);
-                    for (auto &ix : row)
+                    for (auto &&ix : row)
                     {
                         if (false == static_cast<bool>(std::get<1>(ix)))
                         {
@@ -204,57 +336,16 @@ namespace GraphBLAS
                 throw GraphBLAS::NoValueException();
             }
 
-            std::vector<std::tuple<IndexType, bool> > getRow(
-                IndexType row) const
+            typedef ComplementSparseView<typename MatrixT::RowType> const RowType;
+            RowType getRow(IndexType row) const
             {
-                std::vector<std::tuple<IndexType, InternalScalarType> > row_tuples =
-                    m_matrix.getRow(row);
-                std::vector<std::tuple<IndexType, bool> > mask_tuples;
-                auto it = row_tuples.begin();
-                for (IndexType ix = 0; ix < ncols(); ++ix)
-                {
-                    if ((it == row_tuples.end()) || (ix < std::get<0>(*it)))
-                    {
-                        mask_tuples.push_back(std::make_tuple(ix, true));
-                    }
-                    else
-                    {
-                        if (static_cast<bool>(std::get<1>(*it)) == false)
-                        {
-                            mask_tuples.push_back(std::make_tuple(ix, true));
-                        }
-                        ++it;
-                    }
-                }
-
-                return mask_tuples;
-
+                return RowType(m_matrix.getRow(row), ncols());
             }
 
-            std::vector<std::tuple<IndexType, bool> > getCol(
-                IndexType col) const
+            typedef ComplementSparseView<typename MatrixT::ColType> const ColType;
+            ColType getCol(IndexType col) const
             {
-                std::vector<std::tuple<IndexType, InternalScalarType> > col_tuples =
-                    m_matrix.getCol(col);
-                std::vector<std::tuple<IndexType, bool> > mask_tuples;
-                auto it = col_tuples.begin();
-                for (IndexType ix = 0; ix < nrows(); ++ix)
-                {
-                    if ((it == col_tuples.end()) || (ix < std::get<0>(*it)))
-                    {
-                        mask_tuples.push_back(std::make_tuple(ix, true));
-                    }
-                    else
-                    {
-                        if (static_cast<bool>(std::get<1>(*it)) == false)
-                        {
-                            mask_tuples.push_back(std::make_tuple(ix, true));
-                        }
-                        ++it;
-                    }
-                }
-
-                return mask_tuples;
+                return ColType(m_matrix.getCol(col), nrows());
             }
 
             // Get column indices for a given row
@@ -369,22 +460,14 @@ namespace GraphBLAS
             {
             }
 
+            /// The vector whose structure is complemented.
+            VectorT const &getVector() const { return m_vector; }
+
             IndexType size() const  { return m_vector.size(); }
             IndexType nvals() const
             {
-                // THIS IS COSTLY
-                IndexType num_vals(0);
-                auto bitmap(m_vector.get_bitmap());
-                auto vals(m_vector.get_vals());
-
-                for (IndexType idx = 0; idx < size(); ++idx)
-                {
-                    if (!bitmap[idx] || !vals[idx])
-                    {
-                        ++num_vals;
-                    }
-                }
-                return num_vals;
+                // Every index except the stored true values
+                return getContents().size();
             }
 
             /**
@@ -462,21 +545,11 @@ namespace GraphBLAS
                 throw GraphBLAS::NoValueException();
             }
 
-            std::vector<std::tuple<IndexType, bool> > getContents() const
+            typedef ComplementSparseView<typename VectorT::ContentsType> const
+                ContentsType;
+            ContentsType getContents() const
             {
-                auto bitmap(m_vector.get_bitmap());
-                auto vals(m_vector.get_vals());
-
-                std::vector<std::tuple<IndexType, bool> > contents;
-                //contents.reserve(nvals());
-                for (IndexType idx = 0; idx < size(); ++idx)
-                {
-                    if (!bitmap[idx] || !vals[idx])
-                    {
-                        contents.push_back(std::make_tuple(idx, true));
-                    }
-                }
-                return contents;
+                return ContentsType(m_vector.getContents(), size());
             }
 
             void printInfo(std::ostream &os) const
@@ -0,0 +1,297 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_SEQUENTIAL_CSRCSCSPARSEMATRIX_HPP
+#define GB_SEQUENTIAL_CSRCSCSPARSEMATRIX_HPP
+
+#include <iostream>
+#include <vector>
+#include <tuple>
+#include <utility>
+
+#include <graphblas/graphblas.hpp>
+#include <graphblas/platforms/sequential/CsrSparseMatrix.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /**
+         * @brief CSR storage plus a compressed sparse column (CSC) copy
+         *        that is built on the first column access after a
+         *        modification.
+         *
+         * getCol() and getRowIndices() read from the CSC copy and cost
+         * O(column length) instead of a scan of every row.  Every method
+         * that modifies the matrix invalidates the copy; it is rebuilt with
+         * a single counting sort pass over the rows (O(nvals + ncols)).
+         *
+         * @note The CSC copy is built inside const methods and is not
+         *       thread safe.
+         */
+        template<typename ScalarT, typename... TagsT>
+        class CsrCscSparseMatrix : public CsrSparseMatrix<ScalarT>
+        {
+        private:
+            typedef CsrSparseMatrix<ScalarT> ParentMatrixType;
+
+        public:
+            typedef ScalarT ScalarType;
+
+            // Constructor
+            CsrCscSparseMatrix(IndexType num_rows,
+                               IndexType num_cols)
+                : ParentMatrixType(num_rows, num_cols),
+                  m_csc_valid(false)
+            {
+            }
+
+            // Constructor - copy
+            CsrCscSparseMatrix(CsrCscSparseMatrix<ScalarT> const &rhs)
+                : ParentMatrixType(rhs),
+                  m_csc_valid(rhs.m_csc_valid),
+                  m_col_ptr(rhs.m_col_ptr),
+                  m_row_idx(rhs.m_row_idx),
+                  m_col_vals(rhs.m_col_vals)
+            {
+            }
+
+            // Constructor - move (rhs is left empty, with the same dimensions)
+            CsrCscSparseMatrix(CsrCscSparseMatrix<ScalarT> &&rhs)
+                : CsrCscSparseMatrix(rhs.nrows(), rhs.ncols())
+            {
+                swap(rhs);
+            }
+
+            // Constructor - dense from dense matrix
+            CsrCscSparseMatrix(std::vector<std::vector<ScalarT>> const &val)
+                : ParentMatrixType(val),
+                  m_csc_valid(false)
+            {
+            }
+
+            // Constructor - sparse from dense matrix, removing specifed implied zeros
+            CsrCscSparseMatrix(std::vector<std::vector<ScalarT>> const &val,
+                               ScalarT zero)
+                : ParentMatrixType(val, zero),
+                  m_csc_valid(false)
+            {
+            }
+
+            // Destructor
+            ~CsrCscSparseMatrix()
+            {}
+
+            // Assignment (currently restricted to same dimensions)
+            CsrCscSparseMatrix<ScalarT> &operator=(
+                CsrCscSparseMatrix<ScalarT> const &rhs)
+            {
+                if (this != &rhs)
+                {
+                    ParentMatrixType::operator=(rhs);
+                    m_csc_valid = rhs.m_csc_valid;
+                    m_col_ptr = rhs.m_col_ptr;
+                    m_row_idx = rhs.m_row_idx;
+                    m_col_vals = rhs.m_col_vals;
+                }
+                return *this;
+            }
+
+            // Move assignment (currently restricted to same dimensions),
+            // rhs is left empty
+            CsrCscSparseMatrix<ScalarT> &operator=(
+                CsrCscSparseMatrix<ScalarT> &&rhs)
+            {
+                if (this != &rhs)
+                {
+                    if ((this->m_num_rows != rhs.m_num_rows) ||
+                        (this->m_num_cols != rhs.m_num_cols))
+                    {
+                        throw DimensionException();
+                    }
+
+                    swap(rhs);
+                    rhs.clear();
+                }
+                return *this;
+            }
+
+            // Exchange contents (and dimensions) with rhs in constant time
+            void swap(CsrCscSparseMatrix<ScalarT> &rhs)
+            {
+                ParentMatrixType::swap(rhs);
+                std::swap(m_csc_valid, rhs.m_csc_valid);
+                m_col_ptr.swap(rhs.m_col_ptr);
+                m_row_idx.swap(rhs.m_row_idx);
+                m_col_vals.swap(rhs.m_col_vals);
+            }
+
+            template<typename RAIteratorI,
+                     typename RAIteratorJ,
+                     typename RAIteratorV,
+                     typename DupT>
+            void build(RAIteratorI  i_it,
+                       RAIteratorJ  j_it,
+                       RAIteratorV  v_it,
+                       IndexType    n,
+                       DupT         dup)
+            {
+                m_csc_valid = false;
+                ParentMatrixType::build(i_it, j_it, v_it, n, dup);
+            }
+
+            void clear()
+            {
+                m_csc_valid = false;
+                ParentMatrixType::clear();
+            }
+
+            void setElement(IndexType irow, IndexType icol, ScalarT const &val)
+            {
+                m_csc_valid = false;
+                ParentMatrixType::setElement(irow, icol, val);
+            }
+
+            template <typename BinaryOpT>
+            void setElement(IndexType irow, IndexType icol, ScalarT const &val,
+                            BinaryOpT merge)
+            {
+                m_csc_valid = false;
+                ParentMatrixType::setElement(irow, icol, val, merge);
+            }
+
+            template <typename RowT>
+            void setRow(
+                IndexType row_index,
+                RowT const &row_data)
+            {
+                m_csc_valid = false;
+                ParentMatrixType::setRow(row_index, row_data);
+            }
+
+            typedef SparseView<ScalarT> const ColType;
+            ColType getCol(IndexType col_index) const
+            {
+                build_csc();
+
+                IndexType first(m_col_ptr[col_index]);
+                IndexType last(m_col_ptr[col_index + 1]);
+
+                return ColType(m_row_idx.data() + first,
+                               value_iterator<ScalarT>::begin(m_col_vals) + first,
+                               last - first);
+            }
+
+            template <typename ColT>
+            void setCol(
+                IndexType col_index,
+                ColT const &col_data)
+            {
+                m_csc_valid = false;
+                ParentMatrixType::setCol(col_index, col_data);
+            }
+
+            // Get row indices for a given column
+            void getRowIndices(IndexType icol, IndexArrayType &v) const
+            {
+                if (icol >= this->ncols())
+                {
+                    throw IndexOutOfBoundsException(
+                        "getRowIndices: index out of bounds");
+                }
+
+                build_csc();
+                v.assign(m_row_idx.begin() + m_col_ptr[icol],
+                         m_row_idx.begin() + m_col_ptr[icol + 1]);
+            }
+
+            friend std::ostream &operator<<(std::ostream                      &os,
+                                            CsrCscSparseMatrix<ScalarT> const &mat)
+            {
+                mat.printInfo(os);
+                return os;
+            }
+
+        private:
+            // Counting sort of the CSR elements by column.  Walking the rows
+            // in order leaves the row indices of each column sorted.
+            void build_csc() const
+            {
+                if (m_csc_valid)
+                {
+                    return;
+                }
+
+                IndexType num_cols(this->m_num_cols);
+                IndexType num_vals(this->nvals());
+
+                m_col_ptr.assign(num_cols + 1, 0);
+                m_row_idx.resize(num_vals);
+                m_col_vals.resize(num_vals);
+
+                for (IndexType ix = 0; ix < num_vals; ++ix)
+                {
+                    ++m_col_ptr[this->m_col_idx[ix] + 1];
+                }
+                for (IndexType col = 0; col < num_cols; ++col)
+                {
+                    m_col_ptr[col + 1] += m_col_ptr[col];
+                }
+
+                std::vector<IndexType> next(m_col_ptr.begin(), m_col_ptr.end() - 1);
+                for (IndexType row = 0; row < this->m_fill_row; ++row)
+                {
+                    for (IndexType ix = this->m_row_ptr[row];
+                         ix < this->m_row_ptr[row + 1];
+                         ++ix)
+                    {
+                        IndexType dst(next[this->m_col_idx[ix]]++);
+                        m_row_idx[dst] = row;
+                        m_col_vals[dst] = this->m_vals[ix];
+                    }
+                }
+
+                m_csc_valid = true;
+            }
+
+        private:
+            // Compressed sparse column copy, rebuilt lazily
+            mutable bool                   m_csc_valid;
+            mutable std::vector<IndexType> m_col_ptr;
+            mutable std::vector<IndexType> m_row_idx;
+            mutable std::vector<ScalarT>   m_col_vals;
+        };
+
+    } // namespace backend
+
+} // namespace GraphBLAS
+
+#endif // GB_SEQUENTIAL_CSRCSCSPARSEMATRIX_HPP
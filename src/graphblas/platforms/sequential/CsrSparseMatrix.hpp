@@ -0,0 +1,693 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_SEQUENTIAL_CSRSPARSEMATRIX_HPP
+#define GB_SEQUENTIAL_CSRSPARSEMATRIX_HPP
+
+#include <iostream>
+#include <vector>
+#include <tuple>
+#include <algorithm>
+#include <typeinfo>
+#include <stdexcept>
+#include <utility>
+
+#include <graphblas/graphblas.hpp>
+#include <graphblas/platforms/sequential/build_helpers.hpp>
+#include <graphblas/platforms/sequential/SparseView.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /**
+         * @brief Compressed sparse row (CSR) storage: one contiguous array
+         *        of row offsets, and contiguous arrays of column indices and
+         *        values for all stored elements.
+         *
+         * Rows are filled lazily from the top: all rows at or after
+         * m_fill_row are empty and their offsets in m_row_ptr are not
+         * maintained.  This makes clear() O(1) and makes rewriting the
+         * matrix one row at a time in increasing row order (which is what
+         * the operations do when they copy a result into their output)
+         * O(nrows + nvals) instead of O(nrows * nvals).
+         *
+         * Updates to rows before m_fill_row must shift the trailing storage,
+         * so random setElement/setRow calls are more expensive than they are
+         * for LilSparseMatrix.
+         */
+        template<typename ScalarT, typename... TagsT>
+        class CsrSparseMatrix
+        {
+        public:
+            typedef ScalarT ScalarType;
+
+            // Constructor
+            CsrSparseMatrix(IndexType num_rows,
+                            IndexType num_cols)
+                : m_num_rows(num_rows),
+                  m_num_cols(num_cols),
+                  m_fill_row(0),
+                  m_row_ptr(num_rows + 1, 0)
+            {
+            }
+
+            // Constructor - copy
+            CsrSparseMatrix(CsrSparseMatrix<ScalarT> const &rhs)
+                : m_num_rows(rhs.m_num_rows),
+                  m_num_cols(rhs.m_num_cols),
+                  m_fill_row(rhs.m_fill_row),
+                  m_row_ptr(rhs.m_row_ptr),
+                  m_col_idx(rhs.m_col_idx),
+                  m_vals(rhs.m_vals)
+            {
+            }
+
+            // Constructor - move (rhs is left empty, with the same dimensions)
+            CsrSparseMatrix(CsrSparseMatrix<ScalarT> &&rhs)
+                : CsrSparseMatrix(rhs.m_num_rows, rhs.m_num_cols)
+            {
+                swap(rhs);
+            }
+
+            // Constructor - dense from dense matrix
+            CsrSparseMatrix(std::vector<std::vector<ScalarT>> const &val)
+                : m_num_rows(val.size()),
+                  m_num_cols(val[0].size()),
+                  m_fill_row(val.size()),
+                  m_row_ptr(val.size() + 1, 0)
+            {
+                m_col_idx.reserve(m_num_rows*m_num_cols);
+                m_vals.reserve(m_num_rows*m_num_cols);
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    if (val[ii].size() != m_num_cols)
+                    {
+                        throw DimensionException("CsrSparseMatix(dense ctor)");
+                    }
+
+                    for (IndexType jj = 0; jj < m_num_cols; jj++)
+                    {
+                        m_col_idx.push_back(jj);
+                        m_vals.push_back(val[ii][jj]);
+                    }
+                    m_row_ptr[ii + 1] = m_col_idx.size();
+                }
+            }
+
+            // Constructor - sparse from dense matrix, removing specifed implied zeros
+            CsrSparseMatrix(std::vector<std::vector<ScalarT>> const &val,
+                            ScalarT zero)
+                : m_num_rows(val.size()),
+                  m_num_cols(val[0].size()),
+                  m_fill_row(val.size()),
+                  m_row_ptr(val.size() + 1, 0)
+            {
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    if (val[ii].size() != m_num_cols)
+                    {
+                        throw DimensionException("CsrSparseMatix(dense ctor)");
+                    }
+
+                    for (IndexType jj = 0; jj < m_num_cols; jj++)
+                    {
+                        if (val[ii][jj] != zero)
+                        {
+                            m_col_idx.push_back(jj);
+                            m_vals.push_back(val[ii][jj]);
+                        }
+                    }
+                    m_row_ptr[ii + 1] = m_col_idx.size();
+                }
+            }
+
+            // Destructor
+            ~CsrSparseMatrix()
+            {}
+
+            // Assignment (currently restricted to same dimensions)
+            CsrSparseMatrix<ScalarT> &operator=(CsrSparseMatrix<ScalarT> const &rhs)
+            {
+                if (this != &rhs)
+                {
+                    // push this check to frontend
+                    if ((m_num_rows != rhs.m_num_rows) ||
+                        (m_num_cols != rhs.m_num_cols))
+                    {
+                        throw DimensionException();
+                    }
+
+                    m_fill_row = rhs.m_fill_row;
+                    m_row_ptr = rhs.m_row_ptr;
+                    m_col_idx = rhs.m_col_idx;
+                    m_vals = rhs.m_vals;
+                }
+                return *this;
+            }
+
+            // Move assignment (currently restricted to same dimensions),
+            // rhs is left empty
+            CsrSparseMatrix<ScalarT> &operator=(CsrSparseMatrix<ScalarT> &&rhs)
+            {
+                if (this != &rhs)
+                {
+                    if ((m_num_rows != rhs.m_num_rows) ||
+                        (m_num_cols != rhs.m_num_cols))
+                    {
+                        throw DimensionException();
+                    }
+
+                    swap(rhs);
+                    rhs.clear();
+                }
+                return *this;
+            }
+
+            // Exchange contents (and dimensions) with rhs in constant time
+            void swap(CsrSparseMatrix<ScalarT> &rhs)
+            {
+                std::swap(m_num_rows, rhs.m_num_rows);
+                std::swap(m_num_cols, rhs.m_num_cols);
+                std::swap(m_fill_row, rhs.m_fill_row);
+                m_row_ptr.swap(rhs.m_row_ptr);
+                m_col_idx.swap(rhs.m_col_idx);
+                m_vals.swap(rhs.m_vals);
+            }
+
+            // EQUALITY OPERATORS
+            /**
+             * @brief Equality testing for CsrSparseMatrix.
+             * @param rhs The right hand side of the equality operation.
+             * @return If this CsrSparseMatrix and rhs are identical.
+             */
+            bool operator==(CsrSparseMatrix<ScalarT> const &rhs) const
+            {
+                if ((m_num_rows != rhs.m_num_rows) ||
+                    (m_num_cols != rhs.m_num_cols) ||
+                    (m_col_idx != rhs.m_col_idx) ||
+                    (m_vals != rhs.m_vals))
+                {
+                    return false;
+                }
+
+                // Offsets past the fill rows may be stale, compare row by row
+                for (IndexType row = 0; row < m_num_rows; ++row)
+                {
+                    if (row_end(row) != rhs.row_end(row))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            /**
+             * @brief Inequality testing for CsrSparseMatrix.
+             * @param rhs The right hand side of the inequality operation.
+             * @return If this CsrSparseMatrix and rhs are not identical.
+             */
+            bool operator!=(CsrSparseMatrix<ScalarT> const &rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+            /**
+             * Bulk build: sort the tuples by row and column and combine
+             * duplicates (and any values already stored) with dup, then
+             * fill the arrays in one pass.
+             */
+            template<typename RAIteratorI,
+                     typename RAIteratorJ,
+                     typename RAIteratorV,
+                     typename DupT>
+            void build(RAIteratorI  i_it,
+                       RAIteratorJ  j_it,
+                       RAIteratorV  v_it,
+                       IndexType    n,
+                       DupT         dup)
+            {
+                std::vector<std::tuple<IndexType, ScalarT> > entries;
+                sort_build_tuples(*this, i_it, j_it, v_it, n, dup,
+                                  m_row_ptr, entries);
+
+                m_col_idx.clear();
+                m_vals.clear();
+                m_col_idx.reserve(entries.size());
+                m_vals.reserve(entries.size());
+                for (auto&& entry : entries)
+                {
+                    m_col_idx.push_back(std::get<0>(entry));
+                    m_vals.push_back(std::get<1>(entry));
+                }
+                m_fill_row = m_num_rows;
+            }
+
+            void clear()
+            {
+                m_fill_row = 0;
+                m_row_ptr[0] = 0;
+                m_col_idx.clear();
+                m_vals.clear();
+            }
+
+            IndexType nrows() const { return m_num_rows; }
+            IndexType ncols() const { return m_num_cols; }
+            IndexType nvals() const { return m_col_idx.size(); }
+
+            bool hasElement(IndexType irow, IndexType icol) const
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "get_value_at: index out of bounds");
+                }
+
+                IndexType ix;
+                return find(irow, icol, ix);
+            }
+
+            // Get value at index
+            ScalarT extractElement(IndexType irow, IndexType icol) const
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "get_value_at: index out of bounds");
+                }
+
+                IndexType ix;
+                if (!find(irow, icol, ix))
+                {
+                    throw NoValueException("get_value_at: no entry at index");
+                }
+                return m_vals[ix];
+            }
+
+            // Set value at index
+            void setElement(IndexType irow, IndexType icol, ScalarT const &val)
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException("setElement: index out of bounds");
+                }
+
+                IndexType ix;
+                if (find(irow, icol, ix))
+                {
+                    m_vals[ix] = val;
+                }
+                else
+                {
+                    insert(irow, ix, icol, val);
+                }
+            }
+
+            // Set value at index + 'merge' with any existing value
+            // according to the BinaryOp passed.
+            template <typename BinaryOpT>
+            void setElement(IndexType irow, IndexType icol, ScalarT const &val,
+                            BinaryOpT merge)
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "setElement(merge): index out of bounds");
+                }
+
+                IndexType ix;
+                if (find(irow, icol, ix))
+                {
+                    m_vals[ix] = merge(m_vals[ix], val);
+                }
+                else
+                {
+                    insert(irow, ix, icol, val);
+                }
+            }
+
+            /// @note Rows are not stored as tuples, so they are assembled
+            ///       here from the contiguous index and value arrays.
+            typedef SparseView<ScalarT> const RowType;
+            RowType getRow(IndexType row_index) const
+            {
+                IndexType first(row_begin(row_index));
+                IndexType last(row_end(row_index));
+
+                return RowType(m_col_idx.data() + first,
+                               value_iterator<ScalarT>::begin(m_vals) + first,
+                               last - first);
+            }
+
+            // Allow casting
+            template <typename RowT>
+            void setRow(
+                IndexType row_index,
+                RowT const &row_data)
+            {
+                IndexType first(row_begin(row_index));
+                IndexType last(row_end(row_index));
+                IndexType old_nvals(last - first);
+                IndexType new_nvals(row_data.size());
+
+                if (row_index >= m_fill_row)
+                {
+                    // Appending past the filled rows: nothing to shift.
+                    if (row_data.empty())
+                    {
+                        return;
+                    }
+                    extend_fill(row_index);
+                }
+                else if (new_nvals > old_nvals)
+                {
+                    IndexType delta(new_nvals - old_nvals);
+                    m_col_idx.insert(m_col_idx.begin() + last, delta, 0);
+                    m_vals.insert(m_vals.begin() + last, delta, ScalarT());
+                    for (IndexType row = row_index + 1; row <= m_fill_row; ++row)
+                    {
+                        m_row_ptr[row] += delta;
+                    }
+                }
+                else if (new_nvals < old_nvals)
+                {
+                    IndexType delta(old_nvals - new_nvals);
+                    m_col_idx.erase(m_col_idx.begin() + first + new_nvals,
+                                    m_col_idx.begin() + last);
+                    m_vals.erase(m_vals.begin() + first + new_nvals,
+                                 m_vals.begin() + last);
+                    for (IndexType row = row_index + 1; row <= m_fill_row; ++row)
+                    {
+                        m_row_ptr[row] -= delta;
+                    }
+                }
+
+                IndexType ix(first);
+                if (row_index >= m_fill_row)
+                {
+                    m_col_idx.resize(first + new_nvals);
+                    m_vals.resize(first + new_nvals);
+                    m_row_ptr[row_index + 1] = m_col_idx.size();
+                    m_fill_row = row_index + 1;
+                }
+                for (auto&& tupl : row_data)
+                {
+                    m_col_idx[ix] = std::get<0>(tupl);
+                    m_vals[ix] = static_cast<ScalarT>(std::get<1>(tupl));
+                    ++ix;
+                }
+            }
+
+            /// @note Columns require a scan of every row (a binary search
+            ///       within each).
+            typedef std::vector<std::tuple<IndexType, ScalarT> > const ColType;
+            ColType getCol(IndexType col_index) const
+            {
+                std::vector<std::tuple<IndexType, ScalarT> > data;
+
+                for (IndexType ii = 0; ii < m_fill_row; ii++)
+                {
+                    IndexType ix;
+                    if (find(ii, col_index, ix))
+                    {
+                        data.push_back(std::make_tuple(ii, m_vals[ix]));
+                    }
+                }
+
+                return data;
+            }
+
+            // col_data must be in increasing index order.  The storage is
+            // rebuilt in a single pass.
+            template <typename ColT>
+            void setCol(
+                IndexType col_index,
+                ColT const &col_data)
+            {
+                std::vector<IndexType> row_ptr(m_num_rows + 1, 0);
+                std::vector<IndexType> col_idx;
+                std::vector<ScalarT>   vals;
+                col_idx.reserve(nvals() + col_data.size());
+                vals.reserve(nvals() + col_data.size());
+
+                auto it = col_data.begin();
+                for (IndexType row_index = 0; row_index < m_num_rows; row_index++)
+                {
+                    bool insert_here((it != col_data.end()) &&
+                                     (std::get<0>(*it) == row_index));
+                    if ((it != col_data.end()) && (std::get<0>(*it) < row_index))
+                    {
+                        // This should not happen
+                        throw GraphBLAS::PanicException(
+                            "CsrSparseMatrix::setCol() INTERNAL ERROR");
+                    }
+
+                    IndexType last(row_end(row_index));
+                    for (IndexType ix = row_begin(row_index); ix < last; ++ix)
+                    {
+                        if (insert_here && (m_col_idx[ix] >= col_index))
+                        {
+                            col_idx.push_back(col_index);
+                            vals.push_back(static_cast<ScalarT>(std::get<1>(*it)));
+                            insert_here = false;
+                            ++it;
+                        }
+                        if (m_col_idx[ix] != col_index)
+                        {
+                            col_idx.push_back(m_col_idx[ix]);
+                            vals.push_back(m_vals[ix]);
+                        }
+                    }
+                    if (insert_here)
+                    {
+                        col_idx.push_back(col_index);
+                        vals.push_back(static_cast<ScalarT>(std::get<1>(*it)));
+                        ++it;
+                    }
+                    row_ptr[row_index + 1] = col_idx.size();
+                }
+
+                m_row_ptr.swap(row_ptr);
+                m_col_idx.swap(col_idx);
+                m_vals.swap(vals);
+                m_fill_row = m_num_rows;
+            }
+
+            // Get column indices for a given row
+            void getColumnIndices(IndexType irow, IndexArrayType &v) const
+            {
+                if (irow >= m_num_rows)
+                {
+                    throw IndexOutOfBoundsException(
+                        "getColumnIndices: index out of bounds");
+                }
+
+                IndexType first(row_begin(irow));
+                IndexType last(row_end(irow));
+                if (first != last)
+                {
+                    v.assign(m_col_idx.begin() + first,
+                             m_col_idx.begin() + last);
+                }
+            }
+
+            // Get row indices for a given column
+            void getRowIndices(IndexType icol, IndexArrayType &v) const
+            {
+                if (icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "getRowIndices: index out of bounds");
+                }
+
+                v.resize(0);
+                for (IndexType ii = 0; ii < m_fill_row; ii++)
+                {
+                    IndexType ix;
+                    if (find(ii, icol, ix))
+                    {
+                        v.push_back(ii);
+                    }
+                }
+            }
+
+            template<typename RAIteratorIT,
+                     typename RAIteratorJT,
+                     typename RAIteratorVT>
+            void extractTuples(RAIteratorIT        row_it,
+                               RAIteratorJT        col_it,
+                               RAIteratorVT        values) const
+            {
+                for (IndexType row = 0; row < m_fill_row; ++row)
+                {
+                    for (IndexType ix = m_row_ptr[row]; ix < m_row_ptr[row + 1]; ++ix)
+                    {
+                        *row_it = row;          ++row_it;
+                        *col_it = m_col_idx[ix]; ++col_it;
+                        *values = m_vals[ix];   ++values;
+                    }
+                }
+            }
+
+            // output specific to the storage layout of this type of matrix
+            void printInfo(std::ostream &os) const
+            {
+                // Used to print data in storage format instead of like a matrix
+                #ifdef GRB_SEQUENTIAL_MATRIX_PRINT_STORAGE
+                    os << "CsrSparseMatrix<" << typeid(ScalarT).name() << ">"
+                       << std::endl;
+                    os << "dimensions: " << m_num_rows << " x " << m_num_cols
+                       << std::endl;
+                    os << "num stored values = " << nvals() << std::endl;
+                    for (IndexType row = 0; row < m_num_rows; ++row)
+                    {
+                        os << row << " :";
+                        for (IndexType ix = row_begin(row); ix < row_end(row); ++ix)
+                        {
+                            os << " " << m_col_idx[ix] << ":" << m_vals[ix];
+                        }
+                        os << std::endl;
+                    }
+                #else
+                    IndexType num_rows = nrows();
+                    IndexType num_cols = ncols();
+
+                    os << "(" << num_rows << "x" << num_cols << ")" << std::endl;
+
+                    for (IndexType row_idx = 0; row_idx < num_rows; ++row_idx)
+                    {
+                        // We like to start with a little whitespace indent
+                        os << ((row_idx == 0) ? "  [[" : "   [");
+
+                        IndexType curr_idx = 0;
+                        IndexType last(row_end(row_idx));
+                        for (IndexType ix = row_begin(row_idx); ix < last; ++ix)
+                        {
+                            while (curr_idx < m_col_idx[ix])
+                            {
+                                os << ((curr_idx == 0) ? " " : ",  " );
+                                ++curr_idx;
+                            }
+
+                            if (curr_idx != 0)
+                                os << ", ";
+                            os << m_vals[ix];
+
+                            ++curr_idx;
+                        }
+
+                        // Fill in the rest to the end
+                        while (curr_idx < num_cols)
+                        {
+                            os << ((curr_idx == 0) ? " " : ",  " );
+                            ++curr_idx;
+                        }
+                        os << ((row_idx == num_rows - 1 ) ? "]]" : "]\n");
+                    }
+                #endif
+            }
+
+            friend std::ostream &operator<<(std::ostream                   &os,
+                                            CsrSparseMatrix<ScalarT> const &mat)
+            {
+                mat.printInfo(os);
+                return os;
+            }
+
+        protected:
+            // Offsets of a row's elements in m_col_idx/m_vals.
+            IndexType row_begin(IndexType row) const
+            {
+                return (row < m_fill_row) ? m_row_ptr[row] : m_col_idx.size();
+            }
+
+            IndexType row_end(IndexType row) const
+            {
+                return (row < m_fill_row) ? m_row_ptr[row + 1] : m_col_idx.size();
+            }
+
+            // Binary search within a row. If not found, ix is the offset
+            // where icol would be inserted.
+            bool find(IndexType irow, IndexType icol, IndexType &ix) const
+            {
+                auto first(m_col_idx.begin() + row_begin(irow));
+                auto last(m_col_idx.begin() + row_end(irow));
+                auto it(std::lower_bound(first, last, icol));
+                ix = it - m_col_idx.begin();
+                return ((it != last) && (*it == icol));
+            }
+
+            // Make rows [m_fill_row, row) explicitly empty.
+            void extend_fill(IndexType row)
+            {
+                for (IndexType r = m_fill_row; r < row; ++r)
+                {
+                    m_row_ptr[r + 1] = m_row_ptr[r];
+                }
+                m_fill_row = std::max(m_fill_row, row);
+            }
+
+            // Insert a new element at offset ix (which lies in row irow).
+            void insert(IndexType irow, IndexType ix,
+                        IndexType icol, ScalarT const &val)
+            {
+                if (irow >= m_fill_row)
+                {
+                    extend_fill(irow);
+                    m_row_ptr[irow + 1] = m_row_ptr[irow];
+                    m_fill_row = irow + 1;
+                }
+                m_col_idx.insert(m_col_idx.begin() + ix, icol);
+                m_vals.insert(m_vals.begin() + ix, val);
+                for (IndexType row = irow + 1; row <= m_fill_row; ++row)
+                {
+                    ++m_row_ptr[row];
+                }
+            }
+
+        protected:
+            IndexType m_num_rows;
+            IndexType m_num_cols;
+
+            // Rows at or after this one are empty (offsets not maintained)
+            IndexType m_fill_row;
+
+            // Compressed sparse row storage (CSR)
+            std::vector<IndexType> m_row_ptr;
+            std::vector<IndexType> m_col_idx;
+            std::vector<ScalarT>   m_vals;
+        };
+
+    } // namespace backend
+
+} // namespace GraphBLAS
+
+#endif // GB_SEQUENTIAL_CSRSPARSEMATRIX_HPP
@@ -0,0 +1,640 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_SEQUENTIAL_DENSEMATRIX_HPP
+#define GB_SEQUENTIAL_DENSEMATRIX_HPP
+
+#include <iostream>
+#include <vector>
+#include <tuple>
+#include <algorithm>
+#include <typeinfo>
+#include <stdexcept>
+#include <utility>
+
+#include <graphblas/graphblas.hpp>
+#include <graphblas/platforms/sequential/SparseView.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /**
+         * @brief Dense row major storage (selected with DenseTag): a value
+         *        slot for every element, and a bitmap of the stored
+         *        elements only while some element is not stored.
+         *
+         * getRow() returns DenseViews of the rows; when the matrix is full
+         * they carry no bitmap, so kernels (see dot()) read the values by
+         * position.  Once every element has been written the bitmap and
+         * the per row counts are released again.
+         */
+        template<typename ScalarT, typename... TagsT>
+        class DenseMatrix
+        {
+        public:
+            typedef ScalarT ScalarType;
+
+            // Constructor
+            DenseMatrix(IndexType num_rows,
+                        IndexType num_cols)
+                : m_num_rows(num_rows),
+                  m_num_cols(num_cols),
+                  m_nvals(0),
+                  m_vals(num_rows*num_cols),
+                  m_bitmap(bitmap_num_words(num_rows*num_cols), 0),
+                  m_row_nvals(num_rows, 0)
+            {
+            }
+
+            // Constructor - copy
+            DenseMatrix(DenseMatrix<ScalarT> const &rhs)
+                : m_num_rows(rhs.m_num_rows),
+                  m_num_cols(rhs.m_num_cols),
+                  m_nvals(rhs.m_nvals),
+                  m_vals(rhs.m_vals),
+                  m_bitmap(rhs.m_bitmap),
+                  m_row_nvals(rhs.m_row_nvals)
+            {
+            }
+
+            // Constructor - move (rhs is left empty, with the same dimensions)
+            DenseMatrix(DenseMatrix<ScalarT> &&rhs)
+                : DenseMatrix(rhs.m_num_rows, rhs.m_num_cols)
+            {
+                swap(rhs);
+            }
+
+            // Constructor - dense from dense matrix
+            DenseMatrix(std::vector<std::vector<ScalarT>> const &val)
+                : m_num_rows(val.size()),
+                  m_num_cols(val[0].size()),
+                  m_nvals(val.size()*val[0].size())
+            {
+                m_vals.reserve(m_nvals);
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    if (val[ii].size() != m_num_cols)
+                    {
+                        throw DimensionException("DenseMatrix(dense ctor)");
+                    }
+                    m_vals.insert(m_vals.end(), val[ii].begin(), val[ii].end());
+                }
+            }
+
+            // Constructor - sparse from dense matrix, removing specifed implied zeros
+            DenseMatrix(std::vector<std::vector<ScalarT>> const &val,
+                        ScalarT zero)
+                : m_num_rows(val.size()),
+                  m_num_cols(val[0].size()),
+                  m_nvals(0),
+                  m_bitmap(bitmap_num_words(val.size()*val[0].size()), 0),
+                  m_row_nvals(val.size(), 0)
+            {
+                m_vals.reserve(m_num_rows*m_num_cols);
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    if (val[ii].size() != m_num_cols)
+                    {
+                        throw DimensionException("DenseMatrix(dense ctor)");
+                    }
+                    m_vals.insert(m_vals.end(), val[ii].begin(), val[ii].end());
+
+                    for (IndexType jj = 0; jj < m_num_cols; jj++)
+                    {
+                        if (val[ii][jj] != zero)
+                        {
+                            set_bit(m_bitmap.data(), offset(ii, jj));
+                            ++m_row_nvals[ii];
+                        }
+                    }
+                    m_nvals += m_row_nvals[ii];
+                }
+                check_full();
+            }
+
+            // Destructor
+            ~DenseMatrix()
+            {}
+
+            // Assignment (currently restricted to same dimensions)
+            DenseMatrix<ScalarT> &operator=(DenseMatrix<ScalarT> const &rhs)
+            {
+                if (this != &rhs)
+                {
+                    // push this check to frontend
+                    if ((m_num_rows != rhs.m_num_rows) ||
+                        (m_num_cols != rhs.m_num_cols))
+                    {
+                        throw DimensionException();
+                    }
+
+                    m_nvals = rhs.m_nvals;
+                    m_vals = rhs.m_vals;
+                    m_bitmap = rhs.m_bitmap;
+                    m_row_nvals = rhs.m_row_nvals;
+                }
+                return *this;
+            }
+
+            // Move assignment (currently restricted to same dimensions),
+            // rhs is left empty
+            DenseMatrix<ScalarT> &operator=(DenseMatrix<ScalarT> &&rhs)
+            {
+                if (this != &rhs)
+                {
+                    if ((m_num_rows != rhs.m_num_rows) ||
+                        (m_num_cols != rhs.m_num_cols))
+                    {
+                        throw DimensionException();
+                    }
+
+                    swap(rhs);
+                    rhs.clear();
+                }
+                return *this;
+            }
+
+            // Exchange contents (and dimensions) with rhs in constant time
+            void swap(DenseMatrix<ScalarT> &rhs)
+            {
+                std::swap(m_num_rows, rhs.m_num_rows);
+                std::swap(m_num_cols, rhs.m_num_cols);
+                std::swap(m_nvals, rhs.m_nvals);
+                m_vals.swap(rhs.m_vals);
+                m_bitmap.swap(rhs.m_bitmap);
+                m_row_nvals.swap(rhs.m_row_nvals);
+            }
+
+            // EQUALITY OPERATORS
+            /**
+             * @brief Equality testing for DenseMatrix.
+             * @param rhs The right hand side of the equality operation.
+             * @return If this DenseMatrix and rhs are identical.
+             */
+            bool operator==(DenseMatrix<ScalarT> const &rhs) const
+            {
+                if ((m_num_rows != rhs.m_num_rows) ||
+                    (m_num_cols != rhs.m_num_cols) ||
+                    (m_nvals != rhs.m_nvals))
+                {
+                    return false;
+                }
+
+                for (IndexType ix = 0; ix < m_vals.size(); ++ix)
+                {
+                    bool has(stored(ix));
+                    if ((has != rhs.stored(ix)) ||
+                        (has && (m_vals[ix] != rhs.m_vals[ix])))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            /**
+             * @brief Inequality testing for DenseMatrix.
+             * @param rhs The right hand side of the inequality operation.
+             * @return If this DenseMatrix and rhs are not identical.
+             */
+            bool operator!=(DenseMatrix<ScalarT> const &rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+            /**
+             * Bulk build: scatter the tuples into place, combining them
+             * with any value already stored at the same location with dup
+             * (stored = dup(stored, v), in input order).
+             */
+            template<typename RAIteratorI,
+                     typename RAIteratorJ,
+                     typename RAIteratorV,
+                     typename DupT>
+            void build(RAIteratorI  i_it,
+                       RAIteratorJ  j_it,
+                       RAIteratorV  v_it,
+                       IndexType    n,
+                       DupT         dup)
+            {
+                for (IndexType ix = 0; ix < n; ++ix)
+                {
+                    if ((i_it[ix] >= m_num_rows) || (j_it[ix] >= m_num_cols))
+                    {
+                        throw IndexOutOfBoundsException(
+                            "build: index out of bounds");
+                    }
+                }
+
+                for (IndexType ix = 0; ix < n; ++ix)
+                {
+                    IndexType pos(offset(i_it[ix], j_it[ix]));
+                    if (stored(pos))
+                    {
+                        m_vals[pos] = dup(static_cast<ScalarT>(m_vals[pos]),
+                                          static_cast<ScalarT>(v_it[ix]));
+                    }
+                    else
+                    {
+                        m_vals[pos] = static_cast<ScalarT>(v_it[ix]);
+                        mark(i_it[ix], pos);
+                    }
+                }
+                check_full();
+            }
+
+            void clear()
+            {
+                m_nvals = 0;
+                m_bitmap.assign(bitmap_num_words(m_vals.size()), 0);
+                m_row_nvals.assign(m_num_rows, 0);
+            }
+
+            IndexType nrows() const { return m_num_rows; }
+            IndexType ncols() const { return m_num_cols; }
+            IndexType nvals() const { return m_nvals; }
+
+            /// True if every element is stored (there is no bitmap).
+            bool isFull() const { return m_nvals == m_vals.size(); }
+
+            bool hasElement(IndexType irow, IndexType icol) const
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "get_value_at: index out of bounds");
+                }
+
+                return stored(offset(irow, icol));
+            }
+
+            // Get value at index
+            ScalarT extractElement(IndexType irow, IndexType icol) const
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "get_value_at: index out of bounds");
+                }
+
+                IndexType pos(offset(irow, icol));
+                if (!stored(pos))
+                {
+                    throw NoValueException("get_value_at: no entry at index");
+                }
+                return m_vals[pos];
+            }
+
+            // Set value at index
+            void setElement(IndexType irow, IndexType icol, ScalarT const &val)
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException("setElement: index out of bounds");
+                }
+
+                IndexType pos(offset(irow, icol));
+                m_vals[pos] = val;
+                if (!stored(pos))
+                {
+                    mark(irow, pos);
+                    check_full();
+                }
+            }
+
+            // Set value at index + 'merge' with any existing value
+            // according to the BinaryOp passed.
+            template <typename BinaryOpT>
+            void setElement(IndexType irow, IndexType icol, ScalarT const &val,
+                            BinaryOpT merge)
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "setElement(merge): index out of bounds");
+                }
+
+                IndexType pos(offset(irow, icol));
+                if (stored(pos))
+                {
+                    m_vals[pos] = merge(static_cast<ScalarT>(m_vals[pos]), val);
+                }
+                else
+                {
+                    m_vals[pos] = val;
+                    mark(irow, pos);
+                    check_full();
+                }
+            }
+
+            typedef DenseView<ScalarT> const RowType;
+            RowType getRow(IndexType row_index) const
+            {
+                return RowType(value_iterator<ScalarT>::begin(m_vals) +
+                                   offset(row_index, 0),
+                               isFull() ? nullptr : m_bitmap.data(),
+                               offset(row_index, 0),
+                               m_num_cols,
+                               isFull() ? m_num_cols : m_row_nvals[row_index]);
+            }
+
+            // Allow casting.  Writing a full row into a full matrix does
+            // not touch the structure.
+            template <typename RowT>
+            void setRow(
+                IndexType row_index,
+                RowT const &row_data)
+            {
+                IndexType first(offset(row_index, 0));
+                if (isFull() && (row_data.size() == m_num_cols))
+                {
+                    IndexType ix(first);
+                    for (auto&& tupl : row_data)
+                    {
+                        m_vals[ix++] = static_cast<ScalarT>(std::get<1>(tupl));
+                    }
+                    return;
+                }
+
+                make_partial();
+                for (IndexType pos = first; pos < first + m_num_cols; ++pos)
+                {
+                    clear_bit(m_bitmap.data(), pos);
+                }
+                m_nvals -= m_row_nvals[row_index];
+                m_row_nvals[row_index] = 0;
+
+                for (auto&& tupl : row_data)
+                {
+                    IndexType pos(first + std::get<0>(tupl));
+                    m_vals[pos] = static_cast<ScalarT>(std::get<1>(tupl));
+                    mark(row_index, pos);
+                }
+                check_full();
+            }
+
+            typedef std::vector<std::tuple<IndexType, ScalarT> > const ColType;
+            ColType getCol(IndexType col_index) const
+            {
+                std::vector<std::tuple<IndexType, ScalarT> > data;
+
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    IndexType pos(offset(ii, col_index));
+                    if (stored(pos))
+                    {
+                        data.push_back(std::make_tuple(
+                                           ii, static_cast<ScalarT>(m_vals[pos])));
+                    }
+                }
+
+                return data;
+            }
+
+            // col_data must be in increasing index order.
+            template <typename ColT>
+            void setCol(
+                IndexType col_index,
+                ColT const &col_data)
+            {
+                if (isFull() && (col_data.size() == m_num_rows))
+                {
+                    for (auto&& tupl : col_data)
+                    {
+                        m_vals[offset(std::get<0>(tupl), col_index)] =
+                            static_cast<ScalarT>(std::get<1>(tupl));
+                    }
+                    return;
+                }
+
+                make_partial();
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    IndexType pos(offset(ii, col_index));
+                    if (test_bit(m_bitmap.data(), pos))
+                    {
+                        clear_bit(m_bitmap.data(), pos);
+                        --m_row_nvals[ii];
+                        --m_nvals;
+                    }
+                }
+
+                for (auto&& tupl : col_data)
+                {
+                    IndexType pos(offset(std::get<0>(tupl), col_index));
+                    m_vals[pos] = static_cast<ScalarT>(std::get<1>(tupl));
+                    mark(std::get<0>(tupl), pos);
+                }
+                check_full();
+            }
+
+            // Get column indices for a given row
+            void getColumnIndices(IndexType irow, IndexArrayType &v) const
+            {
+                if (irow >= m_num_rows)
+                {
+                    throw IndexOutOfBoundsException(
+                        "getColumnIndices: index out of bounds");
+                }
+
+                v.resize(0);
+                for (IndexType jj = 0; jj < m_num_cols; jj++)
+                {
+                    if (stored(offset(irow, jj)))
+                    {
+                        v.push_back(jj);
+                    }
+                }
+            }
+
+            // Get row indices for a given column
+            void getRowIndices(IndexType icol, IndexArrayType &v) const
+            {
+                if (icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "getRowIndices: index out of bounds");
+                }
+
+                v.resize(0);
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    if (stored(offset(ii, icol)))
+                    {
+                        v.push_back(ii);
+                    }
+                }
+            }
+
+            template<typename RAIteratorIT,
+                     typename RAIteratorJT,
+                     typename RAIteratorVT>
+            void extractTuples(RAIteratorIT        row_it,
+                               RAIteratorJT        col_it,
+                               RAIteratorVT        values) const
+            {
+                for (IndexType row = 0; row < m_num_rows; ++row)
+                {
+                    for (IndexType col = 0; col < m_num_cols; ++col)
+                    {
+                        IndexType pos(offset(row, col));
+                        if (stored(pos))
+                        {
+                            *row_it = row;         ++row_it;
+                            *col_it = col;         ++col_it;
+                            *values = m_vals[pos]; ++values;
+                        }
+                    }
+                }
+            }
+
+            // output specific to the storage layout of this type of matrix
+            void printInfo(std::ostream &os) const
+            {
+                // Used to print data in storage format instead of like a matrix
+                #ifdef GRB_SEQUENTIAL_MATRIX_PRINT_STORAGE
+                    os << "DenseMatrix<" << typeid(ScalarT).name() << ">"
+                       << std::endl;
+                    os << "dimensions: " << m_num_rows << " x " << m_num_cols
+                       << std::endl;
+                    os << "num stored values = " << nvals()
+                       << (isFull() ? " (full)" : "") << std::endl;
+                    for (IndexType row = 0; row < m_num_rows; ++row)
+                    {
+                        os << row << " :";
+                        for (IndexType col = 0; col < m_num_cols; ++col)
+                        {
+                            if (stored(offset(row, col)))
+                            {
+                                os << " " << col << ":"
+                                   << m_vals[offset(row, col)];
+                            }
+                        }
+                        os << std::endl;
+                    }
+                #else
+                    IndexType num_rows = nrows();
+                    IndexType num_cols = ncols();
+
+                    os << "(" << num_rows << "x" << num_cols << ")" << std::endl;
+
+                    for (IndexType row_idx = 0; row_idx < num_rows; ++row_idx)
+                    {
+                        // We like to start with a little whitespace indent
+                        os << ((row_idx == 0) ? "  [[" : "   [");
+
+                        for (IndexType col_idx = 0; col_idx < num_cols; ++col_idx)
+                        {
+                            IndexType pos(offset(row_idx, col_idx));
+                            if (stored(pos))
+                            {
+                                if (col_idx != 0)
+                                    os << ", ";
+                                os << m_vals[pos];
+                            }
+                            else
+                            {
+                                os << ((col_idx == 0) ? " " : ",  " );
+                            }
+                        }
+                        os << ((row_idx == num_rows - 1 ) ? "]]" : "]\n");
+                    }
+                #endif
+            }
+
+            friend std::ostream &operator<<(std::ostream               &os,
+                                            DenseMatrix<ScalarT> const &mat)
+            {
+                mat.printInfo(os);
+                return os;
+            }
+
+        private:
+            IndexType offset(IndexType irow, IndexType icol) const
+            {
+                return irow*m_num_cols + icol;
+            }
+
+            bool stored(IndexType pos) const
+            {
+                return isFull() || test_bit(m_bitmap.data(), pos);
+            }
+
+            // Flag a newly stored element (the matrix is not full).
+            void mark(IndexType irow, IndexType pos)
+            {
+                set_bit(m_bitmap.data(), pos);
+                ++m_row_nvals[irow];
+                ++m_nvals;
+            }
+
+            // Bring back the structure of a full matrix before removing
+            // elements.
+            void make_partial()
+            {
+                if (m_bitmap.empty() && !m_vals.empty())
+                {
+                    m_bitmap.assign(bitmap_num_words(m_vals.size()),
+                                    ~BitmapWord(0));
+                    m_bitmap.back() &= bitmap_tail_mask(m_vals.size());
+                    m_row_nvals.assign(m_num_rows, m_num_cols);
+                }
+            }
+
+            /// Drop the structure once every element is stored.
+            void check_full()
+            {
+                if (isFull())
+                {
+                    std::vector<BitmapWord>().swap(m_bitmap);
+                    std::vector<IndexType>().swap(m_row_nvals);
+                }
+            }
+
+        private:
+            IndexType m_num_rows;
+            IndexType m_num_cols;
+            IndexType m_nvals;
+
+            // A slot for every element, row major
+            std::vector<ScalarT>    m_vals;
+
+            // Empty when every element is stored
+            std::vector<BitmapWord> m_bitmap;
+            std::vector<IndexType>  m_row_nvals;
+        };
+
+    } // namespace backend
+
+} // namespace GraphBLAS
+
+#endif // GB_SEQUENTIAL_DENSEMATRIX_HPP
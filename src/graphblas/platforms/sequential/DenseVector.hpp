@@ -0,0 +1,533 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_SEQUENTIAL_DENSEVECTOR_HPP
+#define GB_SEQUENTIAL_DENSEVECTOR_HPP
+
+#include <iostream>
+#include <vector>
+#include <utility>
+
+#include <graphblas/platforms/sequential/SparseView.hpp>
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /**
+         * @brief Class representing a vector with a value slot for every
+         *        index (selected with DenseTag).
+         *
+         * This is meant for vectors that are full, or nearly so, most of
+         * the time (e.g., ranks or per vertex probabilities): the values
+         * are one contiguous array, and a bitmap of the stored indices only
+         * exists while some index is not stored.  Writing every index (by
+         * setContents() with a full result, assignment from a
+         * std::vector, ...) drops the bitmap again, so getContents() of a
+         * full vector iterates the values without any structural checks.
+         */
+        template<typename ScalarT>
+        class DenseVector
+        {
+        public:
+            typedef ScalarT ScalarType;
+
+            /**
+             * @brief Construct an empty dense vector with given size
+             *
+             * @param[in] nsize  Size of vector.
+             */
+            DenseVector(IndexType nsize)
+                : m_size(nsize),
+                  m_nvals(0),
+                  m_vals(nsize),
+                  m_bitmap(bitmap_num_words(nsize), 0)
+            {
+                if (nsize == 0)
+                {
+                    throw InvalidValueException();
+                }
+            }
+
+            DenseVector(IndexType const &nsize, ScalarT const &value)
+                : m_size(nsize),
+                  m_nvals(nsize),
+                  m_vals(nsize, value)
+            {
+                if (nsize == 0)
+                {
+                    throw InvalidValueException();
+                }
+            }
+
+            /**
+             * @brief Construct from a dense vector.
+             *
+             * @param[in]  rhs  The dense vector to assign to this vector.
+             *                  Size is implied by the vector.
+             */
+            DenseVector(std::vector<ScalarT> const &rhs)
+                : m_size(rhs.size()),
+                  m_nvals(rhs.size()),
+                  m_vals(rhs)
+            {
+                if (rhs.size() == 0)
+                {
+                    throw InvalidValueException();
+                }
+            }
+
+            /**
+             * @brief Construct a vector from a dense array and zero val.
+             *
+             * @param[in]  rhs  The dense vector to assign to this vector.
+             *                  Size is implied by the vector.
+             * @param[in]  zero An values in the rhs equal to this value will result
+             *                  in an implied zero in the resulting vector
+             */
+            DenseVector(std::vector<ScalarT> const &rhs,
+                        ScalarT const              &zero)
+                : m_size(rhs.size()),
+                  m_nvals(0),
+                  m_vals(rhs),
+                  m_bitmap(bitmap_num_words(rhs.size()), 0)
+            {
+                if (rhs.size() == 0)
+                {
+                    throw InvalidValueException();
+                }
+
+                for (IndexType idx = 0; idx < rhs.size(); ++idx)
+                {
+                    if (rhs[idx] != zero)
+                    {
+                        set_bit(m_bitmap.data(), idx);
+                        ++m_nvals;
+                    }
+                }
+                check_full();
+            }
+
+            /**
+             * @brief Construct from index and value arrays.
+             * @deprecated Use vectorBuild method
+             */
+            DenseVector(
+                IndexType                     nsize,
+                std::vector<IndexType> const &indices,
+                std::vector<ScalarT>   const &values)
+                : m_size(nsize),
+                  m_nvals(0),
+                  m_vals(nsize),
+                  m_bitmap(bitmap_num_words(nsize), 0)
+            {
+                /// @todo check for same size indices and values
+                for (auto i : indices)
+                {
+                    if (i >= m_size)
+                    {
+                        throw DimensionException();  // Should this be IndexOutOfBounds?
+                    }
+                }
+                build(indices.begin(), values.begin(), indices.size());
+            }
+
+            /**
+             * @brief Copy constructor for DenseVector.
+             *
+             * @param[in] rhs  The DenseVector to copy construct this
+             *                 DenseVector from.
+             */
+            DenseVector(DenseVector<ScalarT> const &rhs)
+                : m_size(rhs.m_size),
+                  m_nvals(rhs.m_nvals),
+                  m_vals(rhs.m_vals),
+                  m_bitmap(rhs.m_bitmap)
+            {
+            }
+
+            /**
+             * @brief Move constructor for DenseVector.
+             *
+             * @param[in] rhs  The DenseVector to take the contents of;
+             *                 it is left empty, with the same size.
+             */
+            DenseVector(DenseVector<ScalarT> &&rhs)
+                : DenseVector(rhs.m_size)
+            {
+                swap(rhs);
+            }
+
+            ~DenseVector() {}
+
+            /**
+             * @brief Copy assignment.
+             *
+             * @param[in] rhs  The DenseVector to assign to this
+             *
+             * @return *this.
+             */
+            DenseVector<ScalarT>& operator=(DenseVector<ScalarT> const &rhs)
+            {
+                if (this != &rhs)
+                {
+                    if (m_size != rhs.m_size)
+                    {
+                        throw DimensionException();
+                    }
+
+                    m_nvals = rhs.m_nvals;
+                    m_vals = rhs.m_vals;
+                    m_bitmap = rhs.m_bitmap;
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Move assignment; rhs is left empty.
+             *
+             * @param[in] rhs  The DenseVector to move into this
+             *
+             * @return *this.
+             */
+            DenseVector<ScalarT>& operator=(
+                DenseVector<ScalarT> &&rhs)
+            {
+                if (this != &rhs)
+                {
+                    if (m_size != rhs.m_size)
+                    {
+                        throw DimensionException();
+                    }
+
+                    swap(rhs);
+                    rhs.clear();
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Exchange the contents (and sizes) of two vectors in
+             *        constant time.
+             */
+            void swap(DenseVector<ScalarT> &rhs)
+            {
+                std::swap(m_size, rhs.m_size);
+                std::swap(m_nvals, rhs.m_nvals);
+                m_vals.swap(rhs.m_vals);
+                m_bitmap.swap(rhs.m_bitmap);
+            }
+
+            /**
+             * @brief Assignment from a dense vector.
+             *
+             * @param[in]  rhs  The dense vector to assign to this vector.
+             *
+             * @return *this.
+             */
+            DenseVector<ScalarT>& operator=(std::vector<ScalarT> const &rhs)
+            {
+                if (rhs.size() != m_size)
+                {
+                    throw DimensionException();
+                }
+                m_vals = rhs;
+                m_nvals = m_size;
+                release_bitmap();
+                return *this;
+            }
+
+            // EQUALITY OPERATORS
+            /**
+             * @brief Equality testing for DenseVector.
+             * @param rhs The right hand side of the equality operation.
+             * @return If this DenseVector and rhs are identical.
+             */
+            bool operator==(DenseVector<ScalarT> const &rhs) const
+            {
+                if ((m_size != rhs.m_size) || (m_nvals != rhs.m_nvals))
+                {
+                    return false;
+                }
+
+                for (IndexType idx = 0; idx < m_size; ++idx)
+                {
+                    bool has(stored(idx));
+                    if ((has != rhs.stored(idx)) ||
+                        (has && (m_vals[idx] != rhs.m_vals[idx])))
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * @brief Inequality testing for DenseVector.
+             * @param rhs The right hand side of the inequality operation.
+             * @return If this DenseVector and rhs are not identical.
+             */
+            bool operator!=(DenseVector<ScalarT> const &rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+            // FUNCTIONS
+
+            /**
+             * Replace the contents with the given (index, value) pairs,
+             * combining values at the same index with dup (in the order
+             * they are given).
+             */
+            template<typename RAIteratorIT,
+                     typename RAIteratorVT,
+                     typename BinaryOpT = GraphBLAS::Second<ScalarType> >
+            void build(RAIteratorIT  i_it,
+                       RAIteratorVT  v_it,
+                       IndexType     nvals,
+                       BinaryOpT     dup = BinaryOpT())
+            {
+                for (IndexType idx = 0; idx < nvals; ++idx)
+                {
+                    if (i_it[idx] >= m_size)
+                    {
+                        throw IndexOutOfBoundsException();
+                    }
+                }
+
+                clear();
+                for (IndexType idx = 0; idx < nvals; ++idx)
+                {
+                    IndexType i = i_it[idx];
+                    if (test_bit(m_bitmap.data(), i))
+                    {
+                        m_vals[i] = dup(m_vals[i], v_it[idx]);
+                    }
+                    else
+                    {
+                        m_vals[i] = v_it[idx];
+                        set_bit(m_bitmap.data(), i);
+                        ++m_nvals;
+                    }
+                }
+                check_full();
+            }
+
+            void clear()
+            {
+                m_nvals = 0;
+                m_bitmap.assign(bitmap_num_words(m_size), 0);
+            }
+
+            IndexType size() const { return m_size; }
+            IndexType nvals() const { return m_nvals; }
+
+            /// True if every index is stored (there is no bitmap).
+            bool isFull() const { return m_nvals == m_size; }
+
+            bool hasElement(IndexType index) const
+            {
+                if (index >= m_size)
+                {
+                    throw IndexOutOfBoundsException();
+                }
+
+                return stored(index);
+            }
+
+            /**
+             * @brief Access the elements of this DenseVector given index.
+             *
+             * @param[in] index  Position to access.
+             *
+             * @return The element of this DenseVector at the given index.
+             */
+            ScalarT extractElement(IndexType index) const
+            {
+                if (index >= m_size)
+                {
+                    throw IndexOutOfBoundsException();
+                }
+
+                if (!stored(index))
+                {
+                    throw NoValueException();
+                }
+                return m_vals[index];
+            }
+
+            void setElement(IndexType      index,
+                            ScalarT const &new_val)
+            {
+                if (index >= m_size)
+                {
+                    throw IndexOutOfBoundsException();
+                }
+
+                m_vals[index] = new_val;
+                if (!stored(index))
+                {
+                    set_bit(m_bitmap.data(), index);
+                    ++m_nvals;
+                    check_full();
+                }
+            }
+
+            template<typename RAIteratorIT,
+                     typename RAIteratorVT>
+            void extractTuples(RAIteratorIT        i_it,
+                               RAIteratorVT        v_it) const
+            {
+                for (auto&& elt : getContents())
+                {
+                    *i_it = std::get<0>(elt); ++i_it;
+                    *v_it = std::get<1>(elt); ++v_it;
+                }
+            }
+
+            void extractTuples(IndexArrayType        &indices,
+                               std::vector<ScalarT>  &values) const
+            {
+                extractTuples(indices.begin(), values.begin());
+            }
+
+            // output specific to the storage layout of this type of vector
+            void printInfo(std::ostream &os) const
+            {
+                os << "[";
+                for (IndexType idx = 0; idx < m_size; ++idx)
+                {
+                    if (idx > 0) os << ", ";
+                    if (stored(idx))
+                    {
+                        os << m_vals[idx];
+                    }
+                    else
+                    {
+                        os << "-";
+                    }
+                }
+                os << "]";
+            }
+
+            friend std::ostream &operator<<(std::ostream               &os,
+                                            DenseVector<ScalarT> const &vec)
+            {
+                vec.printInfo(os);
+                return os;
+            }
+
+            typedef DenseView<ScalarT> const ContentsType;
+            ContentsType getContents() const
+            {
+                return ContentsType(value_iterator<ScalarT>::begin(m_vals),
+                                    isFull() ? nullptr : m_bitmap.data(),
+                                    0, m_size, m_nvals);
+            }
+
+            /// A full result (one value for every index) is copied straight
+            /// into the values without touching a bitmap.
+            template <typename OtherScalarT>
+            void setContents(
+                std::vector<std::tuple<IndexType,OtherScalarT> > const &contents)
+            {
+                if (contents.size() == m_size)
+                {
+                    for (IndexType idx = 0; idx < m_size; ++idx)
+                    {
+                        m_vals[idx] =
+                            static_cast<ScalarT>(std::get<1>(contents[idx]));
+                    }
+                    m_nvals = m_size;
+                    release_bitmap();
+                    return;
+                }
+
+                m_bitmap.assign(bitmap_num_words(m_size), 0);
+                for (auto&& tupl : contents)
+                {
+                    set_bit(m_bitmap.data(), std::get<0>(tupl));
+                    m_vals[std::get<0>(tupl)] =
+                        static_cast<ScalarT>(std::get<1>(tupl));
+                }
+                m_nvals = contents.size();
+            }
+
+            // Positional access for the kernels of dense_ewise.hpp: they
+            // write the values and the bitmap words directly and then set
+            // the number of stored values.
+            ScalarT *valueData() { return m_vals.data(); }
+
+            /// The bitmap words (allocated if the vector is full).
+            BitmapWord *bitmapData()
+            {
+                if (m_bitmap.empty())
+                {
+                    m_bitmap.assign(bitmap_num_words(m_size), 0);
+                }
+                return m_bitmap.data();
+            }
+
+            void setNvals(IndexType nvals)
+            {
+                m_nvals = nvals;
+                check_full();
+            }
+
+        private:
+            bool stored(IndexType idx) const
+            {
+                return isFull() || test_bit(m_bitmap.data(), idx);
+            }
+
+            /// Drop the bitmap once every index is stored.
+            void check_full()
+            {
+                if (isFull())
+                {
+                    release_bitmap();
+                }
+            }
+
+            void release_bitmap()
+            {
+                std::vector<BitmapWord>().swap(m_bitmap);
+            }
+
+            IndexType               m_size;   // only changed by swap()
+            IndexType               m_nvals;
+
+            std::vector<ScalarT>    m_vals;   // a slot for every index
+            std::vector<BitmapWord> m_bitmap; // empty when every index is stored
+        };
+    } // backend
+} // GraphBLAS
+
+#endif // GB_SEQUENTIAL_DENSEVECTOR_HPP
@@ -0,0 +1,718 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_SEQUENTIAL_HYBRIDSPARSEVECTOR_HPP
+#define GB_SEQUENTIAL_HYBRIDSPARSEVECTOR_HPP
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include <graphblas/platforms/sequential/SparseView.hpp>
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /**
+         * @brief Class representing a sparse vector that is stored either as
+         *        a sorted list of (index, value) pairs or as a bitmap + dense
+         *        vector, depending on how many of its elements are stored.
+         *
+         * The list costs O(nvals) memory and makes clear(), getContents()
+         * and comparisons proportional to the stored values (e.g., the one
+         * vertex frontier at the start of a BFS); the bitmap gives O(1)
+         * element access once a sizable fraction of the vector is stored.
+         * The form is chosen again whenever the contents are replaced as a
+         * whole (build, setContents, clear).  A list becomes a bitmap when
+         * more than 1/8 of the elements are stored, and a bitmap becomes a
+         * list when fewer than 1/32 are; the gap keeps a vector whose
+         * density hovers near one threshold from converting back and forth.
+         */
+        template<typename ScalarT>
+        class HybridSparseVector
+        {
+        public:
+            typedef ScalarT ScalarType;
+
+            /**
+             * @brief Construct an empty sparse vector with given size
+             *
+             * @param[in] nsize  Size of vector.
+             */
+            HybridSparseVector(IndexType nsize)
+                : m_size(nsize),
+                  m_nvals(0),
+                  m_is_bitmap(false),
+                  m_insert_work(0)
+            {
+                if (nsize == 0)
+                {
+                    throw InvalidValueException();
+                }
+            }
+
+            HybridSparseVector(IndexType const &nsize, ScalarT const &value)
+                : m_size(nsize),
+                  m_nvals(nsize),
+                  m_is_bitmap(true),
+                  m_insert_work(0),
+                  m_vals(nsize, value),
+                  m_bitmap(nsize, true)
+            {
+                if (nsize == 0)
+                {
+                    throw InvalidValueException();
+                }
+            }
+
+            /**
+             * @brief Construct from a dense vector.
+             *
+             * @param[in]  rhs  The dense vector to assign to this vector.
+             *                  Size is implied by the vector.
+             */
+            HybridSparseVector(std::vector<ScalarT> const &rhs)
+                : m_size(rhs.size()),
+                  m_nvals(rhs.size()),
+                  m_is_bitmap(true),
+                  m_insert_work(0),
+                  m_vals(rhs),
+                  m_bitmap(rhs.size(), true)
+            {
+                if (rhs.size() == 0)
+                {
+                    throw InvalidValueException();
+                }
+            }
+
+            /**
+             * @brief Construct a sparse vector from a dense array and zero val.
+             *
+             * @param[in]  rhs  The dense vector to assign to this vector.
+             *                  Size is implied by the vector.
+             * @param[in]  zero An values in the rhs equal to this value will result
+             *                  in an implied zero in the resulting sparse vector
+             */
+            HybridSparseVector(std::vector<ScalarT> const &rhs,
+                               ScalarT const              &zero)
+                : m_size(rhs.size()),
+                  m_nvals(0),
+                  m_is_bitmap(false),
+                  m_insert_work(0)
+            {
+                if (rhs.size() == 0)
+                {
+                    throw InvalidValueException();
+                }
+
+                for (IndexType idx = 0; idx < rhs.size(); ++idx)
+                {
+                    if (rhs[idx] != zero)
+                    {
+                        m_indices.push_back(idx);
+                        m_values.push_back(rhs[idx]);
+                        ++m_nvals;
+                    }
+                }
+                choose_form();
+            }
+
+            /**
+             * @brief Construct from index and value arrays.
+             * @deprecated Use vectorBuild method
+             */
+            HybridSparseVector(
+                IndexType                     nsize,
+                std::vector<IndexType> const &indices,
+                std::vector<ScalarT>   const &values)
+                : m_size(nsize),
+                  m_nvals(0),
+                  m_is_bitmap(false),
+                  m_insert_work(0)
+            {
+                /// @todo check for same size indices and values
+                for (auto i : indices)
+                {
+                    if (i >= m_size)
+                    {
+                        throw DimensionException();  // Should this be IndexOutOfBounds?
+                    }
+                }
+                build(indices.begin(), values.begin(), indices.size());
+            }
+
+            /**
+             * @brief Copy constructor for HybridSparseVector.
+             *
+             * @param[in] rhs  The HybridSparseVector to copy construct this
+             *                 HybridSparseVector from.
+             */
+            HybridSparseVector(HybridSparseVector<ScalarT> const &rhs)
+                : m_size(rhs.m_size),
+                  m_nvals(rhs.m_nvals),
+                  m_is_bitmap(rhs.m_is_bitmap),
+                  m_insert_work(rhs.m_insert_work),
+                  m_indices(rhs.m_indices),
+                  m_values(rhs.m_values),
+                  m_vals(rhs.m_vals),
+                  m_bitmap(rhs.m_bitmap)
+            {
+            }
+
+            /**
+             * @brief Move constructor for HybridSparseVector.
+             *
+             * @param[in] rhs  The HybridSparseVector to take the contents of;
+             *                 it is left empty, with the same size.
+             */
+            HybridSparseVector(HybridSparseVector<ScalarT> &&rhs)
+                : HybridSparseVector(rhs.m_size)
+            {
+                swap(rhs);
+            }
+
+            ~HybridSparseVector() {}
+
+            /**
+             * @brief Copy assignment.
+             *
+             * @param[in] rhs  The HybridSparseVector to assign to this
+             *
+             * @return *this.
+             */
+            HybridSparseVector<ScalarT>& operator=(
+                HybridSparseVector<ScalarT> const &rhs)
+            {
+                if (this != &rhs)
+                {
+                    if (m_size != rhs.m_size)
+                    {
+                        throw DimensionException();
+                    }
+
+                    m_nvals = rhs.m_nvals;
+                    m_is_bitmap = rhs.m_is_bitmap;
+                    m_insert_work = rhs.m_insert_work;
+                    m_indices = rhs.m_indices;
+                    m_values = rhs.m_values;
+                    m_vals = rhs.m_vals;
+                    m_bitmap = rhs.m_bitmap;
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Move assignment; rhs is left empty.
+             *
+             * @param[in] rhs  The HybridSparseVector to move into this
+             *
+             * @return *this.
+             */
+            HybridSparseVector<ScalarT>& operator=(
+                HybridSparseVector<ScalarT> &&rhs)
+            {
+                if (this != &rhs)
+                {
+                    if (m_size != rhs.m_size)
+                    {
+                        throw DimensionException();
+                    }
+
+                    swap(rhs);
+                    rhs.clear();
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Exchange the contents (and sizes) of two vectors in
+             *        constant time.
+             */
+            void swap(HybridSparseVector<ScalarT> &rhs)
+            {
+                std::swap(m_size, rhs.m_size);
+                std::swap(m_nvals, rhs.m_nvals);
+                std::swap(m_is_bitmap, rhs.m_is_bitmap);
+                std::swap(m_insert_work, rhs.m_insert_work);
+                m_indices.swap(rhs.m_indices);
+                m_values.swap(rhs.m_values);
+                m_vals.swap(rhs.m_vals);
+                m_bitmap.swap(rhs.m_bitmap);
+            }
+
+            /**
+             * @brief Assignment from a dense vector.
+             *
+             * @param[in]  rhs  The dense vector to assign to this vector.
+             *
+             * @return *this.
+             */
+            HybridSparseVector<ScalarT>& operator=(std::vector<ScalarT> const &rhs)
+            {
+                if (rhs.size() != m_size)
+                {
+                    throw DimensionException();
+                }
+                release_list();
+                m_vals = rhs;
+                m_bitmap.assign(m_size, true);
+                m_nvals = m_size;
+                m_is_bitmap = true;
+                m_insert_work = 0;
+                return *this;
+            }
+
+            // EQUALITY OPERATORS
+            /**
+             * @brief Equality testing for HybridSparseVector (regardless of
+             *        the form each side is held in).
+             * @param rhs The right hand side of the equality operation.
+             * @return If this HybridSparseVector and rhs are identical.
+             */
+            bool operator==(HybridSparseVector<ScalarT> const &rhs) const
+            {
+                if ((m_size != rhs.m_size) || (m_nvals != rhs.m_nvals))
+                {
+                    return false;
+                }
+
+                ContentsType lhs_contents(getContents());
+                ContentsType rhs_contents(rhs.getContents());
+                auto rhs_it(rhs_contents.begin());
+                for (auto&& elt : lhs_contents)
+                {
+                    if ((std::get<0>(elt) != std::get<0>(*rhs_it)) ||
+                        (std::get<1>(elt) != std::get<1>(*rhs_it)))
+                    {
+                        return false;
+                    }
+                    ++rhs_it;
+                }
+
+                return true;
+            }
+
+            /**
+             * @brief Inequality testing for HybridSparseVector.
+             * @param rhs The right hand side of the inequality operation.
+             * @return If this HybridSparseVector and rhs are not identical.
+             */
+            bool operator!=(HybridSparseVector<ScalarT> const &rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+            // FUNCTIONS
+
+            /**
+             * Replace the contents with the given (index, value) pairs,
+             * combining values at the same index with dup (in the order
+             * they are given).
+             */
+            template<typename RAIteratorIT,
+                     typename RAIteratorVT,
+                     typename BinaryOpT = GraphBLAS::Second<ScalarType> >
+            void build(RAIteratorIT  i_it,
+                       RAIteratorVT  v_it,
+                       IndexType     nvals,
+                       BinaryOpT     dup = BinaryOpT())
+            {
+                for (IndexType idx = 0; idx < nvals; ++idx)
+                {
+                    if (i_it[idx] >= m_size)
+                    {
+                        throw IndexOutOfBoundsException();
+                    }
+                }
+
+                if (dense_enough(nvals))
+                {
+                    // Scatter straight into a bitmap.
+                    std::vector<ScalarType> vals(m_size);
+                    std::vector<bool> bitmap(m_size, false);
+                    IndexType num_vals(0);
+
+                    for (IndexType idx = 0; idx < nvals; ++idx)
+                    {
+                        IndexType i = i_it[idx];
+                        if (bitmap[i] == true)
+                        {
+                            vals[i] = dup(vals[i], v_it[idx]);
+                        }
+                        else
+                        {
+                            vals[i] = v_it[idx];
+                            bitmap[i] = true;
+                            ++num_vals;
+                        }
+                    }
+
+                    release_list();
+                    m_vals.swap(vals);
+                    m_bitmap.swap(bitmap);
+                    m_nvals = num_vals;
+                    m_is_bitmap = true;
+                }
+                else
+                {
+                    // Stable sort of the positions by index keeps duplicates
+                    // in input order for dup.
+                    std::vector<IndexType> order(nvals);
+                    std::iota(order.begin(), order.end(), 0);
+                    std::stable_sort(order.begin(), order.end(),
+                                     [&](IndexType a, IndexType b)
+                                     { return i_it[a] < i_it[b]; });
+
+                    std::vector<IndexType> indices;
+                    std::vector<ScalarType> values;
+                    indices.reserve(nvals);
+                    values.reserve(nvals);
+                    for (auto pos : order)
+                    {
+                        IndexType i = i_it[pos];
+                        if (!indices.empty() && (indices.back() == i))
+                        {
+                            values.back() = dup(values.back(), v_it[pos]);
+                        }
+                        else
+                        {
+                            indices.push_back(i);
+                            values.push_back(v_it[pos]);
+                        }
+                    }
+
+                    release_bitmap();
+                    m_indices.swap(indices);
+                    m_values.swap(values);
+                    m_nvals = m_indices.size();
+                    m_is_bitmap = false;
+                }
+                m_insert_work = 0;
+            }
+
+            void clear()
+            {
+                m_nvals = 0;
+                m_is_bitmap = false;
+                m_insert_work = 0;
+                m_indices.clear();
+                m_values.clear();
+                release_bitmap();
+            }
+
+            IndexType size() const { return m_size; }
+            IndexType nvals() const { return m_nvals; }
+
+            /// True if the elements are currently held in a bitmap.
+            bool isBitmap() const { return m_is_bitmap; }
+
+            bool hasElement(IndexType index) const
+            {
+                if (index >= m_size)
+                {
+                    throw IndexOutOfBoundsException();
+                }
+
+                if (m_is_bitmap)
+                {
+                    return m_bitmap[index];
+                }
+                return std::binary_search(m_indices.begin(), m_indices.end(),
+                                          index);
+            }
+
+            /**
+             * @brief Access the elements of this HybridSparseVector given index.
+             *
+             * @param[in] index  Position to access.
+             *
+             * @return The element of this HybridSparseVector at the given
+             *         index.
+             */
+            ScalarT extractElement(IndexType index) const
+            {
+                if (index >= m_size)
+                {
+                    throw IndexOutOfBoundsException();
+                }
+
+                if (m_is_bitmap)
+                {
+                    if (m_bitmap[index] == false)
+                    {
+                        throw NoValueException();
+                    }
+                    return m_vals[index];
+                }
+
+                auto it(std::lower_bound(m_indices.begin(), m_indices.end(),
+                                         index));
+                if ((it == m_indices.end()) || (*it != index))
+                {
+                    throw NoValueException();
+                }
+                return m_values[it - m_indices.begin()];
+            }
+
+            /**
+             * Setting elements in increasing index order appends to the
+             * list.  Inserting anywhere else shifts the values after it;
+             * once the shifting has cost as much as a bitmap would, the
+             * vector switches to a bitmap.
+             */
+            void setElement(IndexType      index,
+                            ScalarT const &new_val)
+            {
+                if (index >= m_size)
+                {
+                    throw IndexOutOfBoundsException();
+                }
+
+                if (m_is_bitmap)
+                {
+                    m_vals[index] = new_val;
+                    if (m_bitmap[index] == false)
+                    {
+                        ++m_nvals;
+                        m_bitmap[index] = true;
+                    }
+                    return;
+                }
+
+                auto it(std::lower_bound(m_indices.begin(), m_indices.end(),
+                                         index));
+                IndexType pos(it - m_indices.begin());
+                if ((it != m_indices.end()) && (*it == index))
+                {
+                    m_values[pos] = new_val;
+                    return;
+                }
+
+                m_insert_work += m_nvals - pos;
+                m_indices.insert(it, index);
+                m_values.insert(m_values.begin() + pos, new_val);
+                ++m_nvals;
+
+                if (dense_enough(m_nvals) || (m_insert_work > m_size))
+                {
+                    to_bitmap();
+                }
+            }
+
+            template<typename RAIteratorIT,
+                     typename RAIteratorVT>
+            void extractTuples(RAIteratorIT        i_it,
+                               RAIteratorVT        v_it) const
+            {
+                for (auto&& elt : getContents())
+                {
+                    *i_it = std::get<0>(elt); ++i_it;
+                    *v_it = std::get<1>(elt); ++v_it;
+                }
+            }
+
+            void extractTuples(IndexArrayType        &indices,
+                               std::vector<ScalarT>  &values) const
+            {
+                extractTuples(indices.begin(), values.begin());
+            }
+
+            // output specific to the storage layout of this type of vector
+            void printInfo(std::ostream &os) const
+            {
+                ContentsType contents(getContents());
+                auto it(contents.begin());
+                os << "[";
+                for (IndexType idx = 0; idx < m_size; ++idx)
+                {
+                    if (idx > 0) os << ", ";
+                    if ((it != contents.end()) && (std::get<0>(*it) == idx))
+                    {
+                        os << std::get<1>(*it);
+                        ++it;
+                    }
+                    else
+                    {
+                        os << "-";
+                    }
+                }
+                os << "]";
+            }
+
+            friend std::ostream &operator<<(std::ostream             &os,
+                                            HybridSparseVector<ScalarT> const &vec)
+            {
+                vec.printInfo(os);
+                return os;
+            }
+
+            typedef HybridView<ScalarT> const ContentsType;
+            ContentsType getContents() const
+            {
+                return ContentsType(
+                    SparseView<ScalarT>(
+                        m_indices.data(),
+                        value_iterator<ScalarT>::begin(m_values),
+                        m_is_bitmap ? 0 : m_nvals),
+                    BitmapView<ScalarT>(m_bitmap, m_vals,
+                                        m_is_bitmap ? m_nvals : 0),
+                    m_is_bitmap);
+            }
+
+            template <typename OtherScalarT>
+            void setContents(
+                std::vector<std::tuple<IndexType,OtherScalarT> > const &contents)
+            {
+                IndexType nvals(contents.size());
+                bool use_bitmap(m_is_bitmap ? !sparse_enough(nvals)
+                                            : dense_enough(nvals));
+
+                if (use_bitmap)
+                {
+                    release_list();
+                    m_vals.resize(m_size);
+                    m_bitmap.assign(m_size, false);
+                    for (auto&& tupl : contents)
+                    {
+                        m_bitmap[std::get<0>(tupl)] = true;
+                        m_vals[std::get<0>(tupl)] =
+                            static_cast<ScalarT>(std::get<1>(tupl));
+                    }
+                }
+                else
+                {
+                    release_bitmap();
+                    m_indices.clear();
+                    m_values.clear();
+                    m_indices.reserve(nvals);
+                    m_values.reserve(nvals);
+                    for (auto&& tupl : contents)
+                    {
+                        m_indices.push_back(std::get<0>(tupl));
+                        m_values.push_back(
+                            static_cast<ScalarT>(std::get<1>(tupl)));
+                    }
+                }
+
+                m_nvals = nvals;
+                m_is_bitmap = use_bitmap;
+                m_insert_work = 0;
+            }
+
+        private:
+            bool dense_enough(IndexType nvals) const
+            {
+                return nvals > m_size/8;
+            }
+
+            bool sparse_enough(IndexType nvals) const
+            {
+                return nvals < m_size/32;
+            }
+
+            /// Pick the form for the current number of stored values.
+            void choose_form()
+            {
+                if (!m_is_bitmap && dense_enough(m_nvals))
+                {
+                    to_bitmap();
+                }
+                else if (m_is_bitmap && sparse_enough(m_nvals))
+                {
+                    to_list();
+                }
+            }
+
+            void to_bitmap()
+            {
+                m_vals.resize(m_size);
+                m_bitmap.assign(m_size, false);
+                for (IndexType ix = 0; ix < m_nvals; ++ix)
+                {
+                    m_bitmap[m_indices[ix]] = true;
+                    m_vals[m_indices[ix]] = m_values[ix];
+                }
+                release_list();
+                m_is_bitmap = true;
+                m_insert_work = 0;
+            }
+
+            void to_list()
+            {
+                m_indices.clear();
+                m_values.clear();
+                m_indices.reserve(m_nvals);
+                m_values.reserve(m_nvals);
+                for (IndexType idx = 0; idx < m_size; ++idx)
+                {
+                    if (m_bitmap[idx])
+                    {
+                        m_indices.push_back(idx);
+                        m_values.push_back(m_vals[idx]);
+                    }
+                }
+                release_bitmap();
+                m_is_bitmap = false;
+            }
+
+            // Give the memory of the unused form back.
+            void release_list()
+            {
+                std::vector<IndexType>().swap(m_indices);
+                std::vector<ScalarT>().swap(m_values);
+            }
+
+            void release_bitmap()
+            {
+                std::vector<ScalarT>().swap(m_vals);
+                std::vector<bool>().swap(m_bitmap);
+            }
+
+            IndexType              m_size;   // only changed by swap()
+            IndexType              m_nvals;
+            bool                   m_is_bitmap;
+            IndexType              m_insert_work; // values shifted by setElement
+
+            // Sorted list form
+            std::vector<IndexType> m_indices;
+            std::vector<ScalarT>   m_values;
+
+            // Bitmap form
+            std::vector<ScalarT>   m_vals;
+            std::vector<bool>      m_bitmap;
+        };
+    } // backend
+} // GraphBLAS
+
+
+
+#endif // GB_SEQUENTIAL_HYBRIDSPARSEVECTOR_HPP
@@ -0,0 +1,719 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#ifndef GB_SEQUENTIAL_HYPERSPARSEMATRIX_HPP
+#define GB_SEQUENTIAL_HYPERSPARSEMATRIX_HPP
+
+#include <iostream>
+#include <vector>
+#include <tuple>
+#include <algorithm>
+#include <typeinfo>
+#include <stdexcept>
+#include <utility>
+
+#include <graphblas/graphblas.hpp>
+#include <graphblas/platforms/sequential/build_helpers.hpp>
+#include <graphblas/platforms/sequential/SparseView.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /**
+         * @brief Hypersparse (doubly compressed sparse row, DCSR) storage:
+         *        CSR arrays for the non-empty rows only, plus the sorted
+         *        list of which rows those are.
+         *
+         * Nothing is allocated per row, so the dimensions can be as large
+         * as IndexType allows (e.g., 64 bit hashed vertex IDs, or n x 1
+         * matrices with a handful of values).  A row lookup is a binary
+         * search of the non-empty rows, and nonEmptyRows() lets the
+         * operations loop over the rows that hold values instead of all
+         * nrows() of them.
+         *
+         * As with CsrSparseMatrix, setting rows in increasing row order
+         * appends; updates anywhere else shift the trailing storage.
+         */
+        template<typename ScalarT, typename... TagsT>
+        class HypersparseMatrix
+        {
+        public:
+            typedef ScalarT ScalarType;
+
+            // Constructor
+            HypersparseMatrix(IndexType num_rows,
+                              IndexType num_cols)
+                : m_num_rows(num_rows),
+                  m_num_cols(num_cols),
+                  m_row_ptr(1, 0)
+            {
+            }
+
+            // Constructor - copy
+            HypersparseMatrix(HypersparseMatrix<ScalarT> const &rhs)
+                : m_num_rows(rhs.m_num_rows),
+                  m_num_cols(rhs.m_num_cols),
+                  m_row_ids(rhs.m_row_ids),
+                  m_row_ptr(rhs.m_row_ptr),
+                  m_col_idx(rhs.m_col_idx),
+                  m_vals(rhs.m_vals)
+            {
+            }
+
+            // Constructor - move (rhs is left empty, with the same dimensions)
+            HypersparseMatrix(HypersparseMatrix<ScalarT> &&rhs)
+                : HypersparseMatrix(rhs.m_num_rows, rhs.m_num_cols)
+            {
+                swap(rhs);
+            }
+
+            // Constructor - dense from dense matrix
+            HypersparseMatrix(std::vector<std::vector<ScalarT>> const &val)
+                : m_num_rows(val.size()),
+                  m_num_cols(val[0].size()),
+                  m_row_ptr(1, 0)
+            {
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    if (val[ii].size() != m_num_cols)
+                    {
+                        throw DimensionException("HypersparseMatrix(dense ctor)");
+                    }
+
+                    for (IndexType jj = 0; jj < m_num_cols; jj++)
+                    {
+                        m_col_idx.push_back(jj);
+                        m_vals.push_back(val[ii][jj]);
+                    }
+                    append_row(ii);
+                }
+            }
+
+            // Constructor - sparse from dense matrix, removing specifed implied zeros
+            HypersparseMatrix(std::vector<std::vector<ScalarT>> const &val,
+                              ScalarT zero)
+                : m_num_rows(val.size()),
+                  m_num_cols(val[0].size()),
+                  m_row_ptr(1, 0)
+            {
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    if (val[ii].size() != m_num_cols)
+                    {
+                        throw DimensionException("HypersparseMatrix(dense ctor)");
+                    }
+
+                    for (IndexType jj = 0; jj < m_num_cols; jj++)
+                    {
+                        if (val[ii][jj] != zero)
+                        {
+                            m_col_idx.push_back(jj);
+                            m_vals.push_back(val[ii][jj]);
+                        }
+                    }
+                    append_row(ii);
+                }
+            }
+
+            // Destructor
+            ~HypersparseMatrix()
+            {}
+
+            // Assignment (currently restricted to same dimensions)
+            HypersparseMatrix<ScalarT> &operator=(
+                HypersparseMatrix<ScalarT> const &rhs)
+            {
+                if (this != &rhs)
+                {
+                    // push this check to frontend
+                    if ((m_num_rows != rhs.m_num_rows) ||
+                        (m_num_cols != rhs.m_num_cols))
+                    {
+                        throw DimensionException();
+                    }
+
+                    m_row_ids = rhs.m_row_ids;
+                    m_row_ptr = rhs.m_row_ptr;
+                    m_col_idx = rhs.m_col_idx;
+                    m_vals = rhs.m_vals;
+                }
+                return *this;
+            }
+
+            // Move assignment (currently restricted to same dimensions),
+            // rhs is left empty
+            HypersparseMatrix<ScalarT> &operator=(
+                HypersparseMatrix<ScalarT> &&rhs)
+            {
+                if (this != &rhs)
+                {
+                    if ((m_num_rows != rhs.m_num_rows) ||
+                        (m_num_cols != rhs.m_num_cols))
+                    {
+                        throw DimensionException();
+                    }
+
+                    swap(rhs);
+                    rhs.clear();
+                }
+                return *this;
+            }
+
+            // Exchange contents (and dimensions) with rhs in constant time
+            void swap(HypersparseMatrix<ScalarT> &rhs)
+            {
+                std::swap(m_num_rows, rhs.m_num_rows);
+                std::swap(m_num_cols, rhs.m_num_cols);
+                m_row_ids.swap(rhs.m_row_ids);
+                m_row_ptr.swap(rhs.m_row_ptr);
+                m_col_idx.swap(rhs.m_col_idx);
+                m_vals.swap(rhs.m_vals);
+            }
+
+            // EQUALITY OPERATORS
+            /**
+             * @brief Equality testing for HypersparseMatrix.
+             * @param rhs The right hand side of the equality operation.
+             * @return If this HypersparseMatrix and rhs are identical.
+             */
+            bool operator==(HypersparseMatrix<ScalarT> const &rhs) const
+            {
+                // Only non-empty rows are listed, so the arrays are unique
+                return ((m_num_rows == rhs.m_num_rows) &&
+                        (m_num_cols == rhs.m_num_cols) &&
+                        (m_row_ids == rhs.m_row_ids) &&
+                        (m_row_ptr == rhs.m_row_ptr) &&
+                        (m_col_idx == rhs.m_col_idx) &&
+                        (m_vals == rhs.m_vals));
+            }
+
+            /**
+             * @brief Inequality testing for HypersparseMatrix.
+             * @param rhs The right hand side of the inequality operation.
+             * @return If this HypersparseMatrix and rhs are not identical.
+             */
+            bool operator!=(HypersparseMatrix<ScalarT> const &rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+            /**
+             * Bulk build: sort the tuples by row and column and combine
+             * duplicates (and any values already stored) with dup, then
+             * fill the arrays in one pass.
+             */
+            template<typename RAIteratorI,
+                     typename RAIteratorJ,
+                     typename RAIteratorV,
+                     typename DupT>
+            void build(RAIteratorI  i_it,
+                       RAIteratorJ  j_it,
+                       RAIteratorV  v_it,
+                       IndexType    n,
+                       DupT         dup)
+            {
+                std::vector<IndexType> row_ids;
+                std::vector<IndexType> row_ptr;
+                std::vector<std::tuple<IndexType, ScalarT> > entries;
+
+                sort_build_tuples_hypersparse(*this, i_it, j_it, v_it, n, dup,
+                                              row_ids, row_ptr, entries);
+
+                m_col_idx.clear();
+                m_vals.clear();
+                m_col_idx.reserve(entries.size());
+                m_vals.reserve(entries.size());
+                for (auto&& entry : entries)
+                {
+                    m_col_idx.push_back(std::get<0>(entry));
+                    m_vals.push_back(std::get<1>(entry));
+                }
+                m_row_ids.swap(row_ids);
+                m_row_ptr.swap(row_ptr);
+            }
+
+            void clear()
+            {
+                m_row_ids.clear();
+                m_row_ptr.assign(1, 0);
+                m_col_idx.clear();
+                m_vals.clear();
+            }
+
+            IndexType nrows() const { return m_num_rows; }
+            IndexType ncols() const { return m_num_cols; }
+            IndexType nvals() const { return m_col_idx.size(); }
+
+            /// The rows that hold at least one value, in increasing order.
+            std::vector<IndexType> const &nonEmptyRows() const
+            {
+                return m_row_ids;
+            }
+
+            bool hasElement(IndexType irow, IndexType icol) const
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "get_value_at: index out of bounds");
+                }
+
+                IndexType slot, ix;
+                return find(irow, icol, slot, ix);
+            }
+
+            // Get value at index
+            ScalarT extractElement(IndexType irow, IndexType icol) const
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "get_value_at: index out of bounds");
+                }
+
+                IndexType slot, ix;
+                if (!find(irow, icol, slot, ix))
+                {
+                    throw NoValueException("get_value_at: no entry at index");
+                }
+                return m_vals[ix];
+            }
+
+            // Set value at index
+            void setElement(IndexType irow, IndexType icol, ScalarT const &val)
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException("setElement: index out of bounds");
+                }
+
+                IndexType slot, ix;
+                if (find(irow, icol, slot, ix))
+                {
+                    m_vals[ix] = val;
+                }
+                else
+                {
+                    insert(irow, slot, ix, icol, val);
+                }
+            }
+
+            // Set value at index + 'merge' with any existing value
+            // according to the BinaryOp passed.
+            template <typename BinaryOpT>
+            void setElement(IndexType irow, IndexType icol, ScalarT const &val,
+                            BinaryOpT merge)
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "setElement(merge): index out of bounds");
+                }
+
+                IndexType slot, ix;
+                if (find(irow, icol, slot, ix))
+                {
+                    m_vals[ix] = merge(m_vals[ix], val);
+                }
+                else
+                {
+                    insert(irow, slot, ix, icol, val);
+                }
+            }
+
+            typedef SparseView<ScalarT> const RowType;
+            RowType getRow(IndexType row_index) const
+            {
+                IndexType slot(row_slot(row_index));
+                if (!has_row(slot, row_index))
+                {
+                    return RowType();
+                }
+
+                IndexType first(m_row_ptr[slot]);
+                return RowType(m_col_idx.data() + first,
+                               value_iterator<ScalarT>::begin(m_vals) + first,
+                               m_row_ptr[slot + 1] - first);
+            }
+
+            // Allow casting
+            template <typename RowT>
+            void setRow(
+                IndexType row_index,
+                RowT const &row_data)
+            {
+                if (m_row_ids.empty() || (row_index > m_row_ids.back()))
+                {
+                    // Appending after the last stored row
+                    for (auto&& tupl : row_data)
+                    {
+                        m_col_idx.push_back(std::get<0>(tupl));
+                        m_vals.push_back(static_cast<ScalarT>(std::get<1>(tupl)));
+                    }
+                    append_row(row_index);
+                    return;
+                }
+
+                IndexType slot(row_slot(row_index));
+                IndexType new_nvals(row_data.size());
+                IndexType first, old_nvals;
+
+                if (has_row(slot, row_index))
+                {
+                    first = m_row_ptr[slot];
+                    old_nvals = m_row_ptr[slot + 1] - first;
+                    if (new_nvals == 0)
+                    {
+                        // The row is no longer listed
+                        resize_row(slot, first, old_nvals, 0);
+                        m_row_ids.erase(m_row_ids.begin() + slot);
+                        m_row_ptr.erase(m_row_ptr.begin() + slot + 1);
+                        return;
+                    }
+                }
+                else
+                {
+                    if (new_nvals == 0)
+                    {
+                        return;
+                    }
+                    first = m_row_ptr[slot];
+                    old_nvals = 0;
+                    m_row_ids.insert(m_row_ids.begin() + slot, row_index);
+                    m_row_ptr.insert(m_row_ptr.begin() + slot + 1, first);
+                }
+
+                resize_row(slot, first, old_nvals, new_nvals);
+
+                IndexType ix(first);
+                for (auto&& tupl : row_data)
+                {
+                    m_col_idx[ix] = std::get<0>(tupl);
+                    m_vals[ix] = static_cast<ScalarT>(std::get<1>(tupl));
+                    ++ix;
+                }
+            }
+
+            /// @note Columns require a binary search of every non-empty
+            ///       row.
+            typedef std::vector<std::tuple<IndexType, ScalarT> > const ColType;
+            ColType getCol(IndexType col_index) const
+            {
+                std::vector<std::tuple<IndexType, ScalarT> > data;
+
+                for (IndexType slot = 0; slot < m_row_ids.size(); ++slot)
+                {
+                    IndexType ix;
+                    if (find_in_slot(slot, col_index, ix))
+                    {
+                        data.push_back(std::make_tuple(m_row_ids[slot],
+                                                       m_vals[ix]));
+                    }
+                }
+
+                return data;
+            }
+
+            // col_data must be in increasing index order.  The storage is
+            // rebuilt in a single pass over the union of the non-empty rows
+            // and the rows of col_data.
+            template <typename ColT>
+            void setCol(
+                IndexType col_index,
+                ColT const &col_data)
+            {
+                std::vector<IndexType> row_ids;
+                std::vector<IndexType> row_ptr(1, 0);
+                std::vector<IndexType> col_idx;
+                std::vector<ScalarT>   vals;
+                col_idx.reserve(nvals() + col_data.size());
+                vals.reserve(nvals() + col_data.size());
+
+                auto it = col_data.begin();
+                IndexType slot(0);
+                while ((slot < m_row_ids.size()) || (it != col_data.end()))
+                {
+                    // Next row of either the storage or col_data
+                    IndexType row_index;
+                    if ((it != col_data.end()) &&
+                        ((slot == m_row_ids.size()) ||
+                         (std::get<0>(*it) <= m_row_ids[slot])))
+                    {
+                        row_index = std::get<0>(*it);
+                    }
+                    else
+                    {
+                        row_index = m_row_ids[slot];
+                    }
+
+                    bool insert_here((it != col_data.end()) &&
+                                     (std::get<0>(*it) == row_index));
+                    if ((slot < m_row_ids.size()) &&
+                        (m_row_ids[slot] == row_index))
+                    {
+                        for (IndexType ix = m_row_ptr[slot];
+                             ix < m_row_ptr[slot + 1]; ++ix)
+                        {
+                            if (insert_here && (m_col_idx[ix] >= col_index))
+                            {
+                                col_idx.push_back(col_index);
+                                vals.push_back(
+                                    static_cast<ScalarT>(std::get<1>(*it)));
+                                insert_here = false;
+                                ++it;
+                            }
+                            if (m_col_idx[ix] != col_index)
+                            {
+                                col_idx.push_back(m_col_idx[ix]);
+                                vals.push_back(m_vals[ix]);
+                            }
+                        }
+                        ++slot;
+                    }
+                    if (insert_here)
+                    {
+                        col_idx.push_back(col_index);
+                        vals.push_back(static_cast<ScalarT>(std::get<1>(*it)));
+                        ++it;
+                    }
+
+                    if (col_idx.size() > row_ptr.back())
+                    {
+                        row_ids.push_back(row_index);
+                        row_ptr.push_back(col_idx.size());
+                    }
+                }
+
+                m_row_ids.swap(row_ids);
+                m_row_ptr.swap(row_ptr);
+                m_col_idx.swap(col_idx);
+                m_vals.swap(vals);
+            }
+
+            // Get column indices for a given row
+            void getColumnIndices(IndexType irow, IndexArrayType &v) const
+            {
+                if (irow >= m_num_rows)
+                {
+                    throw IndexOutOfBoundsException(
+                        "getColumnIndices: index out of bounds");
+                }
+
+                IndexType slot(row_slot(irow));
+                if (has_row(slot, irow))
+                {
+                    v.assign(m_col_idx.begin() + m_row_ptr[slot],
+                             m_col_idx.begin() + m_row_ptr[slot + 1]);
+                }
+            }
+
+            // Get row indices for a given column
+            void getRowIndices(IndexType icol, IndexArrayType &v) const
+            {
+                if (icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "getRowIndices: index out of bounds");
+                }
+
+                v.resize(0);
+                for (IndexType slot = 0; slot < m_row_ids.size(); ++slot)
+                {
+                    IndexType ix;
+                    if (find_in_slot(slot, icol, ix))
+                    {
+                        v.push_back(m_row_ids[slot]);
+                    }
+                }
+            }
+
+            template<typename RAIteratorIT,
+                     typename RAIteratorJT,
+                     typename RAIteratorVT>
+            void extractTuples(RAIteratorIT        row_it,
+                               RAIteratorJT        col_it,
+                               RAIteratorVT        values) const
+            {
+                for (IndexType slot = 0; slot < m_row_ids.size(); ++slot)
+                {
+                    for (IndexType ix = m_row_ptr[slot];
+                         ix < m_row_ptr[slot + 1]; ++ix)
+                    {
+                        *row_it = m_row_ids[slot]; ++row_it;
+                        *col_it = m_col_idx[ix];   ++col_it;
+                        *values = m_vals[ix];      ++values;
+                    }
+                }
+            }
+
+            // output specific to the storage layout of this type of matrix
+            // (only the non-empty rows, whatever the dimensions)
+            void printInfo(std::ostream &os) const
+            {
+                os << "HypersparseMatrix<" << typeid(ScalarT).name() << ">"
+                   << std::endl;
+                os << "dimensions: " << m_num_rows << " x " << m_num_cols
+                   << std::endl;
+                os << "num stored values = " << nvals() << std::endl;
+                for (IndexType slot = 0; slot < m_row_ids.size(); ++slot)
+                {
+                    os << m_row_ids[slot] << " :";
+                    for (IndexType ix = m_row_ptr[slot];
+                         ix < m_row_ptr[slot + 1]; ++ix)
+                    {
+                        os << " " << m_col_idx[ix] << ":" << m_vals[ix];
+                    }
+                    os << std::endl;
+                }
+            }
+
+            friend std::ostream &operator<<(std::ostream                     &os,
+                                            HypersparseMatrix<ScalarT> const &mat)
+            {
+                mat.printInfo(os);
+                return os;
+            }
+
+        protected:
+            // Position of irow in m_row_ids (or where it would be inserted).
+            IndexType row_slot(IndexType irow) const
+            {
+                return std::lower_bound(m_row_ids.begin(), m_row_ids.end(),
+                                        irow) - m_row_ids.begin();
+            }
+
+            bool has_row(IndexType slot, IndexType irow) const
+            {
+                return (slot < m_row_ids.size()) && (m_row_ids[slot] == irow);
+            }
+
+            // Binary search within the row at slot.  If not found, ix is
+            // the offset where icol would be inserted.
+            bool find_in_slot(IndexType slot, IndexType icol,
+                              IndexType &ix) const
+            {
+                auto first(m_col_idx.begin() + m_row_ptr[slot]);
+                auto last(m_col_idx.begin() + m_row_ptr[slot + 1]);
+                auto it(std::lower_bound(first, last, icol));
+                ix = it - m_col_idx.begin();
+                return ((it != last) && (*it == icol));
+            }
+
+            // If not found, slot is where irow is (or would be inserted) in
+            // m_row_ids and ix is where icol would be inserted.
+            bool find(IndexType irow, IndexType icol,
+                      IndexType &slot, IndexType &ix) const
+            {
+                slot = row_slot(irow);
+                if (!has_row(slot, irow))
+                {
+                    ix = m_row_ptr[slot];
+                    return false;
+                }
+                return find_in_slot(slot, icol, ix);
+            }
+
+            // Finish a row whose values were appended to the arrays.
+            void append_row(IndexType irow)
+            {
+                if (m_col_idx.size() > m_row_ptr.back())
+                {
+                    m_row_ids.push_back(irow);
+                    m_row_ptr.push_back(m_col_idx.size());
+                }
+            }
+
+            // Grow or shrink the storage of the row at slot (starting at
+            // offset first) from old_nvals to new_nvals.
+            void resize_row(IndexType slot, IndexType first,
+                            IndexType old_nvals, IndexType new_nvals)
+            {
+                IndexType last(first + old_nvals);
+                if (new_nvals > old_nvals)
+                {
+                    IndexType delta(new_nvals - old_nvals);
+                    m_col_idx.insert(m_col_idx.begin() + last, delta, 0);
+                    m_vals.insert(m_vals.begin() + last, delta, ScalarT());
+                    for (IndexType s = slot + 1; s < m_row_ptr.size(); ++s)
+                    {
+                        m_row_ptr[s] += delta;
+                    }
+                }
+                else if (new_nvals < old_nvals)
+                {
+                    IndexType delta(old_nvals - new_nvals);
+                    m_col_idx.erase(m_col_idx.begin() + first + new_nvals,
+                                    m_col_idx.begin() + last);
+                    m_vals.erase(m_vals.begin() + first + new_nvals,
+                                 m_vals.begin() + last);
+                    for (IndexType s = slot + 1; s < m_row_ptr.size(); ++s)
+                    {
+                        m_row_ptr[s] -= delta;
+                    }
+                }
+            }
+
+            // Insert a new element at offset ix of the row irow (at slot).
+            void insert(IndexType irow, IndexType slot, IndexType ix,
+                        IndexType icol, ScalarT const &val)
+            {
+                if (!has_row(slot, irow))
+                {
+                    m_row_ids.insert(m_row_ids.begin() + slot, irow);
+                    m_row_ptr.insert(m_row_ptr.begin() + slot + 1, ix);
+                }
+                m_col_idx.insert(m_col_idx.begin() + ix, icol);
+                m_vals.insert(m_vals.begin() + ix, val);
+                for (IndexType s = slot + 1; s < m_row_ptr.size(); ++s)
+                {
+                    ++m_row_ptr[s];
+                }
+            }
+
+        protected:
+            IndexType m_num_rows;
+            IndexType m_num_cols;
+
+            // Doubly compressed sparse row storage (DCSR): the non-empty
+            // rows and, for each, its offset in m_col_idx/m_vals.
+            std::vector<IndexType> m_row_ids;
+            std::vector<IndexType> m_row_ptr;   // m_row_ids.size() + 1
+            std::vector<IndexType> m_col_idx;
+            std::vector<ScalarT>   m_vals;
+        };
+
+    } // namespace backend
+
+} // namespace GraphBLAS
+
+#endif // GB_SEQUENTIAL_HYPERSPARSEMATRIX_HPP
@@ -32,10 +32,13 @@
 
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include <typeinfo>
 #include <stdexcept>
+#include <utility>
 
 #include <graphblas/graphblas.hpp>
+#include <graphblas/platforms/sequential/build_helpers.hpp>
 
 //****************************************************************************
 
@@ -69,6 +72,13 @@ namespace GraphBLAS
             {
             }
 
+            // Constructor - move (rhs is left empty, with the same dimensions)
+            LilSparseMatrix(LilSparseMatrix<ScalarT> &&rhs)
+                : LilSparseMatrix(rhs.m_num_rows, rhs.m_num_cols)
+            {
+                swap(rhs);
+            }
+
             // Constructor - dense from dense matrix
             LilSparseMatrix(std::vector<std::vector<ScalarT>> const &val)
                 : m_num_rows(val.size()),
@@ -139,6 +149,33 @@ namespace GraphBLAS
                 return *this;
             }
 
+            // Move assignment (currently restricted to same dimensions),
+            // rhs is left empty
+            LilSparseMatrix<ScalarT> &operator=(LilSparseMatrix<ScalarT> &&rhs)
+            {
+                if (this != &rhs)
+                {
+                    if ((m_num_rows != rhs.m_num_rows) ||
+                        (m_num_cols != rhs.m_num_cols))
+                    {
+                        throw DimensionException();
+                    }
+
+                    swap(rhs);
+                    rhs.clear();
+                }
+                return *this;
+            }
+
+            // Exchange contents (and dimensions) with rhs in constant time
+            void swap(LilSparseMatrix<ScalarT> &rhs)
+            {
+                std::swap(m_num_rows, rhs.m_num_rows);
+                std::swap(m_num_cols, rhs.m_num_cols);
+                std::swap(m_nvals, rhs.m_nvals);
+                m_data.swap(rhs.m_data);
+            }
+
             // EQUALITY OPERATORS
             /**
              * @brief Equality testing for LilMatrix.
@@ -163,6 +200,11 @@ namespace GraphBLAS
                 return !(*this == rhs);
             }
 
+            /**
+             * Bulk build: sort the tuples by row and column and combine
+             * duplicates (and any values already stored) with dup, then
+             * fill each row in one pass.
+             */
             template<typename RAIteratorI,
                      typename RAIteratorJ,
                      typename RAIteratorV,
@@ -175,15 +217,20 @@ namespace GraphBLAS
             {
                 /// @todo should this function throw an error if matrix is not empty
 
-                /// @todo should this function call clear?
-                //clear();
+                std::vector<IndexType> row_ptr;
+                std::vector<std::tuple<IndexType, ScalarT> > entries;
+                sort_build_tuples(*this, i_it, j_it, v_it, n, dup,
+                                  row_ptr, entries);
 
-                /// @todo DOING SOMETHING REALLY STUPID RIGHT NOW
-                for (IndexType ix = 0; ix < n; ++ix)
+#ifdef _OPENMP
+                #pragma omp parallel for schedule(dynamic, 256)
+#endif
+                for (IndexType row = 0; row < m_num_rows; ++row)
                 {
-                    setElement(*i_it, *j_it, *v_it, dup);
-                    ++i_it; ++j_it; ++v_it;
+                    m_data[row].assign(entries.begin() + row_ptr[row],
+                                       entries.begin() + row_ptr[row + 1]);
                 }
+                m_nvals = entries.size();
             }
 
             void clear()
@@ -361,10 +408,10 @@ namespace GraphBLAS
             }
 
             // Allow casting
-            template <typename OtherScalarT>
+            template <typename RowT>
             void setRow(
                 IndexType row_index,
-                std::vector<std::tuple<IndexType, OtherScalarT> > const &row_data)
+                RowT const &row_data)
             {
                 IndexType old_nvals = m_data[row_index].size();
                 IndexType new_nvals = row_data.size();
@@ -372,7 +419,7 @@ namespace GraphBLAS
                 m_nvals = m_nvals + new_nvals - old_nvals;
                 //m_data[row_index] = row_data;   // swap here?
                 m_data[row_index].clear();
-                for (auto &tupl : row_data)
+                for (auto&& tupl : row_data)
                 {
                     m_data[row_index].push_back(
                         std::make_tuple(std::get<0>(tupl),
@@ -392,7 +439,22 @@ namespace GraphBLAS
                 m_data[row_index] = row_data;   // swap here?
             }
 
+            // Take over the contents of a row built elsewhere
+            void setRow(
+                IndexType row_index,
+                std::vector<std::tuple<IndexType, ScalarT> > &&row_data)
+            {
+                IndexType old_nvals = m_data[row_index].size();
+                IndexType new_nvals = row_data.size();
+
+                m_nvals = m_nvals + new_nvals - old_nvals;
+                m_data[row_index] = std::move(row_data);
+            }
+
             /// @todo need move semantics.
+            // A column of row major storage is gathered from every row (by
+            // a binary search of each), so it is returned as a copy rather
+            // than a view.
             typedef std::vector<std::tuple<IndexType, ScalarT> > const ColType;
             ColType getCol(IndexType col_index) const
             {
@@ -400,15 +462,15 @@ namespace GraphBLAS
 
                 for (IndexType ii = 0; ii < m_num_rows; ii++)
                 {
-                    if (!m_data[ii].empty())
+                    auto it(std::lower_bound(
+                                m_data[ii].begin(), m_data[ii].end(), col_index,
+                                [](std::tuple<IndexType, ScalarT> const &elt,
+                                   IndexType                             idx)
+                                { return std::get<0>(elt) < idx; }));
+                    if ((it != m_data[ii].end()) &&
+                        (std::get<0>(*it) == col_index))
                     {
-                        for (auto tupl : m_data[ii])
-                        {
-                            if (std::get<0>(tupl) == col_index)
-                            {
-                                data.push_back(std::make_tuple(ii, std::get<1>(tupl)));
-                            }
-                        }
+                        data.push_back(std::make_tuple(ii, std::get<1>(*it)));
                     }
                 }
 
@@ -417,10 +479,10 @@ namespace GraphBLAS
 
             // col_data must be in increasing index order
             /// @todo this could be vastly improved.
-            template <typename OtherScalarT>
+            template <typename ColT>
             void setCol(
                 IndexType col_index,
-                std::vector<std::tuple<IndexType, OtherScalarT> > const &col_data)
+                ColT const &col_data)
             {
                 auto it = col_data.begin();
                 for (IndexType row_index = 0; row_index < m_num_rows; row_index++)
@@ -560,9 +622,9 @@ namespace GraphBLAS
             template<typename RAIteratorIT,
                      typename RAIteratorJT,
                      typename RAIteratorVT>
-            ScalarT extractTuples(RAIteratorIT        row_it,
-                                  RAIteratorJT        col_it,
-                                  RAIteratorVT        values) const
+            void extractTuples(RAIteratorIT        row_it,
+                               RAIteratorJT        col_it,
+                               RAIteratorVT        values) const
             {
                 for (IndexType row = 0; row < m_data.size(); ++row)
                 {
@@ -0,0 +1,499 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_SEQUENTIAL_MAPPEDCSRSPARSEMATRIX_HPP
+#define GB_SEQUENTIAL_MAPPEDCSRSPARSEMATRIX_HPP
+
+#include <iostream>
+#include <vector>
+#include <tuple>
+#include <memory>
+#include <string>
+#include <utility>
+#include <algorithm>
+
+#include <graphblas/graphblas.hpp>
+#include <graphblas/io/binary_format.hpp>
+#include <graphblas/platforms/sequential/CsrSparseMatrix.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /**
+         * @brief CSR storage that can use the sections of a memory mapped
+         *        binary file (see io/binary_format.hpp) in place.
+         *
+         * A matrix constructed from a file name reads its row offsets,
+         * column indices and values straight from the mapping, so loading
+         * costs O(1) regardless of the size of the file, and copies of the
+         * matrix share the mapping.  The first modification copies the
+         * mapped arrays into ordinary CsrSparseMatrix storage (clear() just
+         * drops the mapping); after that it behaves like CsrSparseMatrix.
+         *
+         * @note Only the header and the first and last row offsets are
+         *       checked when a file is mapped; the arrays are trusted to be
+         *       as written by io::write_binary_matrix().
+         */
+        template<typename ScalarT, typename... TagsT>
+        class MappedCsrSparseMatrix : public CsrSparseMatrix<ScalarT>
+        {
+        private:
+            typedef CsrSparseMatrix<ScalarT> ParentMatrixType;
+
+        public:
+            typedef ScalarT ScalarType;
+
+            // Constructor
+            MappedCsrSparseMatrix(IndexType num_rows,
+                                  IndexType num_cols)
+                : ParentMatrixType(num_rows, num_cols)
+            {
+            }
+
+            // Constructor - map a matrix stored in a binary file
+            MappedCsrSparseMatrix(std::string const &filename)
+                : ParentMatrixType(0, 0),
+                  m_file(std::make_shared<io::MappedFile>(filename))
+            {
+                io::BinaryHeader const &header(
+                    io::mapped_binary_header(*m_file, filename));
+                io::check_binary_header<ScalarT>(header, m_file->size(),
+                                                 io::BINARY_MATRIX, filename);
+
+                this->m_num_rows = header.nrows;
+                this->m_num_cols = header.ncols;
+                m_map_nvals   = header.nvals;
+                m_map_row_ptr = m_file->section<IndexType>(header.row_ptr_offset);
+                m_map_col_idx = m_file->section<IndexType>(header.index_offset);
+                m_map_vals    = m_file->section<ScalarT>(header.value_offset);
+
+                if ((m_map_row_ptr[0] != 0) ||
+                    (m_map_row_ptr[header.nrows] != m_map_nvals))
+                {
+                    throw InvalidValueException(
+                        "MappedCsrSparseMatrix: " + filename + " is corrupt");
+                }
+            }
+
+            // Constructor - copy (shares the mapping)
+            MappedCsrSparseMatrix(MappedCsrSparseMatrix<ScalarT> const &rhs)
+                : ParentMatrixType(rhs),
+                  m_file(rhs.m_file),
+                  m_map_nvals(rhs.m_map_nvals),
+                  m_map_row_ptr(rhs.m_map_row_ptr),
+                  m_map_col_idx(rhs.m_map_col_idx),
+                  m_map_vals(rhs.m_map_vals)
+            {
+            }
+
+            // Constructor - move (takes over the mapping; rhs is left empty,
+            // with the same dimensions)
+            MappedCsrSparseMatrix(MappedCsrSparseMatrix<ScalarT> &&rhs)
+                : MappedCsrSparseMatrix(rhs.m_num_rows, rhs.m_num_cols)
+            {
+                swap(rhs);
+            }
+
+            // Constructor - dense from dense matrix
+            MappedCsrSparseMatrix(std::vector<std::vector<ScalarT>> const &val)
+                : ParentMatrixType(val)
+            {
+            }
+
+            // Constructor - sparse from dense matrix, removing specifed implied zeros
+            MappedCsrSparseMatrix(std::vector<std::vector<ScalarT>> const &val,
+                                  ScalarT zero)
+                : ParentMatrixType(val, zero)
+            {
+            }
+
+            // Destructor
+            ~MappedCsrSparseMatrix()
+            {}
+
+            // Assignment (currently restricted to same dimensions)
+            MappedCsrSparseMatrix<ScalarT> &operator=(
+                MappedCsrSparseMatrix<ScalarT> const &rhs)
+            {
+                if (this != &rhs)
+                {
+                    if ((this->m_num_rows != rhs.m_num_rows) ||
+                        (this->m_num_cols != rhs.m_num_cols))
+                    {
+                        throw DimensionException();
+                    }
+
+                    ParentMatrixType::operator=(rhs);
+                    m_file    = rhs.m_file;
+                    m_map_nvals   = rhs.m_map_nvals;
+                    m_map_row_ptr = rhs.m_map_row_ptr;
+                    m_map_col_idx = rhs.m_map_col_idx;
+                    m_map_vals    = rhs.m_map_vals;
+                }
+                return *this;
+            }
+
+            // Move assignment (currently restricted to same dimensions),
+            // rhs is left empty
+            MappedCsrSparseMatrix<ScalarT> &operator=(
+                MappedCsrSparseMatrix<ScalarT> &&rhs)
+            {
+                if (this != &rhs)
+                {
+                    if ((this->m_num_rows != rhs.m_num_rows) ||
+                        (this->m_num_cols != rhs.m_num_cols))
+                    {
+                        throw DimensionException();
+                    }
+
+                    swap(rhs);
+                    rhs.clear();
+                }
+                return *this;
+            }
+
+            // Exchange contents (and dimensions) with rhs in constant time
+            void swap(MappedCsrSparseMatrix<ScalarT> &rhs)
+            {
+                ParentMatrixType::swap(rhs);
+                m_file.swap(rhs.m_file);
+                std::swap(m_map_nvals,   rhs.m_map_nvals);
+                std::swap(m_map_row_ptr, rhs.m_map_row_ptr);
+                std::swap(m_map_col_idx, rhs.m_map_col_idx);
+                std::swap(m_map_vals,    rhs.m_map_vals);
+            }
+
+            bool operator==(MappedCsrSparseMatrix<ScalarT> const &rhs) const
+            {
+                if (!m_file && !rhs.m_file)
+                {
+                    return ParentMatrixType::operator==(rhs);
+                }
+
+                if ((this->m_num_rows != rhs.m_num_rows) ||
+                    (this->m_num_cols != rhs.m_num_cols) ||
+                    (nvals() != rhs.nvals()))
+                {
+                    return false;
+                }
+                for (IndexType row = 0; row < this->m_num_rows; ++row)
+                {
+                    if (getRow(row) != rhs.getRow(row))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            bool operator!=(MappedCsrSparseMatrix<ScalarT> const &rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+            /// True while the matrix reads from a mapped file
+            bool isMapped() const { return (bool)m_file; }
+
+            template<typename RAIteratorI,
+                     typename RAIteratorJ,
+                     typename RAIteratorV,
+                     typename DupT>
+            void build(RAIteratorI  i_it,
+                       RAIteratorJ  j_it,
+                       RAIteratorV  v_it,
+                       IndexType    n,
+                       DupT         dup)
+            {
+                unmap();
+                ParentMatrixType::build(i_it, j_it, v_it, n, dup);
+            }
+
+            void clear()
+            {
+                if (m_file)
+                {
+                    m_file.reset();
+                    this->m_row_ptr.assign(this->m_num_rows + 1, 0);
+                }
+                ParentMatrixType::clear();
+            }
+
+            IndexType nvals() const
+            {
+                return m_file ? m_map_nvals : ParentMatrixType::nvals();
+            }
+
+            bool hasElement(IndexType irow, IndexType icol) const
+            {
+                if (!m_file)
+                {
+                    return ParentMatrixType::hasElement(irow, icol);
+                }
+
+                if (irow >= this->m_num_rows || icol >= this->m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "get_value_at: index out of bounds");
+                }
+
+                IndexType ix;
+                return mapped_find(irow, icol, ix);
+            }
+
+            ScalarT extractElement(IndexType irow, IndexType icol) const
+            {
+                if (!m_file)
+                {
+                    return ParentMatrixType::extractElement(irow, icol);
+                }
+
+                if (irow >= this->m_num_rows || icol >= this->m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "get_value_at: index out of bounds");
+                }
+
+                IndexType ix;
+                if (!mapped_find(irow, icol, ix))
+                {
+                    throw NoValueException("get_value_at: no entry at index");
+                }
+                return m_map_vals[ix];
+            }
+
+            void setElement(IndexType irow, IndexType icol, ScalarT const &val)
+            {
+                unmap();
+                ParentMatrixType::setElement(irow, icol, val);
+            }
+
+            template <typename BinaryOpT>
+            void setElement(IndexType irow, IndexType icol, ScalarT const &val,
+                            BinaryOpT merge)
+            {
+                unmap();
+                ParentMatrixType::setElement(irow, icol, val, merge);
+            }
+
+            typedef typename ParentMatrixType::RowType RowType;
+            RowType getRow(IndexType row_index) const
+            {
+                if (!m_file)
+                {
+                    return ParentMatrixType::getRow(row_index);
+                }
+
+                IndexType first(m_map_row_ptr[row_index]);
+                IndexType last(m_map_row_ptr[row_index + 1]);
+
+                return RowType(m_map_col_idx + first,
+                               typename value_iterator<ScalarT>::type(m_map_vals) +
+                               first,
+                               last - first);
+            }
+
+            template <typename RowT>
+            void setRow(
+                IndexType row_index,
+                RowT const &row_data)
+            {
+                unmap();
+                ParentMatrixType::setRow(row_index, row_data);
+            }
+
+            typedef std::vector<std::tuple<IndexType, ScalarT> > const ColType;
+            ColType getCol(IndexType col_index) const
+            {
+                if (!m_file)
+                {
+                    return ParentMatrixType::getCol(col_index);
+                }
+
+                std::vector<std::tuple<IndexType, ScalarT> > data;
+                for (IndexType row = 0; row < this->m_num_rows; ++row)
+                {
+                    IndexType ix;
+                    if (mapped_find(row, col_index, ix))
+                    {
+                        data.push_back(std::make_tuple(row, m_map_vals[ix]));
+                    }
+                }
+                return data;
+            }
+
+            template <typename ColT>
+            void setCol(
+                IndexType col_index,
+                ColT const &col_data)
+            {
+                unmap();
+                ParentMatrixType::setCol(col_index, col_data);
+            }
+
+            // Get column indices for a given row
+            void getColumnIndices(IndexType irow, IndexArrayType &v) const
+            {
+                if (!m_file)
+                {
+                    ParentMatrixType::getColumnIndices(irow, v);
+                    return;
+                }
+
+                if (irow >= this->m_num_rows)
+                {
+                    throw IndexOutOfBoundsException(
+                        "getColumnIndices: index out of bounds");
+                }
+
+                if (m_map_row_ptr[irow] != m_map_row_ptr[irow + 1])
+                {
+                    v.assign(m_map_col_idx + m_map_row_ptr[irow],
+                             m_map_col_idx + m_map_row_ptr[irow + 1]);
+                }
+            }
+
+            // Get row indices for a given column
+            void getRowIndices(IndexType icol, IndexArrayType &v) const
+            {
+                if (!m_file)
+                {
+                    ParentMatrixType::getRowIndices(icol, v);
+                    return;
+                }
+
+                if (icol >= this->m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "getRowIndices: index out of bounds");
+                }
+
+                v.resize(0);
+                for (IndexType row = 0; row < this->m_num_rows; ++row)
+                {
+                    IndexType ix;
+                    if (mapped_find(row, icol, ix))
+                    {
+                        v.push_back(row);
+                    }
+                }
+            }
+
+            template<typename RAIteratorIT,
+                     typename RAIteratorJT,
+                     typename RAIteratorVT>
+            void extractTuples(RAIteratorIT        row_it,
+                               RAIteratorJT        col_it,
+                               RAIteratorVT        values) const
+            {
+                if (!m_file)
+                {
+                    ParentMatrixType::extractTuples(row_it, col_it, values);
+                    return;
+                }
+
+                for (IndexType row = 0; row < this->m_num_rows; ++row)
+                {
+                    for (IndexType ix = m_map_row_ptr[row];
+                         ix < m_map_row_ptr[row + 1];
+                         ++ix)
+                    {
+                        *row_it = row;           ++row_it;
+                        *col_it = m_map_col_idx[ix]; ++col_it;
+                        *values = m_map_vals[ix];    ++values;
+                    }
+                }
+            }
+
+            // output specific to the storage layout of this type of matrix
+            void printInfo(std::ostream &os) const
+            {
+                if (m_file)
+                {
+                    // Printing is not worth a second implementation
+                    MappedCsrSparseMatrix<ScalarT> copy(*this);
+                    copy.unmap();
+                    copy.printInfo(os);
+                    return;
+                }
+                ParentMatrixType::printInfo(os);
+            }
+
+            friend std::ostream &operator<<(std::ostream                         &os,
+                                            MappedCsrSparseMatrix<ScalarT> const &mat)
+            {
+                mat.printInfo(os);
+                return os;
+            }
+
+        private:
+            // Copy the mapped arrays into the CSR storage and drop the
+            // mapping (the file stays mapped while other copies use it).
+            void unmap()
+            {
+                if (!m_file)
+                {
+                    return;
+                }
+
+                IndexType num_rows(this->m_num_rows);
+                this->m_row_ptr.assign(m_map_row_ptr, m_map_row_ptr + num_rows + 1);
+                this->m_col_idx.assign(m_map_col_idx, m_map_col_idx + m_map_nvals);
+                this->m_vals.assign(m_map_vals, m_map_vals + m_map_nvals);
+                this->m_fill_row = num_rows;
+                m_file.reset();
+            }
+
+            // Binary search within a mapped row.
+            bool mapped_find(IndexType irow, IndexType icol, IndexType &ix) const
+            {
+                IndexType const *first(m_map_col_idx + m_map_row_ptr[irow]);
+                IndexType const *last(m_map_col_idx + m_map_row_ptr[irow + 1]);
+                IndexType const *it(std::lower_bound(first, last, icol));
+                ix = it - m_map_col_idx;
+                return ((it != last) && (*it == icol));
+            }
+
+        private:
+            // Set while the arrays below point into the mapped file
+            std::shared_ptr<io::MappedFile> m_file;
+
+            IndexType        m_map_nvals   = 0;
+            IndexType const *m_map_row_ptr = nullptr;
+            IndexType const *m_map_col_idx = nullptr;
+            ScalarT   const *m_map_vals    = nullptr;
+        };
+
+    } // namespace backend
+
+} // namespace GraphBLAS
+
+#endif // GB_SEQUENTIAL_MAPPEDCSRSPARSEMATRIX_HPP
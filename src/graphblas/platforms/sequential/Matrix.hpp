@@ -30,7 +30,14 @@
 #pragma once
 
 #include <cstddef>
+#include <utility>
 #include <graphblas/platforms/sequential/LilSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/CsrSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/CsrCscSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/MappedCsrSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/HypersparseMatrix.hpp>
+#include <graphblas/platforms/sequential/IsoSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/DenseMatrix.hpp>
 
 //****************************************************************************
 
@@ -56,50 +63,134 @@ namespace GraphBLAS
         //********************************************************************
 
 
+        /**
+         * Selects the storage class for a backend matrix from its tags
+         * (see detail/matrix_tags.hpp).  List-of-lists is the default.
+         * The sparseness tag comes first, so DenseTag takes precedence
+         * over any storage tag.
+         */
         template<typename ScalarT, typename... TagsT>
-        class Matrix : public LilSparseMatrix<ScalarT>
+        struct matrix_storage_generator
         {
+            typedef LilSparseMatrix<ScalarT> type;
+        };
+
+        template<typename ScalarT, typename... TagsT>
+        struct matrix_storage_generator<ScalarT, CsrStorageTag, TagsT...>
+        {
+            typedef CsrSparseMatrix<ScalarT> type;
+        };
+
+        template<typename ScalarT, typename... TagsT>
+        struct matrix_storage_generator<ScalarT, CsrCscStorageTag, TagsT...>
+        {
+            typedef CsrCscSparseMatrix<ScalarT> type;
+        };
+
+        template<typename ScalarT, typename... TagsT>
+        struct matrix_storage_generator<ScalarT, MappedCsrStorageTag, TagsT...>
+        {
+            typedef MappedCsrSparseMatrix<ScalarT> type;
+        };
+
+        template<typename ScalarT, typename... TagsT>
+        struct matrix_storage_generator<ScalarT, HypersparseStorageTag, TagsT...>
+        {
+            typedef HypersparseMatrix<ScalarT> type;
+        };
+
+        template<typename ScalarT, typename... TagsT>
+        struct matrix_storage_generator<ScalarT, IsoValuedStorageTag, TagsT...>
+        {
+            typedef IsoSparseMatrix<ScalarT> type;
+        };
+
+        template<typename ScalarT, typename... TagsT>
+        struct matrix_storage_generator<ScalarT, DenseTag, TagsT...>
+        {
+            typedef DenseMatrix<ScalarT> type;
+        };
+
+        template<typename ScalarT, typename TagT, typename... TagsT>
+        struct matrix_storage_generator<ScalarT, TagT, TagsT...>
+            : public matrix_storage_generator<ScalarT, TagsT...>
+        {
+        };
+
+        //********************************************************************
+        template<typename ScalarT, typename... TagsT>
+        class Matrix
+            : public matrix_storage_generator<ScalarT, TagsT...>::type
+        {
+        private:
+            typedef typename matrix_storage_generator<
+                ScalarT, TagsT...>::type ParentMatrixType;
+
         public:
             typedef ScalarT ScalarType;
 
             // construct an empty matrix of fixed dimensions
             Matrix(IndexType   num_rows,
                    IndexType   num_cols)
-                : LilSparseMatrix<ScalarT>(num_rows, num_cols)
+                : ParentMatrixType(num_rows, num_cols)
+            {
+            }
+
+            // construct from a binary file (only for storage that supports it)
+            Matrix(std::string const &filename)
+                : ParentMatrixType(filename)
             {
             }
 
             // copy construct
             Matrix(Matrix const &rhs)
-                : LilSparseMatrix<ScalarT>(rhs)
+                : ParentMatrixType(rhs)
+            {
+            }
+
+            // move construct
+            Matrix(Matrix &&rhs)
+                : ParentMatrixType(std::move(rhs))
             {
             }
 
             // construct a dense matrix from dense data.
             Matrix(std::vector<std::vector<ScalarT> > const &values)
-                : LilSparseMatrix<ScalarT>(values)
+                : ParentMatrixType(values)
             {
             }
 
             // construct a sparse matrix from dense data and a zero val.
             Matrix(std::vector<std::vector<ScalarT> > const &values,
                    ScalarT                                   zero)
-                : LilSparseMatrix<ScalarT>(values, zero)
+                : ParentMatrixType(values, zero)
             {
             }
 
             ~Matrix() {}  // virtual?
 
+            Matrix &operator=(Matrix const &rhs)
+            {
+                ParentMatrixType::operator=(rhs);
+                return *this;
+            }
+
+            Matrix &operator=(Matrix &&rhs)
+            {
+                ParentMatrixType::operator=(std::move(rhs));
+                return *this;
+            }
+
             // necessary?
             bool operator==(Matrix const &rhs) const
             {
-                return LilSparseMatrix<ScalarT>::operator==(rhs);
+                return ParentMatrixType::operator==(rhs);
             }
 
             // necessary?
             bool operator!=(Matrix const &rhs) const
             {
-                return LilSparseMatrix<ScalarT>::operator!=(rhs);
+                return ParentMatrixType::operator!=(rhs);
             }
         };
     }
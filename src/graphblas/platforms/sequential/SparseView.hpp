@@ -0,0 +1,845 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+/**
+ * Non-owning views of the stored elements of a row, a column, or a vector.
+ * getRow(), getCol() and getContents() return these instead of building a
+ * new std::vector<std::tuple<IndexType,ScalarT> > on every call.  Iterating
+ * a view yields the same (index, value) tuples, by value, in increasing
+ * index order.
+ *
+ * @note A view refers to the storage of the container it came from and is
+ *       only valid until that container is modified.
+ */
+
+#ifndef GB_SEQUENTIAL_SPARSE_VIEW_HPP
+#define GB_SEQUENTIAL_SPARSE_VIEW_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <graphblas/types.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //********************************************************************
+        /// The scalar type of the elements of a sparse row: either a
+        /// std::vector<std::tuple<IndexType,ScalarT> > or one of the views.
+        template <typename RowT>
+        struct row_scalar_type
+        {
+            typedef typename std::tuple_element<
+                1, typename std::decay<RowT>::type::value_type>::type type;
+        };
+
+        //********************************************************************
+        /// Iterator over an array of stored values.  This is a pointer except
+        /// for bool, whose values are either bit packed in a std::vector<bool>
+        /// or (when memory mapped) an array of bytes.
+        template <typename ScalarT>
+        struct value_iterator
+        {
+            typedef ScalarT const *type;
+
+            static type begin(std::vector<ScalarT> const &vals)
+            {
+                return vals.data();
+            }
+        };
+
+        class BoolValueIterator
+        {
+        public:
+            BoolValueIterator()
+                : m_bytes(nullptr), m_packed(false)
+            {
+            }
+
+            BoolValueIterator(bool const *bytes)
+                : m_bytes(bytes), m_packed(false)
+            {
+            }
+
+            BoolValueIterator(std::vector<bool>::const_iterator bits)
+                : m_bytes(nullptr), m_bits(bits), m_packed(true)
+            {
+            }
+
+            bool operator*() const
+            {
+                return m_packed ? static_cast<bool>(*m_bits) : *m_bytes;
+            }
+
+            bool operator[](std::ptrdiff_t n) const
+            {
+                return m_packed ? static_cast<bool>(m_bits[n]) : m_bytes[n];
+            }
+
+            BoolValueIterator operator+(std::ptrdiff_t n) const
+            {
+                BoolValueIterator result(*this);
+                if (m_packed)
+                {
+                    result.m_bits += n;
+                }
+                else
+                {
+                    result.m_bytes += n;
+                }
+                return result;
+            }
+
+        private:
+            bool const                        *m_bytes;
+            std::vector<bool>::const_iterator  m_bits;
+            bool                               m_packed;
+        };
+
+        template <>
+        struct value_iterator<bool>
+        {
+            typedef BoolValueIterator type;
+
+            static type begin(std::vector<bool> const &vals)
+            {
+                return BoolValueIterator(vals.begin());
+            }
+        };
+
+        //********************************************************************
+        /**
+         * @brief Iterator over the values of iso-valued storage: either one
+         *        value shared by every element, or (once the elements stop
+         *        being equal) the array of stored values.
+         *
+         * Reading an iso value does not touch memory per element, and
+         * kernels can test iso() to skip the values altogether.
+         */
+        template <typename ScalarT>
+        class IsoValueIterator
+        {
+        public:
+            typedef typename value_iterator<ScalarT>::type StoredIterator;
+
+            IsoValueIterator()
+                : m_iso(true), m_vals(), m_value()
+            {
+            }
+
+            explicit IsoValueIterator(ScalarT const &value)
+                : m_iso(true), m_vals(), m_value(value)
+            {
+            }
+
+            explicit IsoValueIterator(StoredIterator vals)
+                : m_iso(false), m_vals(vals), m_value()
+            {
+            }
+
+            ScalarT operator*() const
+            {
+                return m_iso ? m_value : static_cast<ScalarT>(*m_vals);
+            }
+
+            ScalarT operator[](std::ptrdiff_t n) const
+            {
+                return m_iso ? m_value : static_cast<ScalarT>(m_vals[n]);
+            }
+
+            IsoValueIterator operator+(std::ptrdiff_t n) const
+            {
+                return m_iso ? *this : IsoValueIterator(m_vals + n);
+            }
+
+            bool           iso() const   { return m_iso; }
+            ScalarT const &value() const { return m_value; }
+
+        private:
+            bool           m_iso;
+            StoredIterator m_vals;
+            ScalarT        m_value;
+        };
+
+        //********************************************************************
+        /**
+         * @brief A row (or column) of compressed storage: parallel arrays of
+         *        sorted indices and their values.
+         */
+        template <typename ScalarT,
+                  typename ValueIteratorT =
+                      typename value_iterator<ScalarT>::type>
+        class SparseView
+        {
+        public:
+            typedef ValueIteratorT                 ValueIterator;
+            typedef std::tuple<IndexType, ScalarT> value_type;
+
+            class const_iterator
+            {
+            public:
+                typedef std::random_access_iterator_tag iterator_category;
+                typedef std::tuple<IndexType, ScalarT>  value_type;
+                typedef std::ptrdiff_t                  difference_type;
+                typedef void                            pointer;
+                typedef value_type                      reference;
+
+                const_iterator()
+                    : m_idx(nullptr), m_vals(), m_pos(0)
+                {
+                }
+
+                const_iterator(IndexType const *indices,
+                               ValueIterator    values,
+                               difference_type  pos)
+                    : m_idx(indices), m_vals(values), m_pos(pos)
+                {
+                }
+
+                value_type operator*() const
+                {
+                    return value_type(m_idx[m_pos], m_vals[m_pos]);
+                }
+
+                value_type operator[](difference_type n) const
+                {
+                    return value_type(m_idx[m_pos + n], m_vals[m_pos + n]);
+                }
+
+                const_iterator &operator++() { ++m_pos; return *this; }
+                const_iterator &operator--() { --m_pos; return *this; }
+
+                const_iterator operator++(int)
+                {
+                    const_iterator tmp(*this);
+                    ++m_pos;
+                    return tmp;
+                }
+
+                const_iterator &operator+=(difference_type n)
+                {
+                    m_pos += n;
+                    return *this;
+                }
+
+                const_iterator operator+(difference_type n) const
+                {
+                    return const_iterator(m_idx, m_vals, m_pos + n);
+                }
+
+                difference_type operator-(const_iterator const &rhs) const
+                {
+                    return m_pos - rhs.m_pos;
+                }
+
+                bool operator==(const_iterator const &rhs) const
+                {
+                    return m_pos == rhs.m_pos;
+                }
+
+                bool operator!=(const_iterator const &rhs) const
+                {
+                    return m_pos != rhs.m_pos;
+                }
+
+                bool operator<(const_iterator const &rhs) const
+                {
+                    return m_pos < rhs.m_pos;
+                }
+
+            private:
+                IndexType const *m_idx;
+                ValueIterator    m_vals;
+                difference_type  m_pos;
+            };
+
+            typedef const_iterator iterator;
+
+            SparseView()
+                : m_idx(nullptr), m_vals(), m_size(0)
+            {
+            }
+
+            SparseView(IndexType const *indices,
+                       ValueIterator    values,
+                       IndexType        size)
+                : m_idx(indices), m_vals(values), m_size(size)
+            {
+            }
+
+            const_iterator begin() const
+            {
+                return const_iterator(m_idx, m_vals, 0);
+            }
+
+            const_iterator end() const
+            {
+                return const_iterator(m_idx, m_vals, m_size);
+            }
+
+            IndexType size() const  { return m_size; }
+            bool      empty() const { return m_size == 0; }
+
+            value_type operator[](IndexType n) const
+            {
+                return value_type(m_idx[n], m_vals[n]);
+            }
+
+            IndexType const     *indices() const { return m_idx; }
+            ValueIterator const &values() const  { return m_vals; }
+
+            /// Element by element comparison with another row or view.
+            template <typename RowT>
+            bool operator==(RowT const &rhs) const
+            {
+                if (rhs.size() != m_size)
+                {
+                    return false;
+                }
+                auto rhs_it(rhs.begin());
+                for (IndexType ix = 0; ix < m_size; ++ix, ++rhs_it)
+                {
+                    if ((*rhs_it) != (*this)[ix])
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            template <typename RowT>
+            bool operator!=(RowT const &rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+        private:
+            IndexType const *m_idx;
+            ValueIterator    m_vals;
+            IndexType        m_size;
+        };
+
+        //********************************************************************
+        /// The value shared by every element of row, when it comes from
+        /// iso-valued storage that is still iso.  Kernels use this to skip
+        /// the per element values.
+        template <typename RowT, typename ValueT>
+        inline bool iso_value(RowT const &, ValueT &)
+        {
+            return false;
+        }
+
+        template <typename ScalarT, typename ValueT>
+        inline bool iso_value(
+            SparseView<ScalarT, IsoValueIterator<ScalarT> > const &row,
+            ValueT                                                &value)
+        {
+            if (row.values().iso())
+            {
+                value = static_cast<ValueT>(row.values().value());
+                return true;
+            }
+            return false;
+        }
+
+        //********************************************************************
+        /**
+         * @brief The stored elements of a bitmap vector (a flag and a value
+         *        slot for every index).
+         *
+         * Iterating skips the unset flags.  hasElement()/extractElement()
+         * look an index up directly, which dot() uses in place of merging.
+         */
+        template <typename ScalarT>
+        class BitmapView
+        {
+        public:
+            typedef std::tuple<IndexType, ScalarT> value_type;
+
+            class const_iterator
+            {
+            public:
+                typedef std::forward_iterator_tag      iterator_category;
+                typedef std::tuple<IndexType, ScalarT> value_type;
+                typedef std::ptrdiff_t                 difference_type;
+                typedef void                           pointer;
+                typedef value_type                     reference;
+
+                const_iterator(std::vector<bool>    const *bitmap,
+                               std::vector<ScalarT> const *vals,
+                               IndexType                   idx)
+                    : m_bitmap(bitmap), m_vals(vals), m_idx(idx)
+                {
+                    skip_unset();
+                }
+
+                value_type operator*() const
+                {
+                    return value_type(m_idx, (*m_vals)[m_idx]);
+                }
+
+                const_iterator &operator++()
+                {
+                    ++m_idx;
+                    skip_unset();
+                    return *this;
+                }
+
+                const_iterator operator++(int)
+                {
+                    const_iterator tmp(*this);
+                    ++(*this);
+                    return tmp;
+                }
+
+                bool operator==(const_iterator const &rhs) const
+                {
+                    return m_idx == rhs.m_idx;
+                }
+
+                bool operator!=(const_iterator const &rhs) const
+                {
+                    return m_idx != rhs.m_idx;
+                }
+
+            private:
+                void skip_unset()
+                {
+                    while ((m_idx < m_bitmap->size()) && !(*m_bitmap)[m_idx])
+                    {
+                        ++m_idx;
+                    }
+                }
+
+                std::vector<bool>    const *m_bitmap;
+                std::vector<ScalarT> const *m_vals;
+                IndexType                   m_idx;
+            };
+
+            typedef const_iterator iterator;
+
+            BitmapView(std::vector<bool>    const &bitmap,
+                       std::vector<ScalarT> const &vals,
+                       IndexType                   nvals)
+                : m_bitmap(&bitmap), m_vals(&vals), m_nvals(nvals)
+            {
+            }
+
+            const_iterator begin() const
+            {
+                return const_iterator(m_bitmap, m_vals,
+                                      (m_nvals == 0) ? m_bitmap->size() : 0);
+            }
+
+            const_iterator end() const
+            {
+                return const_iterator(m_bitmap, m_vals, m_bitmap->size());
+            }
+
+            IndexType size() const  { return m_nvals; }
+            bool      empty() const { return m_nvals == 0; }
+
+            bool hasElement(IndexType idx) const
+            {
+                return (*m_bitmap)[idx];
+            }
+
+            ScalarT extractElement(IndexType idx) const
+            {
+                return (*m_vals)[idx];
+            }
+
+            /// The number of indices (stored or not).
+            IndexType length() const { return m_bitmap->size(); }
+
+            std::vector<ScalarT> const &values() const { return *m_vals; }
+
+        private:
+            std::vector<bool>    const *m_bitmap;
+            std::vector<ScalarT> const *m_vals;
+            IndexType                   m_nvals;
+        };
+
+        //********************************************************************
+        /**
+         * @brief The stored elements of a vector that is held either as a
+         *        sorted list or as a bitmap (see HybridSparseVector).
+         *
+         * Kernels that can take advantage of one form (for instance dot()
+         * looking values up in a bitmap) dispatch on isBitmap() and work on
+         * list() or bitmap() directly.
+         */
+        template <typename ScalarT>
+        class HybridView
+        {
+        public:
+            typedef std::tuple<IndexType, ScalarT> value_type;
+
+            class const_iterator
+            {
+            public:
+                typedef std::forward_iterator_tag      iterator_category;
+                typedef std::tuple<IndexType, ScalarT> value_type;
+                typedef std::ptrdiff_t                 difference_type;
+                typedef void                           pointer;
+                typedef value_type                     reference;
+
+                const_iterator(
+                    typename SparseView<ScalarT>::const_iterator list_it,
+                    typename BitmapView<ScalarT>::const_iterator bitmap_it,
+                    bool                                         is_bitmap)
+                    : m_list_it(list_it),
+                      m_bitmap_it(bitmap_it),
+                      m_is_bitmap(is_bitmap)
+                {
+                }
+
+                value_type operator*() const
+                {
+                    return m_is_bitmap ? *m_bitmap_it : *m_list_it;
+                }
+
+                const_iterator &operator++()
+                {
+                    if (m_is_bitmap)
+                    {
+                        ++m_bitmap_it;
+                    }
+                    else
+                    {
+                        ++m_list_it;
+                    }
+                    return *this;
+                }
+
+                const_iterator operator++(int)
+                {
+                    const_iterator tmp(*this);
+                    ++(*this);
+                    return tmp;
+                }
+
+                bool operator==(const_iterator const &rhs) const
+                {
+                    return m_is_bitmap ? (m_bitmap_it == rhs.m_bitmap_it)
+                                       : (m_list_it == rhs.m_list_it);
+                }
+
+                bool operator!=(const_iterator const &rhs) const
+                {
+                    return !(*this == rhs);
+                }
+
+            private:
+                typename SparseView<ScalarT>::const_iterator m_list_it;
+                typename BitmapView<ScalarT>::const_iterator m_bitmap_it;
+                bool                                         m_is_bitmap;
+            };
+
+            typedef const_iterator iterator;
+
+            HybridView(SparseView<ScalarT> const &list,
+                       BitmapView<ScalarT> const &bitmap,
+                       bool                       is_bitmap)
+                : m_list(list), m_bitmap(bitmap), m_is_bitmap(is_bitmap)
+            {
+            }
+
+            const_iterator begin() const
+            {
+                return const_iterator(m_list.begin(), m_bitmap.begin(),
+                                      m_is_bitmap);
+            }
+
+            const_iterator end() const
+            {
+                return const_iterator(m_list.end(), m_bitmap.end(),
+                                      m_is_bitmap);
+            }
+
+            IndexType size() const
+            {
+                return m_is_bitmap ? m_bitmap.size() : m_list.size();
+            }
+
+            bool empty() const { return size() == 0; }
+
+            bool isBitmap() const { return m_is_bitmap; }
+
+            SparseView<ScalarT> const &list() const   { return m_list; }
+            BitmapView<ScalarT> const &bitmap() const { return m_bitmap; }
+
+        private:
+            SparseView<ScalarT> m_list;
+            BitmapView<ScalarT> m_bitmap;
+            bool                m_is_bitmap;
+        };
+
+        //********************************************************************
+        /// The bitmaps of dense storage are packed 64 flags to a word, so
+        /// that kernels can combine the structure of two operands a word at
+        /// a time (see dense_ewise.hpp).
+        typedef std::uint64_t BitmapWord;
+
+        static const IndexType BITMAP_WORD_BITS = 64;
+
+        inline IndexType bitmap_num_words(IndexType num_bits)
+        {
+            return (num_bits + BITMAP_WORD_BITS - 1)/BITMAP_WORD_BITS;
+        }
+
+        /// The valid bits of the last word of a bitmap of num_bits flags.
+        inline BitmapWord bitmap_tail_mask(IndexType num_bits)
+        {
+            IndexType tail(num_bits % BITMAP_WORD_BITS);
+            return (tail == 0) ? ~BitmapWord(0)
+                               : ((BitmapWord(1) << tail) - 1);
+        }
+
+        inline bool test_bit(BitmapWord const *words, IndexType pos)
+        {
+            return ((words[pos/BITMAP_WORD_BITS] >>
+                     (pos % BITMAP_WORD_BITS)) & 1) != 0;
+        }
+
+        inline void set_bit(BitmapWord *words, IndexType pos)
+        {
+            words[pos/BITMAP_WORD_BITS] |=
+                (BitmapWord(1) << (pos % BITMAP_WORD_BITS));
+        }
+
+        inline void clear_bit(BitmapWord *words, IndexType pos)
+        {
+            words[pos/BITMAP_WORD_BITS] &=
+                ~(BitmapWord(1) << (pos % BITMAP_WORD_BITS));
+        }
+
+        inline IndexType popcount(BitmapWord word)
+        {
+#if defined(__GNUC__)
+            return __builtin_popcountll(word);
+#else
+            IndexType count(0);
+            for (; word != 0; word &= word - 1)
+            {
+                ++count;
+            }
+            return count;
+#endif
+        }
+
+        //********************************************************************
+        /**
+         * @brief The elements of dense storage (a vector, or a row of a
+         *        matrix; see DenseVector and DenseMatrix): a value slot for
+         *        every index, and a flag for every index only while some of
+         *        them are not stored.
+         *
+         * When full() there is no bitmap, so iterating reads the values in
+         * order and kernels can use values() by position without looking
+         * at the structure at all.
+         */
+        template <typename ScalarT>
+        class DenseView
+        {
+        public:
+            typedef typename value_iterator<ScalarT>::type ValueIterator;
+            typedef std::tuple<IndexType, ScalarT>         value_type;
+
+            class const_iterator
+            {
+            public:
+                typedef std::forward_iterator_tag      iterator_category;
+                typedef std::tuple<IndexType, ScalarT> value_type;
+                typedef std::ptrdiff_t                 difference_type;
+                typedef void                           pointer;
+                typedef value_type                     reference;
+
+                const_iterator(ValueIterator     vals,
+                               BitmapWord const *bitmap,
+                               IndexType         offset,
+                               IndexType         length,
+                               IndexType         idx)
+                    : m_vals(vals),
+                      m_bitmap(bitmap),
+                      m_offset(offset),
+                      m_length(length),
+                      m_idx(idx)
+                {
+                    skip_unset();
+                }
+
+                value_type operator*() const
+                {
+                    return value_type(m_idx, m_vals[m_idx]);
+                }
+
+                const_iterator &operator++()
+                {
+                    ++m_idx;
+                    skip_unset();
+                    return *this;
+                }
+
+                const_iterator operator++(int)
+                {
+                    const_iterator tmp(*this);
+                    ++(*this);
+                    return tmp;
+                }
+
+                bool operator==(const_iterator const &rhs) const
+                {
+                    return m_idx == rhs.m_idx;
+                }
+
+                bool operator!=(const_iterator const &rhs) const
+                {
+                    return m_idx != rhs.m_idx;
+                }
+
+            private:
+                // Move to the next stored index, a word at a time over
+                // empty stretches.
+                void skip_unset()
+                {
+                    if (m_bitmap == nullptr)
+                    {
+                        return;
+                    }
+                    while (m_idx < m_length)
+                    {
+                        IndexType pos(m_offset + m_idx);
+                        IndexType bit(pos % BITMAP_WORD_BITS);
+                        BitmapWord word(m_bitmap[pos/BITMAP_WORD_BITS] >> bit);
+                        if (word == 0)
+                        {
+                            m_idx += BITMAP_WORD_BITS - bit;
+                        }
+                        else if (word & 1)
+                        {
+                            return;
+                        }
+                        else
+                        {
+                            ++m_idx;
+                        }
+                    }
+                    m_idx = m_length;
+                }
+
+                ValueIterator     m_vals;
+                BitmapWord const *m_bitmap;
+                IndexType         m_offset;
+                IndexType         m_length;
+                IndexType         m_idx;
+            };
+
+            typedef const_iterator iterator;
+
+            /**
+             * @param[in] vals    The value of index 0 (of length slots).
+             * @param[in] bitmap  The flags, or nullptr if all are stored.
+             * @param[in] offset  The position of index 0 in the bitmap.
+             * @param[in] length  The number of indices.
+             * @param[in] nvals   The number of stored values.
+             */
+            DenseView(ValueIterator     vals,
+                      BitmapWord const *bitmap,
+                      IndexType         offset,
+                      IndexType         length,
+                      IndexType         nvals)
+                : m_vals(vals),
+                  m_bitmap(bitmap),
+                  m_offset(offset),
+                  m_length(length),
+                  m_nvals(nvals)
+            {
+            }
+
+            const_iterator begin() const
+            {
+                return const_iterator(m_vals, m_bitmap, m_offset, m_length,
+                                      (m_nvals == 0) ? m_length : 0);
+            }
+
+            const_iterator end() const
+            {
+                return const_iterator(m_vals, m_bitmap, m_offset, m_length,
+                                      m_length);
+            }
+
+            IndexType size() const  { return m_nvals; }
+            bool      empty() const { return m_nvals == 0; }
+
+            /// The number of indices (stored or not).
+            IndexType length() const { return m_length; }
+
+            /// True if every index is stored.
+            bool full() const { return m_nvals == m_length; }
+
+            bool hasElement(IndexType idx) const
+            {
+                return (m_bitmap == nullptr) ||
+                    test_bit(m_bitmap, m_offset + idx);
+            }
+
+            ScalarT extractElement(IndexType idx) const
+            {
+                return m_vals[idx];
+            }
+
+            ValueIterator const &values() const { return m_vals; }
+
+            /// The packed flags (nullptr when full()), starting at offset().
+            BitmapWord const *bitmap() const { return m_bitmap; }
+            IndexType         offset() const { return m_offset; }
+
+        private:
+            ValueIterator     m_vals;
+            BitmapWord const *m_bitmap;
+            IndexType         m_offset;
+            IndexType         m_length;
+            IndexType         m_nvals;
+        };
+
+    } // backend
+} // GraphBLAS
+
+#endif // GB_SEQUENTIAL_SPARSE_VIEW_HPP
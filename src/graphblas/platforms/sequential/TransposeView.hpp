@@ -72,6 +72,9 @@ namespace GraphBLAS
             {
             }
 
+            /// The matrix being transposed.
+            MatrixT const &getMatrix() const { return m_matrix; }
+
             // EQUALITY OPERATORS
             //bool
             //operator==(TransposeView<MatrixT> const &rhs) const
@@ -224,6 +227,16 @@ namespace GraphBLAS
                 m_matrix.getColIndices(icol, v);
             }
 
+            template<typename RAIteratorIT,
+                     typename RAIteratorJT,
+                     typename RAIteratorVT>
+            void extractTuples(RAIteratorIT        row_it,
+                               RAIteratorJT        col_it,
+                               RAIteratorVT        values) const
+            {
+                m_matrix.extractTuples(col_it, row_it, values);
+            }
+
             //other methods that may or may not belong here:
             //
             void printInfo(std::ostream &os) const
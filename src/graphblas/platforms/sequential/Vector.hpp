@@ -30,24 +30,27 @@
 #pragma once
 
 #include <cstddef>
+#include <utility>
 #include <iostream>
 
 #include <graphblas/detail/config.hpp>
 #include <vector>
-#include <graphblas/platforms/sequential/BitmapSparseVector.hpp>
+#include <graphblas/platforms/sequential/HybridSparseVector.hpp>
+#include <graphblas/platforms/sequential/DenseVector.hpp>
 
 namespace GraphBLAS
 {
     namespace backend
     {
         //**********************************************************************
-        /// @note ignoring all tags here, there is currently only one
-        ///       implementation of vector: dense+bitmap.
+        /// @note By default a vector is a sorted list or dense+bitmap,
+        ///       whichever suits the number of stored values; DenseTag
+        ///       (below) selects dense storage.
         template<typename ScalarT, typename... TagsT>
-        class Vector : public BitmapSparseVector<ScalarT>
+        class Vector : public HybridSparseVector<ScalarT>
         {
         private:
-            typedef BitmapSparseVector<ScalarT> ParentVectorType;
+            typedef HybridSparseVector<ScalarT> ParentVectorType;
 
         public:
             typedef ScalarT ScalarType;
@@ -65,24 +68,99 @@ namespace GraphBLAS
             Vector(std::vector<ScalarT> const &values, ScalarT const &zero)
                 : ParentVectorType(values, zero) {}
 
+            Vector(Vector const &rhs) : ParentVectorType(rhs) {}
+
+            Vector(Vector &&rhs) : ParentVectorType(std::move(rhs)) {}
+
             ~Vector() {}  // virtual?
 
+            Vector &operator=(Vector const &rhs)
+            {
+                ParentVectorType::operator=(rhs);
+                return *this;
+            }
+
+            Vector &operator=(Vector &&rhs)
+            {
+                ParentVectorType::operator=(std::move(rhs));
+                return *this;
+            }
+
             // necessary?
             bool operator==(Vector const &rhs) const
             {
-                return BitmapSparseVector<ScalarT>::operator==(rhs);
+                return ParentVectorType::operator==(rhs);
             }
 
             // necessary?
             bool operator!=(Vector const &rhs) const
             {
-                return BitmapSparseVector<ScalarT>::operator!=(rhs);
+                return ParentVectorType::operator!=(rhs);
             }
 
             void printInfo(std::ostream &os) const
             {
                 os << "Sequential Backend:" << std::endl;
-                BitmapSparseVector<ScalarT>::printInfo(os);
+                ParentVectorType::printInfo(os);
+            }
+        };
+
+        //**********************************************************************
+        /// A vector with a value slot for every index (see DenseVector).
+        template<typename ScalarT>
+        class Vector<ScalarT, DenseTag> : public DenseVector<ScalarT>
+        {
+        private:
+            typedef DenseVector<ScalarT> ParentVectorType;
+
+        public:
+            typedef ScalarT ScalarType;
+
+            Vector() = delete;
+
+            Vector(IndexType nsize) : ParentVectorType(nsize) {}
+
+            Vector(IndexType const &nsize, ScalarT const &value)
+                : ParentVectorType(nsize, value) {}
+
+            Vector(std::vector<ScalarT> const &values)
+                : ParentVectorType(values) {}
+
+            Vector(std::vector<ScalarT> const &values, ScalarT const &zero)
+                : ParentVectorType(values, zero) {}
+
+            Vector(Vector const &rhs) : ParentVectorType(rhs) {}
+
+            Vector(Vector &&rhs) : ParentVectorType(std::move(rhs)) {}
+
+            ~Vector() {}
+
+            Vector &operator=(Vector const &rhs)
+            {
+                ParentVectorType::operator=(rhs);
+                return *this;
+            }
+
+            Vector &operator=(Vector &&rhs)
+            {
+                ParentVectorType::operator=(std::move(rhs));
+                return *this;
+            }
+
+            bool operator==(Vector const &rhs) const
+            {
+                return ParentVectorType::operator==(rhs);
+            }
+
+            bool operator!=(Vector const &rhs) const
+            {
+                return ParentVectorType::operator!=(rhs);
+            }
+
+            void printInfo(std::ostream &os) const
+            {
+                os << "Sequential Backend (dense):" << std::endl;
+                ParentVectorType::printInfo(os);
             }
         };
     }
@@ -0,0 +1,382 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Bulk build support shared by the sparse matrix storage classes.
+ */
+
+#ifndef GB_SEQUENTIAL_BUILD_HELPERS_HPP
+#define GB_SEQUENTIAL_BUILD_HELPERS_HPP
+
+#pragma once
+
+#include <vector>
+#include <tuple>
+#include <algorithm>
+
+#include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //**********************************************************************
+        /**
+         * Sort n (i, j, v) tuples by row and then by column, combining the
+         * values of tuples with the same (i, j) with dup in input order
+         * (stored = dup(stored, v)).
+         *
+         * The tuples are bucketed by row with a stable counting sort and
+         * then each row is sorted by column and combined.  The rows are
+         * processed in parallel when compiled with OpenMP (the storage
+         * classes are shared with the omp platform).
+         *
+         * @param[out] row_ptr  Offsets of the rows in entries (nrows + 1).
+         * @param[out] entries  The (column, value) pairs of all rows.
+         *
+         * @throw IndexOutOfBoundsException if any index is out of range; no
+         *        output is written in this case.
+         */
+        template<typename ScalarT,
+                 typename RAIteratorI,
+                 typename RAIteratorJ,
+                 typename RAIteratorV,
+                 typename DupT>
+        void sort_build_tuples(
+            IndexType                                      num_rows,
+            IndexType                                      num_cols,
+            RAIteratorI                                    i_it,
+            RAIteratorJ                                    j_it,
+            RAIteratorV                                    v_it,
+            IndexType                                      n,
+            DupT                                           dup,
+            std::vector<IndexType>                        &row_ptr,
+            std::vector<std::tuple<IndexType, ScalarT> >  &entries)
+        {
+            typedef std::tuple<IndexType, ScalarT> EntryType;
+
+            // Count the tuples in each row
+            std::vector<IndexType> bucket_ptr(num_rows + 1, 0);
+            for (IndexType ix = 0; ix < n; ++ix)
+            {
+                if ((i_it[ix] >= num_rows) || (j_it[ix] >= num_cols))
+                {
+                    throw IndexOutOfBoundsException(
+                        "build: index out of bounds");
+                }
+                ++bucket_ptr[i_it[ix] + 1];
+            }
+            for (IndexType row = 0; row < num_rows; ++row)
+            {
+                bucket_ptr[row + 1] += bucket_ptr[row];
+            }
+
+            // Scatter the tuples to their rows, keeping the input order
+            std::vector<EntryType> buckets(n);
+            {
+                std::vector<IndexType> next(bucket_ptr.begin(),
+                                            bucket_ptr.end() - 1);
+                for (IndexType ix = 0; ix < n; ++ix)
+                {
+                    buckets[next[i_it[ix]]++] =
+                        std::make_tuple(static_cast<IndexType>(j_it[ix]),
+                                        static_cast<ScalarT>(v_it[ix]));
+                }
+            }
+
+            // Sort each row by column and combine duplicates in place
+            std::vector<IndexType> row_nvals(num_rows, 0);
+
+#ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic, 256)
+#endif
+            for (IndexType row = 0; row < num_rows; ++row)
+            {
+                auto first = buckets.begin() + bucket_ptr[row];
+                auto last  = buckets.begin() + bucket_ptr[row + 1];
+                if (first == last)
+                {
+                    continue;
+                }
+
+                std::stable_sort(first, last,
+                                 [](EntryType const &a, EntryType const &b)
+                                 { return std::get<0>(a) < std::get<0>(b); });
+
+                auto out = first;
+                for (auto it = first + 1; it != last; ++it)
+                {
+                    if (std::get<0>(*it) == std::get<0>(*out))
+                    {
+                        std::get<1>(*out) = dup(std::get<1>(*out),
+                                                std::get<1>(*it));
+                    }
+                    else
+                    {
+                        *(++out) = *it;
+                    }
+                }
+                row_nvals[row] = (out - first) + 1;
+            }
+
+            row_ptr.assign(num_rows + 1, 0);
+            for (IndexType row = 0; row < num_rows; ++row)
+            {
+                row_ptr[row + 1] = row_ptr[row] + row_nvals[row];
+            }
+
+            // Without duplicates the buckets are already the result
+            if (row_ptr[num_rows] == n)
+            {
+                entries.swap(buckets);
+                return;
+            }
+
+            entries.resize(row_ptr[num_rows]);
+
+#ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic, 256)
+#endif
+            for (IndexType row = 0; row < num_rows; ++row)
+            {
+                std::copy(buckets.begin() + bucket_ptr[row],
+                          buckets.begin() + bucket_ptr[row] + row_nvals[row],
+                          entries.begin() + row_ptr[row]);
+            }
+        }
+
+        //**********************************************************************
+        /// Copy the values stored in A followed by the n new tuples into
+        /// i_all, j_all and v_all.
+        template<typename MatrixT,
+                 typename RAIteratorI,
+                 typename RAIteratorJ,
+                 typename RAIteratorV>
+        void gather_build_tuples(
+            MatrixT                                const &A,
+            RAIteratorI                                   i_it,
+            RAIteratorJ                                   j_it,
+            RAIteratorV                                   v_it,
+            IndexType                                     n,
+            std::vector<IndexType>                       &i_all,
+            std::vector<IndexType>                       &j_all,
+            std::vector<typename MatrixT::ScalarType>    &v_all)
+        {
+            typedef typename MatrixT::ScalarType ScalarType;
+
+            IndexType num_stored(A.nvals());
+            i_all.resize(num_stored);
+            j_all.resize(num_stored);
+            v_all.resize(num_stored);
+            A.extractTuples(i_all.begin(), j_all.begin(), v_all.begin());
+
+            i_all.reserve(num_stored + n);
+            j_all.reserve(num_stored + n);
+            v_all.reserve(num_stored + n);
+            for (IndexType ix = 0; ix < n; ++ix)
+            {
+                i_all.push_back(i_it[ix]);
+                j_all.push_back(j_it[ix]);
+                v_all.push_back(static_cast<ScalarType>(v_it[ix]));
+            }
+        }
+
+        //**********************************************************************
+        /**
+         * sort_build_tuples() for a build into a matrix that may already
+         * hold values: the stored values are placed before the new tuples
+         * so that dup(stored, new) is applied as setElement() would.
+         */
+        template<typename MatrixT,
+                 typename RAIteratorI,
+                 typename RAIteratorJ,
+                 typename RAIteratorV,
+                 typename DupT>
+        void sort_build_tuples(
+            MatrixT                                        const &A,
+            RAIteratorI                                           i_it,
+            RAIteratorJ                                           j_it,
+            RAIteratorV                                           v_it,
+            IndexType                                             n,
+            DupT                                                  dup,
+            std::vector<IndexType>                               &row_ptr,
+            std::vector<std::tuple<IndexType,
+                                   typename MatrixT::ScalarType> > &entries)
+        {
+            typedef typename MatrixT::ScalarType ScalarType;
+
+            if (A.nvals() == 0)
+            {
+                sort_build_tuples<ScalarType>(A.nrows(), A.ncols(),
+                                              i_it, j_it, v_it, n, dup,
+                                              row_ptr, entries);
+                return;
+            }
+
+            std::vector<IndexType>  i_all, j_all;
+            std::vector<ScalarType> v_all;
+            gather_build_tuples(A, i_it, j_it, v_it, n, i_all, j_all, v_all);
+
+            sort_build_tuples<ScalarType>(A.nrows(), A.ncols(),
+                                          i_all.begin(), j_all.begin(),
+                                          v_all.begin(), i_all.size(), dup,
+                                          row_ptr, entries);
+        }
+
+        //**********************************************************************
+        /**
+         * sort_build_tuples() for hypersparse storage: the tuples are
+         * sorted by (row, column) with a comparison sort, so the work and
+         * memory do not depend on the number of rows, and only the
+         * non-empty rows are returned.
+         *
+         * @param[out] row_ids  The non-empty rows, in increasing order.
+         * @param[out] row_ptr  Offsets of those rows in entries
+         *                      (row_ids.size() + 1).
+         * @param[out] entries  The (column, value) pairs of all rows.
+         *
+         * @throw IndexOutOfBoundsException if any index is out of range; no
+         *        output is written in this case.
+         */
+        template<typename ScalarT,
+                 typename RAIteratorI,
+                 typename RAIteratorJ,
+                 typename RAIteratorV,
+                 typename DupT>
+        void sort_build_tuples_hypersparse(
+            IndexType                                      num_rows,
+            IndexType                                      num_cols,
+            RAIteratorI                                    i_it,
+            RAIteratorJ                                    j_it,
+            RAIteratorV                                    v_it,
+            IndexType                                      n,
+            DupT                                           dup,
+            std::vector<IndexType>                        &row_ids,
+            std::vector<IndexType>                        &row_ptr,
+            std::vector<std::tuple<IndexType, ScalarT> >  &entries)
+        {
+            std::vector<IndexType> order(n);
+            for (IndexType ix = 0; ix < n; ++ix)
+            {
+                if ((i_it[ix] >= num_rows) || (j_it[ix] >= num_cols))
+                {
+                    throw IndexOutOfBoundsException(
+                        "build: index out of bounds");
+                }
+                order[ix] = ix;
+            }
+
+            // Stable, so duplicates are combined in input order
+            std::stable_sort(order.begin(), order.end(),
+                             [&](IndexType a, IndexType b)
+                             {
+                                 return ((i_it[a] < i_it[b]) ||
+                                         ((i_it[a] == i_it[b]) &&
+                                          (j_it[a] < j_it[b])));
+                             });
+
+            row_ids.clear();
+            row_ptr.assign(1, 0);
+            entries.clear();
+            entries.reserve(n);
+            for (IndexType k = 0; k < n; ++k)
+            {
+                IndexType ix(order[k]);
+                IndexType row(i_it[ix]);
+                IndexType col(j_it[ix]);
+                ScalarT   val(static_cast<ScalarT>(v_it[ix]));
+
+                if (row_ids.empty() || (row != row_ids.back()))
+                {
+                    if (!row_ids.empty())
+                    {
+                        row_ptr.push_back(entries.size());
+                    }
+                    row_ids.push_back(row);
+                }
+                else if (col == std::get<0>(entries.back()))
+                {
+                    std::get<1>(entries.back()) =
+                        dup(std::get<1>(entries.back()), val);
+                    continue;
+                }
+                entries.push_back(std::make_tuple(col, val));
+            }
+            if (!row_ids.empty())
+            {
+                row_ptr.push_back(entries.size());
+            }
+        }
+
+        /// sort_build_tuples_hypersparse() for a build into a matrix that
+        /// may already hold values (see sort_build_tuples() above).
+        template<typename MatrixT,
+                 typename RAIteratorI,
+                 typename RAIteratorJ,
+                 typename RAIteratorV,
+                 typename DupT>
+        void sort_build_tuples_hypersparse(
+            MatrixT                                        const &A,
+            RAIteratorI                                           i_it,
+            RAIteratorJ                                           j_it,
+            RAIteratorV                                           v_it,
+            IndexType                                             n,
+            DupT                                                  dup,
+            std::vector<IndexType>                               &row_ids,
+            std::vector<IndexType>                               &row_ptr,
+            std::vector<std::tuple<IndexType,
+                                   typename MatrixT::ScalarType> > &entries)
+        {
+            typedef typename MatrixT::ScalarType ScalarType;
+
+            if (A.nvals() == 0)
+            {
+                sort_build_tuples_hypersparse<ScalarType>(
+                    A.nrows(), A.ncols(), i_it, j_it, v_it, n, dup,
+                    row_ids, row_ptr, entries);
+                return;
+            }
+
+            std::vector<IndexType>  i_all, j_all;
+            std::vector<ScalarType> v_all;
+            gather_build_tuples(A, i_it, j_it, v_it, n, i_all, j_all, v_all);
+
+            sort_build_tuples_hypersparse<ScalarType>(
+                A.nrows(), A.ncols(), i_all.begin(), j_all.begin(),
+                v_all.begin(), i_all.size(), dup, row_ids, row_ptr, entries);
+        }
+
+    } // namespace backend
+
+} // namespace GraphBLAS
+
+#endif // GB_SEQUENTIAL_BUILD_HELPERS_HPP
@@ -0,0 +1,544 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Element-wise kernels (eWiseAdd, eWiseMult and apply of vectors) that
+ * write straight into a dense output (see DenseVector) when there is no
+ * mask and no accumulator, instead of building the result as a list of
+ * tuples first.
+ *
+ * - The operands must be dense as well: dense vectors, or vectors held as
+ *   a full bitmap (see HybridSparseVector).
+ * - The work is positional, 64 indices (one word of the packed bitmaps) at
+ *   a time.  The structure of the result is the AND or OR of the words of
+ *   the operands and its number of stored values is their popcount.
+ * - Words where every index is stored in both operands are computed
+ *   without looking at the structure at all.  For the built-in arithmetic
+ *   operators (see dense_safe_op) words that are only partially stored are
+ *   computed for every index too, and the unstored slots are ignored.
+ * - The output may be one of the operands: each index is read before it
+ *   is written.
+ * - The words are processed in parallel when compiled with OpenMP.
+ */
+
+#ifndef GB_SEQUENTIAL_DENSE_EWISE_HPP
+#define GB_SEQUENTIAL_DENSE_EWISE_HPP
+
+#pragma once
+
+#include <type_traits>
+
+#include <graphblas/types.hpp>
+#include <graphblas/algebra.hpp>
+#include <graphblas/detail/trace.hpp>
+
+#include "SparseView.hpp"
+#include "HybridSparseVector.hpp"
+#include "DenseVector.hpp"
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        class NoMask;
+
+        //**********************************************************************
+        /// Scalar types that are kept in a plain array by dense storage.
+        template <typename ScalarT>
+        struct dense_scalar
+            : std::integral_constant<bool,
+                                     std::is_arithmetic<ScalarT>::value &&
+                                     !std::is_same<ScalarT, bool>::value>
+        {
+        };
+
+        //**********************************************************************
+        /**
+         * True for the binary operators that can be evaluated on any value
+         * of their domains, including the (stale or default) value of an
+         * unstored slot of dense storage, without side effects or undefined
+         * behavior.  Partially stored words are then computed without
+         * branching on the structure.
+         *
+         * Plus, Minus and Times only qualify for floating point domains
+         * (integer overflow is undefined); Min and Max for any arithmetic
+         * domain.
+         */
+        template <typename OpT>
+        struct dense_safe_op : std::false_type {};
+
+        template <typename D1, typename D2, typename D3>
+        struct dense_safe_floating_op
+            : std::integral_constant<bool,
+                                     std::is_floating_point<D1>::value &&
+                                     std::is_floating_point<D2>::value &&
+                                     std::is_floating_point<D3>::value>
+        {
+        };
+
+        template <typename D1, typename D2, typename D3>
+        struct dense_safe_op<Plus<D1, D2, D3> >
+            : dense_safe_floating_op<D1, D2, D3> {};
+
+        template <typename D1, typename D2, typename D3>
+        struct dense_safe_op<Minus<D1, D2, D3> >
+            : dense_safe_floating_op<D1, D2, D3> {};
+
+        template <typename D1, typename D2, typename D3>
+        struct dense_safe_op<Times<D1, D2, D3> >
+            : dense_safe_floating_op<D1, D2, D3> {};
+
+        template <typename D1, typename D2, typename D3>
+        struct dense_safe_op<Min<D1, D2, D3> >
+            : std::integral_constant<bool,
+                                     std::is_arithmetic<D1>::value &&
+                                     std::is_arithmetic<D2>::value> {};
+
+        template <typename D1, typename D2, typename D3>
+        struct dense_safe_op<Max<D1, D2, D3> >
+            : std::integral_constant<bool,
+                                     std::is_arithmetic<D1>::value &&
+                                     std::is_arithmetic<D2>::value> {};
+
+        template <typename ScalarT>
+        struct dense_safe_op<PlusMonoid<ScalarT> >
+            : dense_safe_op<Plus<ScalarT> > {};
+
+        template <typename ScalarT>
+        struct dense_safe_op<TimesMonoid<ScalarT> >
+            : dense_safe_op<Times<ScalarT> > {};
+
+        template <typename ScalarT>
+        struct dense_safe_op<MinMonoid<ScalarT> >
+            : dense_safe_op<Min<ScalarT> > {};
+
+        template <typename ScalarT>
+        struct dense_safe_op<MaxMonoid<ScalarT> >
+            : dense_safe_op<Max<ScalarT> > {};
+
+        //**********************************************************************
+        /// True when an operation writes w directly: w is dense, and there
+        /// is no mask and no accumulator.
+        template <typename WVectorT, typename MaskT, typename AccumT>
+        struct dense_output
+            : std::integral_constant<
+                bool,
+                std::is_base_of<DenseVector<typename WVectorT::ScalarType>,
+                                WVectorT>::value &&
+                dense_scalar<typename WVectorT::ScalarType>::value &&
+                std::is_same<MaskT, NoMask>::value &&
+                std::is_same<AccumT, NoAccumulate>::value>
+        {
+        };
+
+        //**********************************************************************
+        /// The values of a dense operand and its packed bitmap (nullptr when
+        /// every index is stored).
+        template <typename ScalarT>
+        struct DenseOperand
+        {
+            ScalarT    const *vals;
+            BitmapWord const *bitmap;
+        };
+
+        /// Contents that are not dense are left to the general kernels.
+        template <typename ContentsT, typename ScalarT>
+        inline bool dense_operand(ContentsT const &, DenseOperand<ScalarT> &)
+        {
+            return false;
+        }
+
+        template <typename ScalarT>
+        inline bool dense_operand(DenseView<ScalarT> const &contents,
+                                  DenseOperand<ScalarT>    &operand)
+        {
+            if (contents.offset() != 0)
+            {
+                return false;
+            }
+            operand.vals   = contents.values();
+            operand.bitmap = contents.bitmap();
+            return true;
+        }
+
+        /// A vector held as a bitmap is only dense if every index is stored
+        /// (its std::vector<bool> flags are not packed in words).
+        template <typename ScalarT>
+        inline bool dense_operand(HybridView<ScalarT> const &contents,
+                                  DenseOperand<ScalarT>     &operand)
+        {
+            if (!contents.isBitmap() ||
+                (contents.bitmap().size() != contents.bitmap().length()))
+            {
+                return false;
+            }
+            operand.vals   = contents.bitmap().values().data();
+            operand.bitmap = nullptr;
+            return true;
+        }
+
+        //**********************************************************************
+        inline IndexType lowest_bit(BitmapWord word)
+        {
+#if defined(__GNUC__)
+            return __builtin_ctzll(word);
+#else
+            IndexType bit(0);
+            for (; (word & 1) == 0; word >>= 1)
+            {
+                ++bit;
+            }
+            return bit;
+#endif
+        }
+
+        /// The flags of one word of an operand (all of the indices in the
+        /// word when the operand has no bitmap).
+        template <typename ScalarT>
+        inline BitmapWord operand_word(DenseOperand<ScalarT> const &operand,
+                                       IndexType                    word,
+                                       BitmapWord                   all)
+        {
+            return (operand.bitmap == nullptr) ? all : operand.bitmap[word];
+        }
+
+        //**********************************************************************
+        /// w = u op v over the union (ewise_or) or the intersection
+        /// (ewise_and) of the structures of u and v.
+        template <bool Union,
+                  typename WScalarT,
+                  typename BinaryOpT,
+                  typename UScalarT,
+                  typename VScalarT>
+        inline void dense_ewise_kernel(DenseVector<WScalarT>        &w,
+                                       BinaryOpT                     op,
+                                       DenseOperand<UScalarT> const &u,
+                                       DenseOperand<VScalarT> const &v)
+        {
+            GRB_TRACE_KERNEL("dense_ewise_kernel");
+
+            typedef typename BinaryOpT::result_type D3ScalarType;
+
+            IndexType  size(w.size());
+            IndexType  num_words(bitmap_num_words(size));
+            BitmapWord tail(bitmap_tail_mask(size));
+
+            bool full(Union ? ((u.bitmap == nullptr) || (v.bitmap == nullptr))
+                            : ((u.bitmap == nullptr) && (v.bitmap == nullptr)));
+            WScalarT   *w_vals(w.valueData());
+            BitmapWord *w_bitmap(full ? nullptr : w.bitmapData());
+
+            // Partially stored words are computed at every index only when
+            // no conversion of a stale value can overflow either.
+            bool const compute_all(
+                dense_safe_op<BinaryOpT>::value &&
+                std::is_same<UScalarT,
+                             typename BinaryOpT::lhs_type>::value &&
+                std::is_same<VScalarT,
+                             typename BinaryOpT::rhs_type>::value &&
+                std::is_same<WScalarT, D3ScalarType>::value);
+
+            IndexType nvals(0);
+
+#ifdef _OPENMP
+            #pragma omp parallel for schedule(static) reduction(+:nvals)
+#endif
+            for (IndexType word = 0; word < num_words; ++word)
+            {
+                IndexType  first(word*BITMAP_WORD_BITS);
+                BitmapWord all((word + 1 == num_words) ? tail : ~BitmapWord(0));
+                IndexType  last(first + popcount(all));
+
+                BitmapWord u_bits(operand_word(u, word, all));
+                BitmapWord v_bits(operand_word(v, word, all));
+                BitmapWord both(u_bits & v_bits);
+                BitmapWord w_bits(Union ? (u_bits | v_bits) : both);
+
+                if (both == all)
+                {
+                    for (IndexType idx = first; idx < last; ++idx)
+                    {
+                        w_vals[idx] = static_cast<WScalarT>(
+                            op(u.vals[idx], v.vals[idx]));
+                    }
+                }
+                else if (compute_all)
+                {
+                    for (IndexType idx = first; idx < last; ++idx)
+                    {
+                        IndexType    bit(idx - first);
+                        UScalarT     u_val(u.vals[idx]);
+                        VScalarT     v_val(v.vals[idx]);
+                        D3ScalarType t_val(op(u_val, v_val));
+                        if (Union)
+                        {
+                            // Only one operand stored: take its value
+                            t_val = ((both >> bit) & 1)   ? t_val :
+                                    ((u_bits >> bit) & 1) ?
+                                    static_cast<D3ScalarType>(u_val) :
+                                    static_cast<D3ScalarType>(v_val);
+                        }
+                        w_vals[idx] = static_cast<WScalarT>(t_val);
+                    }
+                }
+                else
+                {
+                    for (BitmapWord bits = w_bits; bits != 0; bits &= bits - 1)
+                    {
+                        IndexType  bit(lowest_bit(bits));
+                        IndexType  idx(first + bit);
+                        BitmapWord flag(BitmapWord(1) << bit);
+                        if (both & flag)
+                        {
+                            w_vals[idx] = static_cast<WScalarT>(
+                                op(u.vals[idx], v.vals[idx]));
+                        }
+                        else if (u_bits & flag)
+                        {
+                            w_vals[idx] = static_cast<WScalarT>(
+                                static_cast<D3ScalarType>(u.vals[idx]));
+                        }
+                        else
+                        {
+                            w_vals[idx] = static_cast<WScalarT>(
+                                static_cast<D3ScalarType>(v.vals[idx]));
+                        }
+                    }
+                }
+
+                if (w_bitmap != nullptr)
+                {
+                    w_bitmap[word] = w_bits;
+                }
+                nvals += popcount(w_bits);
+            }
+
+            w.setNvals(nvals);
+        }
+
+        //**********************************************************************
+        /// w = op(u) over the structure of u.
+        template <typename WScalarT,
+                  typename UnaryFunctionT,
+                  typename UScalarT>
+        inline void dense_apply_kernel(DenseVector<WScalarT>        &w,
+                                       UnaryFunctionT                op,
+                                       DenseOperand<UScalarT> const &u)
+        {
+            GRB_TRACE_KERNEL("dense_apply_kernel");
+
+            typedef typename UnaryFunctionT::result_type TScalarType;
+
+            IndexType  size(w.size());
+            IndexType  num_words(bitmap_num_words(size));
+            BitmapWord tail(bitmap_tail_mask(size));
+
+            WScalarT   *w_vals(w.valueData());
+            BitmapWord *w_bitmap((u.bitmap == nullptr) ? nullptr
+                                                       : w.bitmapData());
+
+            IndexType nvals(0);
+
+#ifdef _OPENMP
+            #pragma omp parallel for schedule(static) reduction(+:nvals)
+#endif
+            for (IndexType word = 0; word < num_words; ++word)
+            {
+                IndexType  first(word*BITMAP_WORD_BITS);
+                BitmapWord all((word + 1 == num_words) ? tail : ~BitmapWord(0));
+                BitmapWord u_bits(operand_word(u, word, all));
+
+                if (u_bits == all)
+                {
+                    IndexType last(first + popcount(all));
+                    for (IndexType idx = first; idx < last; ++idx)
+                    {
+                        w_vals[idx] = static_cast<WScalarT>(
+                            static_cast<TScalarType>(op(u.vals[idx])));
+                    }
+                }
+                else
+                {
+                    for (BitmapWord bits = u_bits; bits != 0; bits &= bits - 1)
+                    {
+                        IndexType idx(first + lowest_bit(bits));
+                        w_vals[idx] = static_cast<WScalarT>(
+                            static_cast<TScalarType>(op(u.vals[idx])));
+                    }
+                }
+
+                if (w_bitmap != nullptr)
+                {
+                    w_bitmap[word] = u_bits;
+                }
+                nvals += popcount(u_bits);
+            }
+
+            w.setNvals(nvals);
+        }
+
+        //**********************************************************************
+        // Entry points: return false (and do nothing) unless the operation
+        // can be done by the kernels above.
+        //**********************************************************************
+
+        template <bool Union,
+                  typename WVectorT,
+                  typename BinaryOpT,
+                  typename UVectorT,
+                  typename VVectorT>
+        inline bool dense_ewise(WVectorT &, BinaryOpT,
+                                UVectorT const &, VVectorT const &,
+                                std::false_type)
+        {
+            return false;
+        }
+
+        template <bool Union,
+                  typename WVectorT,
+                  typename BinaryOpT,
+                  typename UVectorT,
+                  typename VVectorT>
+        inline bool dense_ewise(WVectorT        &w,
+                                BinaryOpT        op,
+                                UVectorT const  &u,
+                                VVectorT const  &v,
+                                std::true_type)
+        {
+            DenseOperand<typename UVectorT::ScalarType> u_operand;
+            DenseOperand<typename VVectorT::ScalarType> v_operand;
+            if (!dense_operand(u.getContents(), u_operand) ||
+                !dense_operand(v.getContents(), v_operand))
+            {
+                return false;
+            }
+
+            dense_ewise_kernel<Union>(w, op, u_operand, v_operand);
+            return true;
+        }
+
+        /// w = u + v (eWiseAdd) when w is written directly.
+        template <typename WVectorT,
+                  typename MaskT,
+                  typename AccumT,
+                  typename BinaryOpT,
+                  typename UVectorT,
+                  typename VVectorT>
+        inline bool dense_ewise_add(WVectorT       &w,
+                                    MaskT    const &,
+                                    AccumT,
+                                    BinaryOpT       op,
+                                    UVectorT const &u,
+                                    VVectorT const &v)
+        {
+            return dense_ewise<true>(
+                w, op, u, v,
+                std::integral_constant<
+                    bool,
+                    dense_output<WVectorT, MaskT, AccumT>::value &&
+                    dense_scalar<typename UVectorT::ScalarType>::value &&
+                    dense_scalar<typename VVectorT::ScalarType>::value>());
+        }
+
+        /// w = u .* v (eWiseMult) when w is written directly.
+        template <typename WVectorT,
+                  typename MaskT,
+                  typename AccumT,
+                  typename BinaryOpT,
+                  typename UVectorT,
+                  typename VVectorT>
+        inline bool dense_ewise_mult(WVectorT       &w,
+                                     MaskT    const &,
+                                     AccumT,
+                                     BinaryOpT       op,
+                                     UVectorT const &u,
+                                     VVectorT const &v)
+        {
+            return dense_ewise<false>(
+                w, op, u, v,
+                std::integral_constant<
+                    bool,
+                    dense_output<WVectorT, MaskT, AccumT>::value &&
+                    dense_scalar<typename UVectorT::ScalarType>::value &&
+                    dense_scalar<typename VVectorT::ScalarType>::value>());
+        }
+
+        template <typename WVectorT,
+                  typename UnaryFunctionT,
+                  typename UVectorT>
+        inline bool dense_apply(WVectorT &, UnaryFunctionT,
+                                UVectorT const &, std::false_type)
+        {
+            return false;
+        }
+
+        template <typename WVectorT,
+                  typename UnaryFunctionT,
+                  typename UVectorT>
+        inline bool dense_apply(WVectorT       &w,
+                                UnaryFunctionT  op,
+                                UVectorT const &u,
+                                std::true_type)
+        {
+            DenseOperand<typename UVectorT::ScalarType> u_operand;
+            if (!dense_operand(u.getContents(), u_operand))
+            {
+                return false;
+            }
+
+            dense_apply_kernel(w, op, u_operand);
+            return true;
+        }
+
+        /// w = op(u) (apply) when w is written directly.
+        template <typename WVectorT,
+                  typename MaskT,
+                  typename AccumT,
+                  typename UnaryFunctionT,
+                  typename UVectorT>
+        inline bool dense_apply(WVectorT       &w,
+                                MaskT    const &,
+                                AccumT,
+                                UnaryFunctionT  op,
+                                UVectorT const &u)
+        {
+            return dense_apply(
+                w, op, u,
+                std::integral_constant<
+                    bool,
+                    dense_output<WVectorT, MaskT, AccumT>::value &&
+                    dense_scalar<typename UVectorT::ScalarType>::value>());
+        }
+
+    } // backend
+} // GraphBLAS
+
+#endif // GB_SEQUENTIAL_DENSE_EWISE_HPP
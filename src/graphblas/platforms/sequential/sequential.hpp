@@ -43,6 +43,14 @@
 #include <graphblas/platforms/sequential/operations.hpp>
 
 #include <graphblas/platforms/sequential/BitmapSparseVector.hpp>
+#include <graphblas/platforms/sequential/HybridSparseVector.hpp>
+#include <graphblas/platforms/sequential/DenseVector.hpp>
 #include <graphblas/platforms/sequential/LilSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/CsrSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/CsrCscSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/MappedCsrSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/HypersparseMatrix.hpp>
+#include <graphblas/platforms/sequential/IsoSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/DenseMatrix.hpp>
 
 #endif // GB_SEQUENTIAL_HPP
@@ -47,6 +47,7 @@
 
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
+#include "dense_ewise.hpp"
 
 //******************************************************************************
 
@@ -70,12 +71,19 @@ namespace GraphBLAS
             UVectorT                                  const &u,
             bool                                             replace_flag = false)
         {
+            // A dense w without a mask or an accumulator is written in
+            // place (see dense_ewise.hpp)
+            if (dense_apply(w, mask, accum, op, u))
+            {
+                return;
+            }
+
             // =================================================================
             // Apply the unary operator from A into T.
             // This is really the guts of what makes this special.
             typedef typename UVectorT::ScalarType        UScalarType;
             typedef typename UnaryFunctionT::result_type TScalarType;
-            std::vector<std::tuple<IndexType,TScalarType> > t_contents;
+            ScratchVector<std::tuple<IndexType,TScalarType> > t_contents;
 
             if (u.nvals() > 0)
             {
@@ -87,12 +95,12 @@ namespace GraphBLAS
                     UScalarType          u_val;
                     std::tie(u_idx, u_val) = *row_iter;
                     TScalarType t_val = static_cast<TScalarType>(op(u_val));
-                    t_contents.push_back(std::make_tuple(u_idx,t_val));
+                    t_contents->push_back(std::make_tuple(u_idx,t_val));
                     ++row_iter;
                 }
             }
 
-            GRB_LOG_VERBOSE("t: " << t_contents);
+            GRB_LOG_VERBOSE("t: " << *t_contents);
 
             // =================================================================
             // Accumulate into Z
@@ -101,14 +109,14 @@ namespace GraphBLAS
                 TScalarType,
                 typename AccumT::result_type>::type  ZScalarType;
 
-            std::vector<std::tuple<IndexType,ZScalarType> > z_contents;
-            ewise_or_opt_accum_1D(z_contents, w, t_contents, accum);
+            ScratchVector<std::tuple<IndexType,ZScalarType> > z_contents;
+            ewise_or_opt_accum_1D(*z_contents, w, *t_contents, accum);
 
-            GRB_LOG_VERBOSE("z: " << z_contents);
+            GRB_LOG_VERBOSE("z: " << *z_contents);
 
             // =================================================================
             // Copy Z into the final output considering mask and replace
-            write_with_opt_mask_1D(w, z_contents, mask, replace_flag);
+            write_with_opt_mask_1D(w, *z_contents, mask, replace_flag);
         }
 
         //**********************************************************************
@@ -128,7 +136,7 @@ namespace GraphBLAS
             bool                                             replace_flag = false)
         {
             typedef typename AMatrixT::ScalarType                   AScalarType;
-            typedef std::vector<std::tuple<IndexType,AScalarType> > ARowType;
+            typedef typename AMatrixT::RowType                      ARowType;
 
             typedef CScalarT                                        CScalarType;
             typedef std::vector<std::tuple<IndexType,CScalarType> > CRowType;
@@ -143,17 +151,20 @@ namespace GraphBLAS
             // =================================================================
             // Apply the unary operator from A into T.
             // This is really the guts of what makes this special.
-            LilSparseMatrix<TScalarType> T(nrows, ncols);
+            typedef GraphBLAS::backend::Matrix<CScalarT, CTagsT...> CMatrixType;
+            typename scratch_matrix<CMatrixType, TScalarType>::type
+                T(nrows, ncols);
 
-            ARowType a_row;
             TRowType t_row;
 
             IndexType a_idx;
             AScalarType a_val;
 
-            for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+            RowSet rows(stored_rows(A));
+            for (IndexType ix = 0; ix < rows.size(); ++ix)
             {
-                a_row = A.getRow(row_idx);
+                IndexType row_idx(rows[ix]);
+                ARowType a_row(A.getRow(row_idx));
                 if (!a_row.empty())
                 {
                     t_row.clear();
@@ -174,20 +185,15 @@ namespace GraphBLAS
             GRB_LOG_VERBOSE("T: " << T);
 
             // =================================================================
-            // Accumulate T via C into Z
+            // Accumulate T via C and write the result through the mask,
+            // without forming Z
             typedef typename std::conditional<
                 std::is_same<AccumT, NoAccumulate>::value,
                 TScalarType,
                 typename AccumT::result_type>::type  ZScalarType;
 
-            LilSparseMatrix<ZScalarType> Z(nrows, ncols);
-            ewise_or_opt_accum(Z, C, T, accum);
-
-            GRB_LOG_VERBOSE("Z: " << Z);
-
-            // =================================================================
-            // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, mask, replace_flag);
+            write_with_opt_accum_mask<ZScalarType>(C, T, mask, accum,
+                                                   replace_flag);
         }
     }
 }
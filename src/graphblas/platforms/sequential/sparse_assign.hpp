@@ -83,11 +83,13 @@ namespace GraphBLAS
 
         //********************************************************************
         template <typename TScalarT,
-                  typename AScalarT>
+                  typename SrcRowT>
         void vectorExpand(std::vector<std::tuple<IndexType, TScalarT>>  &vec_dest,
-                          std::vector<std::tuple<IndexType, AScalarT>> const &vec_src,
+                          SrcRowT                                const &vec_src,
                           std::vector<std::pair<IndexType, IndexType>> const &Indices)
         {
+            typedef typename row_scalar_type<SrcRowT>::type AScalarT;
+
             // The Indices are pairs of ( output_index, input_index)
             // We do it this way, so we get the output in the right
             // order to begin with
@@ -150,18 +152,17 @@ namespace GraphBLAS
 
         //********************************************************************
         template<typename TScalarT,
-                 typename AScalarT,
+                 typename AMatrixT,
                  typename RowSequenceT,
                  typename ColSequenceT>
         void matrixExpand(LilSparseMatrix<TScalarT>          &T,
-                          LilSparseMatrix<AScalarT>  const   &A,
+                          AMatrixT                   const   &A,
                           RowSequenceT               const   &row_Indices,
                           ColSequenceT               const   &col_Indices)
         {
             // NOTE!! - Backend code. We expect that all dimension
             // checks done elsewhere.
-
-            typedef std::vector<std::tuple<IndexType,AScalarT> > ARowType;
+            typedef typename AMatrixT::RowType ARowType;
             typedef std::vector<std::tuple<IndexType,TScalarT> > TRowType;
 
             T.clear();
@@ -482,7 +483,7 @@ namespace GraphBLAS
 
             // EXTRACT the row of C matrix
             typedef typename CMatrixT::ScalarType CScalarType;
-            auto C_row(C.getRow(row_index));
+            typename CMatrixT::RowType C_row(C.getRow(row_index));
             Vector<CScalarType> c_vec(C.ncols());
             for (auto it : C_row)
             {
@@ -47,6 +47,7 @@
 
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
+#include "dense_ewise.hpp"
 
 
 //****************************************************************************
@@ -73,27 +74,34 @@ namespace GraphBLAS
             VVectorT                                  const &v,
             bool                                             replace_flag = false)
         {
+            // A dense w without a mask or an accumulator is written in
+            // place (see dense_ewise.hpp)
+            if (dense_ewise_add(w, mask, accum, op, u, v))
+            {
+                return;
+            }
+
             // =================================================================
             // Do the basic ewise-and work: T = A .* B
             typedef typename BinaryOpT::result_type D3ScalarType;
-            std::vector<std::tuple<IndexType,D3ScalarType> > t_contents;
+            ScratchVector<std::tuple<IndexType,D3ScalarType> > t_contents;
 
             if ((u.nvals() > 0) || (v.nvals() > 0))
             {
                 auto u_contents(u.getContents());
                 auto v_contents(v.getContents());
 
-                ewise_or(t_contents, u_contents, v_contents, op);
+                ewise_or(*t_contents, u_contents, v_contents, op);
             }
 
             // =================================================================
             // Accumulate into Z
-            std::vector<std::tuple<IndexType,WScalarT> > z_contents;
-            ewise_or_opt_accum_1D(z_contents, w, t_contents, accum);
+            ScratchVector<std::tuple<IndexType,WScalarT> > z_contents;
+            ewise_or_opt_accum_1D(*z_contents, w, *t_contents, accum);
 
             // =================================================================
             // Copy Z into the final output considering mask and replace
-            write_with_opt_mask_1D(w, z_contents, mask, replace_flag);
+            write_with_opt_mask_1D(w, *z_contents, mask, replace_flag);
         }
 
         //**********************************************************************
@@ -120,22 +128,26 @@ namespace GraphBLAS
             typedef typename AMatrixT::ScalarType AScalarType;
             typedef typename BMatrixT::ScalarType BScalarType;
 
-            typedef std::vector<std::tuple<IndexType,AScalarType> > ARowType;
-            typedef std::vector<std::tuple<IndexType,BScalarType> > BRowType;
+            typedef typename AMatrixT::RowType ARowType;
+            typedef typename BMatrixT::RowType BRowType;
             typedef std::vector<std::tuple<IndexType,CScalarT> > CRowType;
 
             // =================================================================
             // Do the basic ewise-and work: T = A .* B
             typedef typename BinaryOpT::result_type D3ScalarType;
             typedef std::vector<std::tuple<IndexType,D3ScalarType> > TRowType;
-            LilSparseMatrix<D3ScalarType> T(num_rows, num_cols);
+            typedef GraphBLAS::backend::Matrix<CScalarT, CTagsT...> CMatrixType;
+            typename scratch_matrix<CMatrixType, D3ScalarType>::type
+                T(num_rows, num_cols);
 
             if ((A.nvals() > 0) || (B.nvals() > 0))
             {
                 // create a row of result at a time
                 TRowType T_row;
-                for (IndexType row_idx = 0; row_idx < num_rows; ++row_idx)
+                RowSet rows(stored_rows(A, B));
+                for (IndexType ix = 0; ix < rows.size(); ++ix)
                 {
+                    IndexType row_idx(rows[ix]);
                     ARowType A_row(A.getRow(row_idx));
                     BRowType B_row(B.getRow(row_idx));
 
@@ -161,14 +173,10 @@ namespace GraphBLAS
             }
 
             // =================================================================
-            // Accumulate into Z
-
-            LilSparseMatrix<CScalarT> Z(num_rows, num_cols);
-            ewise_or_opt_accum(Z, C, T, accum);
-
-            // =================================================================
-            // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, Mask, replace_flag);
+            // Accumulate T via C and write the result through the mask,
+            // without forming Z
+            write_with_opt_accum_mask<CScalarT>(C, T, Mask, accum,
+                                                replace_flag);
         } // ewisemult
 
     } // backend
@@ -39,6 +39,7 @@
 #include <utility>
 #include <vector>
 #include <iterator>
+#include <algorithm>
 #include <type_traits>
 #include <iostream>
 
@@ -62,7 +63,7 @@ namespace GraphBLAS
          * Extracts a series of values from the vector based on the passed in
          * indices.
          * @tparam CScalarT  The type of the output scalar.
-         * @tparam AScalarT  The type of the input scalar.
+         * @tparam ARowT     The input (a vector of tuples or a view).
          * @tparam SequenceT A random access iterator into a container of indices
          *
          * @param vec_dest The output vector.
@@ -71,14 +72,16 @@ namespace GraphBLAS
          * @param end     Iterator at end of sequence of indices to extract.
          */
         template<typename CScalarT,
-                 typename AScalarT,
+                 typename ARowT,
                  typename IteratorT>
         void vectorExtract(
                 std::vector<std::tuple<IndexType, CScalarT> >       &vec_dest,
-                std::vector<std::tuple<IndexType, AScalarT> > const &vec_src,
+                ARowT                                         const &vec_src,
                 IteratorT           begin,
                 IteratorT           end)
         {
+            typedef typename row_scalar_type<ARowT>::type AScalarT;
+
             // This is expensive but the indices can be duplicates and
             // out of order.
 
@@ -109,12 +112,106 @@ namespace GraphBLAS
         }
 
         // *******************************************************************
+        /// The contents of a bitmap vector are looked up by index directly.
         template<typename CScalarT,
                  typename AScalarT,
+                 typename IteratorT>
+        void vectorExtract(
+                std::vector<std::tuple<IndexType, CScalarT> >       &vec_dest,
+                BitmapView<AScalarT>                          const &vec_src,
+                IteratorT           begin,
+                IteratorT           end)
+        {
+            vec_dest.clear();
+
+            IndexType out_idx = 0;
+            for (auto col_it = begin; col_it != end; ++col_it, ++out_idx)
+            {
+                if (vec_src.hasElement(*col_it))
+                {
+                    vec_dest.push_back(
+                        std::make_tuple(out_idx,
+                                        static_cast<CScalarT>(
+                                            vec_src.extractElement(*col_it))));
+                }
+            }
+        }
+
+        // *******************************************************************
+        /// Dense contents are looked up by index too, without checking the
+        /// structure when they are full.
+        template<typename CScalarT,
+                 typename AScalarT,
+                 typename IteratorT>
+        void vectorExtract(
+                std::vector<std::tuple<IndexType, CScalarT> >       &vec_dest,
+                DenseView<AScalarT>                           const &vec_src,
+                IteratorT           begin,
+                IteratorT           end)
+        {
+            vec_dest.clear();
+
+            bool all_stored(vec_src.full());
+            IndexType out_idx = 0;
+            for (auto col_it = begin; col_it != end; ++col_it, ++out_idx)
+            {
+                if (all_stored || vec_src.hasElement(*col_it))
+                {
+                    vec_dest.push_back(
+                        std::make_tuple(out_idx,
+                                        static_cast<CScalarT>(
+                                            vec_src.extractElement(*col_it))));
+                }
+            }
+        }
+
+        // *******************************************************************
+        /// A vector held as a bitmap is looked up directly; one held as a
+        /// sorted list is binary searched for each index.
+        template<typename CScalarT,
+                 typename AScalarT,
+                 typename IteratorT>
+        void vectorExtract(
+                std::vector<std::tuple<IndexType, CScalarT> >       &vec_dest,
+                HybridView<AScalarT>                          const &vec_src,
+                IteratorT           begin,
+                IteratorT           end)
+        {
+            if (vec_src.isBitmap())
+            {
+                vectorExtract(vec_dest, vec_src.bitmap(), begin, end);
+                return;
+            }
+
+            vec_dest.clear();
+
+            SparseView<AScalarT> const &list(vec_src.list());
+            IndexType out_idx = 0;
+            for (auto col_it = begin; col_it != end; ++col_it, ++out_idx)
+            {
+                IndexType wanted_idx = *col_it;
+                auto A_it = std::lower_bound(
+                    list.begin(), list.end(), wanted_idx,
+                    [](std::tuple<IndexType, AScalarT> const &elt,
+                       IndexType                             idx)
+                    { return std::get<0>(elt) < idx; });
+                if ((A_it != list.end()) && (std::get<0>(*A_it) == wanted_idx))
+                {
+                    vec_dest.push_back(
+                        std::make_tuple(out_idx,
+                                        static_cast<CScalarT>(
+                                            std::get<1>(*A_it))));
+                }
+            }
+        }
+
+        // *******************************************************************
+        template<typename CScalarT,
+                 typename ARowT,
                  typename SequenceT>
         void vectorExtract(
                 std::vector<std::tuple<IndexType, CScalarT> >       &vec_dest,
-                std::vector<std::tuple<IndexType, AScalarT> > const &vec_src,
+                ARowT                                         const &vec_src,
                 SequenceT                                            indices)
         {
             vectorExtract(vec_dest, vec_src, indices.begin(), indices.end());
@@ -122,16 +219,17 @@ namespace GraphBLAS
 
         // *******************************************************************
         template<typename CScalarT,
-                 typename AScalarT,
+                 typename AMatrixT,
                  typename RowIteratorT,
                  typename ColIteratorT>
         void matrixExtract(LilSparseMatrix<CScalarT>          &C,
-                           LilSparseMatrix<AScalarT>  const   &A,
+                           AMatrixT                   const   &A,
                            RowIteratorT                        row_begin,
                            RowIteratorT                        row_end,
                            ColIteratorT                        col_begin,
                            ColIteratorT                        col_end)
         {
+            typedef typename AMatrixT::ScalarType AScalarT;
             //typedef std::vector<std::tuple<IndexType,AScalarT> > ARowType;
             typedef std::vector<std::tuple<IndexType,CScalarT> > CRowType;
 
@@ -144,7 +242,7 @@ namespace GraphBLAS
                  row_it != row_end;
                  ++row_it, ++out_row_index)
             {
-                auto row(A.getRow(*row_it));
+                typename AMatrixT::RowType row(A.getRow(*row_it));
 
                 IndexType tmp_idx;
                 AScalarT tmp_value;
@@ -183,7 +281,7 @@ namespace GraphBLAS
                  row_it != row_end;
                  ++row_it, ++out_row_index)
             {
-                auto row(A.getRow(*row_it));
+                typename AMatrixT::RowType row(A.getRow(*row_it));
 
                 IndexType tmp_idx;
                 AScalarT tmp_value;
@@ -226,16 +324,17 @@ namespace GraphBLAS
         }
 
         //********************************************************************
-        template <typename WScalarT, typename AScalarT, typename IteratorT>
+        template <typename WScalarT, typename AMatrixT, typename IteratorT>
         void extractColumn(
             std::vector< std::tuple<IndexType, WScalarT> >         &vec_dest,
-            LilSparseMatrix<AScalarT>                       const  &A,
+            AMatrixT                                        const  &A,
             IteratorT                                               row_begin,
             IteratorT                                               row_end,
             IndexType                                               col_index)
         {
+            typedef typename AMatrixT::ScalarType AScalarT;
             // Walk the rows, extracting the cell if it exists
-            typedef std::vector<std::tuple<IndexType,AScalarT> > ARowType;
+            typedef typename AMatrixT::RowType ARowType;
 
             vec_dest.clear();
 
@@ -411,20 +510,15 @@ namespace GraphBLAS
             GRB_LOG_VERBOSE("T: " << T);
 
             // =================================================================
-            // Accumulate into Z
+            // Accumulate T via C and write the result through the mask,
+            // without forming Z
             typedef typename std::conditional<
                 std::is_same<AccumT, NoAccumulate>::value,
                 AScalarType,
                 typename AccumT::result_type>::type  ZScalarType;
 
-            LilSparseMatrix<ZScalarType> Z(C.nrows(), C.ncols());
-            ewise_or_opt_accum(Z, C, T, accum);
-
-            GRB_LOG_VERBOSE("Z: " << Z);
-
-            // =================================================================
-            // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, Mask, replace_flag);
+            write_with_opt_accum_mask<ZScalarType>(C, T, Mask, accum,
+                                                   replace_flag);
 
             GRB_LOG_VERBOSE("C (Result): " << C);
         };
@@ -43,8 +43,18 @@
 #include <iterator>
 #include <iostream>
 #include <string>
+#include <algorithm>
+#include <type_traits>
 #include <graphblas/algebra.hpp>
 #include <graphblas/indices.hpp>
+#include <graphblas/platforms/sequential/workspace.hpp>
+
+#include "SparseView.hpp"
+#include "sparse_intersect.hpp"
+#include "LilSparseMatrix.hpp"
+#include "HypersparseMatrix.hpp"
+#include "CsrCscSparseMatrix.hpp"
+#include "TransposeView.hpp"
 
 //****************************************************************************
 
@@ -73,6 +83,128 @@ namespace GraphBLAS
             os << std::endl;
         }
 
+        //**********************************************************************
+        /// True if MatrixT is (or derives from) hypersparse storage.
+        template<typename MatrixT>
+        struct is_hypersparse
+            : public std::is_base_of<
+                HypersparseMatrix<typename MatrixT::ScalarType>, MatrixT>
+        {
+        };
+
+        /// True if MatrixT is (or derives from) storage that keeps a CSC
+        /// copy for column access.
+        template<typename MatrixT>
+        struct has_csc_copy
+            : public std::is_base_of<
+                CsrCscSparseMatrix<typename MatrixT::ScalarType>, MatrixT>
+        {
+        };
+
+        template<typename ScalarT, typename... TagsT> class DenseMatrix;
+
+        /// Storage for the temporaries of an operation that writes to a
+        /// CMatrixT: hypersparse when C is, so that they do not allocate
+        /// every row either.
+        template<typename CMatrixT, typename ScalarT>
+        struct scratch_matrix
+        {
+            typedef typename std::conditional<
+                is_hypersparse<CMatrixT>::value,
+                HypersparseMatrix<ScalarT>,
+                LilSparseMatrix<ScalarT> >::type type;
+        };
+
+        /// The rows an operation has to visit: all of them, or a sorted list
+        /// when the operands are hypersparse.
+        class RowSet
+        {
+        public:
+            explicit RowSet(IndexType num_rows)
+                : m_all(true), m_num_rows(num_rows)
+            {
+            }
+
+            explicit RowSet(std::vector<IndexType> const &rows)
+                : m_all(false), m_num_rows(rows.size()), m_rows(rows)
+            {
+            }
+
+            bool all() const { return m_all; }
+            std::vector<IndexType> const &rows() const { return m_rows; }
+
+            IndexType size() const { return m_num_rows; }
+            IndexType operator[](IndexType ix) const
+            {
+                return m_all ? ix : m_rows[ix];
+            }
+
+        private:
+            bool                   m_all;
+            IndexType              m_num_rows;
+            std::vector<IndexType> m_rows;
+        };
+
+        template<typename MatrixT>
+        inline RowSet stored_rows(MatrixT const &A, std::false_type)
+        {
+            return RowSet(A.nrows());
+        }
+
+        template<typename MatrixT>
+        inline RowSet stored_rows(MatrixT const &A, std::true_type)
+        {
+            return RowSet(A.nonEmptyRows());
+        }
+
+        /// The rows of A that may hold values.  The set is a copy, so A
+        /// may be modified while looping over it.
+        template<typename MatrixT>
+        inline RowSet stored_rows(MatrixT const &A)
+        {
+            return stored_rows(A, typename is_hypersparse<MatrixT>::type());
+        }
+
+        /// The rows of A or B that may hold values.
+        template<typename AMatrixT, typename BMatrixT>
+        inline RowSet stored_rows(AMatrixT const &A, BMatrixT const &B)
+        {
+            RowSet A_rows(stored_rows(A));
+            RowSet B_rows(stored_rows(B));
+            if (A_rows.all() || B_rows.all())
+            {
+                return RowSet(A.nrows());
+            }
+
+            std::vector<IndexType> rows;
+            std::set_union(A_rows.rows().begin(), A_rows.rows().end(),
+                           B_rows.rows().begin(), B_rows.rows().end(),
+                           std::back_inserter(rows));
+            return RowSet(rows);
+        }
+
+        /// The rows where both A and B may hold values.
+        template<typename AMatrixT, typename BMatrixT>
+        inline RowSet common_rows(AMatrixT const &A, BMatrixT const &B)
+        {
+            RowSet A_rows(stored_rows(A));
+            RowSet B_rows(stored_rows(B));
+            if (A_rows.all())
+            {
+                return B_rows;
+            }
+            if (B_rows.all())
+            {
+                return A_rows;
+            }
+
+            std::vector<IndexType> rows;
+            std::set_intersection(A_rows.rows().begin(), A_rows.rows().end(),
+                                  B_rows.rows().begin(), B_rows.rows().end(),
+                                  std::back_inserter(rows));
+            return RowSet(rows);
+        }
+
         //**********************************************************************
 
         template <typename DstMatrixT,
@@ -83,16 +215,17 @@ namespace GraphBLAS
             typedef typename SrcMatrixT::ScalarType SrcScalarType;
             typedef typename DstMatrixT::ScalarType DstScalarType;
 
-            typedef std::vector<std::tuple<IndexType, SrcScalarType> > SrcRowType;
+            typedef typename SrcMatrixT::RowType SrcRowType;
             typedef std::vector<std::tuple<IndexType, DstScalarType> > DstRowType;
 
             // Copying removes the contents of the other matrix so clear it first.
             dstMatrix.clear();
 
-            IndexType nrows(dstMatrix.nrows());
-            for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+            RowSet rows(stored_rows(srcMatrix));
+            for (IndexType ix = 0; ix < rows.size(); ++ix)
             {
-                SrcRowType srcRow = srcMatrix.getRow(row_idx);
+                IndexType row_idx(rows[ix]);
+                SrcRowType srcRow(srcMatrix.getRow(row_idx));
                 DstRowType dstRow;
 
                 // We need to construct a new row with the appropriate cast!
@@ -111,6 +244,40 @@ namespace GraphBLAS
 
         // @todo: Make a sparse copy where they are the same type for efficiency
 
+        //**********************************************************************
+        /// Replace the contents of C with the computed rows.  The rows are
+        /// set in increasing order, which only appends to compressed
+        /// storage.
+        template<typename CMatrixT, typename RowT>
+        inline void set_rows(CMatrixT                      &C,
+                             std::vector<RowT>     const   &rows)
+        {
+            C.clear();
+            for (IndexType row_idx = 0; row_idx < rows.size(); ++row_idx)
+            {
+                if (!rows[row_idx].empty())
+                {
+                    C.setRow(row_idx, rows[row_idx]);
+                }
+            }
+        }
+
+        /// set_rows() for rows computed over row_set.
+        template<typename CMatrixT, typename RowT>
+        inline void set_rows(CMatrixT                      &C,
+                             std::vector<RowT>     const   &rows,
+                             RowSet                const   &row_set)
+        {
+            C.clear();
+            for (IndexType ix = 0; ix < rows.size(); ++ix)
+            {
+                if (!rows[ix].empty())
+                {
+                    C.setRow(row_set[ix], rows[ix]);
+                }
+            }
+        }
+
         //**********************************************************************
         /// Increments the provided iterate while the value is less
         /// than the provided index
@@ -200,7 +367,7 @@ namespace GraphBLAS
             std::tie(tmp_idx, tmp_val) = *iter;
             while (iter != iter_end && tmp_idx < idx )
             {
-                vec.push_back(*iter);
+                vec.push_back(std::make_tuple(tmp_idx, tmp_val));
 
                 ++iter;
                 if (iter == iter_end)
@@ -215,14 +382,16 @@ namespace GraphBLAS
 
         /// Perform the dot product of a row of a matrix with a sparse vector without
         /// pulling the indices out of the vector first.
-        template <typename D1, typename D2, typename D3, typename SemiringT>
+        template <typename ARowT, typename D2, typename D3, typename SemiringT>
         bool dot2(D3                                                      &ans,
-                  std::vector<std::tuple<GraphBLAS::IndexType,D1> > const &A_row,
+                  ARowT                                             const &A_row,
                   std::vector<bool>                                 const &u_bitmap,
                   std::vector<D2>                                   const &u_vals,
                   GraphBLAS::IndexType                                     u_nvals,
                   SemiringT                                                op)
         {
+            typedef typename row_scalar_type<ARowT>::type D1;
+
             bool value_set(false);
             ans = op.zero();
 
@@ -276,13 +445,18 @@ namespace GraphBLAS
         }
 
         //************************************************************************
-        /// A dot product of two sparse vectors (vectors<tuple(index,value)>)
-        template <typename D1, typename D2, typename D3, typename SemiringT>
+        /// A dot product of two sparse vectors (vectors<tuple(index,value)>
+        /// or views) that can only be iterated: merge them.
+        template <typename Row1T, typename Row2T, typename D3, typename SemiringT>
         bool dot(D3                                                      &ans,
-                 std::vector<std::tuple<GraphBLAS::IndexType,D1> > const &vec1,
-                 std::vector<std::tuple<GraphBLAS::IndexType,D2> > const &vec2,
-                 SemiringT                                                op)
+                 Row1T                                             const &vec1,
+                 Row2T                                             const &vec2,
+                 SemiringT                                                op,
+                 std::false_type)
         {
+            typedef typename row_scalar_type<Row1T>::type D1;
+            typedef typename row_scalar_type<Row2T>::type D2;
+
             bool value_set(false);
             ans = op.zero();
 
@@ -306,27 +480,20 @@ namespace GraphBLAS
                 std::tie(a_idx, a_val) = *v1_it;
                 std::tie(u_idx, u_val) = *v2_it;
 
-                //std::cerr << "Examine u idx,val = " << u_idx << "," << u_val
-                //          << "; A col_idx,val = " << a_idx << "," << a_val << std::endl;
-
                 if (u_idx == a_idx)
                 {
-                    //std::cerr << ans << " + " << a_val << " * " << u_val << " = ";
                     ans = op.add(ans, op.mult(a_val, u_val));
                     value_set = true;
-                    //std::cerr << ans << std::endl;
 
                     ++v2_it;
                     ++v1_it;
                 }
                 else if (u_idx > a_idx)
                 {
-                    //std::cerr << "Advancing v1_it" << std::endl;
                     ++v1_it;
                 }
                 else
                 {
-                    //std::cerr << "Advancing v2_it" << std::endl;
                     ++v2_it;
                 }
             }
@@ -334,13 +501,676 @@ namespace GraphBLAS
             return value_set;
         }
 
+        /// A dot product of two random access rows: intersect their indices
+        /// (see sparse_intersect.hpp) and read the values that match.
+        template <typename Row1T, typename Row2T, typename D3, typename SemiringT>
+        bool dot(D3                                                      &ans,
+                 Row1T                                             const &vec1,
+                 Row2T                                             const &vec2,
+                 SemiringT                                                op,
+                 std::true_type)
+        {
+            typedef typename row_scalar_type<Row1T>::type D1;
+            typedef typename row_scalar_type<Row2T>::type D2;
+
+            bool value_set(false);
+            ans = op.zero();
+
+            // Both iso (see IsoSparseMatrix): every product is the same, so
+            // only the indices are intersected.
+            D1 a_iso = D1();
+            D2 u_iso = D2();
+            if (iso_value(vec1, a_iso) && iso_value(vec2, u_iso))
+            {
+                auto prod(op.mult(a_iso, u_iso));
+                sparse_intersect(vec1, vec2,
+                                 [&](IndexType, IndexType)
+                                 {
+                                     ans = op.add(ans, prod);
+                                     value_set = true;
+                                 });
+                return value_set;
+            }
+
+            sparse_intersect(vec1, vec2,
+                             [&](IndexType pos1, IndexType pos2)
+                             {
+                                 ans = op.add(ans,
+                                              op.mult(std::get<1>(vec1[pos1]),
+                                                      std::get<1>(vec2[pos2])));
+                                 value_set = true;
+                             });
+            return value_set;
+        }
+
+        /// A dot product of two sparse vectors (vectors<tuple(index,value)>
+        /// or views)
+        template <typename Row1T, typename Row2T, typename D3, typename SemiringT>
+        bool dot(D3                                                      &ans,
+                 Row1T                                             const &vec1,
+                 Row2T                                             const &vec2,
+                 SemiringT                                                op)
+        {
+            return dot(ans, vec1, vec2, op,
+                       std::integral_constant<
+                           bool,
+                           (is_random_access_row<Row1T>::value &&
+                            is_random_access_row<Row2T>::value)>());
+        }
+
+        /// A dot product with a vector that can look its elements up by
+        /// index (bitmap or dense contents) visits the stored elements of
+        /// the other operand only, so it does not depend on the number of
+        /// values that can be looked up.  If all_stored, every index of
+        /// the lookup side is stored and its structure is not checked.
+        template <typename Row1T, typename Lookup2T, typename D3,
+                  typename SemiringT>
+        bool dot_lookup_rhs(D3                                           &ans,
+                            Row1T                                  const &vec1,
+                            Lookup2T                               const &vec2,
+                            SemiringT                                     op,
+                            bool                                          all_stored)
+        {
+            bool value_set(false);
+            ans = op.zero();
+
+            if (vec2.empty())
+            {
+                return value_set;
+            }
+
+            for (auto&& elt : vec1)
+            {
+                IndexType idx(std::get<0>(elt));
+                if (all_stored || vec2.hasElement(idx))
+                {
+                    ans = op.add(ans, op.mult(std::get<1>(elt),
+                                              vec2.extractElement(idx)));
+                    value_set = true;
+                }
+            }
+
+            return value_set;
+        }
+
+        template <typename Lookup1T, typename Row2T, typename D3,
+                  typename SemiringT>
+        bool dot_lookup_lhs(D3                                           &ans,
+                            Lookup1T                               const &vec1,
+                            Row2T                                  const &vec2,
+                            SemiringT                                     op,
+                            bool                                          all_stored)
+        {
+            bool value_set(false);
+            ans = op.zero();
+
+            if (vec1.empty())
+            {
+                return value_set;
+            }
+
+            for (auto&& elt : vec2)
+            {
+                IndexType idx(std::get<0>(elt));
+                if (all_stored || vec1.hasElement(idx))
+                {
+                    ans = op.add(ans, op.mult(vec1.extractElement(idx),
+                                              std::get<1>(elt)));
+                    value_set = true;
+                }
+            }
+
+            return value_set;
+        }
+
+        template <typename Row1T, typename D2, typename D3, typename SemiringT>
+        bool dot(D3                                                      &ans,
+                 Row1T                                             const &vec1,
+                 BitmapView<D2>                                    const &vec2,
+                 SemiringT                                                op)
+        {
+            return dot_lookup_rhs(ans, vec1, vec2, op, false);
+        }
+
+        template <typename D1, typename Row2T, typename D3, typename SemiringT>
+        bool dot(D3                                                      &ans,
+                 BitmapView<D1>                                    const &vec1,
+                 Row2T                                             const &vec2,
+                 SemiringT                                                op)
+        {
+            return dot_lookup_lhs(ans, vec1, vec2, op, false);
+        }
+
+        /// The contents of a hybrid vector are looked up when they are held
+        /// as a bitmap and merged when they are held as a sorted list.
+        template <typename Row1T, typename D2, typename D3, typename SemiringT>
+        bool dot(D3                                                      &ans,
+                 Row1T                                             const &vec1,
+                 HybridView<D2>                                    const &vec2,
+                 SemiringT                                                op)
+        {
+            return (vec2.isBitmap() ? dot(ans, vec1, vec2.bitmap(), op)
+                                    : dot(ans, vec1, vec2.list(), op));
+        }
+
+        template <typename D1, typename Row2T, typename D3, typename SemiringT>
+        bool dot(D3                                                      &ans,
+                 HybridView<D1>                                    const &vec1,
+                 Row2T                                             const &vec2,
+                 SemiringT                                                op)
+        {
+            return (vec1.isBitmap() ? dot(ans, vec1.bitmap(), vec2, op)
+                                    : dot(ans, vec1.list(), vec2, op));
+        }
+
+        /// Dense contents are looked up like a bitmap, without checking the
+        /// structure when they are full.
+        template <typename Row1T, typename D2, typename D3, typename SemiringT>
+        bool dot(D3                                                      &ans,
+                 Row1T                                             const &vec1,
+                 DenseView<D2>                                     const &vec2,
+                 SemiringT                                                op)
+        {
+            return dot_lookup_rhs(ans, vec1, vec2, op, vec2.full());
+        }
+
+        template <typename D1, typename Row2T, typename D3, typename SemiringT>
+        bool dot(D3                                                      &ans,
+                 DenseView<D1>                                     const &vec1,
+                 Row2T                                             const &vec2,
+                 SemiringT                                                op)
+        {
+            return dot_lookup_lhs(ans, vec1, vec2, op, vec1.full());
+        }
+
+        /// Two full operands are multiplied position by position.
+        template <typename D1, typename D2, typename D3, typename SemiringT>
+        bool dot(D3                                                      &ans,
+                 DenseView<D1>                                     const &vec1,
+                 DenseView<D2>                                     const &vec2,
+                 SemiringT                                                op)
+        {
+            if (!vec1.full() || !vec2.full())
+            {
+                return dot_lookup_rhs(ans, vec1, vec2, op, vec2.full());
+            }
+
+            ans = op.zero();
+            auto vals1(vec1.values());
+            auto vals2(vec2.values());
+            IndexType length(vec1.length());
+            for (IndexType idx = 0; idx < length; ++idx)
+            {
+                ans = op.add(ans, op.mult(vals1[idx], vals2[idx]));
+            }
+            return (length > 0);
+        }
+
+        template <typename D1, typename D2, typename D3, typename SemiringT>
+        bool dot(D3                                                      &ans,
+                 DenseView<D1>                                     const &vec1,
+                 HybridView<D2>                                    const &vec2,
+                 SemiringT                                                op)
+        {
+            return (vec2.isBitmap()
+                    ? dot_lookup_rhs(ans, vec1, vec2.bitmap(), op, false)
+                    : dot_lookup_lhs(ans, vec1, vec2.list(), op, vec1.full()));
+        }
+
+        template <typename D1, typename D2, typename D3, typename SemiringT>
+        bool dot(D3                                                      &ans,
+                 HybridView<D1>                                    const &vec1,
+                 DenseView<D2>                                     const &vec2,
+                 SemiringT                                                op)
+        {
+            return (vec1.isBitmap()
+                    ? dot_lookup_lhs(ans, vec1.bitmap(), vec2, op, false)
+                    : dot_lookup_rhs(ans, vec1.list(), vec2, op, vec2.full()));
+        }
+
+        //************************************************************************
+        /// Fill T (empty) with the transpose of A by a counting sort: count
+        /// the entries in each column of A, size the rows of T to match,
+        /// then scatter the rows of A in increasing order so that every row
+        /// of T is only appended to and ends up sorted.
+        template<typename TScalarT,
+                 typename AMatrixT>
+        inline void transpose_into(LilSparseMatrix<TScalarT> &T,
+                                   AMatrixT            const &A)
+        {
+            typedef std::vector<std::tuple<IndexType, TScalarT> > TRowType;
+
+            RowSet row_set(stored_rows(A));
+
+            std::vector<IndexType> counts(A.ncols(), 0);
+            for (IndexType ix = 0; ix < row_set.size(); ++ix)
+            {
+                for (auto&& elt : A.getRow(row_set[ix]))
+                {
+                    ++counts[std::get<0>(elt)];
+                }
+            }
+
+            std::vector<TRowType> rows(A.ncols());
+            for (IndexType col_idx = 0; col_idx < A.ncols(); ++col_idx)
+            {
+                rows[col_idx].reserve(counts[col_idx]);
+            }
+
+            for (IndexType ix = 0; ix < row_set.size(); ++ix)
+            {
+                IndexType row_idx(row_set[ix]);
+                for (auto&& elt : A.getRow(row_idx))
+                {
+                    rows[std::get<0>(elt)].push_back(
+                        std::make_tuple(row_idx,
+                                        static_cast<TScalarT>(
+                                            std::get<1>(elt))));
+                }
+            }
+
+            for (IndexType col_idx = 0; col_idx < A.ncols(); ++col_idx)
+            {
+                if (!rows[col_idx].empty())
+                {
+                    T.setRow(col_idx, std::move(rows[col_idx]));
+                }
+            }
+        }
+
+        /// The transpose of a TransposeView is the underlying matrix, whose
+        /// rows are copied directly.
+        template<typename TScalarT,
+                 typename MatrixT>
+        inline void transpose_into(LilSparseMatrix<TScalarT>      &T,
+                                   TransposeView<MatrixT>   const &A)
+        {
+            MatrixT const &B(A.getMatrix());
+            RowSet row_set(stored_rows(B));
+            for (IndexType ix = 0; ix < row_set.size(); ++ix)
+            {
+                auto&& b_row(B.getRow(row_set[ix]));
+                if (b_row.size() > 0)
+                {
+                    T.setRow(row_set[ix], b_row);
+                }
+            }
+        }
+
+        /// Hypersparse: build from the swapped tuples of A, so only the
+        /// stored rows of A are visited.
+        template<typename TScalarT,
+                 typename AMatrixT>
+        inline void transpose_into(HypersparseMatrix<TScalarT> &T,
+                                   AMatrixT              const &A)
+        {
+            IndexType nvals(A.nvals());
+            IndexArrayType        i(nvals), j(nvals);
+            std::vector<TScalarT> v(nvals);
+            A.extractTuples(j.begin(), i.begin(), v.begin());
+            T.build(i.begin(), j.begin(), v.begin(), nvals,
+                    Second<TScalarT>());
+        }
+
         //************************************************************************
-        /// A reduction of a sparse vector (vector<tuple(index,value)>) using a
-        /// binary op or a monoid.
-        template <typename D1, typename D3, typename BinaryOpT>
+        /// Row access on a TransposeView searches every row of the underlying
+        /// matrix, so kernels that need many rows use a row major copy.
+        template<typename MatrixT>
+        inline MatrixT const &row_major(MatrixT const &A)
+        {
+            return A;
+        }
+
+        template<typename MatrixT>
+        inline LilSparseMatrix<typename MatrixT::ScalarType>
+        row_major_copy(TransposeView<MatrixT> const &A, std::false_type)
+        {
+            typedef typename MatrixT::ScalarType ScalarType;
+
+            LilSparseMatrix<ScalarType> result(A.nrows(), A.ncols());
+            transpose_into(result, A.getMatrix());
+            return result;
+        }
+
+        /// The transpose of hypersparse storage is built from its tuples so
+        /// that nothing is allocated per row or column.
+        template<typename MatrixT>
+        inline HypersparseMatrix<typename MatrixT::ScalarType>
+        row_major_copy(TransposeView<MatrixT> const &A, std::true_type)
+        {
+            typedef typename MatrixT::ScalarType ScalarType;
+
+            IndexType nvals(A.nvals());
+            IndexArrayType          i(nvals), j(nvals);
+            std::vector<ScalarType> v(nvals);
+            A.extractTuples(i.begin(), j.begin(), v.begin());
+
+            HypersparseMatrix<ScalarType> result(A.nrows(), A.ncols());
+            result.build(i.begin(), j.begin(), v.begin(), nvals,
+                         Second<ScalarType>());
+            return result;
+        }
+
+        template<typename MatrixT>
+        inline typename scratch_matrix<MatrixT,
+                                       typename MatrixT::ScalarType>::type
+        row_major(TransposeView<MatrixT> const &A)
+        {
+            return row_major_copy(A, typename is_hypersparse<MatrixT>::type());
+        }
+
+        //************************************************************************
+        /// Estimated work of one getRow() or getCol() call beyond the length
+        /// of the result: matrices are stored by row, so column access
+        /// searches every row, and a TransposeView swaps the two.
+        template<typename MatrixT>
+        inline double row_access_cost(MatrixT const &)
+        {
+            return 0.;
+        }
+
+        template<typename MatrixT>
+        inline double row_access_cost(TransposeView<MatrixT> const &A)
+        {
+            return (double)A.ncols();
+        }
+
+        template<typename MatrixT>
+        inline double col_access_cost(MatrixT const &A, std::false_type)
+        {
+            return (double)A.nrows();
+        }
+
+        /// The columns of a CsrCscSparseMatrix come from its CSC copy,
+        /// which is built once (in one pass) and then shared by every
+        /// column access until the matrix changes.
+        template<typename MatrixT>
+        inline double col_access_cost(MatrixT const &, std::true_type)
+        {
+            return 0.;
+        }
+
+        template<typename MatrixT>
+        inline double col_access_cost(MatrixT const &A)
+        {
+            return col_access_cost(A, typename has_csc_copy<MatrixT>::type());
+        }
+
+        template<typename MatrixT>
+        inline double col_access_cost(TransposeView<MatrixT> const &)
+        {
+            return 0.;
+        }
+
+        //************************************************************************
+        /// Estimated work of one dot() with the contents of a vector beyond
+        /// the length of the other operand: the contents are merged unless
+        /// they can be looked up directly.
+        template<typename ContentsT>
+        inline double lookup_cost(ContentsT const &contents)
+        {
+            return (double)contents.size();
+        }
+
+        template<typename ScalarT>
+        inline double lookup_cost(BitmapView<ScalarT> const &contents)
+        {
+            return 0.;
+        }
+
+        template<typename ScalarT>
+        inline double lookup_cost(HybridView<ScalarT> const &contents)
+        {
+            return (contents.isBitmap() ? 0. : (double)contents.size());
+        }
+
+        template<typename ScalarT>
+        inline double lookup_cost(DenseView<ScalarT> const &)
+        {
+            return 0.;
+        }
+
+        //************************************************************************
+        /// Flag the positions of a vector that pass the mask (all of them
+        /// for NoMask).
+        template<typename MaskT>
+        inline void mask_flags_1D(ScratchFlags &flags, MaskT const &mask)
+        {
+            auto mask_contents(mask.getContents());
+            for (auto&& elt : mask_contents)
+            {
+                if (static_cast<bool>(std::get<1>(elt)))
+                {
+                    flags.set(std::get<0>(elt));
+                }
+            }
+        }
+
+        inline void mask_flags_1D(ScratchFlags &flags, NoMask const &)
+        {
+            flags.set_all();
+        }
+
+        /// The columns of the stored true values in a row of the mask, in
+        /// increasing order.
+        template<typename MMatrixT>
+        inline void mask_row_cols(std::vector<IndexType> &cols,
+                                  MMatrixT       const   &M,
+                                  IndexType               row_idx)
+        {
+            cols.clear();
+            typename MMatrixT::RowType M_row(M.getRow(row_idx));
+            for (auto&& M_elt : M_row)
+            {
+                if (static_cast<bool>(std::get<1>(M_elt)))
+                {
+                    cols.push_back(std::get<0>(M_elt));
+                }
+            }
+        }
+
+        inline void mask_row_cols(std::vector<IndexType> &cols,
+                                  NoMask         const   &,
+                                  IndexType               )
+        {
+            cols.clear();
+        }
+
+        /// Estimated number of positions of a vector that pass the mask.
+        template<typename MaskT>
+        inline IndexType mask_nvals_1D(MaskT const &mask, IndexType)
+        {
+            return mask.nvals();
+        }
+
+        inline IndexType mask_nvals_1D(NoMask const &, IndexType size)
+        {
+            return size;
+        }
+
+        //************************************************************************
+        /// Compute one row of T = A +.* B with Gustavson's algorithm, but
+        /// with the products sorted and combined instead of scattered into a
+        /// dense accumulator, so that nothing is allocated per column.  Only
+        /// the positions in the row of M (or, if complement is set, the
+        /// positions not in it) are kept.
+        ///
+        /// products and mask_cols are workspace; T_row starts empty.
+        template<typename TRowT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_sorted_row(TRowT                  &T_row,
+                                   TRowT                  &products,
+                                   std::vector<IndexType> &mask_cols,
+                                   MMatrixT       const   &M,
+                                   bool                    complement,
+                                   SemiringT               op,
+                                   AMatrixT       const   &A,
+                                   BMatrixT       const   &B,
+                                   IndexType               row_idx)
+        {
+            typedef typename TRowT::value_type ProductType;
+
+            mask_row_cols(mask_cols, M, row_idx);
+            if (!complement && mask_cols.empty())
+            {
+                return;
+            }
+
+            products.clear();
+            typename AMatrixT::RowType A_row(A.getRow(row_idx));
+            for (auto&& A_elt : A_row)
+            {
+                typename BMatrixT::RowType B_row(B.getRow(std::get<0>(A_elt)));
+                for (auto&& B_elt : B_row)
+                {
+                    products.push_back(
+                        ProductType(std::get<0>(B_elt),
+                                    op.mult(std::get<1>(A_elt),
+                                            std::get<1>(B_elt))));
+                }
+            }
+
+            std::stable_sort(products.begin(), products.end(),
+                             [](ProductType const &a, ProductType const &b)
+                             { return std::get<0>(a) < std::get<0>(b); });
+
+            auto mask_it(mask_cols.begin());
+            auto it(products.begin());
+            while (it != products.end())
+            {
+                IndexType col_idx(std::get<0>(*it));
+                auto      sum(std::get<1>(*it));
+                for (++it;
+                     (it != products.end()) && (std::get<0>(*it) == col_idx);
+                     ++it)
+                {
+                    sum = op.add(sum, std::get<1>(*it));
+                }
+
+                while ((mask_it != mask_cols.end()) && (*mask_it < col_idx))
+                {
+                    ++mask_it;
+                }
+                bool in_mask((mask_it != mask_cols.end()) &&
+                             (*mask_it == col_idx));
+                if (in_mask != complement)
+                {
+                    T_row.push_back(ProductType(col_idx, sum));
+                }
+            }
+        }
+
+        //************************************************************************
+        /// Compute one row of T<M> = A +.* B with one dot product per stored
+        /// true value in the row of M.  B is accessed by column (usually a
+        /// TransposeView, whose columns are rows of the underlying matrix).
+        /// T_row starts empty.
+        template<typename TRowT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_masked_dot_row(TRowT                  &T_row,
+                                       MMatrixT       const   &M,
+                                       SemiringT               op,
+                                       AMatrixT       const   &A,
+                                       BMatrixT       const   &B,
+                                       IndexType               row_idx)
+        {
+            typedef typename TRowT::value_type ProductType;
+            typedef typename std::tuple_element<1, ProductType>::type
+                D3ScalarType;
+
+            typename MMatrixT::RowType M_row(M.getRow(row_idx));
+            if (M_row.empty())
+            {
+                return;
+            }
+
+            typename AMatrixT::RowType A_row(A.getRow(row_idx));
+            if (A_row.empty())
+            {
+                return;
+            }
+
+            for (auto&& M_elt : M_row)
+            {
+                if (!static_cast<bool>(std::get<1>(M_elt)))
+                {
+                    continue;
+                }
+
+                IndexType col_idx(std::get<0>(M_elt));
+                typename BMatrixT::ColType B_col(B.getCol(col_idx));
+
+                D3ScalarType T_val;
+                if (dot(T_val, A_row, B_col, op))
+                {
+                    T_row.push_back(ProductType(col_idx, T_val));
+                }
+            }
+        }
+
+        //************************************************************************
+        /// Stands in for the result matrix of the mxm kernels when only the
+        /// reduction of the result is wanted: the rows (or columns) handed to
+        /// setRow() (or setCol()) are folded into a single monoid value as
+        /// they are produced instead of being stored.  apply_op is applied
+        /// to each value first.
+        template<typename MonoidT, typename UnaryOpT>
+        class MonoidReduceSink
+        {
+        public:
+            typedef typename MonoidT::result_type ScalarType;
+
+            MonoidReduceSink(MonoidT monoid, UnaryOpT apply_op)
+                : m_monoid(monoid),
+                  m_apply_op(apply_op),
+                  m_value(monoid.identity())
+            {
+            }
+
+            template<typename RowT>
+            void setRow(IndexType, RowT const &row)
+            {
+                for (auto&& elt : row)
+                {
+                    m_value = m_monoid(m_value,
+                                       static_cast<ScalarType>(
+                                           m_apply_op(std::get<1>(elt))));
+                }
+            }
+
+            template<typename ColT>
+            void setCol(IndexType col_idx, ColT const &col)
+            {
+                setRow(col_idx, col);
+            }
+
+            /// Fold in the value of another sink (e.g., one per thread).
+            void merge(MonoidReduceSink const &other)
+            {
+                m_value = m_monoid(m_value, other.m_value);
+            }
+
+            ScalarType value() const { return m_value; }
+
+        private:
+            MonoidT     m_monoid;
+            UnaryOpT    m_apply_op;
+            ScalarType  m_value;
+        };
+
+        //************************************************************************
+        /// A reduction of a sparse vector (vector<tuple(index,value)> or view)
+        /// using a binary op or a monoid.
+        template <typename RowT, typename D3, typename BinaryOpT>
         bool reduction(
             D3                                                      &ans,
-            std::vector<std::tuple<GraphBLAS::IndexType,D1> > const &vec,
+            RowT                                              const &vec,
             BinaryOpT                                                op)
         {
             if (vec.empty())
@@ -351,19 +1181,22 @@ namespace GraphBLAS
             typedef typename BinaryOpT::result_type D3ScalarType;
             D3ScalarType tmp;
 
-            if (vec.size() == 1)
+            auto it(vec.begin());
+            auto first_val(std::get<1>(*it));
+            ++it;
+            if (it == vec.end())
             {
-                tmp = static_cast<D3ScalarType>(std::get<1>(vec[0]));
+                tmp = static_cast<D3ScalarType>(first_val);
             }
             else
             {
                 /// @note Since op is associative and commutative left to right
                 /// ordering is not strictly required.
-                tmp = op(std::get<1>(vec[0]), std::get<1>(vec[1]));
+                tmp = op(first_val, std::get<1>(*it));
 
-                for (size_t idx = 2; idx < vec.size(); ++idx)
+                for (++it; it != vec.end(); ++it)
                 {
-                    tmp = op(tmp, std::get<1>(vec[idx]));
+                    tmp = op(tmp, std::get<1>(*it));
                 }
             }
 
@@ -373,12 +1206,15 @@ namespace GraphBLAS
 
         //**********************************************************************
         /// Apply element-wise operation to union on sparse vectors.
-        template <typename D1, typename D2, typename D3, typename BinaryOpT>
+        template <typename D3, typename Row1T, typename Row2T, typename BinaryOpT>
         void ewise_or(std::vector<std::tuple<GraphBLAS::IndexType,D3> >       &ans,
-                      std::vector<std::tuple<GraphBLAS::IndexType,D1> > const &vec1,
-                      std::vector<std::tuple<GraphBLAS::IndexType,D2> > const &vec2,
+                      Row1T                                             const &vec1,
+                      Row2T                                             const &vec2,
                       BinaryOpT                                                op)
         {
+            typedef typename row_scalar_type<Row1T>::type D1;
+            typedef typename row_scalar_type<Row2T>::type D2;
+
             ans.clear();
             auto v1_it = vec1.begin();
             auto v2_it = vec2.begin();
@@ -435,6 +1271,56 @@ namespace GraphBLAS
             }
         }
 
+        /// Union of two dense operands: walk the positions (without any
+        /// structural checks when both are full).
+        template <typename D3, typename D1, typename D2, typename BinaryOpT>
+        void ewise_or(std::vector<std::tuple<GraphBLAS::IndexType,D3> >       &ans,
+                      DenseView<D1>                                     const &vec1,
+                      DenseView<D2>                                     const &vec2,
+                      BinaryOpT                                                op)
+        {
+            ans.clear();
+            IndexType length(vec1.length());
+            auto vals1(vec1.values());
+            auto vals2(vec2.values());
+
+            if (vec1.full() && vec2.full())
+            {
+                ans.reserve(length);
+                for (IndexType idx = 0; idx < length; ++idx)
+                {
+                    ans.push_back(std::make_tuple(
+                                      idx,
+                                      static_cast<D3>(op(vals1[idx],
+                                                         vals2[idx]))));
+                }
+                return;
+            }
+
+            for (IndexType idx = 0; idx < length; ++idx)
+            {
+                bool has1(vec1.hasElement(idx));
+                bool has2(vec2.hasElement(idx));
+                if (has1 && has2)
+                {
+                    ans.push_back(std::make_tuple(
+                                      idx,
+                                      static_cast<D3>(op(vals1[idx],
+                                                         vals2[idx]))));
+                }
+                else if (has1)
+                {
+                    ans.push_back(std::make_tuple(
+                                      idx, static_cast<D3>(vals1[idx])));
+                }
+                else if (has2)
+                {
+                    ans.push_back(std::make_tuple(
+                                      idx, static_cast<D3>(vals2[idx])));
+                }
+            }
+        }
+
         //********************************************************************
         // ALL SUPPORT
         // This is where we turns alls into the correct range
@@ -473,9 +1359,9 @@ namespace GraphBLAS
         ///    x        -     x      -    (take vec1_i which is no stored value)
         ///    x        x --> x    vec1_i
         ///
-        /// \tparam D1
-        /// \tparam D2
         /// \tparam D3
+        /// \tparam Row1T
+        /// \tparam Row2T
         /// \tparam SequenceT  Could be a out of order subset of indices
         ///
         /// \param ans   A row of the answer (Z or z), starts empty
@@ -483,13 +1369,16 @@ namespace GraphBLAS
         /// \param vec2  A row of the T (or t) container, indices in increasing order
         /// \param stencil_indices  Assumed to not be in order
         ///
-        template <typename D1, typename D2, typename D3, typename SequenceT>
+        template <typename D3, typename Row1T, typename Row2T, typename SequenceT>
         void ewise_or_stencil(
             std::vector<std::tuple<GraphBLAS::IndexType,D3> >       &ans,
-            std::vector<std::tuple<GraphBLAS::IndexType,D1> > const &vec1,
-            std::vector<std::tuple<GraphBLAS::IndexType,D2> > const &vec2,
+            Row1T                                             const &vec1,
+            Row2T                                             const &vec2,
             SequenceT                                                stencil_indices)
         {
+            typedef typename row_scalar_type<Row1T>::type D1;
+            typedef typename row_scalar_type<Row2T>::type D2;
+
             ans.clear();
 
             //auto stencil_it = stencil_indices.begin();
@@ -665,7 +1554,9 @@ namespace GraphBLAS
                 {
                     // Row not stenciled.  Take row from C only
                     // There should be nothing in T for this row
-                    Z.setRow(row_idx, C.getRow(row_idx));
+                    typename CMatrixT::RowType C_row(C.getRow(row_idx));
+                    tmp_row.assign(C_row.begin(), C_row.end());
+                    Z.setRow(row_idx, tmp_row);
                 }
             }
         }
@@ -685,9 +1576,10 @@ namespace GraphBLAS
             typedef std::vector<std::tuple<IndexType,ZScalarType> > ZRowType;
 
             ZRowType tmp_row;
-            IndexType nRows(Z.nrows());
-            for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
+            RowSet rows(stored_rows(C, T));
+            for (IndexType ix = 0; ix < rows.size(); ++ix)
             {
+                IndexType row_idx(rows[ix]);
                 ewise_or(tmp_row, C.getRow(row_idx), T.getRow(row_idx), accum);
                 Z.setRow(row_idx, tmp_row);
             }
@@ -769,13 +1661,18 @@ namespace GraphBLAS
         }
 
         //************************************************************************
-        /// Apply element-wise operation to intersection of sparse vectors.
-        template <typename D1, typename D2, typename D3, typename BinaryOpT>
+        /// Apply element-wise operation to intersection of sparse vectors
+        /// that can only be iterated: merge them.
+        template <typename D3, typename Row1T, typename Row2T, typename BinaryOpT>
         void ewise_and(std::vector<std::tuple<GraphBLAS::IndexType,D3> >       &ans,
-                       std::vector<std::tuple<GraphBLAS::IndexType,D1> > const &vec1,
-                       std::vector<std::tuple<GraphBLAS::IndexType,D2> > const &vec2,
-                       BinaryOpT                                                op)
+                       Row1T                                             const &vec1,
+                       Row2T                                             const &vec2,
+                       BinaryOpT                                                op,
+                       std::false_type)
         {
+            typedef typename row_scalar_type<Row1T>::type D1;
+            typedef typename row_scalar_type<Row2T>::type D2;
+
             ans.clear();
             auto v1_it = vec1.begin();
             auto v2_it = vec2.begin();
@@ -813,6 +1710,71 @@ namespace GraphBLAS
             }
         }
 
+        /// Apply element-wise operation to intersection of random access
+        /// rows (see sparse_intersect.hpp).
+        template <typename D3, typename Row1T, typename Row2T, typename BinaryOpT>
+        void ewise_and(std::vector<std::tuple<GraphBLAS::IndexType,D3> >       &ans,
+                       Row1T                                             const &vec1,
+                       Row2T                                             const &vec2,
+                       BinaryOpT                                                op,
+                       std::true_type)
+        {
+            ans.clear();
+            sparse_intersect(vec1, vec2,
+                             [&](IndexType pos1, IndexType pos2)
+                             {
+                                 ans.push_back(std::make_tuple(
+                                     row_index_at(vec1, pos1),
+                                     static_cast<D3>(op(std::get<1>(vec1[pos1]),
+                                                        std::get<1>(vec2[pos2])))));
+                             });
+        }
+
+        /// Apply element-wise operation to intersection of sparse vectors.
+        template <typename D3, typename Row1T, typename Row2T, typename BinaryOpT>
+        void ewise_and(std::vector<std::tuple<GraphBLAS::IndexType,D3> >       &ans,
+                       Row1T                                             const &vec1,
+                       Row2T                                             const &vec2,
+                       BinaryOpT                                                op)
+        {
+            ewise_and(ans, vec1, vec2, op,
+                      std::integral_constant<
+                          bool,
+                          (is_random_access_row<Row1T>::value &&
+                           is_random_access_row<Row2T>::value)>());
+        }
+
+        /// Intersection of two dense operands: walk the positions (without
+        /// any structural checks when both are full).
+        template <typename D3, typename D1, typename D2, typename BinaryOpT>
+        void ewise_and(std::vector<std::tuple<GraphBLAS::IndexType,D3> >       &ans,
+                       DenseView<D1>                                     const &vec1,
+                       DenseView<D2>                                     const &vec2,
+                       BinaryOpT                                                op)
+        {
+            ans.clear();
+            IndexType length(vec1.length());
+            auto vals1(vec1.values());
+            auto vals2(vec2.values());
+            bool all_stored(vec1.full() && vec2.full());
+
+            if (all_stored)
+            {
+                ans.reserve(length);
+            }
+            for (IndexType idx = 0; idx < length; ++idx)
+            {
+                if (all_stored ||
+                    (vec1.hasElement(idx) && vec2.hasElement(idx)))
+                {
+                    ans.push_back(std::make_tuple(
+                                      idx,
+                                      static_cast<D3>(op(vals1[idx],
+                                                         vals2[idx]))));
+                }
+            }
+        }
+
         //**********************************************************************
         //**********************************************************************
         /**
@@ -828,9 +1790,10 @@ namespace GraphBLAS
          * L(C) = {(i,j,Zij):(i,j) \in (ind(C) \cap int(\not M))} \cup
          *        {(i,j,Zij):(i,j) \in (ind(Z) \cap int(\not M))}
          *
-         * @tparam CScalarT The scalar type of the C vector input AND result.
-         * @tparam ZScalarT The scalar type of the Z vector input.
-         * @tparam MScalarT The scalar type of the mask vector.
+         * @tparam CScalarT The scalar type of the result.
+         * @tparam CRowT    The C vector input (a vector of tuples or a view).
+         * @tparam ZRowT    The Z vector input.
+         * @tparam MRowT    The mask vector.
          *
          * @param result Result vector.  We clear this first.
          * @param c_vec The original c values that may be carried through.
@@ -840,19 +1803,24 @@ namespace GraphBLAS
          *                by the mask regardless if they are overlayed.
          */
         template < typename CScalarT,
-                   typename ZScalarT,
-                   typename MScalarT>
+                   typename CRowT,
+                   typename ZRowT,
+                   typename MRowT>
         void apply_with_mask(std::vector<std::tuple<IndexType, CScalarT> >          &result,
-                             std::vector<std::tuple<IndexType, CScalarT> > const    &c_vec,
-                             std::vector<std::tuple<IndexType, ZScalarT> > const    &z_vec,
-                             std::vector<std::tuple<IndexType, MScalarT> > const    &mask_vec,
+                             CRowT                                         const    &c_vec,
+                             ZRowT                                         const    &z_vec,
+                             MRowT                                         const    &mask_vec,
                              bool                                                    replace)
         {
+            typedef typename row_scalar_type<CRowT>::type CRowScalarT;
+            typedef typename row_scalar_type<ZRowT>::type ZScalarT;
+            typedef typename row_scalar_type<MRowT>::type MScalarT;
+
             auto c_it = c_vec.begin();
             auto z_it = z_vec.begin();
             auto mask_it = mask_vec.begin();
 
-            CScalarT c_val;
+            CRowScalarT c_val;
             ZScalarT z_val;
             MScalarT mask_val;
             GraphBLAS::IndexType c_idx, z_idx, mask_idx;
@@ -928,7 +1896,9 @@ namespace GraphBLAS
                     //std::tie(c_idx, c_val) = *c_it;
                     //std::cerr << "Catch up= " << c_idx << ":" << c_val << std::endl;
                     //result.push_back(std::make_tuple(c_idx, static_cast<CScalarT>(c_val)));
-                    result.push_back(*c_it);
+                    result.push_back(std::make_tuple(
+                                         std::get<0>(*c_it),
+                                         static_cast<CScalarT>(std::get<1>(*c_it))));
                     ++c_it;
                 }
             }
@@ -937,6 +1907,21 @@ namespace GraphBLAS
 
         } // apply_with_mask
 
+        //**********************************************************************
+        /// True if the storage of C replaces one row without moving the
+        /// others (a list per row, or a slot per element), so that rows can
+        /// be rewritten in any order.
+        template<typename CMatrixT>
+        struct updates_rows_in_place
+            : public std::integral_constant<
+                bool,
+                std::is_base_of<LilSparseMatrix<typename CMatrixT::ScalarType>,
+                                CMatrixT>::value ||
+                std::is_base_of<DenseMatrix<typename CMatrixT::ScalarType>,
+                                CMatrixT>::value>
+        {
+        };
+
         //**********************************************************************
         // Matrix version
 
@@ -949,17 +1934,33 @@ namespace GraphBLAS
                                  bool               replace)
         {
             typedef typename CMatrixT::ScalarType CScalarType;
-            typedef typename ZMatrixT::ScalarType ZScalarType;
-            typedef typename MMatrixT::ScalarType MScalarType;
 
             typedef std::vector<std::tuple<IndexType, CScalarType> > CRowType;
-            typedef std::vector<std::tuple<IndexType, ZScalarType> > ZRowType;
-            typedef std::vector<std::tuple<IndexType, MScalarType> > MRowType;
+
+            // Rows without values in C or Z stay empty whatever the mask
+            RowSet rows(stored_rows(C, Z));
+
+            if (!updates_rows_in_place<CMatrixT>::value)
+            {
+                // Setting a row of compressed storage moves every row after
+                // it, so the new rows are formed first and C is rebuilt in
+                // row order.
+                std::vector<CRowType> new_rows(rows.size());
+                for (IndexType ix = 0; ix < rows.size(); ++ix)
+                {
+                    IndexType row_idx(rows[ix]);
+                    apply_with_mask(new_rows[ix], C.getRow(row_idx),
+                                    Z.getRow(row_idx), mask.getRow(row_idx),
+                                    replace);
+                }
+                set_rows(C, new_rows, rows);
+                return;
+            }
 
             CRowType tmp_row;
-            IndexType nRows(C.nrows());
-            for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
+            for (IndexType ix = 0; ix < rows.size(); ++ix)
             {
+                IndexType row_idx(rows[ix]);
                 apply_with_mask(tmp_row, C.getRow(row_idx), Z.getRow(row_idx),
                                 mask.getRow(row_idx), replace);
 
@@ -981,6 +1982,162 @@ namespace GraphBLAS
             sparse_copy(C, Z);
         }
 
+        //**********************************************************************
+        /// True if writing to C may change operand A (A is C or a view of
+        /// C).
+        template<typename CMatrixT, typename AMatrixT>
+        inline bool is_aliased(CMatrixT const &C, AMatrixT const &A)
+        {
+            return (static_cast<void const *>(&C) ==
+                    static_cast<void const *>(&A));
+        }
+
+        template<typename CMatrixT, typename AMatrixT>
+        inline bool is_aliased(CMatrixT const &C,
+                               TransposeView<AMatrixT> const &A)
+        {
+            return is_aliased(C, A.getMatrix());
+        }
+
+        //**********************************************************************
+        /// One row of Z = accum(C, T) (see ewise_or_opt_accum).
+        template <typename ZScalarT,
+                  typename CRowT,
+                  typename TRowT,
+                  typename BinaryOpT>
+        void ewise_or_opt_accum_row(
+            std::vector<std::tuple<IndexType, ZScalarT> > &z_row,
+            CRowT                                   const &c_row,
+            TRowT                                   const &t_row,
+            BinaryOpT                                      accum)
+        {
+            ewise_or(z_row, c_row, t_row, accum);
+        }
+
+        template <typename ZScalarT,
+                  typename CRowT,
+                  typename TRowT>
+        void ewise_or_opt_accum_row(
+            std::vector<std::tuple<IndexType, ZScalarT> > &z_row,
+            CRowT                                   const &,
+            TRowT                                   const &t_row,
+            GraphBLAS::NoAccumulate)
+        {
+            z_row.clear();
+            for (auto&& tupl : t_row)
+            {
+                z_row.push_back(std::make_tuple(
+                                    std::get<0>(tupl),
+                                    static_cast<ZScalarT>(std::get<1>(tupl))));
+            }
+        }
+
+        //**********************************************************************
+        /**
+         * C<M> = accum(C, T) written directly into C, without building the
+         * Z matrix of ewise_or_opt_accum() followed by write_with_opt_mask():
+         * each row of Z is formed in a row buffer (with values of type
+         * ZScalarT) and written through the mask right away.  T is
+         * complete before C is touched, so C may be an operand of the
+         * operation that computed T.
+         */
+        template < typename ZScalarT,
+                   typename CMatrixT,
+                   typename TMatrixT,
+                   typename MMatrixT,
+                   typename BinaryOpT >
+        void write_with_opt_accum_mask(CMatrixT           &C,
+                                       TMatrixT   const   &T,
+                                       MMatrixT   const   &mask,
+                                       BinaryOpT           accum,
+                                       bool                replace)
+        {
+            typedef typename CMatrixT::ScalarType CScalarType;
+            typedef std::vector<std::tuple<IndexType, CScalarType> > CRowType;
+
+            std::vector<std::tuple<IndexType, ZScalarT> > z_row;
+
+            // Rows without values in C or T stay empty whatever the mask
+            RowSet rows(stored_rows(C, T));
+
+            if (!updates_rows_in_place<CMatrixT>::value)
+            {
+                // As in write_with_opt_mask(): form the new rows, then
+                // rebuild C in row order.
+                std::vector<CRowType> new_rows(rows.size());
+                for (IndexType ix = 0; ix < rows.size(); ++ix)
+                {
+                    IndexType row_idx(rows[ix]);
+                    typename CMatrixT::RowType C_row(C.getRow(row_idx));
+                    ewise_or_opt_accum_row(z_row, C_row, T.getRow(row_idx),
+                                           accum);
+                    apply_with_mask(new_rows[ix], C_row, z_row,
+                                    mask.getRow(row_idx), replace);
+                }
+                set_rows(C, new_rows, rows);
+                return;
+            }
+
+            CRowType c_row;
+            for (IndexType ix = 0; ix < rows.size(); ++ix)
+            {
+                IndexType row_idx(rows[ix]);
+                typename CMatrixT::RowType C_row(C.getRow(row_idx));
+                ewise_or_opt_accum_row(z_row, C_row, T.getRow(row_idx), accum);
+                apply_with_mask(c_row, C_row, z_row, mask.getRow(row_idx),
+                                replace);
+                C.setRow(row_idx, c_row);
+            }
+        }
+
+        /// Without a mask only the rows of T change C, and they are
+        /// accumulated in place when the storage of C allows it.
+        template < typename ZScalarT,
+                   typename CMatrixT,
+                   typename TMatrixT,
+                   typename BinaryOpT >
+        void write_with_opt_accum_mask(CMatrixT                   &C,
+                                       TMatrixT           const   &T,
+                                       backend::NoMask    const   &mask,
+                                       BinaryOpT                   accum,
+                                       bool                        replace)
+        {
+            if (!updates_rows_in_place<CMatrixT>::value)
+            {
+                typename scratch_matrix<CMatrixT, ZScalarT>::type
+                    Z(C.nrows(), C.ncols());
+                ewise_or_opt_accum(Z, C, T, accum);
+                write_with_opt_mask(C, Z, mask, replace);
+                return;
+            }
+
+            std::vector<std::tuple<IndexType, ZScalarT> > z_row;
+            RowSet rows(stored_rows(T));
+            for (IndexType ix = 0; ix < rows.size(); ++ix)
+            {
+                IndexType row_idx(rows[ix]);
+                typename TMatrixT::RowType T_row(T.getRow(row_idx));
+                if (!T_row.empty())
+                {
+                    ewise_or(z_row, C.getRow(row_idx), T_row, accum);
+                    C.setRow(row_idx, z_row);
+                }
+            }
+        }
+
+        /// Without a mask or an accumulator C is a copy of T.
+        template < typename ZScalarT,
+                   typename CMatrixT,
+                   typename TMatrixT >
+        void write_with_opt_accum_mask(CMatrixT                   &C,
+                                       TMatrixT           const   &T,
+                                       backend::NoMask    const   &,
+                                       GraphBLAS::NoAccumulate      ,
+                                       bool                        )
+        {
+            sparse_copy(C, T);
+        }
+
         //**********************************************************************
         // Vector version
 
@@ -0,0 +1,335 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Intersection of the sorted indices of two sparse rows (or vectors), the
+ * inner loop of dot() and ewise_and().
+ *
+ * - When one operand is much shorter than the other, each of its indices
+ *   is found in the longer one by galloping (exponential) search.
+ * - When both operands keep their indices in a contiguous array (see
+ *   SparseView), blocks of indices are compared with AVX-512 or AVX2 if the
+ *   compiler targets them (e.g., -march=native), four or eight at a time.
+ * - Otherwise the indices are merged one at a time.
+ *
+ * The matches are reported in increasing index order in every case, so
+ * the results (including floating point sums) do not depend on the path.
+ */
+
+#ifndef GB_SEQUENTIAL_SPARSE_INTERSECT_HPP
+#define GB_SEQUENTIAL_SPARSE_INTERSECT_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include <graphblas/types.hpp>
+#include "SparseView.hpp"
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /// Rows with constant time access to the n-th stored element.
+        template <typename RowT>
+        struct is_random_access_row : public std::false_type
+        {
+        };
+
+        template <typename TupleT, typename AllocT>
+        struct is_random_access_row<std::vector<TupleT, AllocT> >
+            : public std::true_type
+        {
+        };
+
+        template <typename ScalarT, typename ValueIteratorT>
+        struct is_random_access_row<SparseView<ScalarT, ValueIteratorT> >
+            : public std::true_type
+        {
+        };
+
+        /// Gallop when one operand is this many times longer than the other.
+        static IndexType const INTERSECT_GALLOP_RATIO = 32;
+
+        //********************************************************************
+        /// The index of the n-th stored element of a row.
+        template <typename RowT>
+        inline IndexType row_index_at(RowT const &row, IndexType n)
+        {
+            return std::get<0>(row[n]);
+        }
+
+        template <typename ScalarT, typename ValueIteratorT>
+        inline IndexType row_index_at(
+            SparseView<ScalarT, ValueIteratorT> const &row, IndexType n)
+        {
+            return row.indices()[n];
+        }
+
+        //********************************************************************
+        /// Merge row1[pos1, n1) and row2[pos2, n2) one index at a time.
+        template <typename Row1T, typename Row2T, typename MatchT>
+        inline void intersect_merge(Row1T const &row1, IndexType pos1,
+                                    Row2T const &row2, IndexType pos2,
+                                    MatchT      &match)
+        {
+            IndexType n1(row1.size()), n2(row2.size());
+            while ((pos1 < n1) && (pos2 < n2))
+            {
+                IndexType idx1(row_index_at(row1, pos1));
+                IndexType idx2(row_index_at(row2, pos2));
+                if (idx1 == idx2)
+                {
+                    match(pos1, pos2);
+                    ++pos1;
+                    ++pos2;
+                }
+                else if (idx1 < idx2)
+                {
+                    ++pos1;
+                }
+                else
+                {
+                    ++pos2;
+                }
+            }
+        }
+
+        //********************************************************************
+        /// First position at or after pos in row whose index is >= idx:
+        /// probe 1, 2, 4, ... ahead, then binary search the last step.
+        template <typename RowT>
+        inline IndexType gallop(RowT const &row, IndexType pos, IndexType idx)
+        {
+            IndexType n(row.size());
+            IndexType lo(pos), step(1);
+            IndexType hi(pos);
+            while ((hi < n) && (row_index_at(row, hi) < idx))
+            {
+                lo = hi + 1;
+                hi = pos + step;
+                step *= 2;
+            }
+            if (hi > n)
+            {
+                hi = n;
+            }
+            while (lo < hi)
+            {
+                IndexType mid(lo + (hi - lo)/2);
+                if (row_index_at(row, mid) < idx)
+                {
+                    lo = mid + 1;
+                }
+                else
+                {
+                    hi = mid;
+                }
+            }
+            return lo;
+        }
+
+        /// Find each index of the short row in the long one.  match is
+        /// called as match(short position, long position).
+        template <typename ShortRowT, typename LongRowT, typename MatchT>
+        inline void intersect_gallop(ShortRowT const &short_row,
+                                     LongRowT  const &long_row,
+                                     MatchT          &match)
+        {
+            IndexType long_pos(0);
+            IndexType long_n(long_row.size());
+            for (IndexType pos = 0;
+                 (pos < short_row.size()) && (long_pos < long_n);
+                 ++pos)
+            {
+                IndexType idx(row_index_at(short_row, pos));
+                long_pos = gallop(long_row, long_pos, idx);
+                if ((long_pos < long_n) &&
+                    (row_index_at(long_row, long_pos) == idx))
+                {
+                    match(pos, long_pos);
+                    ++long_pos;
+                }
+            }
+        }
+
+        //********************************************************************
+        // Which indices of a block of idx1 also appear in the block of idx2
+        // at the same offset, as a bit mask.  The block of idx2 is rotated
+        // through every lane.
+#if defined(__AVX512F__)
+#define GB_INTERSECT_BLOCK 8
+        inline unsigned int intersect_block(IndexType const *idx1,
+                                            IndexType const *idx2)
+        {
+            __m512i a(_mm512_loadu_si512(idx1));
+            __m512i b(_mm512_loadu_si512(idx2));
+            __mmask8 found(_mm512_cmpeq_epi64_mask(a, b));
+            for (int r = 1; r < GB_INTERSECT_BLOCK; ++r)
+            {
+                b = _mm512_alignr_epi64(b, b, 1);
+                found |= _mm512_cmpeq_epi64_mask(a, b);
+            }
+            return found;
+        }
+#elif defined(__AVX2__)
+#define GB_INTERSECT_BLOCK 4
+        inline unsigned int intersect_block(IndexType const *idx1,
+                                            IndexType const *idx2)
+        {
+            __m256i a(_mm256_loadu_si256(
+                          reinterpret_cast<__m256i const *>(idx1)));
+            __m256i b(_mm256_loadu_si256(
+                          reinterpret_cast<__m256i const *>(idx2)));
+            __m256i eq(_mm256_cmpeq_epi64(a, b));
+            for (int r = 1; r < GB_INTERSECT_BLOCK; ++r)
+            {
+                b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(0, 3, 2, 1));
+                eq = _mm256_or_si256(eq, _mm256_cmpeq_epi64(a, b));
+            }
+            return _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+        }
+#else
+#define GB_INTERSECT_BLOCK 0
+#endif
+
+        /// Compare blocks of indices from two contiguous index arrays, then
+        /// merge what is left.  After each comparison the block with the
+        /// smaller last index (or both) is replaced by the next one.
+        template <typename Row1T, typename Row2T, typename MatchT>
+        inline void intersect_blocks(Row1T const &row1,
+                                     Row2T const &row2,
+                                     MatchT      &match)
+        {
+            IndexType pos1(0), pos2(0);
+
+#if GB_INTERSECT_BLOCK > 0
+            IndexType const *idx1(row1.indices());
+            IndexType const *idx2(row2.indices());
+            IndexType n1(row1.size()), n2(row2.size());
+
+            while ((pos1 + GB_INTERSECT_BLOCK <= n1) &&
+                   (pos2 + GB_INTERSECT_BLOCK <= n2))
+            {
+                unsigned int found(intersect_block(idx1 + pos1, idx2 + pos2));
+
+                // Report the matches in order, finding each in idx2's block
+                IndexType pos(pos2);
+                for (IndexType k = 0; found != 0; ++k, found >>= 1)
+                {
+                    if (found & 1)
+                    {
+                        while (idx2[pos] != idx1[pos1 + k])
+                        {
+                            ++pos;
+                        }
+                        match(pos1 + k, pos);
+                    }
+                }
+
+                IndexType last1(idx1[pos1 + GB_INTERSECT_BLOCK - 1]);
+                IndexType last2(idx2[pos2 + GB_INTERSECT_BLOCK - 1]);
+                if (last1 <= last2)
+                {
+                    pos1 += GB_INTERSECT_BLOCK;
+                }
+                if (last2 <= last1)
+                {
+                    pos2 += GB_INTERSECT_BLOCK;
+                }
+            }
+#endif
+            intersect_merge(row1, pos1, row2, pos2, match);
+        }
+
+        //********************************************************************
+        template <typename Row1T, typename Row2T, typename MatchT>
+        inline void intersect_same_size(Row1T const &row1,
+                                        Row2T const &row2,
+                                        MatchT      &match)
+        {
+            intersect_merge(row1, 0, row2, 0, match);
+        }
+
+        template <typename S1, typename V1,
+                  typename S2, typename V2,
+                  typename MatchT>
+        inline void intersect_same_size(SparseView<S1, V1> const &row1,
+                                        SparseView<S2, V2> const &row2,
+                                        MatchT                   &match)
+        {
+            intersect_blocks(row1, row2, match);
+        }
+
+        //********************************************************************
+        /**
+         * @brief Call match(pos1, pos2) for each pair of positions at which
+         *        row1 and row2 (random access rows with sorted indices)
+         *        store the same index, in increasing index order.
+         */
+        template <typename Row1T, typename Row2T, typename MatchT>
+        inline void sparse_intersect(Row1T const &row1,
+                                     Row2T const &row2,
+                                     MatchT       match)
+        {
+            IndexType n1(row1.size()), n2(row2.size());
+            if ((n1 == 0) || (n2 == 0))
+            {
+                return;
+            }
+
+            if (n2 / INTERSECT_GALLOP_RATIO > n1)
+            {
+                intersect_gallop(row1, row2, match);
+            }
+            else if (n1 / INTERSECT_GALLOP_RATIO > n2)
+            {
+                auto swapped([&match](IndexType pos2, IndexType pos1)
+                             { match(pos1, pos2); });
+                intersect_gallop(row2, row1, swapped);
+            }
+            else
+            {
+                intersect_same_size(row1, row2, match);
+            }
+        }
+
+    } // backend
+} // GraphBLAS
+
+#endif // GB_SEQUENTIAL_SPARSE_INTERSECT_HPP
@@ -42,13 +42,18 @@
 #include <iterator>
 #include <iostream>
 #include <chrono>
+#include <algorithm>
+#include <type_traits>
 
 #include <graphblas/detail/logging.h>
+#include <graphblas/detail/trace.hpp>
 #include <graphblas/types.hpp>
 #include <graphblas/algebra.hpp>
 
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
+#include "TransposeView.hpp"
+#include "ComplementView.hpp"
 
 
 //****************************************************************************
@@ -57,6 +62,471 @@ namespace GraphBLAS
 {
     namespace backend
     {
+        //**********************************************************************
+        /// Compute T = A +.* B one dot product per (row of A, column of B).
+        template<typename TMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_dot(TMatrixT            &T,
+                            SemiringT            op,
+                            AMatrixT    const   &A,
+                            BMatrixT    const   &B)
+        {
+            GRB_TRACE_KERNEL("mxm_dot");
+
+            RowSet    A_rows(stored_rows(A));
+            IndexType ncol_B(B.ncols());
+
+            typedef typename SemiringT::result_type D3ScalarType;
+            typedef std::vector<std::tuple<IndexType,D3ScalarType> > TColType;
+
+            // create a column of result at a time
+            TColType T_col;
+            for (IndexType col_idx = 0; col_idx < ncol_B; ++col_idx)
+            {
+                typename BMatrixT::ColType B_col(B.getCol(col_idx));
+
+                if (!B_col.empty())
+                {
+                    for (IndexType ix = 0; ix < A_rows.size(); ++ix)
+                    {
+                        IndexType row_idx(A_rows[ix]);
+                        typename AMatrixT::RowType A_row(A.getRow(row_idx));
+                        if (!A_row.empty())
+                        {
+                            D3ScalarType T_val;
+                            if (dot(T_val, A_row, B_col, op))
+                            {
+                                T_col.push_back(
+                                        std::make_tuple(row_idx, T_val));
+                            }
+                        }
+                    }
+                    if (!T_col.empty())
+                    {
+                        T.setCol(col_idx, T_col);
+                        T_col.clear();
+                    }
+                }
+            }
+        }
+
+        //**********************************************************************
+        /// Flag the columns of the stored true values in a row of the mask.
+        template<typename MMatrixT>
+        inline void mark_mask_row(ScratchFlags           &marks,
+                                  MMatrixT       const   &M,
+                                  IndexType               row_idx)
+        {
+            typename MMatrixT::RowType M_row(M.getRow(row_idx));
+            for (auto&& M_elt : M_row)
+            {
+                if (static_cast<bool>(std::get<1>(M_elt)))
+                {
+                    marks.set(std::get<0>(M_elt));
+                }
+            }
+        }
+
+        inline void mark_mask_row(ScratchFlags           &,
+                                  NoMask         const   &,
+                                  IndexType)
+        {
+        }
+
+        //**********************************************************************
+        /// Gustavson's algorithm with the products of each row sorted and
+        /// combined (see mxm_sorted_row()); used when the dense accumulator
+        /// would be larger than the operands (e.g., for hypersparse
+        /// matrices).  Masking is as in mxm_gustavson().
+        template<typename TMatrixT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_gustavson_sorted(TMatrixT            &T,
+                                         MMatrixT    const   &M,
+                                         bool                 complement,
+                                         SemiringT            op,
+                                         AMatrixT    const   &A,
+                                         BMatrixT    const   &B)
+        {
+            GRB_TRACE_KERNEL("mxm_gustavson_sorted");
+
+            typedef typename SemiringT::result_type D3ScalarType;
+            typedef std::tuple<IndexType,D3ScalarType> ProductType;
+
+            std::vector<ProductType> products;
+            std::vector<IndexType>   mask_cols;
+            std::vector<ProductType> T_row;
+
+            RowSet A_rows(stored_rows(A));
+            for (IndexType ix = 0; ix < A_rows.size(); ++ix)
+            {
+                IndexType row_idx(A_rows[ix]);
+                mxm_sorted_row(T_row, products, mask_cols,
+                               M, complement, op, A, B, row_idx);
+                if (!T_row.empty())
+                {
+                    T.setRow(row_idx, T_row);
+                    T_row.clear();
+                }
+            }
+        }
+
+        //**********************************************************************
+        /// Compute T = A +.* B with Gustavson's algorithm: each row of T is
+        /// the sum of the rows of B selected by the row of A, scattered into
+        /// a sparse accumulator (dense values, flags and a list of the
+        /// columns touched).
+        ///
+        /// Only the positions in M (or, if complement is set, the positions
+        /// not in M) are computed.  With NoMask and complement set, every
+        /// position is computed.
+        template<typename TMatrixT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_gustavson(TMatrixT            &T,
+                                  MMatrixT    const   &M,
+                                  bool                 complement,
+                                  SemiringT            op,
+                                  AMatrixT    const   &A_in,
+                                  BMatrixT    const   &B_in)
+        {
+            GRB_TRACE_KERNEL("mxm_gustavson");
+
+            auto const &A(row_major(A_in));
+            auto const &B(row_major(B_in));
+            typedef typename std::decay<decltype(A)>::type ARowMajorType;
+            typedef typename std::decay<decltype(B)>::type BRowMajorType;
+
+            IndexType ncol_B(B.ncols());
+            if (ncol_B > A.nvals() + B.nvals())
+            {
+                mxm_gustavson_sorted(T, M, complement, op, A, B);
+                return;
+            }
+
+            typedef typename SemiringT::result_type D3ScalarType;
+            typedef std::vector<std::tuple<IndexType,D3ScalarType> > TRowType;
+
+            SparseAccumulator<D3ScalarType> spa(ncol_B);
+
+            ScratchFlags mask_flags(ncol_B);
+
+            TRowType T_row;
+            RowSet A_rows(stored_rows(A));
+            for (IndexType ix = 0; ix < A_rows.size(); ++ix)
+            {
+                IndexType row_idx(A_rows[ix]);
+                mark_mask_row(mask_flags, M, row_idx);
+                if (!complement && mask_flags.empty())
+                {
+                    continue;
+                }
+
+                typename ARowMajorType::RowType A_row(A.getRow(row_idx));
+
+                for (auto&& A_elt : A_row)
+                {
+                    typename BRowMajorType::RowType B_row(
+                        B.getRow(std::get<0>(A_elt)));
+
+                    // An iso row of B (see IsoSparseMatrix) has one product
+                    typedef typename row_scalar_type<
+                        typename BRowMajorType::RowType>::type BIsoType;
+                    BIsoType B_iso = BIsoType();
+                    bool iso(iso_value(B_row, B_iso));
+                    D3ScalarType iso_prod(op.zero());
+                    if (iso)
+                    {
+                        iso_prod = op.mult(std::get<1>(A_elt), B_iso);
+                    }
+
+                    for (auto&& B_elt : B_row)
+                    {
+                        IndexType col_idx(std::get<0>(B_elt));
+                        if (mask_flags[col_idx] == complement)
+                        {
+                            continue;
+                        }
+
+                        D3ScalarType prod(iso ? iso_prod
+                                              : op.mult(std::get<1>(A_elt),
+                                                        std::get<1>(B_elt)));
+                        spa.accumulate(col_idx, prod, op);
+                    }
+                }
+
+                mask_flags.reset();
+
+                if (!spa.empty())
+                {
+                    spa.gather(T_row);
+                    T.setRow(row_idx, T_row);
+                    T_row.clear();
+                }
+            }
+        }
+
+        //**********************************************************************
+        /// Compute T<M> = A +.* B with one dot product per stored true value
+        /// in the mask, so the work is proportional to nvals(M).
+        template<typename TMatrixT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_masked_dot(TMatrixT                      &T,
+                                   MMatrixT              const   &M,
+                                   SemiringT                      op,
+                                   AMatrixT              const   &A_in,
+                                   TransposeView<BMatrixT> const &B)
+        {
+            GRB_TRACE_KERNEL("mxm_masked_dot");
+
+            auto const &A(row_major(A_in));
+
+            typedef typename SemiringT::result_type D3ScalarType;
+            typedef std::vector<std::tuple<IndexType,D3ScalarType> > TRowType;
+
+            TRowType T_row;
+            RowSet M_rows(stored_rows(M));
+            for (IndexType ix = 0; ix < M_rows.size(); ++ix)
+            {
+                IndexType row_idx(M_rows[ix]);
+                mxm_masked_dot_row(T_row, M, op, A, B, row_idx);
+                if (!T_row.empty())
+                {
+                    T.setRow(row_idx, T_row);
+                    T_row.clear();
+                }
+            }
+        }
+
+        /// Column access on a matrix that is not a TransposeView searches
+        /// every row, so transpose B once and take its rows instead.
+        template<typename TMatrixT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_masked_dot(TMatrixT            &T,
+                                   MMatrixT    const   &M,
+                                   SemiringT            op,
+                                   AMatrixT    const   &A,
+                                   BMatrixT    const   &B)
+        {
+            typedef typename BMatrixT::ScalarType BScalarType;
+            typedef typename scratch_matrix<BMatrixT, BScalarType>::type
+                BTMatrixType;
+            BTMatrixType BT(row_major(TransposeView<BMatrixT>(B)));
+            mxm_masked_dot(T, M, op, A, TransposeView<BTMatrixType>(BT));
+        }
+
+        //**********************************************************************
+        /// Estimated number of multiplies in A +.* B
+        template<typename AMatrixT,
+                 typename BMatrixT>
+        inline double mxm_flops(AMatrixT const &A, BMatrixT const &B)
+        {
+            return ((double)A.nvals() * (double)B.nvals() /
+                    (double)std::max<IndexType>(B.nrows(), 1));
+        }
+
+        /// Gustavson's algorithm does work proportional to the number of
+        /// multiplies; the dot product version tests every (row, col) pair.
+        /// Use Gustavson unless the estimated multiplies exceed the number of
+        /// output positions (i.e., the result is expected to be dense).
+        template<typename AMatrixT,
+                 typename BMatrixT>
+        inline bool mxm_use_gustavson(AMatrixT const &A, BMatrixT const &B)
+        {
+            return (mxm_flops(A, B) < (double)A.nrows() * (double)B.ncols());
+        }
+
+        //**********************************************************************
+        /// Choose the kernel for T<M> = A +.* B based on the mask.
+
+        template<typename TMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_compute(TMatrixT            &T,
+                                NoMask      const   &M,
+                                SemiringT            op,
+                                AMatrixT    const   &A,
+                                BMatrixT    const   &B)
+        {
+            if (mxm_use_gustavson(A, B))
+            {
+                mxm_gustavson(T, M, true, op, A, B);
+            }
+            else
+            {
+                mxm_dot(T, op, A, B);
+            }
+        }
+
+        /// A complemented mask removes positions from the result, so skip
+        /// them in the Gustavson accumulation.
+        template<typename TMatrixT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_compute(TMatrixT                           &T,
+                                MatrixComplementView<MMatrixT> const &M,
+                                SemiringT                           op,
+                                AMatrixT                   const   &A,
+                                BMatrixT                   const   &B)
+        {
+            if (mxm_use_gustavson(A, B))
+            {
+                mxm_gustavson(T, M.getMatrix(), true, op, A, B);
+            }
+            else
+            {
+                mxm_dot(T, op, A, B);
+            }
+        }
+
+        /// With a mask only the masked positions are needed: one dot product
+        /// per mask value, or Gustavson restricted to the mask when that is
+        /// expected to take fewer operations.
+        template<typename TMatrixT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_compute(TMatrixT            &T,
+                                MMatrixT    const   &M,
+                                SemiringT            op,
+                                AMatrixT    const   &A,
+                                BMatrixT    const   &B)
+        {
+            double dot_ops((double)M.nvals() *
+                           ((double)A.nvals() /
+                            (double)std::max<IndexType>(A.nrows(), 1) +
+                            (double)B.nvals() /
+                            (double)std::max<IndexType>(B.ncols(), 1)));
+
+            if (dot_ops < mxm_flops(A, B))
+            {
+                mxm_masked_dot(T, M, op, A, B);
+            }
+            else
+            {
+                mxm_gustavson(T, M, false, op, A, B);
+            }
+        }
+
+        //**********************************************************************
+        /// The kernels above already honour a mask (or NoMask); only the
+        /// dense dot product case of a complemented mask relies on the
+        /// masked write that follows, so use Gustavson for it here.
+        template<typename SinkT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_reduce_compute(SinkT               &sink,
+                                       MMatrixT    const   &M,
+                                       SemiringT            op,
+                                       AMatrixT    const   &A,
+                                       BMatrixT    const   &B)
+        {
+            mxm_compute(sink, M, op, A, B);
+        }
+
+        template<typename SinkT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_reduce_compute(
+            SinkT                                &sink,
+            MatrixComplementView<MMatrixT> const &M,
+            SemiringT                             op,
+            AMatrixT                     const   &A,
+            BMatrixT                     const   &B)
+        {
+            mxm_gustavson(sink, M.getMatrix(), true, op, A, B);
+        }
+
+        //**********************************************************************
+        /// Fused mxm and reduce to scalar:
+        ///     val = accum(val, reduce(monoid, apply_op((A +.* B)<M>)))
+        /// The product is folded into the monoid row by row as the kernels
+        /// produce it (see MonoidReduceSink), so it is never stored.
+        template<typename ValueT,
+                 typename MMatrixT,
+                 typename AccumT,
+                 typename MonoidT,
+                 typename UnaryOpT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_reduce(ValueT              &val,
+                               MMatrixT    const   &M,
+                               AccumT               accum,
+                               MonoidT              monoid,
+                               UnaryOpT             apply_op,
+                               SemiringT            op,
+                               AMatrixT    const   &A,
+                               BMatrixT    const   &B)
+        {
+            MonoidReduceSink<MonoidT, UnaryOpT> sink(monoid, apply_op);
+            mxm_reduce_compute(sink, M, op, A, B);
+
+            ValueT z;
+            opt_accum_scalar(z, val, sink.value(), accum);
+            val = z;
+        }
+
+        //**********************************************************************
+        /// Without a mask or an accumulator C is the product itself.  When
+        /// the kernels would have kept T in the storage of C anyway, and C
+        /// is not one of the operands, compute the product straight into C.
+        template<typename CMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline bool mxm_into(CMatrixT            &C,
+                             SemiringT            op,
+                             AMatrixT    const   &A,
+                             BMatrixT    const   &B,
+                             std::true_type)
+        {
+            if (is_aliased(C, A) || is_aliased(C, B))
+            {
+                return false;
+            }
+
+            C.clear();
+            if ((A.nvals() > 0) && (B.nvals() > 0))
+            {
+                mxm_compute(C, NoMask(), op, A, B);
+            }
+            return true;
+        }
+
+        template<typename CMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline bool mxm_into(CMatrixT            &,
+                             SemiringT             ,
+                             AMatrixT    const   &,
+                             BMatrixT    const   &,
+                             std::false_type)
+        {
+            return false;
+        }
+
         //**********************************************************************
         /// Implementation of 4.3.1 mxm: Matrix-matrix multiply
         template<typename CMatrixT,
@@ -76,71 +546,48 @@ namespace GraphBLAS
             // Dimension checks happen in front end
             IndexType nrow_A(A.nrows());
             IndexType ncol_B(B.ncols());
-            //Frontend checks the dimensions, but use C explicitly
-            IndexType nrow_C(C.nrows());
-            IndexType ncol_C(C.ncols());
 
             typedef typename SemiringT::result_type D3ScalarType;
-            typedef typename AMatrixT::ScalarType AScalarType;
-            typedef typename BMatrixT::ScalarType BScalarType;
-            typedef typename CMatrixT::ScalarType CScalarType;
-            typedef std::vector<std::tuple<IndexType,CScalarType> > CColType;
-            typedef std::vector<std::tuple<IndexType,D3ScalarType> > TColType;
+            typedef typename CMatrixT::ScalarType   CScalarType;
+
+            // =================================================================
+            // C = A +.* B needs no temporaries (see mxm_into)
+            if (mxm_into(C, op, A, B,
+                         std::integral_constant<
+                             bool,
+                             std::is_same<MMatrixT, NoMask>::value &&
+                             std::is_same<AccumT, NoAccumulate>::value &&
+                             std::is_base_of<
+                                 typename scratch_matrix<CMatrixT,
+                                                         CScalarType>::type,
+                                 CMatrixT>::value>()))
+            {
+                return;
+            }
 
             // =================================================================
-            // Do the basic dot-product work with the semi-ring.
-            LilSparseMatrix<D3ScalarType> T(nrow_A, ncol_B);
+            // Do the basic multiply work with the semi-ring.
+            typename scratch_matrix<CMatrixT, D3ScalarType>::type
+                T(nrow_A, ncol_B);
 
             // Build this completely based on the semiring
             if ((A.nvals() > 0) && (B.nvals() > 0))
             {
-                // create a column of result at a time
-                TColType T_col;
-                for (IndexType col_idx = 0; col_idx < ncol_B; ++col_idx)
-                {
-                    typename BMatrixT::ColType B_col(B.getCol(col_idx));
-
-                    if (!B_col.empty())
-                    {
-                        for (IndexType row_idx = 0; row_idx < nrow_A; ++row_idx)
-                        {
-                            typename AMatrixT::RowType A_row(A.getRow(row_idx));
-                            if (!A_row.empty())
-                            {
-                                D3ScalarType T_val;
-                                if (dot(T_val, A_row, B_col, op))
-                                {
-                                    T_col.push_back(
-                                            std::make_tuple(row_idx, T_val));
-                                }
-                            }
-                        }
-                        if (!T_col.empty())
-                        {
-                            T.setCol(col_idx, T_col);
-                            T_col.clear();
-                        }
-                    }
-                }
+                mxm_compute(T, M, op, A, B);
             }
 
             GRB_LOG_VERBOSE("T: " << T);
 
             // =================================================================
-            // Accumulate into Z
+            // Accumulate T via C and write the result through the mask,
+            // without forming Z
             typedef typename std::conditional<
                 std::is_same<AccumT, NoAccumulate>::value,
                 D3ScalarType,
                 typename AccumT::result_type>::type ZScalarType;
-            LilSparseMatrix<ZScalarType> Z(nrow_C, ncol_C);
 
-            ewise_or_opt_accum(Z, C, T, accum);
-
-            GRB_LOG_VERBOSE("Z: " << Z);
-
-            // =================================================================
-            // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, M, replace_flag);
+            write_with_opt_accum_mask<ZScalarType>(C, T, M, accum,
+                                                   replace_flag);
 
         } // mxm
     } // backend
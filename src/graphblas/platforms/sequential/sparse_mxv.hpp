@@ -41,7 +41,9 @@
 #include <vector>
 #include <iterator>
 #include <iostream>
+#include <algorithm>
 #include <graphblas/algebra.hpp>
+#include <graphblas/detail/trace.hpp>
 
 #include "sparse_helpers.hpp"
 
@@ -52,6 +54,173 @@ namespace GraphBLAS
 {
     namespace backend
     {
+        //********************************************************************
+        /// Pull: one dot product of u with each row of A that passes the
+        /// mask.
+        template<typename D3ScalarT,
+                 typename MaskT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UContentsT>
+        inline void mxv_pull(
+            std::vector<std::tuple<IndexType, D3ScalarT> >       &t,
+            MaskT                                          const &mask,
+            SemiringT                                             op,
+            AMatrixT                                       const &A,
+            UContentsT                                     const &u_contents)
+        {
+            GRB_TRACE_KERNEL("mxv_pull");
+
+            typedef typename AMatrixT::RowType ARowType;
+
+            ScratchFlags mask_flags(A.nrows());
+            mask_flags_1D(mask_flags, mask);
+
+            for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+            {
+                if (!mask_flags[row_idx])
+                {
+                    continue;
+                }
+
+                ARowType const &A_row(A.getRow(row_idx));
+
+                if (!A_row.empty())
+                {
+                    D3ScalarT t_val;
+                    if (dot(t_val, A_row, u_contents, op))
+                    {
+                        t.push_back(std::make_tuple(row_idx, t_val));
+                    }
+                }
+            }
+        }
+
+        //********************************************************************
+        /// Push: scatter each stored value of u times the corresponding
+        /// column of A into a sparse accumulator.  A must have cheap column
+        /// access (see mxv_push()).
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UContentsT>
+        inline void mxv_push_cols(
+            std::vector<std::tuple<IndexType, D3ScalarT> >       &t,
+            SemiringT                                             op,
+            AMatrixT                                       const &A,
+            UContentsT                                     const &u_contents)
+        {
+            GRB_TRACE_KERNEL("mxv_push");
+
+            SparseAccumulator<D3ScalarT> spa(A.nrows());
+
+            for (auto&& u_elt : u_contents)
+            {
+                typename AMatrixT::ColType A_col(
+                    A.getCol(std::get<0>(u_elt)));
+
+                for (auto&& A_elt : A_col)
+                {
+                    IndexType idx(std::get<0>(A_elt));
+                    D3ScalarT prod(op.mult(std::get<1>(A_elt),
+                                           std::get<1>(u_elt)));
+                    spa.accumulate(idx, prod, op);
+                }
+            }
+
+            spa.gather(t);
+        }
+
+        /// The columns of a TransposeView are rows of the underlying
+        /// matrix.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UContentsT>
+        inline void mxv_push(
+            std::vector<std::tuple<IndexType, D3ScalarT> >       &t,
+            SemiringT                                             op,
+            TransposeView<AMatrixT>                        const &A,
+            UContentsT                                     const &u_contents)
+        {
+            mxv_push_cols(t, op, A, u_contents);
+        }
+
+        /// The columns of a CsrCscSparseMatrix are read from its CSC copy.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UContentsT>
+        inline void mxv_push(
+            std::vector<std::tuple<IndexType, D3ScalarT> >       &t,
+            SemiringT                                             op,
+            AMatrixT                                       const &A,
+            UContentsT                                     const &u_contents,
+            std::true_type)
+        {
+            mxv_push_cols(t, op, A, u_contents);
+        }
+
+        /// Column access on other matrices searches every row, so
+        /// transpose A once and take its rows instead.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UContentsT>
+        inline void mxv_push(
+            std::vector<std::tuple<IndexType, D3ScalarT> >       &t,
+            SemiringT                                             op,
+            AMatrixT                                       const &A,
+            UContentsT                                     const &u_contents,
+            std::false_type)
+        {
+            typedef typename scratch_matrix<
+                AMatrixT, typename AMatrixT::ScalarType>::type ATMatrixType;
+            ATMatrixType AT(row_major(TransposeView<AMatrixT>(A)));
+            mxv_push(t, op, TransposeView<ATMatrixType>(AT), u_contents);
+        }
+
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UContentsT>
+        inline void mxv_push(
+            std::vector<std::tuple<IndexType, D3ScalarT> >       &t,
+            SemiringT                                             op,
+            AMatrixT                                       const &A,
+            UContentsT                                     const &u_contents)
+        {
+            mxv_push(t, op, A, u_contents,
+                     typename has_csc_copy<AMatrixT>::type());
+        }
+
+        //********************************************************************
+        /// Push does work proportional to the columns of A selected by u;
+        /// pull does a dot product (a lookup per stored value when u is held
+        /// as a bitmap, a merge with u otherwise) for every row that passes
+        /// the mask.  Pick the direction with the smaller estimate.
+        template<typename MaskT,
+                 typename AMatrixT,
+                 typename UContentsT>
+        inline bool mxv_use_push(MaskT      const &mask,
+                                 AMatrixT   const &A,
+                                 UContentsT const &u_contents)
+        {
+            double nvals_A((double)A.nvals());
+            double push_ops((double)u_contents.size() * nvals_A /
+                            (double)std::max<IndexType>(A.ncols(), 1));
+            if (col_access_cost(A) > 0.)
+            {
+                push_ops += nvals_A;   // transposed copy
+            }
+
+            double pull_ops((double)mask_nvals_1D(mask, A.nrows()) *
+                            (nvals_A / (double)std::max<IndexType>(A.nrows(), 1) +
+                             row_access_cost(A) + lookup_cost(u_contents)));
+
+            return (push_ops < pull_ops);
+        }
+
         //********************************************************************
         /// Implementation of 4.3.3 mxv: Matrix-Vector variant
         template<typename WVectorT,
@@ -69,28 +238,21 @@ namespace GraphBLAS
                         bool             replace_flag = false)
         {
             // =================================================================
-            // Do the basic dot-product work with the semi-ring.
+            // Do the basic multiply work with the semi-ring.
             typedef typename SemiringT::result_type D3ScalarType;
-            typedef typename AMatrixT::ScalarType AScalarType;
-            typedef std::vector<std::tuple<IndexType,AScalarType> >  ARowType;
 
-            std::vector<std::tuple<IndexType, D3ScalarType> > t;
+            ScratchVector<std::tuple<IndexType, D3ScalarType> > t;
 
             if ((A.nvals() > 0) && (u.nvals() > 0))
             {
                 auto u_contents(u.getContents());
-                for (IndexType row_idx = 0; row_idx < w.size(); ++row_idx)
+                if (mxv_use_push(mask, A, u_contents))
                 {
-                    ARowType const &A_row(A.getRow(row_idx));
-
-                    if (!A_row.empty())
-                    {
-                        D3ScalarType t_val;
-                        if (dot(t_val, A_row, u_contents, op))
-                        {
-                            t.push_back(std::make_tuple(row_idx, t_val));
-                        }
-                    }
+                    mxv_push(*t, op, A, u_contents);
+                }
+                else
+                {
+                    mxv_pull(*t, mask, op, A, u_contents);
                 }
             }
 
@@ -99,12 +261,12 @@ namespace GraphBLAS
             typedef typename std::conditional<std::is_same<AccumT, NoAccumulate>::value,
                                               D3ScalarType,
                                               typename AccumT::result_type>::type ZScalarType;
-            std::vector<std::tuple<IndexType, ZScalarType> > z;
-            ewise_or_opt_accum_1D(z, w, t, accum);
+            ScratchVector<std::tuple<IndexType, ZScalarType> > z;
+            ewise_or_opt_accum_1D(*z, w, *t, accum);
 
             // =================================================================
             // Copy Z into the final output, w, considering mask and replace
-            write_with_opt_mask_1D(w, z, mask, replace_flag);
+            write_with_opt_mask_1D(w, *z, mask, replace_flag);
         }
 
     } // backend
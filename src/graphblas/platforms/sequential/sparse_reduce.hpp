@@ -68,18 +68,17 @@ namespace GraphBLAS
             // =================================================================
             // Do the basic reduction work with the binary op
             typedef typename BinaryOpT::result_type D3ScalarType;
-            typedef typename AMatrixT::ScalarType AScalarType;
-            typedef std::vector<std::tuple<IndexType,AScalarType> >  ARowType;
+            typedef typename AMatrixT::RowType ARowType;
 
             std::vector<std::tuple<IndexType, D3ScalarType> > t;
 
             if (A.nvals() > 0)
             {
-                for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+                RowSet rows(stored_rows(A));
+                for (IndexType ix = 0; ix < rows.size(); ++ix)
                 {
-                    /// @todo Can't be a reference because A might be transpose
-                    /// view.  Need to specialize on TransposeView and getCol()
-                    ARowType const A_row(A.getRow(row_idx));
+                    IndexType row_idx(rows[ix]);
+                    ARowType A_row(A.getRow(row_idx));
 
                     /// @todo There is something hinky with domains here.  How
                     /// does one perform the reduction in A domain but produce
@@ -121,14 +120,13 @@ namespace GraphBLAS
             // =================================================================
             // Do the basic reduction work with the monoid
             typedef typename MonoidT::result_type D3ScalarType;
-            typedef typename UVectorT::ScalarType UScalarType;
-            typedef std::vector<std::tuple<IndexType,UScalarType> >  UColType;
+            typedef typename UVectorT::ContentsType UColType;
 
             D3ScalarType t = op.identity();
 
             if (u.nvals() > 0)
             {
-                UColType const u_col(u.getContents());
+                UColType u_col(u.getContents());
 
                 reduction(t, u_col, op);
             }
@@ -159,18 +157,16 @@ namespace GraphBLAS
             // =================================================================
             // Do the basic reduction work with the monoid
             typedef typename MonoidT::result_type D3ScalarType;
-            typedef typename AMatrixT::ScalarType AScalarType;
-            typedef std::vector<std::tuple<IndexType,AScalarType> >  ARowType;
+            typedef typename AMatrixT::RowType ARowType;
 
             D3ScalarType t = op.identity();
 
             if (A.nvals() > 0)
             {
-                for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+                RowSet rows(stored_rows(A));
+                for (IndexType ix = 0; ix < rows.size(); ++ix)
                 {
-                    /// @todo Can't be a reference because A might be transpose
-                    /// view.  Need to specialize on TransposeView and getCol()
-                    ARowType const A_row(A.getRow(row_idx));
+                    ARowType A_row(A.getRow(rows[ix]));
 
                     /// @todo There is something hinky with domains here.  How
                     /// does one perform the reduction in A domain but produce
@@ -44,6 +44,7 @@
 #include <graphblas/types.hpp>
 #include <graphblas/exceptions.hpp>
 #include <graphblas/algebra.hpp>
+#include <graphblas/detail/trace.hpp>
 
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
@@ -76,43 +77,26 @@ namespace GraphBLAS
             IndexType ncols(A.ncols());
 
             // =================================================================
-            // Apply the unary operator from A into T.
-            // This is really the guts of what makes this special.
-
-            /// @todo Do something different if A is TransposeView
-            LilSparseMatrix<AScalarType> T(ncols, nrows);
-            for (IndexType ridx = A.nrows(); ridx > 0; --ridx)
-            {
-                IndexType row_idx = ridx - 1;
-                auto a_row = A.getRow(row_idx);
-                for (auto elt = a_row.begin(); elt != a_row.end(); ++elt)
-                {
-                    T.setElement(std::get<0>(*elt), row_idx, std::get<1>(*elt));
-
-                    /// @todo Would be nice to push_back on each row directly
-                    //IndexType idx = std::get<0>(elt);
-                    //T.getRow(idx).push_back(
-                    //    std::make_tuple(row_idx, std::get<1>(elt)));
-                }
-            }
+            // Transpose A into T: a counting sort by column (a row copy when
+            // A is a TransposeView), or a build when C is hypersparse.
+            typename scratch_matrix<CMatrixT, AScalarType>::type T(ncols, nrows);
+            GRB_TRACE_KERNEL(is_hypersparse<CMatrixT>::value
+                             ? "transpose_build"
+                             : "transpose_counting_sort");
+            transpose_into(T, A);
 
             GRB_LOG_VERBOSE("T: " << T);
 
             // =================================================================
-            // Accumulate T via C into Z
+            // Accumulate T via C and write the result through the mask,
+            // without forming Z
             typedef typename std::conditional<
                 std::is_same<AccumT, NoAccumulate>::value,
                 AScalarType,
                 typename AccumT::result_type>::type  ZScalarType;
 
-            LilSparseMatrix<ZScalarType> Z(ncols, nrows);
-            ewise_or_opt_accum(Z, C, T, accum);
-
-            GRB_LOG_VERBOSE("Z: " << Z);
-
-            // =================================================================
-            // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, mask, replace_flag);
+            write_with_opt_accum_mask<ZScalarType>(C, T, mask, accum,
+                                                   replace_flag);
         }
     }
 }
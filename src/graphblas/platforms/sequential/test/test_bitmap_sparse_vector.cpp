@@ -176,6 +176,30 @@ BOOST_AUTO_TEST_CASE(test_assignment)
     BOOST_CHECK_EQUAL(v1, v2);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_get_contents_view)
+{
+    std::vector<IndexType> indices = {0, 3, 4, 6, 7};
+    std::vector<double>    values  = {6 ,4, 7, 9, 4};
+
+    GraphBLAS::backend::BitmapSparseVector<double> v1(8, indices, values);
+    auto contents(v1.getContents());
+
+    BOOST_CHECK_EQUAL(contents.size(), indices.size());
+    BOOST_CHECK(contents.hasElement(3));
+    BOOST_CHECK(!contents.hasElement(5));
+    BOOST_CHECK_EQUAL(contents.extractElement(6), 9.0);
+
+    IndexType ix(0);
+    for (auto&& elt : contents)
+    {
+        BOOST_CHECK_EQUAL(std::get<0>(elt), indices[ix]);
+        BOOST_CHECK_EQUAL(std::get<1>(elt), values[ix]);
+        ++ix;
+    }
+    BOOST_CHECK_EQUAL(ix, indices.size());
+}
+
 //****************************************************************************
 BOOST_AUTO_TEST_CASE(test_mxv_sparse_nomask_noaccum)
 {
@@ -0,0 +1,212 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE csr_csc_sparse_matrix_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+// Columns come from the CSC copy, in row order
+BOOST_AUTO_TEST_CASE(csr_csc_test_get_col)
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3},
+                                            {2, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+
+    backend::CsrCscSparseMatrix<double> m1(mat, 0);
+
+    for (IndexType ci = 0; ci < 4; ++ci)
+    {
+        auto col = m1.getCol(ci);
+        IndexArrayType row_indices;
+        m1.getRowIndices(ci, row_indices);
+        BOOST_CHECK_EQUAL(col.size(), row_indices.size());
+
+        IndexType ix = 0;
+        for (IndexType ri = 0; ri < 7; ++ri)
+        {
+            if (mat[ri][ci] != 0)
+            {
+                BOOST_REQUIRE(ix < col.size());
+                BOOST_CHECK_EQUAL(std::get<0>(col[ix]), ri);
+                BOOST_CHECK_EQUAL(std::get<1>(col[ix]), mat[ri][ci]);
+                BOOST_CHECK_EQUAL(row_indices[ix], ri);
+                ++ix;
+            }
+        }
+        BOOST_CHECK_EQUAL(ix, col.size());
+    }
+
+    IndexArrayType row_indices;
+    BOOST_CHECK_THROW(m1.getRowIndices(4, row_indices),
+                      IndexOutOfBoundsException);
+}
+
+//****************************************************************************
+// Every modification must invalidate the CSC copy
+BOOST_AUTO_TEST_CASE(csr_csc_test_invalidation)
+{
+    std::vector<std::vector<double>> mat = {{1, 0, 2},
+                                            {0, 3, 0},
+                                            {4, 0, 5}};
+
+    backend::CsrCscSparseMatrix<double> m1(mat, 0);
+    BOOST_CHECK_EQUAL(m1.getCol(1).size(), 1UL);
+
+    m1.setElement(0, 1, 8.);
+    auto col = m1.getCol(1);
+    BOOST_CHECK_EQUAL(col.size(), 2UL);
+    BOOST_CHECK_EQUAL(std::get<0>(col[0]), 0UL);
+    BOOST_CHECK_EQUAL(std::get<1>(col[0]), 8.);
+
+    m1.setElement(0, 1, 1., GraphBLAS::Plus<double>());
+    BOOST_CHECK_EQUAL(std::get<1>(m1.getCol(1)[0]), 9.);
+
+    std::vector<std::tuple<IndexType, double> > row;
+    row.push_back(std::make_tuple(1, 7.));
+    m1.setRow(2, row);
+    col = m1.getCol(1);
+    BOOST_CHECK_EQUAL(col.size(), 3UL);
+    BOOST_CHECK_EQUAL(std::get<1>(col[2]), 7.);
+    BOOST_CHECK_EQUAL(m1.getCol(0).size(), 1UL);
+
+    m1.setCol(1, std::vector<std::tuple<IndexType, double> >());
+    BOOST_CHECK_EQUAL(m1.getCol(1).size(), 0UL);
+    BOOST_CHECK_EQUAL(m1.nvals(), 2UL);
+
+    IndexArrayType i = {2, 0};
+    IndexArrayType j = {2, 2};
+    std::vector<double> v = {6., 1.};
+    m1.build(i.begin(), j.begin(), v.begin(), i.size(),
+             GraphBLAS::Plus<double>());
+    BOOST_CHECK_EQUAL(m1.getCol(2).size(), 2UL);
+    BOOST_CHECK_EQUAL(std::get<1>(m1.getCol(2)[0]), 3.);
+
+    m1.clear();
+    BOOST_CHECK_EQUAL(m1.getCol(0).size(), 0UL);
+    BOOST_CHECK_EQUAL(m1.getCol(2).size(), 0UL);
+
+    backend::CsrCscSparseMatrix<double> m2(mat, 0);
+    BOOST_CHECK_EQUAL(m2.getCol(0).size(), 2UL);
+    m2 = m1;
+    BOOST_CHECK_EQUAL(m2.getCol(0).size(), 0UL);
+}
+
+//****************************************************************************
+// Operations on frontend matrices tagged with CSR/CSC storage
+BOOST_AUTO_TEST_CASE(csr_csc_test_frontend_operations)
+{
+    std::vector<std::vector<double>> A_dense = {{1, 0, 2},
+                                                {0, 3, 0},
+                                                {4, 0, 5}};
+    std::vector<std::vector<double>> AA_dense = {{9, 0, 12},
+                                                 {0, 9, 0},
+                                                 {24, 0, 33}};
+    std::vector<std::vector<double>> AT_dense = {{1, 0, 4},
+                                                 {0, 3, 0},
+                                                 {2, 0, 5}};
+
+    GraphBLAS::Matrix<double, GraphBLAS::CsrCscStorageTag> A(A_dense, 0.);
+    GraphBLAS::Matrix<double, GraphBLAS::CsrCscStorageTag> AA(AA_dense, 0.);
+    GraphBLAS::Matrix<double, GraphBLAS::CsrCscStorageTag> AT(AT_dense, 0.);
+
+    GraphBLAS::Matrix<double, GraphBLAS::CsrCscStorageTag> C(3, 3);
+    GraphBLAS::mxm(C, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(), A, A);
+    BOOST_CHECK_EQUAL(C, AA);
+
+    GraphBLAS::transpose(C, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(), A);
+    BOOST_CHECK_EQUAL(C, AT);
+
+    GraphBLAS::mxm(C, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(),
+                   GraphBLAS::transpose(A), GraphBLAS::transpose(A));
+    GraphBLAS::transpose(C, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(), C);
+    BOOST_CHECK_EQUAL(C, AA);
+
+    std::vector<double> u_dense = {1, 1, 0};
+    GraphBLAS::Vector<double> u(u_dense, 0.);
+    GraphBLAS::Vector<double> w(3);
+    GraphBLAS::vxm(w, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(), u, A);
+    BOOST_CHECK_EQUAL(w.nvals(), 3);
+    BOOST_CHECK_EQUAL(w.extractElement(0), 1.0);
+    BOOST_CHECK_EQUAL(w.extractElement(1), 3.0);
+    BOOST_CHECK_EQUAL(w.extractElement(2), 2.0);
+}
+
+//****************************************************************************
+// mxv reads columns from the CSC copy, so push needs no transposed copy
+BOOST_AUTO_TEST_CASE(csr_csc_test_mxv_push)
+{
+    std::vector<std::vector<double>> A_dense = {{1, 0, 2},
+                                                {0, 3, 0},
+                                                {4, 0, 5}};
+    // The frontend hands the backend its Matrix type, not the storage class
+    backend::Matrix<double, CsrCscStorageTag> A(A_dense, 0.);
+    backend::Matrix<double>                   A_lil(A_dense, 0.);
+
+    BOOST_CHECK_EQUAL(backend::col_access_cost(A), 0.);
+    BOOST_CHECK(backend::col_access_cost(A_lil) > 0.);
+
+    std::vector<std::tuple<IndexType, double> > u = {std::make_tuple(2, 2.)};
+    BOOST_CHECK(backend::mxv_use_push(backend::NoMask(), A, u));
+
+    std::vector<std::tuple<IndexType, double> > t;
+    backend::mxv_push(t, GraphBLAS::ArithmeticSemiring<double>(), A, u);
+    std::vector<std::tuple<IndexType, double> > answer =
+        {std::make_tuple(0, 4.), std::make_tuple(2, 10.)};
+    BOOST_CHECK(t == answer);
+
+    std::vector<double> u_dense = {0, 0, 2};
+    GraphBLAS::Matrix<double, GraphBLAS::CsrCscStorageTag> A_front(A_dense, 0.);
+    GraphBLAS::Vector<double> u_front(u_dense, 0.);
+    GraphBLAS::Vector<double> w(3);
+    GraphBLAS::mxv(w, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(), A_front, u_front);
+    BOOST_CHECK_EQUAL(w.nvals(), 2);
+    BOOST_CHECK_EQUAL(w.extractElement(0), 4.0);
+    BOOST_CHECK_EQUAL(w.extractElement(2), 10.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
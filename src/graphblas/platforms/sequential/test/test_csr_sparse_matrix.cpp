@@ -0,0 +1,530 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE csr_sparse_matrix_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+// CSR basic constructor
+BOOST_AUTO_TEST_CASE(csr_test_construction_basic)
+{
+    IndexType M = 7;
+    IndexType N = 4;
+    backend::CsrSparseMatrix<double> m1(M, N);
+
+    IndexType num_rows(m1.nrows());
+    IndexType num_cols(m1.ncols());
+
+    BOOST_CHECK_EQUAL(num_rows, M);
+    BOOST_CHECK_EQUAL(num_cols, N);
+}
+
+
+//****************************************************************************
+// CSR constructor from dense matrix
+BOOST_AUTO_TEST_CASE(csr_test_construction_dense)
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3},
+                                            {2, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+
+    backend::CsrSparseMatrix<double> m1(mat);
+
+    IndexType M = mat.size();
+    IndexType N = mat[0].size();
+    IndexType num_rows(m1.nrows());
+    IndexType num_cols(m1.ncols());
+
+    BOOST_CHECK_EQUAL(num_rows, M);
+    BOOST_CHECK_EQUAL(num_cols, N);
+    for (IndexType i = 0; i < M; i++)
+    {
+        for (IndexType j = 0; j < N; j++)
+        {
+            BOOST_CHECK_EQUAL(m1.extractElement(i, j), mat[i][j]);
+        }
+    }
+}
+
+//****************************************************************************
+// CSR constructor from dense matrix, implied zeros
+BOOST_AUTO_TEST_CASE(csr_test_construction_dense_zero)
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3},
+                                            {2, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+
+    backend::CsrSparseMatrix<double> m1(mat, 0);
+
+    IndexType M = mat.size();
+    IndexType N = mat[0].size();
+    IndexType num_rows(m1.nrows());
+    IndexType num_cols(m1.ncols());
+
+    BOOST_CHECK_EQUAL(num_rows, M);
+    BOOST_CHECK_EQUAL(num_cols, N);
+    for (IndexType i = 0; i < M; i++)
+    {
+        for (IndexType j = 0; j < N; j++)
+        {
+            if (mat[i][j] != 0)
+            {
+                BOOST_CHECK_EQUAL(m1.extractElement(i, j), mat[i][j]);
+            }
+        }
+    }
+}
+
+//****************************************************************************
+// CSR constructor from copy
+BOOST_AUTO_TEST_CASE(csr_test_construction_copy)
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3},
+                                            {2, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+
+    backend::CsrSparseMatrix<double> m1(mat, 0);
+
+    backend::CsrSparseMatrix<double> m2(m1);
+
+    BOOST_CHECK_EQUAL(m1, m2);
+}
+
+//****************************************************************************
+// Assignment to empty location
+BOOST_AUTO_TEST_CASE(csr_test_assign_to_implied_zero)
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3},
+                                            {2, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+
+    backend::CsrSparseMatrix<double> m1(mat, 0);
+
+    mat[0][1] = 8;
+    m1.setElement(0, 1, 8);
+    BOOST_CHECK_EQUAL(m1.extractElement(0, 1), mat[0][1]);
+
+    backend::CsrSparseMatrix<double> m2(mat, 0);
+    BOOST_CHECK_EQUAL(m1, m2);
+}
+
+//****************************************************************************
+// Assignment to a location with a previous value
+BOOST_AUTO_TEST_CASE(csr_test_assign_to_nonzero_element)
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3},
+                                            {2, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+
+    backend::CsrSparseMatrix<double> m1(mat, 0);
+
+    mat[0][0] = 8;
+    m1.setElement(0, 0, 8);
+    BOOST_CHECK_EQUAL(m1.extractElement(0, 0), mat[0][0]);
+
+    backend::CsrSparseMatrix<double> m2(mat, 0);
+    BOOST_CHECK_EQUAL(m1, m2);
+}
+
+
+//****************************************************************************
+// test set/get_col
+BOOST_AUTO_TEST_CASE(csr_test_get_set_col)
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3},
+                                            {2, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+
+    backend::CsrSparseMatrix<double> m1(mat, 0);
+
+    auto col = m1.getCol(0);
+    BOOST_CHECK_EQUAL(4UL, col.size());
+
+    col = m1.getCol(1);
+    BOOST_CHECK_EQUAL(2UL, col.size());
+
+    col = m1.getCol(2);
+    BOOST_CHECK_EQUAL(1UL, col.size());
+
+    col = m1.getCol(3);
+    BOOST_CHECK_EQUAL(5UL, col.size());
+
+    BOOST_CHECK_EQUAL(12UL, m1.nvals());
+    col.clear();
+    m1.setCol(0, col);
+    col = m1.getCol(0);
+    BOOST_CHECK_EQUAL(0UL, col.size());
+    BOOST_CHECK_EQUAL(8UL, m1.nvals());
+
+    col.clear();
+    m1.setCol(1, col);
+    BOOST_CHECK_EQUAL(6UL, m1.nvals());
+    m1.setCol(2, col);
+    BOOST_CHECK_EQUAL(5UL, m1.nvals());
+    m1.setCol(3, col);
+    BOOST_CHECK_EQUAL(0UL, m1.nvals());
+
+
+    std::vector<std::vector<double>> mat2= {{0, 1, 0, 3, 0, 5, 0, 7, 0, 1, 0, 3, 0, 5, 0, 7},
+                                            {0, 0, 2, 3, 0, 0, 6, 7, 0, 0, 2, 3, 0, 0, 6, 7},
+                                            {0, 0, 0, 0, 4, 5, 6, 7, 0, 0, 0, 0, 4, 5, 6, 7},
+                                            {0, 0, 0, 0, 0, 0, 0, 0, 8, 8, 8, 8, 8, 8, 8, 8}};
+
+    backend::CsrSparseMatrix<double> m2(mat2, 0);
+    backend::CsrSparseMatrix<double> m3(4, 1);
+    for (IndexType ci = 0; ci < 16; ++ci)
+    {
+        IndexType nz(0);
+        //m3.setCol(0, m2.getCol(ci));
+        auto c = m2.getCol(ci);
+        m3.setCol(0, c);
+
+        for (IndexType ri = 0; ri < 4; ++ri)
+        {
+            if (mat2[ri][ci] == 0)
+            {
+                ++nz;
+            }
+            else
+            {
+                BOOST_CHECK_EQUAL(mat2[ri][ci], m3.extractElement(ri, 0));
+            }
+        }
+        BOOST_CHECK_EQUAL(m3.nvals(), 4UL - nz);
+    }
+}
+
+//****************************************************************************
+// test set/get_col
+BOOST_AUTO_TEST_CASE(csr_test_get_set_row)
+{
+    std::vector<std::vector<double>> mat = {{6, 7, 0, 2, 2, 0, 0},
+                                            {0, 0, 0, 5, 0, 0, 1},
+                                            {0, 0, 9, 0, 0, 0, 0},
+                                            {4, 0, 4, 3, 1, 0, 2}};
+
+    backend::CsrSparseMatrix<double> m1(mat, 0);
+
+    auto row = m1.getRow(0);
+    BOOST_CHECK_EQUAL(4UL, row.size());
+
+    row = m1.getRow(1);
+    BOOST_CHECK_EQUAL(2UL, row.size());
+
+    row = m1.getRow(2);
+    BOOST_CHECK_EQUAL(1UL, row.size());
+
+    row = m1.getRow(3);
+    BOOST_CHECK_EQUAL(5UL, row.size());
+
+    BOOST_CHECK_EQUAL(12UL, m1.nvals());
+    m1.setRow(0, std::vector<std::tuple<IndexType, double> >());
+    row = m1.getRow(0);
+    BOOST_CHECK_EQUAL(0UL, row.size());
+    BOOST_CHECK_EQUAL(8UL, m1.nvals());
+
+    m1.setRow(1, row);
+    BOOST_CHECK_EQUAL(6UL, m1.nvals());
+    m1.setRow(2, row);
+    BOOST_CHECK_EQUAL(5UL, m1.nvals());
+    m1.setRow(3, row);
+    BOOST_CHECK_EQUAL(0UL, m1.nvals());
+
+
+    std::vector<std::vector<double>> mat2= {{0, 0, 0, 0},
+                                            {0, 0, 0, 1},
+                                            {0, 0, 2, 0},
+                                            {0, 0, 2, 1},
+                                            {0, 4, 0, 0},
+                                            {0, 4, 0, 1},
+                                            {0, 4, 2, 0},
+                                            {0, 4, 2, 1},
+                                            {8, 0, 0, 0},
+                                            {8, 0, 0, 1},
+                                            {8, 0, 2, 0},
+                                            {8, 0, 2, 1},
+                                            {8, 4, 0, 0},
+                                            {8, 4, 0, 1},
+                                            {8, 4, 2, 0},
+                                            {8, 4, 2, 1}};
+
+    backend::CsrSparseMatrix<double> m2(mat2, 0);
+    backend::CsrSparseMatrix<double> m3(1, 4);
+    for (IndexType row_idx = 0; row_idx < 16; ++row_idx)
+    {
+        IndexType nz(0);
+        auto c = m2.getRow(row_idx);
+        m3.setRow(0, c);
+
+        for (IndexType col_idx = 0; col_idx < 4; ++col_idx)
+        {
+            if (mat2[row_idx][col_idx] == 0)
+            {
+                ++nz;
+            }
+            else
+            {
+                BOOST_CHECK_EQUAL(mat2[row_idx][col_idx], m3.extractElement(0, col_idx));
+            }
+        }
+        BOOST_CHECK_EQUAL(m3.nvals(), 4UL - nz);
+    }
+}
+
+//****************************************************************************
+// Bulk build with duplicates, out of order tuples and empty rows
+BOOST_AUTO_TEST_CASE(csr_test_build)
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3},
+                                            {2, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+
+    IndexArrayType i = {6, 3, 0, 2, 1, 3, 4, 0, 2, 3, 4, 6, 3};
+    IndexArrayType j = {3, 0, 3, 2, 0, 1, 0, 0, 3, 3, 3, 1, 0};
+    std::vector<double> v = {2, 1, 4, 9, 7, 5, 2, 6, 4, 3, 1, 1, 1};
+
+    backend::CsrSparseMatrix<double> m1(7, 4);
+    m1.build(i.begin(), j.begin(), v.begin(), i.size(),
+             GraphBLAS::Plus<double>());
+
+    backend::CsrSparseMatrix<double> m2(mat, 0);
+    BOOST_CHECK_EQUAL(m1, m2);
+    BOOST_CHECK_EQUAL(m1.nvals(), 12);
+}
+
+//****************************************************************************
+// Rewriting rows in increasing order after clear (the operation write path)
+BOOST_AUTO_TEST_CASE(csr_test_clear_and_set_rows)
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3},
+                                            {2, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+
+    backend::CsrSparseMatrix<double> m1(mat, 0);
+    backend::CsrSparseMatrix<double> m2(mat, 0);
+
+    m1.clear();
+    BOOST_CHECK_EQUAL(m1.nvals(), 0);
+    BOOST_CHECK(!m1.hasElement(6, 3));
+
+    for (IndexType row_idx = 0; row_idx < m2.nrows(); ++row_idx)
+    {
+        m1.setRow(row_idx, m2.getRow(row_idx));
+    }
+    BOOST_CHECK_EQUAL(m1, m2);
+
+    // Setting an element beyond the last filled row
+    m1.clear();
+    m1.setElement(4, 2, 3.0);
+    m1.setElement(1, 1, 1.0);
+    BOOST_CHECK_EQUAL(m1.nvals(), 2);
+    BOOST_CHECK_EQUAL(m1.extractElement(4, 2), 3.0);
+    BOOST_CHECK_EQUAL(m1.extractElement(1, 1), 1.0);
+    BOOST_CHECK(!m1.hasElement(5, 2));
+}
+
+//****************************************************************************
+// Operations on frontend matrices tagged with CSR storage
+BOOST_AUTO_TEST_CASE(csr_test_frontend_operations)
+{
+    std::vector<std::vector<double>> A_dense = {{1, 0, 2},
+                                                {0, 3, 0},
+                                                {4, 0, 5}};
+    std::vector<std::vector<double>> AA_dense = {{9, 0, 12},
+                                                 {0, 9, 0},
+                                                 {24, 0, 33}};
+    std::vector<std::vector<double>> AT_dense = {{1, 0, 4},
+                                                 {0, 3, 0},
+                                                 {2, 0, 5}};
+
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> A(A_dense, 0.);
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> AA(AA_dense, 0.);
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> AT(AT_dense, 0.);
+    GraphBLAS::Matrix<double> A_lil(A_dense, 0.);
+
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> C(3, 3);
+    GraphBLAS::mxm(C, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(), A, A_lil);
+    BOOST_CHECK_EQUAL(C, AA);
+
+    GraphBLAS::transpose(C, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(), A);
+    BOOST_CHECK_EQUAL(C, AT);
+
+    GraphBLAS::eWiseAdd(C, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                        GraphBLAS::Plus<double>(),
+                        A, GraphBLAS::transpose(A));
+    BOOST_CHECK_EQUAL(C.nvals(), 5);
+    BOOST_CHECK_EQUAL(C.extractElement(0, 2), 6.0);
+
+    GraphBLAS::Vector<double> w(3);
+    GraphBLAS::extract(w, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                       A, GraphBLAS::AllIndices(), (IndexType)2);
+    BOOST_CHECK_EQUAL(w.nvals(), 2);
+    BOOST_CHECK_EQUAL(w.extractElement(2), 5.0);
+
+    double sum = 0;
+    GraphBLAS::reduce(sum, GraphBLAS::NoAccumulate(),
+                      GraphBLAS::PlusMonoid<double>(), A);
+    BOOST_CHECK_EQUAL(sum, 15.0);
+}
+
+//****************************************************************************
+// Masked writes into a CSR matrix that already holds values rebuild it in
+// row order
+BOOST_AUTO_TEST_CASE(csr_test_masked_write_into_populated)
+{
+    std::vector<std::vector<double>> A_dense = {{1, 0, 2},
+                                                {0, 3, 0},
+                                                {4, 0, 5}};
+    std::vector<std::vector<double>> C_dense = {{7, 7, 0},
+                                                {0, 0, 7},
+                                                {7, 0, 0}};
+    std::vector<std::vector<bool>> M_dense = {{true,  false, true},
+                                              {false, true,  false},
+                                              {false, true,  false}};
+    std::vector<std::vector<double>> merge_dense = {{1, 7, 2},
+                                                    {0, 3, 7},
+                                                    {7, 0, 0}};
+    std::vector<std::vector<double>> replace_dense = {{1, 0, 2},
+                                                      {0, 3, 0},
+                                                      {0, 0, 0}};
+
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> A(A_dense, 0.);
+    GraphBLAS::Matrix<bool> M(M_dense, false);
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag>
+        merge_answer(merge_dense, 0.);
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag>
+        replace_answer(replace_dense, 0.);
+
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> C(C_dense, 0.);
+    GraphBLAS::assign(C, M, GraphBLAS::NoAccumulate(), A,
+                      GraphBLAS::AllIndices(), GraphBLAS::AllIndices());
+    BOOST_CHECK_EQUAL(C, merge_answer);
+
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> D(C_dense, 0.);
+    GraphBLAS::assign(D, M, GraphBLAS::NoAccumulate(), A,
+                      GraphBLAS::AllIndices(), GraphBLAS::AllIndices(), true);
+    BOOST_CHECK_EQUAL(D, replace_answer);
+
+    // The rows written are consistent with the stored row offsets
+    C.setElement(1, 0, 8.);
+    BOOST_CHECK_EQUAL(C.nvals(), 7);
+    BOOST_CHECK_EQUAL(C.extractElement(1, 2), 7.);
+    BOOST_CHECK_EQUAL(C.extractElement(2, 0), 7.);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(csr_test_masked_accum_into_populated)
+{
+    std::vector<std::vector<double>> A_dense = {{1, 0, 2},
+                                                {0, 3, 0},
+                                                {4, 0, 5}};
+    std::vector<std::vector<double>> C_dense = {{1, 1, 0},
+                                                {0, 0, 1},
+                                                {1, 0, 0}};
+    std::vector<std::vector<bool>> M_dense = {{true,  false, true},
+                                              {false, true,  false},
+                                              {false, false, false}};
+    std::vector<std::vector<double>> merge_dense = {{10, 1, 12},
+                                                    { 0, 9,  1},
+                                                    { 1, 0,  0}};
+    std::vector<std::vector<double>> replace_dense = {{10, 0, 12},
+                                                      { 0, 9,  0},
+                                                      { 0, 0,  0}};
+
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> A(A_dense, 0.);
+    GraphBLAS::Matrix<bool> M(M_dense, false);
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag>
+        merge_answer(merge_dense, 0.);
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag>
+        replace_answer(replace_dense, 0.);
+
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> C(C_dense, 0.);
+    GraphBLAS::mxm(C, M, GraphBLAS::Plus<double>(),
+                   GraphBLAS::ArithmeticSemiring<double>(), A, A);
+    BOOST_CHECK_EQUAL(C, merge_answer);
+
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> D(C_dense, 0.);
+    GraphBLAS::mxm(D, M, GraphBLAS::Plus<double>(),
+                   GraphBLAS::ArithmeticSemiring<double>(), A, A, true);
+    BOOST_CHECK_EQUAL(D, replace_answer);
+
+    // C as an operand as well as the output
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> E(A_dense, 0.);
+    GraphBLAS::mxm(E, M, GraphBLAS::Plus<double>(),
+                   GraphBLAS::ArithmeticSemiring<double>(), E, E);
+    BOOST_CHECK_EQUAL(E.extractElement(0, 0), 10.);
+    BOOST_CHECK_EQUAL(E.extractElement(1, 1), 12.);
+    BOOST_CHECK_EQUAL(E.extractElement(2, 2), 5.);
+    BOOST_CHECK_EQUAL(E.nvals(), 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
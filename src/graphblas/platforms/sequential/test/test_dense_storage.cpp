@@ -0,0 +1,325 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE dense_storage_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    std::vector<std::vector<double>> const mat = {{6, 0, 0, 4},
+                                                  {7, 0, 0, 0},
+                                                  {0, 0, 9, 4},
+                                                  {2, 5, 0, 3}};
+
+    std::vector<std::vector<double>> const full = {{6, 1, 2, 4},
+                                                   {7, 3, 8, 1},
+                                                   {5, 2, 9, 4},
+                                                   {2, 5, 1, 3}};
+
+    // Same stored elements, whatever the storage of each side
+    template <typename V1T, typename V2T>
+    bool same_elements(V1T const &v1, V2T const &v2)
+    {
+        if ((v1.size() != v2.size()) || (v1.nvals() != v2.nvals()))
+        {
+            return false;
+        }
+        IndexArrayType i1(v1.nvals()), i2(v2.nvals());
+        std::vector<typename V1T::ScalarType> x1(v1.nvals());
+        std::vector<typename V2T::ScalarType> x2(v2.nvals());
+        v1.extractTuples(i1, x1);
+        v2.extractTuples(i2, x2);
+        return ((i1 == i2) && (x1 == x2));
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(dense_test_vector_full_and_partial)
+{
+    backend::DenseVector<double> v1(4);
+    BOOST_CHECK_EQUAL(v1.nvals(), 0);
+    BOOST_CHECK(!v1.isFull());
+    BOOST_CHECK(v1.getContents().empty());
+
+    v1.setElement(2, 3.0);
+    v1.setElement(0, 1.0);
+    BOOST_CHECK_EQUAL(v1.nvals(), 2);
+    BOOST_CHECK(!v1.hasElement(1));
+    BOOST_CHECK_THROW(v1.extractElement(1), NoValueException);
+
+    // Iterating skips the indices that are not stored
+    std::vector<std::tuple<IndexType, double> > contents;
+    for (auto&& elt : v1.getContents())
+    {
+        contents.push_back(elt);
+    }
+    BOOST_CHECK_EQUAL(contents.size(), 2);
+    BOOST_CHECK_EQUAL(std::get<0>(contents[1]), 2);
+    BOOST_CHECK_EQUAL(std::get<1>(contents[1]), 3.0);
+
+    // Storing every index drops the bitmap
+    v1.setElement(1, 2.0);
+    v1.setElement(3, 4.0);
+    BOOST_CHECK(v1.isFull());
+    BOOST_CHECK(v1.getContents().full());
+    BOOST_CHECK(v1 == backend::DenseVector<double>(
+                    std::vector<double>({1, 2, 3, 4})));
+
+    v1.clear();
+    BOOST_CHECK_EQUAL(v1.nvals(), 0);
+    BOOST_CHECK(!v1.hasElement(0));
+
+    // A full result is copied without a bitmap, a partial one with one
+    v1.setContents(std::vector<std::tuple<IndexType, int> >(
+                       {std::make_tuple(0, 5), std::make_tuple(1, 6),
+                        std::make_tuple(2, 7), std::make_tuple(3, 8)}));
+    BOOST_CHECK(v1.isFull());
+    BOOST_CHECK_EQUAL(v1.extractElement(3), 8.0);
+    v1.setContents(std::vector<std::tuple<IndexType, int> >(
+                       {std::make_tuple(3, 9)}));
+    BOOST_CHECK_EQUAL(v1.nvals(), 1);
+    BOOST_CHECK(!v1.hasElement(0));
+    BOOST_CHECK_EQUAL(v1.extractElement(3), 9.0);
+
+    backend::DenseVector<double> v2(std::vector<double>({0, 2, 0, 1}), 0.);
+    BOOST_CHECK_EQUAL(v2.nvals(), 2);
+    IndexArrayType i = {3, 1, 3};
+    std::vector<double> x = {1, 2, 3};
+    backend::DenseVector<double> v3(4);
+    v3.build(i.begin(), x.begin(), i.size(), Plus<double>());
+    BOOST_CHECK(v2 != v3);
+    v3.setElement(3, 1.0);
+    BOOST_CHECK(v2 == v3);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(dense_test_matrix_full_and_partial)
+{
+    backend::DenseMatrix<double> m1(mat, 0);
+    BOOST_CHECK_EQUAL(m1.nvals(), 8);
+    BOOST_CHECK(!m1.isFull());
+    for (IndexType i = 0; i < mat.size(); i++)
+    {
+        for (IndexType j = 0; j < mat[0].size(); j++)
+        {
+            BOOST_CHECK_EQUAL(m1.hasElement(i, j), (mat[i][j] != 0));
+            if (mat[i][j] != 0)
+            {
+                BOOST_CHECK_EQUAL(m1.extractElement(i, j), mat[i][j]);
+            }
+        }
+    }
+    BOOST_CHECK_EQUAL(m1.getRow(3).size(), 3);
+    BOOST_CHECK_EQUAL(m1.getCol(0).size(), 3);
+
+    backend::DenseMatrix<double> m2(full);
+    BOOST_CHECK(m2.isFull());
+    BOOST_CHECK(m2.getRow(1).full());
+    BOOST_CHECK_EQUAL(m2.extractElement(1, 2), 8.0);
+
+    // Removing elements brings the bitmap back, refilling drops it
+    m2.setRow(1, std::vector<std::tuple<IndexType, double> >(
+                  {std::make_tuple(0, 7.0)}));
+    BOOST_CHECK_EQUAL(m2.nvals(), 13);
+    BOOST_CHECK(!m2.hasElement(1, 1));
+    BOOST_CHECK_EQUAL(m2.getRow(1).size(), 1);
+    m2.setCol(1, std::vector<std::tuple<IndexType, double> >(
+                  {std::make_tuple(0, 1.0), std::make_tuple(1, 3.0),
+                   std::make_tuple(2, 2.0), std::make_tuple(3, 5.0)}));
+    m2.setElement(1, 2, 8.0);
+    m2.setElement(1, 3, 1.0);
+    BOOST_CHECK(m2.isFull());
+    BOOST_CHECK(m2 == backend::DenseMatrix<double>(full));
+
+    // build combines with the stored values
+    IndexArrayType i = {1, 1, 3};
+    IndexArrayType j = {1, 1, 0};
+    std::vector<double> v = {1, 2, 3};
+    m1.build(i.begin(), j.begin(), v.begin(), i.size(), Plus<double>());
+    BOOST_CHECK_EQUAL(m1.nvals(), 9);
+    BOOST_CHECK_EQUAL(m1.extractElement(1, 1), 3.0);
+    BOOST_CHECK_EQUAL(m1.extractElement(3, 0), 5.0);
+
+    m1.clear();
+    BOOST_CHECK_EQUAL(m1.nvals(), 0);
+    BOOST_CHECK(m1.getRow(0).empty());
+}
+
+//****************************************************************************
+// Same results as the default storage, for full and partial operands
+BOOST_AUTO_TEST_CASE(dense_test_operations_match_sparse)
+{
+    Matrix<double> A(mat, 0.), F(full, 0.);
+    Matrix<double, DenseTag> DA(mat, 0.), DF(full);
+
+    Vector<double> u(std::vector<double>({1, 2, 3, 4}));
+    Vector<double> s(std::vector<double>({0, 2, 0, 4}), 0.);
+    Vector<double, DenseTag> du(std::vector<double>({1, 2, 3, 4}));
+    Vector<double, DenseTag> ds(std::vector<double>({0, 2, 0, 4}), 0.);
+
+    // mxv and vxm (dot products with full and partial dense operands)
+    Vector<double> w(4), ans(4);
+    Vector<double, DenseTag> dw(4);
+    mxv(ans, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), F, u);
+    mxv(dw, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), DF, du);
+    BOOST_CHECK(same_elements(dw, ans));
+    BOOST_CHECK(dw.nvals() == 4);
+
+    mxv(ans, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, s);
+    mxv(dw, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), DA, ds);
+    BOOST_CHECK(same_elements(dw, ans));
+    mxv(dw, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), DF, s);
+    mxv(ans, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), F, s);
+    BOOST_CHECK(same_elements(dw, ans));
+
+    vxm(ans, s, NoAccumulate(), ArithmeticSemiring<double>(), u, A);
+    vxm(dw, ds, NoAccumulate(), ArithmeticSemiring<double>(), du, DA);
+    BOOST_CHECK(same_elements(dw, ans));
+
+    // element-wise operations
+    eWiseAdd(ans, NoMask(), NoAccumulate(), Minus<double>(), u, s);
+    eWiseAdd(dw, NoMask(), NoAccumulate(), Minus<double>(), du, ds);
+    BOOST_CHECK(same_elements(dw, ans));
+    eWiseMult(ans, NoMask(), NoAccumulate(), Times<double>(), u, s);
+    eWiseMult(dw, NoMask(), NoAccumulate(), Times<double>(), du, ds);
+    BOOST_CHECK(same_elements(dw, ans));
+    eWiseMult(dw, NoMask(), NoAccumulate(), Times<double>(), du, du);
+    BOOST_CHECK_EQUAL(dw.nvals(), 4);
+    BOOST_CHECK_EQUAL(dw.extractElement(3), 16.0);
+
+    // extract and reduce
+    IndexArrayType idx = {3, 0, 1};
+    Vector<double> e(3);
+    Vector<double, DenseTag> de(3);
+    extract(e, NoMask(), NoAccumulate(), s, idx);
+    extract(de, NoMask(), NoAccumulate(), ds, idx);
+    BOOST_CHECK(same_elements(de, e));
+
+    Matrix<double> C(4, 4);
+    Matrix<double, DenseTag> DC(4, 4);
+    mxm(C, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        A, transpose(F));
+    mxm(DC, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        DA, transpose(DF));
+    double sum(0.), dsum(0.);
+    reduce(sum, NoAccumulate(), PlusMonoid<double>(), C);
+    reduce(dsum, NoAccumulate(), PlusMonoid<double>(), DC);
+    BOOST_CHECK_EQUAL(sum, dsum);
+    BOOST_CHECK_EQUAL(C.nvals(), DC.nvals());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(dense_test_ewise_word_kernels)
+{
+    // Three bitmap words, the last one partly used
+    IndexType const N(150);
+    std::vector<double> full_vals(N), part_vals(N), other_vals(N);
+    for (IndexType ix = 0; ix < N; ++ix)
+    {
+        full_vals[ix]  = 1.0 + ix;
+        part_vals[ix]  = (ix % 3 == 0) ? 0.0 : 2.0*ix;
+        other_vals[ix] = ((ix < 64) || (ix % 5 == 0)) ? 0.5 + ix : 0.0;
+    }
+
+    Vector<double> u(full_vals), s(part_vals, 0.), t(other_vals, 0.);
+    Vector<double, DenseTag> du(full_vals), ds(part_vals, 0.),
+        dt(other_vals, 0.);
+
+    Vector<double> ans(N);
+    Vector<double, DenseTag> dw(N);
+
+    // Safe (floating point) operators over full and partial operands
+    eWiseAdd(ans, NoMask(), NoAccumulate(), Minus<double>(), s, t);
+    eWiseAdd(dw, NoMask(), NoAccumulate(), Minus<double>(), ds, dt);
+    BOOST_CHECK(same_elements(dw, ans));
+    eWiseMult(ans, NoMask(), NoAccumulate(), Times<double>(), s, t);
+    eWiseMult(dw, NoMask(), NoAccumulate(), Times<double>(), ds, dt);
+    BOOST_CHECK(same_elements(dw, ans));
+    eWiseMult(ans, NoMask(), NoAccumulate(), PlusMonoid<double>(), u, t);
+    eWiseMult(dw, NoMask(), NoAccumulate(), PlusMonoid<double>(), du, dt);
+    BOOST_CHECK(same_elements(dw, ans));
+    eWiseAdd(ans, NoMask(), NoAccumulate(), Max<double>(), s, u);
+    eWiseAdd(dw, NoMask(), NoAccumulate(), Max<double>(), ds, du);
+    BOOST_CHECK(same_elements(dw, ans));
+    BOOST_CHECK_EQUAL(dw.nvals(), N);
+
+    // A full vector in the default storage is read as a dense operand
+    eWiseAdd(ans, NoMask(), NoAccumulate(), Plus<double>(), u, s);
+    eWiseAdd(dw, NoMask(), NoAccumulate(), Plus<double>(), u, ds);
+    BOOST_CHECK(same_elements(dw, ans));
+
+    // Other operators and domains go through the per index loop
+    Vector<int> ians(N);
+    Vector<int, DenseTag> diw(N);
+    eWiseAdd(ians, NoMask(), NoAccumulate(), Minus<int>(), s, t);
+    eWiseAdd(diw, NoMask(), NoAccumulate(), Minus<int>(), ds, dt);
+    BOOST_CHECK(same_elements(diw, ians));
+    eWiseMult(ians, NoMask(), NoAccumulate(), Div<double>(), t, s);
+    eWiseMult(diw, NoMask(), NoAccumulate(), Div<double>(), dt, ds);
+    BOOST_CHECK(same_elements(diw, ians));
+
+    apply(ans, NoMask(), NoAccumulate(), AdditiveInverse<double>(), t);
+    apply(dw, NoMask(), NoAccumulate(), AdditiveInverse<double>(), dt);
+    BOOST_CHECK(same_elements(dw, ans));
+    apply(ans, NoMask(), NoAccumulate(), AdditiveInverse<double>(), u);
+    apply(dw, NoMask(), NoAccumulate(), AdditiveInverse<double>(), du);
+    BOOST_CHECK(same_elements(dw, ans));
+    BOOST_CHECK_EQUAL(dw.nvals(), N);
+
+    // The output may be one of the operands
+    Vector<double> a(s);
+    Vector<double, DenseTag> da(ds);
+    eWiseAdd(a, NoMask(), NoAccumulate(), Plus<double>(), a, t);
+    eWiseAdd(da, NoMask(), NoAccumulate(), Plus<double>(), da, dt);
+    BOOST_CHECK(same_elements(da, a));
+    eWiseMult(a, NoMask(), NoAccumulate(), Times<double>(), a, a);
+    eWiseMult(da, NoMask(), NoAccumulate(), Times<double>(), da, da);
+    BOOST_CHECK(same_elements(da, a));
+    apply(a, NoMask(), NoAccumulate(), AdditiveInverse<double>(), a);
+    apply(da, NoMask(), NoAccumulate(), AdditiveInverse<double>(), da);
+    BOOST_CHECK(same_elements(da, a));
+
+    // A mask or an accumulator uses the general kernels
+    eWiseAdd(a, s, Plus<double>(), Plus<double>(), u, t);
+    eWiseAdd(da, ds, Plus<double>(), Plus<double>(), du, dt);
+    BOOST_CHECK(same_elements(da, a));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
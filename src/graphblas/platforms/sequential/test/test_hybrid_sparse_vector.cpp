@@ -0,0 +1,258 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE hybrid_sparse_vector_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_construction_basic)
+{
+    GraphBLAS::IndexType M = 7;
+    GraphBLAS::backend::HybridSparseVector<double> v1(M);
+
+    BOOST_CHECK_EQUAL(v1.size(), M);
+    BOOST_CHECK_EQUAL(v1.nvals(), 0);
+    BOOST_CHECK(!v1.isBitmap());
+    BOOST_CHECK_THROW(v1.extractElement(0), NoValueException);
+    BOOST_CHECK_THROW(v1.extractElement(M-1), NoValueException);
+    BOOST_CHECK_THROW(v1.extractElement(M), IndexOutOfBoundsException);
+
+    BOOST_CHECK_THROW(GraphBLAS::backend::HybridSparseVector<double>(0),
+                      InvalidValueException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_construction_from_dense)
+{
+    std::vector<double> vec = {6, 0, 0, 4, 7, 0, 9, 4};
+
+    GraphBLAS::backend::HybridSparseVector<double> v1(vec);
+    BOOST_CHECK_EQUAL(v1.nvals(), vec.size());
+    BOOST_CHECK(v1.isBitmap());
+
+    GraphBLAS::backend::HybridSparseVector<double> v2(vec, 0);
+    BOOST_CHECK_EQUAL(v2.nvals(), 5);
+    BOOST_CHECK_EQUAL(v2.extractElement(6), 9.0);
+    BOOST_CHECK_THROW(v2.extractElement(1), NoValueException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_switch_list_to_bitmap_and_back)
+{
+    GraphBLAS::IndexType M = 1000;
+    GraphBLAS::backend::HybridSparseVector<double> v1(M);
+
+    // In order: appended to the list
+    for (GraphBLAS::IndexType idx = 0; idx < M/8; ++idx)
+    {
+        v1.setElement(idx, idx);
+    }
+    BOOST_CHECK(!v1.isBitmap());
+    BOOST_CHECK_EQUAL(v1.nvals(), M/8);
+
+    // One more than 1/8 of the elements
+    v1.setElement(M - 1, 1.0);
+    BOOST_CHECK(v1.isBitmap());
+    BOOST_CHECK_EQUAL(v1.nvals(), M/8 + 1);
+    BOOST_CHECK_EQUAL(v1.extractElement(3), 3.0);
+    BOOST_CHECK_EQUAL(v1.extractElement(M - 1), 1.0);
+
+    // Above 1/32 of the elements stays a bitmap
+    std::vector<std::tuple<GraphBLAS::IndexType, double> > contents;
+    for (GraphBLAS::IndexType idx = 0; idx < M/16; ++idx)
+    {
+        contents.push_back(std::make_tuple(2*idx, 2.0));
+    }
+    v1.setContents(contents);
+    BOOST_CHECK(v1.isBitmap());
+    BOOST_CHECK_EQUAL(v1.nvals(), M/16);
+
+    // Below 1/32 goes back to a list
+    contents.resize(M/64);
+    v1.setContents(contents);
+    BOOST_CHECK(!v1.isBitmap());
+    BOOST_CHECK_EQUAL(v1.nvals(), M/64);
+    BOOST_CHECK(v1.hasElement(2));
+    BOOST_CHECK(!v1.hasElement(3));
+
+    v1.clear();
+    BOOST_CHECK(!v1.isBitmap());
+    BOOST_CHECK_EQUAL(v1.nvals(), 0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_out_of_order_set_element)
+{
+    GraphBLAS::IndexType M = 1000;
+    GraphBLAS::backend::HybridSparseVector<double> v1(M);
+
+    // Inserting at the front shifts the whole list each time; the vector
+    // becomes a bitmap once that costs more than a bitmap would.
+    GraphBLAS::IndexType idx(M);
+    while (!v1.isBitmap())
+    {
+        --idx;
+        v1.setElement(idx, idx);
+    }
+    BOOST_CHECK(v1.nvals() <= M/8);
+    BOOST_CHECK_EQUAL(v1.nvals(), M - idx);
+    for (GraphBLAS::IndexType ix = idx; ix < M; ++ix)
+    {
+        BOOST_CHECK_EQUAL(v1.extractElement(ix), ix);
+    }
+
+    // Overwrite does not add a value
+    v1.setElement(M - 1, 7.0);
+    BOOST_CHECK_EQUAL(v1.nvals(), M - idx);
+    BOOST_CHECK_EQUAL(v1.extractElement(M - 1), 7.0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_build_dup)
+{
+    std::vector<IndexType> indices = {700, 3, 700, 40};
+    std::vector<double>    values  = {1, 2, 3, 4};
+
+    GraphBLAS::backend::HybridSparseVector<double> v1(1000);
+    v1.build(indices.begin(), values.begin(), indices.size(),
+             GraphBLAS::Plus<double>());
+    BOOST_CHECK(!v1.isBitmap());
+    BOOST_CHECK_EQUAL(v1.nvals(), 3);
+    BOOST_CHECK_EQUAL(v1.extractElement(700), 4.0);
+
+    IndexArrayType      out_idx(3);
+    std::vector<double> out_vals(3);
+    v1.extractTuples(out_idx, out_vals);
+    BOOST_CHECK_EQUAL(out_idx[0], 3);
+    BOOST_CHECK_EQUAL(out_idx[1], 40);
+    BOOST_CHECK_EQUAL(out_idx[2], 700);
+    BOOST_CHECK_EQUAL(out_vals[2], 4.0);
+
+    std::vector<IndexType> bad = {1000};
+    BOOST_CHECK_THROW(v1.build(bad.begin(), values.begin(), 1),
+                      IndexOutOfBoundsException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_equality_across_forms)
+{
+    GraphBLAS::IndexType M = 1000;
+    std::vector<IndexType> indices = {1, 5, 999};
+    std::vector<double>    values  = {1, 5, 9};
+
+    // List form
+    GraphBLAS::backend::HybridSparseVector<double> v1(M, indices, values);
+    BOOST_CHECK(!v1.isBitmap());
+
+    // Bitmap form with the same contents
+    std::vector<std::tuple<GraphBLAS::IndexType, double> > contents;
+    for (GraphBLAS::IndexType idx = 0; idx < M/2; ++idx)
+    {
+        contents.push_back(std::make_tuple(idx, 1.0));
+    }
+    GraphBLAS::backend::HybridSparseVector<double> v2(M);
+    v2.setContents(contents);
+    BOOST_CHECK(v2.isBitmap());
+    BOOST_CHECK(v1 != v2);
+
+    contents.clear();
+    for (IndexType ix = 0; ix < indices.size(); ++ix)
+    {
+        contents.push_back(std::make_tuple(indices[ix], values[ix]));
+    }
+    v2.setContents(contents);
+    BOOST_CHECK(!v2.isBitmap());
+    BOOST_CHECK_EQUAL(v1, v2);
+
+    std::vector<double> dense(M, 0.);
+    dense[1] = 1; dense[5] = 5; dense[999] = 9;
+    GraphBLAS::backend::HybridSparseVector<double> v3(M);
+    v3 = dense;
+    BOOST_CHECK(v3.isBitmap());
+    BOOST_CHECK(v1 != v3);
+    v3.setContents(contents);
+    BOOST_CHECK_EQUAL(v1, v3);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_operations_on_list_form)
+{
+    // A path graph: vertex i is connected to i + 1
+    GraphBLAS::IndexType N = 1000;
+    IndexArrayType i, j;
+    std::vector<double> v;
+    for (GraphBLAS::IndexType idx = 0; idx + 1 < N; ++idx)
+    {
+        i.push_back(idx); j.push_back(idx + 1); v.push_back(idx);
+    }
+    GraphBLAS::Matrix<double> A(N, N);
+    A.build(i, j, v);
+
+    GraphBLAS::Vector<double> u(N);
+    u.setElement(500, 2.0);
+
+    // push
+    GraphBLAS::Vector<double> w(N);
+    GraphBLAS::vxm(w, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(), u, A);
+    BOOST_CHECK_EQUAL(w.nvals(), 1);
+    BOOST_CHECK_EQUAL(w.extractElement(501), 1000.0);
+
+    // pull (merge with the list)
+    GraphBLAS::Vector<bool> mask(N);
+    mask.setElement(499, true);
+    GraphBLAS::mxv(w, mask, GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(), A, u, true);
+    BOOST_CHECK_EQUAL(w.nvals(), 1);
+    BOOST_CHECK_EQUAL(w.extractElement(499), 998.0);
+
+    IndexArrayType indices = {500, 7, 500};
+    GraphBLAS::Vector<double> e(3);
+    GraphBLAS::extract(e, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                       u, indices);
+    BOOST_CHECK_EQUAL(e.nvals(), 2);
+    BOOST_CHECK_EQUAL(e.extractElement(2), 2.0);
+
+    double sum(0.);
+    GraphBLAS::reduce(sum, GraphBLAS::NoAccumulate(),
+                      GraphBLAS::PlusMonoid<double>(), w);
+    BOOST_CHECK_EQUAL(sum, 998.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
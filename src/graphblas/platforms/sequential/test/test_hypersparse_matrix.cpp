@@ -0,0 +1,376 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE hypersparse_matrix_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    // A vertex ID space that could not be allocated row by row
+    IndexType const HUGE_DIM = IndexType(1) << 40;
+
+    std::vector<std::vector<double>> const mat = {{6, 0, 0, 4},
+                                                  {7, 0, 0, 0},
+                                                  {0, 0, 9, 4},
+                                                  {2, 5, 0, 3},
+                                                  {2, 0, 0, 1},
+                                                  {0, 0, 0, 0},
+                                                  {0, 1, 0, 2}};
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(hypersparse_test_construction_basic)
+{
+    backend::HypersparseMatrix<double> m1(HUGE_DIM, HUGE_DIM);
+
+    BOOST_CHECK_EQUAL(m1.nrows(), HUGE_DIM);
+    BOOST_CHECK_EQUAL(m1.ncols(), HUGE_DIM);
+    BOOST_CHECK_EQUAL(m1.nvals(), 0);
+    BOOST_CHECK(m1.nonEmptyRows().empty());
+    BOOST_CHECK(m1.getRow(HUGE_DIM - 1).empty());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(hypersparse_test_construction_dense_zero)
+{
+    backend::HypersparseMatrix<double> m1(mat, 0);
+
+    BOOST_CHECK_EQUAL(m1.nrows(), mat.size());
+    BOOST_CHECK_EQUAL(m1.ncols(), mat[0].size());
+    BOOST_CHECK_EQUAL(m1.nvals(), 12);
+    BOOST_CHECK_EQUAL(m1.nonEmptyRows().size(), 6);
+    for (IndexType i = 0; i < mat.size(); i++)
+    {
+        for (IndexType j = 0; j < mat[0].size(); j++)
+        {
+            if (mat[i][j] != 0)
+            {
+                BOOST_CHECK_EQUAL(m1.extractElement(i, j), mat[i][j]);
+            }
+            else
+            {
+                BOOST_CHECK(!m1.hasElement(i, j));
+            }
+        }
+    }
+    BOOST_CHECK_THROW(m1.extractElement(5, 0), NoValueException);
+    BOOST_CHECK_THROW(m1.extractElement(7, 0), IndexOutOfBoundsException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(hypersparse_test_build_dup)
+{
+    IndexArrayType i = {HUGE_DIM - 1, 3, HUGE_DIM - 1, 3, 0};
+    IndexArrayType j = {7, HUGE_DIM - 2, 7, 1, 0};
+    std::vector<double> v = {1, 2, 3, 4, 5};
+
+    backend::HypersparseMatrix<double> m1(HUGE_DIM, HUGE_DIM);
+    m1.build(i.begin(), j.begin(), v.begin(), i.size(),
+             GraphBLAS::Plus<double>());
+
+    BOOST_CHECK_EQUAL(m1.nvals(), 4);
+    BOOST_CHECK_EQUAL(m1.nonEmptyRows().size(), 3);
+    BOOST_CHECK_EQUAL(m1.extractElement(HUGE_DIM - 1, 7), 4.0);
+    BOOST_CHECK_EQUAL(m1.extractElement(3, 1), 4.0);
+    BOOST_CHECK_EQUAL(m1.extractElement(3, HUGE_DIM - 2), 2.0);
+
+    // A second build combines with the stored values
+    IndexArrayType i2 = {3};
+    IndexArrayType j2 = {1};
+    std::vector<double> v2 = {10};
+    m1.build(i2.begin(), j2.begin(), v2.begin(), i2.size(),
+             GraphBLAS::Plus<double>());
+    BOOST_CHECK_EQUAL(m1.nvals(), 4);
+    BOOST_CHECK_EQUAL(m1.extractElement(3, 1), 14.0);
+
+    IndexArrayType bad = {HUGE_DIM};
+    BOOST_CHECK_THROW(m1.build(bad.begin(), j2.begin(), v2.begin(), 1,
+                               GraphBLAS::Second<double>()),
+                      IndexOutOfBoundsException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(hypersparse_test_set_element_and_row)
+{
+    backend::HypersparseMatrix<double> m1(mat, 0);
+    backend::HypersparseMatrix<double> m2(mat.size(), mat[0].size());
+
+    // Out of order element and row updates
+    m2.setElement(6, 3, 2);
+    m2.setElement(0, 0, 6);
+    m2.setElement(6, 1, 1);
+    m2.setElement(2, 2, 9);
+    m2.setRow(3, std::vector<std::tuple<IndexType, double> >(
+                  {std::make_tuple(0, 2.), std::make_tuple(1, 5.),
+                   std::make_tuple(3, 3.)}));
+    m2.setElement(0, 3, 4);
+    m2.setRow(1, std::vector<std::tuple<IndexType, double> >(
+                  {std::make_tuple(0, 7.)}));
+    m2.setElement(2, 3, 4);
+    m2.setElement(4, 0, 2);
+    m2.setElement(4, 3, 1);
+    BOOST_CHECK_EQUAL(m1, m2);
+
+    // An emptied row is no longer listed
+    m2.setRow(3, std::vector<std::tuple<IndexType, double> >());
+    BOOST_CHECK_EQUAL(m2.nonEmptyRows().size(), 5);
+    BOOST_CHECK_EQUAL(m2.nvals(), 9);
+    BOOST_CHECK(m2.getRow(3).empty());
+    BOOST_CHECK_EQUAL(m2.extractElement(4, 3), 1.0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(hypersparse_test_get_set_col)
+{
+    backend::HypersparseMatrix<double> m1(mat, 0);
+
+    auto col3(m1.getCol(3));
+    BOOST_CHECK_EQUAL(col3.size(), 5);
+    BOOST_CHECK_EQUAL(std::get<0>(col3[1]), 2);
+
+    // Replace column 0: remove it from rows 0, 3 and 4; add to row 5
+    m1.setCol(0, std::vector<std::tuple<IndexType, double> >(
+                  {std::make_tuple(1, 8.), std::make_tuple(5, 3.)}));
+
+    std::vector<std::vector<double>> ans = {{0, 0, 0, 4},
+                                            {8, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {0, 5, 0, 3},
+                                            {0, 0, 0, 1},
+                                            {3, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+    BOOST_CHECK_EQUAL(m1, backend::HypersparseMatrix<double>(ans, 0));
+
+    // Removing the only value of a row drops the row
+    m1.setCol(0, std::vector<std::tuple<IndexType, double> >());
+    BOOST_CHECK_EQUAL(m1.nonEmptyRows().size(), 5);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(hypersparse_test_extract_tuples)
+{
+    backend::HypersparseMatrix<double> m1(mat, 0);
+
+    IndexArrayType i(m1.nvals()), j(m1.nvals());
+    std::vector<double> v(m1.nvals());
+    m1.extractTuples(i.begin(), j.begin(), v.begin());
+
+    backend::HypersparseMatrix<double> m2(mat.size(), mat[0].size());
+    m2.build(i.begin(), j.begin(), v.begin(), i.size(),
+             GraphBLAS::Second<double>());
+    BOOST_CHECK_EQUAL(m1, m2);
+}
+
+//****************************************************************************
+// Operations on a huge ID space touch only the stored rows
+BOOST_AUTO_TEST_CASE(hypersparse_test_operations_huge_dim)
+{
+    typedef Matrix<double, HypersparseStorageTag> HyperMatrix;
+
+    IndexType a = 12345678901ULL, b = HUGE_DIM - 17, c = 42;
+    IndexArrayType i = {a, b, c};
+    IndexArrayType j = {b, c, a};
+    std::vector<double> v = {1, 2, 3};
+
+    // A 3-cycle a -> b -> c -> a
+    HyperMatrix A(HUGE_DIM, HUGE_DIM);
+    A.build(i, j, v);
+
+    // Two steps: a -> c, b -> a, c -> b
+    HyperMatrix A2(HUGE_DIM, HUGE_DIM);
+    mxm(A2, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, A);
+    BOOST_CHECK_EQUAL(A2.nvals(), 3);
+    BOOST_CHECK_EQUAL(A2.extractElement(a, c), 2.0);
+    BOOST_CHECK_EQUAL(A2.extractElement(b, a), 6.0);
+    BOOST_CHECK_EQUAL(A2.extractElement(c, b), 3.0);
+
+    // Masked and accumulated
+    HyperMatrix M(HUGE_DIM, HUGE_DIM);
+    M.setElement(a, c, 1);
+    mxm(A2, M, Plus<double>(), ArithmeticSemiring<double>(), A, A, true);
+    BOOST_CHECK_EQUAL(A2.nvals(), 1);
+    BOOST_CHECK_EQUAL(A2.extractElement(a, c), 4.0);
+
+    HyperMatrix AT(HUGE_DIM, HUGE_DIM);
+    transpose(AT, NoMask(), NoAccumulate(), A);
+    BOOST_CHECK_EQUAL(AT.nvals(), 3);
+    BOOST_CHECK_EQUAL(AT.extractElement(b, a), 1.0);
+
+    HyperMatrix S(HUGE_DIM, HUGE_DIM);
+    eWiseAdd(S, NoMask(), NoAccumulate(), Plus<double>(), A, AT);
+    BOOST_CHECK_EQUAL(S.nvals(), 6);
+    eWiseMult(S, NoMask(), NoAccumulate(), Times<double>(), A, A);
+    BOOST_CHECK_EQUAL(S.nvals(), 3);
+    BOOST_CHECK_EQUAL(S.extractElement(b, c), 4.0);
+
+    // Accumulate -A into S = A .* A
+    apply(S, NoMask(), Plus<double>(), AdditiveInverse<double>(), A);
+    BOOST_CHECK_EQUAL(S.extractElement(c, a), 6.0);
+
+    double sum(0.);
+    reduce(sum, NoAccumulate(), PlusMonoid<double>(), A);
+    BOOST_CHECK_EQUAL(sum, 6.0);
+
+    // Tall-skinny: an n x 1 batch
+    HyperMatrix x(HUGE_DIM, 1);
+    x.setElement(c, 0, 1.);
+    HyperMatrix y(HUGE_DIM, 1);
+    mxm(y, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, x);
+    BOOST_CHECK_EQUAL(y.nvals(), 1);
+    BOOST_CHECK_EQUAL(y.extractElement(b, 0), 2.0);
+}
+
+//****************************************************************************
+// Same results as the default storage on a small matrix
+BOOST_AUTO_TEST_CASE(hypersparse_test_operations_match_lil)
+{
+    Matrix<double> A(mat, 0.);
+    Matrix<double, HypersparseStorageTag> H(mat, 0.);
+
+    Matrix<double> AAT(7, 7);
+    mxm(AAT, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        A, transpose(A));
+    Matrix<double, HypersparseStorageTag> HHT(7, 7);
+    mxm(HHT, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        H, transpose(H));
+
+    IndexArrayType i(AAT.nvals()), j(AAT.nvals());
+    std::vector<double> v(AAT.nvals());
+    AAT.extractTuples(i, j, v);
+    Matrix<double, HypersparseStorageTag> ans(7, 7);
+    ans.build(i, j, v);
+    BOOST_CHECK_EQUAL(HHT, ans);
+
+    std::vector<double> u_dense = {1, 0, 2, 0};
+    Vector<double> u(u_dense, 0.);
+    Vector<double> Au(7), Hu(7);
+    mxv(Au, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, u);
+    mxv(Hu, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), H, u);
+    BOOST_CHECK_EQUAL(Hu, Au);
+
+    // One value of u in a long column favours push over pull
+    IndexType const N = 64;
+    IndexArrayType ri, ci;
+    std::vector<double> rv;
+    for (IndexType k = 0; k < N; ++k)
+    {
+        ri.push_back(k);
+        ci.push_back((k * 7) % N);
+        rv.push_back(k + 1.);
+    }
+    Matrix<double> B(N, N);
+    B.build(ri, ci, rv);
+    Matrix<double, HypersparseStorageTag> HB(N, N);
+    HB.build(ri, ci, rv);
+
+    Vector<double> u1(N);
+    u1.setElement(7, 2.);
+    Vector<bool> m(N);
+    for (IndexType k = 0; k < N; ++k)
+    {
+        if (k % 8 != 1)
+        {
+            m.setElement(k, true);
+        }
+    }
+
+    Vector<double> Bu1(N), HBu1(N);
+    mxv(Bu1, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), B, u1);
+    mxv(HBu1, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), HB, u1);
+    BOOST_CHECK_EQUAL(HBu1, Bu1);
+    BOOST_CHECK_EQUAL(HBu1.nvals(), 1);
+
+    // Row 1 holds the value in column 7 and is masked out
+    Vector<double> Bmu1(N), HBmu1(N);
+    mxv(Bmu1, m, NoAccumulate(), ArithmeticSemiring<double>(), B, u1);
+    mxv(HBmu1, m, NoAccumulate(), ArithmeticSemiring<double>(), HB, u1);
+    BOOST_CHECK_EQUAL(HBmu1, Bmu1);
+    BOOST_CHECK_EQUAL(HBmu1.nvals(), 0);
+
+    Vector<double> HBu(N);
+    u1.setElement(14, 3.);
+    mxv(HBu, m, NoAccumulate(), ArithmeticSemiring<double>(), HB, u1);
+    BOOST_CHECK_EQUAL(HBu.nvals(), 1);
+    BOOST_CHECK_EQUAL(HBu.extractElement(2), 9.);
+}
+
+//****************************************************************************
+// A masked write rebuilds the rows of a populated matrix in order
+BOOST_AUTO_TEST_CASE(hypersparse_test_masked_write_into_populated)
+{
+    std::vector<std::vector<double>> A_dense = {{1, 0, 2},
+                                                {0, 3, 0},
+                                                {4, 0, 5}};
+    std::vector<std::vector<double>> C_dense = {{7, 7, 0},
+                                                {0, 0, 0},
+                                                {7, 0, 7}};
+    std::vector<std::vector<bool>> M_dense = {{true,  false, true},
+                                              {false, true,  false},
+                                              {false, true,  false}};
+    std::vector<std::vector<double>> merge_dense = {{1, 7, 2},
+                                                    {0, 3, 0},
+                                                    {7, 0, 7}};
+    std::vector<std::vector<double>> replace_dense = {{1, 0, 2},
+                                                      {0, 3, 0},
+                                                      {0, 0, 0}};
+
+    Matrix<double, HypersparseStorageTag> A(A_dense, 0.);
+    Matrix<bool> M(M_dense, false);
+    Matrix<double, HypersparseStorageTag> merge_answer(merge_dense, 0.);
+    Matrix<double, HypersparseStorageTag> replace_answer(replace_dense, 0.);
+
+    Matrix<double, HypersparseStorageTag> C(C_dense, 0.);
+    assign(C, M, NoAccumulate(), A, AllIndices(), AllIndices());
+    BOOST_CHECK_EQUAL(C, merge_answer);
+
+    Matrix<double, HypersparseStorageTag> D(C_dense, 0.);
+    assign(D, M, NoAccumulate(), A, AllIndices(), AllIndices(), true);
+    BOOST_CHECK_EQUAL(D, replace_answer);
+
+    // Row 1 was added between the stored rows, and row 2 of D is gone
+    BOOST_CHECK_EQUAL(C.nvals(), 6);
+    C.setElement(1, 0, 8.);
+    BOOST_CHECK_EQUAL(C.extractElement(1, 1), 3.);
+    BOOST_CHECK_EQUAL(C.extractElement(2, 2), 7.);
+    D.setElement(2, 1, 6.);
+    BOOST_CHECK_EQUAL(D.nvals(), 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
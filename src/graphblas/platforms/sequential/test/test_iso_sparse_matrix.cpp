@@ -0,0 +1,226 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE iso_sparse_matrix_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    std::vector<std::vector<double>> const graph = {{0, 1, 1, 0},
+                                                    {1, 0, 0, 1},
+                                                    {0, 0, 0, 1},
+                                                    {1, 1, 0, 0}};
+
+    std::vector<std::vector<double>> const mat = {{6, 0, 0, 4},
+                                                  {7, 0, 0, 0},
+                                                  {0, 0, 9, 4},
+                                                  {2, 5, 0, 3}};
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(iso_test_construction_dense_zero)
+{
+    backend::IsoSparseMatrix<double> m1(graph, 0);
+
+    BOOST_CHECK_EQUAL(m1.nrows(), 4);
+    BOOST_CHECK_EQUAL(m1.ncols(), 4);
+    BOOST_CHECK_EQUAL(m1.nvals(), 7);
+    BOOST_CHECK(m1.isIso());
+    BOOST_CHECK_EQUAL(m1.isoValue(), 1.0);
+    for (IndexType i = 0; i < graph.size(); i++)
+    {
+        for (IndexType j = 0; j < graph[0].size(); j++)
+        {
+            if (graph[i][j] != 0)
+            {
+                BOOST_CHECK_EQUAL(m1.extractElement(i, j), graph[i][j]);
+            }
+            else
+            {
+                BOOST_CHECK(!m1.hasElement(i, j));
+            }
+        }
+    }
+
+    auto row(m1.getRow(1));
+    BOOST_CHECK_EQUAL(row.size(), 2);
+    BOOST_CHECK(row.values().iso());
+    double val(0);
+    BOOST_CHECK(backend::iso_value(row, val));
+    BOOST_CHECK_EQUAL(val, 1.0);
+
+    backend::IsoSparseMatrix<double> m2(mat, 0);
+    BOOST_CHECK(!m2.isIso());
+    BOOST_CHECK_EQUAL(m2.extractElement(2, 2), 9.0);
+    BOOST_CHECK(!backend::iso_value(m2.getRow(2), val));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(iso_test_writes_end_iso)
+{
+    backend::IsoSparseMatrix<double> m1(graph, 0);
+    backend::IsoSparseMatrix<double> m2(m1);
+
+    // Writing the shared value keeps the matrix iso
+    m1.setElement(2, 0, 1.0);
+    BOOST_CHECK(m1.isIso());
+    BOOST_CHECK_EQUAL(m1.nvals(), 8);
+    BOOST_CHECK(m1 != m2);
+
+    // A different value stores a value per element
+    m1.setElement(0, 1, 3.0);
+    BOOST_CHECK(!m1.isIso());
+    BOOST_CHECK_EQUAL(m1.extractElement(0, 1), 3.0);
+    BOOST_CHECK_EQUAL(m1.extractElement(0, 2), 1.0);
+    BOOST_CHECK_EQUAL(m1.extractElement(2, 0), 1.0);
+
+    m1.setElement(0, 1, 1.0);
+    m1.setRow(2, std::vector<std::tuple<IndexType, double> >(
+                  {std::make_tuple(3, 1.0)}));
+    BOOST_CHECK(m1 == m2);
+
+    // clear() starts over with no value
+    m1.clear();
+    BOOST_CHECK(m1.isIso());
+    m1.setElement(3, 3, 5.0);
+    BOOST_CHECK(m1.isIso());
+    BOOST_CHECK_EQUAL(m1.extractElement(3, 3), 5.0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(iso_test_build)
+{
+    IndexArrayType i = {3, 0, 3, 1};
+    IndexArrayType j = {1, 2, 1, 0};
+    std::vector<bool> v(i.size(), true);
+
+    backend::IsoSparseMatrix<bool> m1(4, 4);
+    m1.build(i.begin(), j.begin(), v.begin(), i.size(),
+             GraphBLAS::LogicalOr<bool>());
+    BOOST_CHECK_EQUAL(m1.nvals(), 3);
+    BOOST_CHECK(m1.isIso());
+    BOOST_CHECK_EQUAL(m1.extractElement(3, 1), true);
+
+    // Duplicates that combine to a different value end iso
+    std::vector<double> w(i.size(), 1.0);
+    backend::IsoSparseMatrix<double> m2(4, 4);
+    m2.build(i.begin(), j.begin(), w.begin(), i.size(),
+             GraphBLAS::Plus<double>());
+    BOOST_CHECK(!m2.isIso());
+    BOOST_CHECK_EQUAL(m2.extractElement(3, 1), 2.0);
+    BOOST_CHECK_EQUAL(m2.extractElement(1, 0), 1.0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(iso_test_setcol)
+{
+    backend::IsoSparseMatrix<double> m1(graph, 0);
+    m1.setCol(2, std::vector<std::tuple<IndexType, double> >(
+                  {std::make_tuple(1, 1.0), std::make_tuple(3, 1.0)}));
+    BOOST_CHECK(m1.isIso());
+    BOOST_CHECK_EQUAL(m1.nvals(), 8);
+    BOOST_CHECK(!m1.hasElement(0, 2));
+    BOOST_CHECK(m1.hasElement(3, 2));
+
+    m1.setCol(0, std::vector<std::tuple<IndexType, double> >(
+                  {std::make_tuple(2, 4.0)}));
+    BOOST_CHECK(!m1.isIso());
+    BOOST_CHECK_EQUAL(m1.nvals(), 7);
+    BOOST_CHECK_EQUAL(m1.extractElement(2, 0), 4.0);
+    BOOST_CHECK_EQUAL(m1.extractElement(3, 2), 1.0);
+}
+
+//****************************************************************************
+// Same results as the default storage, for iso and non-iso operands
+BOOST_AUTO_TEST_CASE(iso_test_operations_match_lil)
+{
+    Matrix<double> A(graph, 0.), W(mat, 0.);
+    Matrix<double, IsoValuedStorageTag> I(graph, 0.), IW(mat, 0.);
+
+    // dot products (masked), Gustavson and the transposed operand
+    Matrix<double> AAT(4, 4), AWT(4, 4);
+    mxm(AAT, A, NoAccumulate(), ArithmeticSemiring<double>(),
+        A, transpose(A));
+    mxm(AWT, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        W, A);
+    Matrix<double, IsoValuedStorageTag> IIT(4, 4), IWT(4, 4);
+    mxm(IIT, I, NoAccumulate(), ArithmeticSemiring<double>(),
+        I, transpose(I));
+    mxm(IWT, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        IW, I);
+
+    IndexArrayType i(AAT.nvals()), j(AAT.nvals());
+    std::vector<double> v(AAT.nvals());
+    AAT.extractTuples(i, j, v);
+    Matrix<double, IsoValuedStorageTag> ans(4, 4);
+    ans.build(i, j, v);
+    BOOST_CHECK_EQUAL(IIT, ans);
+
+    i.resize(AWT.nvals()); j.resize(AWT.nvals()); v.resize(AWT.nvals());
+    AWT.extractTuples(i, j, v);
+    ans.clear();
+    ans.build(i, j, v);
+    BOOST_CHECK_EQUAL(IWT, ans);
+
+    // BFS step
+    Vector<bool> frontier(4), next(4), ans_next(4);
+    frontier.setElement(0, true);
+    Matrix<bool> Ab(4, 4);
+    Matrix<bool, IsoValuedStorageTag> Ib(4, 4);
+    apply(Ab, NoMask(), NoAccumulate(), Identity<double, bool>(), A);
+    apply(Ib, NoMask(), NoAccumulate(), Identity<double, bool>(), I);
+    vxm(ans_next, NoMask(), NoAccumulate(), LogicalSemiring<bool>(),
+        frontier, Ab);
+    vxm(next, NoMask(), NoAccumulate(), LogicalSemiring<bool>(),
+        frontier, Ib);
+    BOOST_CHECK_EQUAL(next, ans_next);
+    BOOST_CHECK_EQUAL(next.nvals(), 2);
+
+    // A result of a logical operation stays iso
+    Matrix<bool, IsoValuedStorageTag> Ib2(4, 4);
+    mxm(Ib2, NoMask(), NoAccumulate(), LogicalSemiring<bool>(), Ib, Ib);
+    BOOST_CHECK_EQUAL(Ib2.nvals(), 11);
+
+    double sum(0.);
+    reduce(sum, NoAccumulate(), PlusMonoid<double>(), I);
+    BOOST_CHECK_EQUAL(sum, 7.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
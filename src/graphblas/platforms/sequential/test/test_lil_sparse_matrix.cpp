@@ -333,4 +333,39 @@ BOOST_AUTO_TEST_CASE(lil_test_get_set_row)
     }
 }
 
+//****************************************************************************
+// LIL move construction, move assignment and swap
+BOOST_AUTO_TEST_CASE(lil_test_move_and_swap)
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4}};
+    backend::LilSparseMatrix<double> answer(mat, 0);
+
+    backend::LilSparseMatrix<double> m1(mat, 0);
+    backend::LilSparseMatrix<double> m2(std::move(m1));
+    BOOST_CHECK_EQUAL(m2, answer);
+    BOOST_CHECK_EQUAL(m1.nrows(), 3);
+    BOOST_CHECK_EQUAL(m1.ncols(), 4);
+    BOOST_CHECK_EQUAL(m1.nvals(), 0);
+
+    // the moved-from matrix is still usable
+    m1.setElement(1, 1, 5.0);
+    BOOST_CHECK_EQUAL(m1.extractElement(1, 1), 5.0);
+
+    m1 = std::move(m2);
+    BOOST_CHECK_EQUAL(m1, answer);
+    BOOST_CHECK_EQUAL(m2.nvals(), 0);
+
+    backend::LilSparseMatrix<double> m3(2, 4);
+    BOOST_CHECK_THROW((m3 = std::move(m1)), DimensionException);
+
+    m3.setElement(0, 3, 1.0);
+    m3.swap(m1);
+    BOOST_CHECK_EQUAL(m3, answer);
+    BOOST_CHECK_EQUAL(m1.nrows(), 2);
+    BOOST_CHECK_EQUAL(m1.nvals(), 1);
+    BOOST_CHECK_EQUAL(m1.extractElement(0, 3), 1.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,176 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#include <iostream>
+#include <algorithm>
+#include <random>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE sparse_intersect_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    typedef std::vector<std::tuple<IndexType, double> > TupleRow;
+
+    // n sorted distinct indices below max_idx, with values idx + 0.5
+    void random_row(std::mt19937 &gen, IndexType n, IndexType max_idx,
+                    IndexArrayType &indices, std::vector<double> &vals)
+    {
+        std::uniform_int_distribution<IndexType> dist(0, max_idx - 1);
+        indices.clear();
+        while (indices.size() < n)
+        {
+            indices.push_back(dist(gen));
+            if (indices.size() == n)
+            {
+                std::sort(indices.begin(), indices.end());
+                indices.erase(std::unique(indices.begin(), indices.end()),
+                              indices.end());
+            }
+        }
+        vals.clear();
+        for (auto idx : indices)
+        {
+            vals.push_back(idx + 0.5);
+        }
+    }
+
+    TupleRow tuple_row(IndexArrayType const &indices,
+                       std::vector<double> const &vals)
+    {
+        TupleRow row;
+        for (IndexType ix = 0; ix < indices.size(); ++ix)
+        {
+            row.push_back(std::make_tuple(indices[ix], vals[ix]));
+        }
+        return row;
+    }
+
+    // The matched indices, in the order they are reported
+    template <typename Row1T, typename Row2T>
+    IndexArrayType intersect_indices(Row1T const &row1, Row2T const &row2)
+    {
+        IndexArrayType result;
+        backend::sparse_intersect(
+            row1, row2,
+            [&](IndexType pos1, IndexType pos2)
+            {
+                BOOST_REQUIRE_EQUAL(std::get<0>(row1[pos1]),
+                                    std::get<0>(row2[pos2]));
+                result.push_back(std::get<0>(row1[pos1]));
+            });
+        return result;
+    }
+}
+
+//****************************************************************************
+// Random rows of similar and of very different lengths (merge, blocks and
+// galloping) match std::set_intersection
+BOOST_AUTO_TEST_CASE(sparse_intersect_test_random)
+{
+    std::mt19937 gen(17);
+    IndexType const sizes[] = {0, 1, 3, 4, 7, 8, 9, 33, 100, 1000, 5000};
+
+    for (auto n1 : sizes)
+    {
+        for (auto n2 : sizes)
+        {
+            IndexArrayType i1, i2;
+            std::vector<double> v1, v2;
+            random_row(gen, n1, 6000, i1, v1);
+            random_row(gen, n2, 6000, i2, v2);
+
+            IndexArrayType answer;
+            std::set_intersection(i1.begin(), i1.end(),
+                                  i2.begin(), i2.end(),
+                                  std::back_inserter(answer));
+
+            backend::SparseView<double> s1(i1.data(), v1.data(), i1.size());
+            backend::SparseView<double> s2(i2.data(), v2.data(), i2.size());
+            TupleRow t1(tuple_row(i1, v1)), t2(tuple_row(i2, v2));
+
+            BOOST_CHECK(intersect_indices(s1, s2) == answer);
+            BOOST_CHECK(intersect_indices(t1, t2) == answer);
+            BOOST_CHECK(intersect_indices(s1, t2) == answer);
+            BOOST_CHECK(intersect_indices(t2, s1) == answer);
+        }
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(sparse_intersect_test_dot_and_ewise_and)
+{
+    IndexArrayType i1 = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 40};
+    std::vector<double> v1(i1.begin(), i1.end());
+    IndexArrayType i2 = {1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 40};
+    std::vector<double> v2(i2.size(), 2.0);
+
+    backend::SparseView<double> s1(i1.data(), v1.data(), i1.size());
+    backend::SparseView<double> s2(i2.data(), v2.data(), i2.size());
+    TupleRow t2(tuple_row(i2, v2));
+
+    double ans;
+    BOOST_CHECK(backend::dot(ans, s1, s2, ArithmeticSemiring<double>()));
+    BOOST_CHECK_EQUAL(ans, 2.0*(1 + 3 + 5 + 7 + 9 + 11 + 40));
+    BOOST_CHECK(backend::dot(ans, t2, s1, ArithmeticSemiring<double>()));
+    BOOST_CHECK_EQUAL(ans, 2.0*(1 + 3 + 5 + 7 + 9 + 11 + 40));
+
+    std::vector<std::tuple<IndexType, double> > w;
+    backend::ewise_and(w, s1, t2, Times<double>());
+    BOOST_CHECK_EQUAL(w.size(), 7);
+    BOOST_CHECK(w[6] == std::make_tuple(IndexType(40), 80.0));
+
+    // A short row against a long one
+    IndexArrayType i3 = {5, 2999};
+    std::vector<double> v3 = {1.0, 1.0};
+    IndexArrayType i4;
+    for (IndexType idx = 0; idx < 3000; ++idx)
+    {
+        i4.push_back(idx);
+    }
+    std::vector<double> v4(i4.size(), 3.0);
+    backend::SparseView<double> s3(i3.data(), v3.data(), i3.size());
+    backend::SparseView<double> s4(i4.data(), v4.data(), i4.size());
+    BOOST_CHECK(backend::dot(ans, s4, s3, ArithmeticSemiring<double>()));
+    BOOST_CHECK_EQUAL(ans, 6.0);
+
+    i3 = {3000, 4000};
+    BOOST_CHECK(!backend::dot(ans, s3, s4, ArithmeticSemiring<double>()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
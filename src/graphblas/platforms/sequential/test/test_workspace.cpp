@@ -0,0 +1,141 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE workspace_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(workspace_test_scratch_vector_reuse)
+{
+    double const *data(nullptr);
+    {
+        backend::ScratchVector<double> buf;
+        BOOST_CHECK(buf->empty());
+        buf->assign(1000, 1.0);
+        data = buf->data();
+    }
+
+    // The next lease on this thread gets the same (emptied) buffer back
+    {
+        backend::ScratchVector<double> buf;
+        BOOST_CHECK(buf->empty());
+        BOOST_CHECK_GE(buf->capacity(), 1000);
+        BOOST_CHECK_EQUAL(buf->data(), data);
+
+        // ...and a nested lease gets another one
+        backend::ScratchVector<double> other;
+        BOOST_CHECK(other->empty());
+        BOOST_CHECK(other->capacity() == 0 || other->data() != data);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(workspace_test_sparse_accumulator)
+{
+    ArithmeticSemiring<double> op;
+    std::vector<std::tuple<IndexType, double> > row;
+    {
+        backend::SparseAccumulator<double> spa(10);
+        BOOST_CHECK(spa.empty());
+        spa.accumulate(7, 1.0, op);
+        spa.accumulate(2, 3.0, op);
+        spa.accumulate(7, 4.0, op);
+        BOOST_CHECK(!spa.empty());
+
+        spa.gather(row);
+        BOOST_CHECK(spa.empty());
+        std::vector<std::tuple<IndexType, double> > answer =
+            {std::make_tuple(2, 3.0), std::make_tuple(7, 5.0)};
+        BOOST_CHECK_EQUAL(row.size(), 2);
+        BOOST_CHECK(row == answer);
+
+        // left set when the accumulator goes out of scope
+        spa.accumulate(9, 1.0, op);
+    }
+
+    // A pooled accumulator starts out empty, even if it grows
+    backend::SparseAccumulator<double> spa(20);
+    spa.accumulate(9, 2.0, op);
+    spa.accumulate(19, 1.0, op);
+    row.clear();
+    spa.gather(row);
+    std::vector<std::tuple<IndexType, double> > answer =
+        {std::make_tuple(9, 2.0), std::make_tuple(19, 1.0)};
+    BOOST_CHECK(row == answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(workspace_test_scratch_flags)
+{
+    {
+        backend::ScratchFlags flags(10);
+        BOOST_CHECK(flags.empty());
+        flags.set(3);
+        flags.set(8);
+        flags.set(3);
+        BOOST_CHECK(!flags.empty());
+        BOOST_CHECK(flags[3] && flags[8] && !flags[4]);
+
+        flags.reset();
+        BOOST_CHECK(flags.empty());
+        BOOST_CHECK(!flags[3] && !flags[8]);
+
+        flags.set_all();
+        BOOST_CHECK(!flags.empty());
+        BOOST_CHECK(flags[0] && flags[9]);
+        flags.reset();
+        BOOST_CHECK(!flags[0]);
+
+        // left set when the flags go out of scope
+        flags.set(5);
+    }
+
+    // Pooled flags start out clear, even if they grow
+    backend::ScratchFlags flags(20);
+    BOOST_CHECK(flags.empty());
+    for (IndexType idx = 0; idx < 20; ++idx)
+    {
+        BOOST_CHECK(!flags[idx]);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,318 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+/**
+ * Scratch space that the kernels reuse from one call to the next.
+ *
+ * Iterative algorithms call the same operations thousands of times, and
+ * each call used to allocate (and for the sparse accumulators, zero fill)
+ * its temporaries anew.  The buffers here are leased from a pool that
+ * belongs to the calling thread, so leasing needs no locking and a kernel
+ * running inside an OpenMP parallel region gets its own buffers.  A lease
+ * gives the buffer back when it goes out of scope.
+ *
+ * Buffers larger than GB_SCRATCH_MAX_BYTES are freed instead of pooled,
+ * and at most GB_SCRATCH_POOL_SIZE buffers of each type are kept per
+ * thread, which bounds the memory a thread holds on to between calls.
+ */
+
+#ifndef GB_SEQUENTIAL_WORKSPACE_HPP
+#define GB_SEQUENTIAL_WORKSPACE_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <graphblas/types.hpp>
+
+#ifndef GB_SCRATCH_MAX_BYTES
+#define GB_SCRATCH_MAX_BYTES (std::size_t(256) << 20)
+#endif
+
+#ifndef GB_SCRATCH_POOL_SIZE
+#define GB_SCRATCH_POOL_SIZE 8
+#endif
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //********************************************************************
+        /// The calling thread's pool of spare buffers of type BufferT.
+        template<typename BufferT>
+        inline std::vector<BufferT> &scratch_pool()
+        {
+            static thread_local std::vector<BufferT> pool;
+            return pool;
+        }
+
+        template<typename BufferT>
+        inline BufferT scratch_acquire()
+        {
+            std::vector<BufferT> &pool(scratch_pool<BufferT>());
+            if (pool.empty())
+            {
+                return BufferT();
+            }
+
+            BufferT buffer(std::move(pool.back()));
+            pool.pop_back();
+            return buffer;
+        }
+
+        template<typename BufferT>
+        inline void scratch_release(BufferT &buffer, std::size_t bytes)
+        {
+            std::vector<BufferT> &pool(scratch_pool<BufferT>());
+            if ((bytes <= GB_SCRATCH_MAX_BYTES) &&
+                (pool.size() < GB_SCRATCH_POOL_SIZE))
+            {
+                pool.push_back(std::move(buffer));
+            }
+        }
+
+        template<typename T>
+        inline std::size_t scratch_bytes(std::vector<T> const &vec)
+        {
+            return vec.capacity()*sizeof(T);
+        }
+
+        inline std::size_t scratch_bytes(std::vector<bool> const &vec)
+        {
+            return vec.capacity()/8;
+        }
+
+        //********************************************************************
+        /**
+         * @brief An empty std::vector<T> that keeps the capacity it had the
+         *        last time the calling thread used it.
+         */
+        template<typename T>
+        class ScratchVector
+        {
+        public:
+            ScratchVector()
+                : m_vec(scratch_acquire<std::vector<T> >())
+            {
+            }
+
+            ~ScratchVector()
+            {
+                m_vec.clear();
+                scratch_release(m_vec, scratch_bytes(m_vec));
+            }
+
+            std::vector<T>       &operator*()        { return m_vec; }
+            std::vector<T> const &operator*() const  { return m_vec; }
+            std::vector<T>       *operator->()       { return &m_vec; }
+            std::vector<T> const *operator->() const { return &m_vec; }
+
+        private:
+            ScratchVector(ScratchVector const &) = delete;
+            ScratchVector &operator=(ScratchVector const &) = delete;
+
+            std::vector<T> m_vec;
+        };
+
+        //********************************************************************
+        /**
+         * @brief A sparse accumulator (SPA) over the indices [0, n): a dense
+         *        array of values with a flag per index, and the list of the
+         *        indices that are set.
+         *
+         * The flags are cleared index by index as the values are gathered
+         * (and when the accumulator goes out of scope), so a pooled SPA is
+         * ready for the next lease without an O(n) fill.
+         */
+        template<typename ScalarT>
+        class SparseAccumulator
+        {
+        private:
+            typedef std::tuple<std::vector<ScalarT>,
+                               std::vector<bool> > ArraysType;
+
+        public:
+            explicit SparseAccumulator(IndexType n)
+                : m_arrays(scratch_acquire<ArraysType>()),
+                  m_vals(std::get<0>(m_arrays)),
+                  m_flags(std::get<1>(m_arrays))
+            {
+                if (m_flags.size() < n)
+                {
+                    m_vals.resize(n);
+                    m_flags.resize(n, false);
+                }
+            }
+
+            ~SparseAccumulator()
+            {
+                reset();
+                scratch_release(m_arrays, (scratch_bytes(m_vals) +
+                                           scratch_bytes(m_flags)));
+            }
+
+            /// Set the value at idx, or combine it with the one there
+            /// using the additive operation of the semiring.
+            template<typename SemiringT>
+            void accumulate(IndexType idx, ScalarT const &val,
+                            SemiringT const &op)
+            {
+                if (m_flags[idx])
+                {
+                    m_vals[idx] = op.add(m_vals[idx], val);
+                }
+                else
+                {
+                    m_flags[idx] = true;
+                    m_vals[idx] = val;
+                    m_indices->push_back(idx);
+                }
+            }
+
+            bool empty() const { return m_indices->empty(); }
+
+            /// Append the (index, value) pairs to row in increasing index
+            /// order and empty the accumulator.
+            template<typename OutScalarT>
+            void gather(std::vector<std::tuple<IndexType, OutScalarT> > &row)
+            {
+                std::sort(m_indices->begin(), m_indices->end());
+                for (auto idx : *m_indices)
+                {
+                    row.push_back(std::make_tuple(idx, m_vals[idx]));
+                    m_flags[idx] = false;
+                }
+                m_indices->clear();
+            }
+
+            /// Empty the accumulator without reading it.
+            void reset()
+            {
+                for (auto idx : *m_indices)
+                {
+                    m_flags[idx] = false;
+                }
+                m_indices->clear();
+            }
+
+        private:
+            SparseAccumulator(SparseAccumulator const &) = delete;
+            SparseAccumulator &operator=(SparseAccumulator const &) = delete;
+
+            ArraysType                 m_arrays;
+            std::vector<ScalarT>      &m_vals;
+            std::vector<bool>         &m_flags;
+            ScratchVector<IndexType>   m_indices;
+        };
+
+        //********************************************************************
+        /**
+         * @brief Flags over the indices [0, n) (e.g., the positions that
+         *        pass a mask), all clear when leased.
+         *
+         * As in the SparseAccumulator, the flags that were set are cleared
+         * index by index by reset() (and when they go out of scope), so a
+         * pooled set of flags needs no O(n) fill.  set_all() sets every
+         * flag without touching the array.
+         */
+        class ScratchFlags
+        {
+        private:
+            // A pool of its own: the flags are released at full size, not
+            // empty like the buffer of a ScratchVector<bool>.
+            typedef std::tuple<std::vector<bool> > ArraysType;
+
+        public:
+            explicit ScratchFlags(IndexType n)
+                : m_arrays(scratch_acquire<ArraysType>()),
+                  m_flags(std::get<0>(m_arrays)),
+                  m_all(false)
+            {
+                if (m_flags.size() < n)
+                {
+                    m_flags.resize(n, false);
+                }
+            }
+
+            ~ScratchFlags()
+            {
+                reset();
+                scratch_release(m_arrays, scratch_bytes(m_flags));
+            }
+
+            bool operator[](IndexType idx) const
+            {
+                return m_all || m_flags[idx];
+            }
+
+            void set(IndexType idx)
+            {
+                if (!m_flags[idx])
+                {
+                    m_flags[idx] = true;
+                    m_indices->push_back(idx);
+                }
+            }
+
+            void set_all() { m_all = true; }
+
+            bool empty() const { return !m_all && m_indices->empty(); }
+
+            /// Clear every flag.
+            void reset()
+            {
+                for (auto idx : *m_indices)
+                {
+                    m_flags[idx] = false;
+                }
+                m_indices->clear();
+                m_all = false;
+            }
+
+        private:
+            ScratchFlags(ScratchFlags const &) = delete;
+            ScratchFlags &operator=(ScratchFlags const &) = delete;
+
+            ArraysType                 m_arrays;
+            std::vector<bool>         &m_flags;
+            ScratchVector<IndexType>   m_indices;
+            bool                       m_all;
+        };
+
+    } // namespace backend
+} // namespace GraphBLAS
+
+#endif // GB_SEQUENTIAL_WORKSPACE_HPP
@@ -0,0 +1,239 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#define GRAPHBLAS_LOGGING_LEVEL 0
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <graphblas/graphblas.hpp>
+#include <graphblas/io/binary_format.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE binary_format_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    typedef Matrix<double, MappedCsrStorageTag> MappedMatrix;
+
+    static char const *MATRIX_FILE = "test_binary_format_matrix.gbm";
+    static char const *VECTOR_FILE = "test_binary_format_vector.gbv";
+
+    static std::vector<std::vector<double> > const mat = {{0, 1, 2, 0},
+                                                          {0, 0, 0, 0},
+                                                          {8, 0, 0, 9},
+                                                          {0, 5, 0, 0}};
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(binary_matrix_round_trip)
+{
+    Matrix<double> A(mat, 0.);
+    io::write_binary_matrix(MATRIX_FILE, A);
+
+    io::BinaryHeader header(io::read_binary_header(MATRIX_FILE));
+    BOOST_CHECK_EQUAL(header.nrows, 4);
+    BOOST_CHECK_EQUAL(header.ncols, 4);
+    BOOST_CHECK_EQUAL(header.nvals, 5);
+
+    Matrix<double> B(4, 4);
+    B.setElement(1, 1, 3.);
+    io::read_binary_matrix(MATRIX_FILE, B);
+    BOOST_CHECK_EQUAL(A, B);
+
+    Matrix<double, CsrStorageTag> C(4, 4);
+    io::read_binary_matrix(MATRIX_FILE, C);
+    BOOST_CHECK_EQUAL(C, (Matrix<double, CsrStorageTag>(mat, 0.)));
+
+    Matrix<double> D(3, 4);
+    BOOST_CHECK_THROW(io::read_binary_matrix(MATRIX_FILE, D),
+                      DimensionException);
+
+    Matrix<float> E(4, 4);
+    BOOST_CHECK_THROW(io::read_binary_matrix(MATRIX_FILE, E),
+                      InvalidValueException);
+
+    std::remove(MATRIX_FILE);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(binary_matrix_mapped)
+{
+    Matrix<double> A(mat, 0.);
+    io::write_binary_matrix(MATRIX_FILE, A);
+
+    MappedMatrix M(MATRIX_FILE);
+    MappedMatrix answer(mat, 0.);
+    BOOST_CHECK_EQUAL(M.nrows(), 4);
+    BOOST_CHECK_EQUAL(M.ncols(), 4);
+    BOOST_CHECK_EQUAL(M.nvals(), 5);
+    BOOST_CHECK_EQUAL(M.extractElement(2, 3), 9.);
+    BOOST_CHECK(!M.hasElement(1, 1));
+    BOOST_CHECK_THROW(M.extractElement(0, 0), NoValueException);
+    BOOST_CHECK_EQUAL(M, answer);
+
+    // Used as an operand in place
+    MappedMatrix P(4, 4);
+    mxm(P, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        M, transpose(M));
+    Matrix<double> PA(4, 4);
+    mxm(PA, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        A, transpose(A));
+    BOOST_CHECK_EQUAL(P.nvals(), PA.nvals());
+    BOOST_CHECK_EQUAL(P.extractElement(2, 2), PA.extractElement(2, 2));
+
+    // Copies share the mapping and the first write copies the storage
+    MappedMatrix M2(M);
+    M2.setElement(1, 1, 7.);
+    BOOST_CHECK_EQUAL(M2.nvals(), 6);
+    BOOST_CHECK_EQUAL(M2.extractElement(1, 1), 7.);
+    BOOST_CHECK_EQUAL(M.nvals(), 5);
+    BOOST_CHECK_EQUAL(M, answer);
+
+    // The file can be removed while it is mapped
+    std::remove(MATRIX_FILE);
+    BOOST_CHECK_EQUAL(M, answer);
+
+    M.clear();
+    BOOST_CHECK_EQUAL(M.nvals(), 0);
+    M.setElement(3, 3, 1.);
+    BOOST_CHECK_EQUAL(M.nvals(), 1);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(binary_bad_files)
+{
+    {
+        std::ofstream os(MATRIX_FILE);
+        os << "0 1 2.0\n1 2 3.0\n" << std::string(200, ' ');
+    }
+    BOOST_CHECK_THROW(MappedMatrix M(MATRIX_FILE),
+                      InvalidValueException);
+
+    {
+        std::ofstream os(MATRIX_FILE);
+    }
+    BOOST_CHECK_THROW(MappedMatrix M(MATRIX_FILE), InvalidValueException);
+
+    Vector<double> u(4);
+    u.setElement(2, 1.);
+    io::write_binary_vector(MATRIX_FILE, u);
+    BOOST_CHECK_THROW(MappedMatrix M(MATRIX_FILE),
+                      InvalidValueException);
+
+    std::remove(MATRIX_FILE);
+    BOOST_CHECK_THROW(MappedMatrix M(MATRIX_FILE),
+                      PanicException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(binary_truncated_and_corrupt_files)
+{
+    Matrix<double> A(mat, 0.);
+    io::write_binary_matrix(MATRIX_FILE, A);
+    std::string contents;
+    {
+        std::ifstream is(MATRIX_FILE, std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(is),
+                        std::istreambuf_iterator<char>());
+    }
+    io::BinaryHeader header(io::read_binary_header(MATRIX_FILE));
+    Matrix<double> B(4, 4);
+
+    auto write_contents = [](std::string const &bytes)
+    {
+        std::ofstream os(MATRIX_FILE, std::ios::binary);
+        os.write(bytes.data(), bytes.size());
+    };
+
+    // Truncated in the middle of the values
+    write_contents(contents.substr(0, contents.size() - 8));
+    BOOST_CHECK_THROW(io::read_binary_matrix(MATRIX_FILE, B),
+                      InvalidValueException);
+    BOOST_CHECK_THROW(MappedMatrix M(MATRIX_FILE), InvalidValueException);
+
+    // A header whose layout was computed with an overflowing nvals
+    std::string overflow(contents);
+    io::BinaryHeader huge(io::make_binary_header<double>(
+        io::BINARY_MATRIX, 4, 4, IndexType(1) << 61));
+    std::memcpy(&overflow[0], &huge, sizeof(huge));
+    write_contents(overflow);
+    BOOST_CHECK_THROW(io::read_binary_matrix(MATRIX_FILE, B),
+                      InvalidValueException);
+    BOOST_CHECK_THROW(MappedMatrix M(MATRIX_FILE), InvalidValueException);
+
+    // Row offsets that do not start at 0, end at nvals or increase
+    IndexType bad_row_ptrs[][5] = {{1, 2, 2, 4, 5},
+                                   {0, 2, 2, 4, 4},
+                                   {0, 3, 2, 4, 5}};
+    for (auto&& row_ptr : bad_row_ptrs)
+    {
+        std::string corrupt(contents);
+        std::memcpy(&corrupt[header.row_ptr_offset], row_ptr,
+                    sizeof(row_ptr));
+        write_contents(corrupt);
+        BOOST_CHECK_THROW(io::read_binary_matrix(MATRIX_FILE, B),
+                          InvalidValueException);
+    }
+
+    std::remove(MATRIX_FILE);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(binary_vector_round_trip)
+{
+    std::vector<double> vec = {0, 3, 0, 0, 4, 5};
+    Vector<double> u(vec, 0.);
+    io::write_binary_vector(VECTOR_FILE, u);
+
+    Vector<double> w(6);
+    io::read_binary_vector(VECTOR_FILE, w);
+    BOOST_CHECK_EQUAL(u, w);
+
+    Vector<double> x(5);
+    BOOST_CHECK_THROW(io::read_binary_vector(VECTOR_FILE, x),
+                      DimensionException);
+
+    std::vector<bool> bvec = {true, false, true, true};
+    Vector<bool> b(bvec, false);
+    io::write_binary_vector(VECTOR_FILE, b);
+    Vector<bool> c(4);
+    io::read_binary_vector(VECTOR_FILE, c);
+    BOOST_CHECK_EQUAL(b, c);
+
+    std::remove(VECTOR_FILE);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
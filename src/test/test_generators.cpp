@@ -0,0 +1,194 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#define GRAPHBLAS_LOGGING_LEVEL 0
+
+#include <iostream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <graphblas/graphblas.hpp>
+#include <graphblas/matrix_utils.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE generators_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_rmat_edges)
+{
+    IndexArrayType rows, cols;
+    std::vector<double> vals;
+    IndexType n(rmat_edges(10, 16, rows, cols, vals, 42));
+
+    BOOST_CHECK_EQUAL(n, 1024);
+    BOOST_CHECK_EQUAL(rows.size(), 16*1024);
+    BOOST_CHECK_EQUAL(cols.size(), 16*1024);
+    BOOST_CHECK_EQUAL(vals.size(), 16*1024);
+    BOOST_CHECK(*std::max_element(rows.begin(), rows.end()) < n);
+    BOOST_CHECK(*std::max_element(cols.begin(), cols.end()) < n);
+    BOOST_CHECK(std::all_of(vals.begin(), vals.end(),
+                            [](double v) { return v == 1.0; }));
+
+    // The degrees are skewed: the largest is far above the average of 16.
+    std::vector<IndexType> degree(n, 0);
+    for (auto i : rows) ++degree[i];
+    BOOST_CHECK(*std::max_element(degree.begin(), degree.end()) > 100);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_rmat_edges_reproducible)
+{
+    IndexArrayType rows1, cols1, rows2, cols2, rows3, cols3;
+    std::vector<int> vals1, vals2, vals3;
+
+    // Several blocks, so that the threads (if any) share the work.
+    rmat_edges(12, 40, rows1, cols1, vals1, 7);
+#ifdef _OPENMP
+    int threads(omp_get_max_threads());
+    omp_set_num_threads(1);
+#endif
+    rmat_edges(12, 40, rows2, cols2, vals2, 7);
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#endif
+    rmat_edges(12, 40, rows3, cols3, vals3, 8);
+
+    BOOST_CHECK(rows1 == rows2);
+    BOOST_CHECK(cols1 == cols2);
+    BOOST_CHECK(rows1 != rows3);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_rmat_edges_bad_parameters)
+{
+    IndexArrayType rows, cols;
+    std::vector<double> vals;
+    BOOST_CHECK_THROW(rmat_edges(4, 2, rows, cols, vals, 1, 0.5, 0.3, 0.3),
+                      InvalidValueException);
+    // edge_factor*2^scale overflows
+    BOOST_CHECK_THROW(rmat_edges(40, IndexType(1) << 30, rows, cols, vals, 1),
+                      InvalidValueException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_erdos_renyi_edges)
+{
+    IndexArrayType rows, cols;
+    std::vector<double> vals;
+    IndexType n(erdos_renyi_edges(2000, 0.01, rows, cols, vals, 3));
+
+    // Expect 2000*1999*0.01 = 39980 edges, standard deviation about 200.
+    BOOST_CHECK_EQUAL(n, 2000);
+    BOOST_CHECK(rows.size() > 38980);
+    BOOST_CHECK(rows.size() < 40980);
+    BOOST_CHECK_EQUAL(vals.size(), rows.size());
+    for (IndexType ix = 0; ix < rows.size(); ++ix)
+    {
+        BOOST_CHECK(rows[ix] != cols[ix]);
+        BOOST_CHECK(cols[ix] < n);
+    }
+
+    // No repeated edges
+    Matrix<double> A(erdos_renyi_graph<Matrix<double>>(2000, 0.01, 3));
+    BOOST_CHECK_EQUAL(A.nvals(), rows.size());
+
+    IndexArrayType rows2, cols2;
+    erdos_renyi_edges(2000, 0.01, rows2, cols2, vals, 3);
+    BOOST_CHECK(rows == rows2);
+    BOOST_CHECK(cols == cols2);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_erdos_renyi_edges_extremes)
+{
+    IndexArrayType rows, cols;
+    std::vector<double> vals;
+
+    erdos_renyi_edges(50, 0.0, rows, cols, vals, 3);
+    BOOST_CHECK_EQUAL(rows.size(), 0);
+
+    erdos_renyi_edges(50, 1.0, rows, cols, vals, 3);
+    BOOST_CHECK_EQUAL(rows.size(), 50*49);
+
+    BOOST_CHECK_THROW(erdos_renyi_edges(50, 1.5, rows, cols, vals, 3),
+                      InvalidValueException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_grid_2d_graph)
+{
+    // 0 - 1 - 2
+    // |   |   |
+    // 3 - 4 - 5
+    IndexArrayType i = {0, 0, 1, 1, 1, 2, 2, 3, 3, 4, 4, 4, 5, 5};
+    IndexArrayType j = {1, 3, 0, 2, 4, 1, 5, 0, 4, 1, 3, 5, 2, 4};
+    std::vector<unsigned int> v(i.size(), 1);
+    Matrix<unsigned int> answer(6, 6);
+    answer.build(i, j, v);
+
+    Matrix<unsigned int> A(grid_2d_graph<Matrix<unsigned int>>(2, 3));
+    BOOST_CHECK_EQUAL(A, answer);
+
+    IndexArrayType rows, cols;
+    std::vector<double> vals;
+    BOOST_CHECK_EQUAL(grid_2d_edges(1, 1, rows, cols, vals), 1);
+    BOOST_CHECK_EQUAL(rows.size(), 0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_power_law_edges)
+{
+    IndexArrayType rows, cols;
+    std::vector<double> vals;
+    IndexType n(power_law_edges(5000, 50000, 2.1, rows, cols, vals, 11));
+
+    BOOST_CHECK_EQUAL(n, 5000);
+    BOOST_CHECK_EQUAL(rows.size(), 50000);
+    BOOST_CHECK_EQUAL(vals.size(), 50000);
+
+    std::vector<IndexType> degree(n, 0);
+    for (auto i : rows) ++degree[i];
+    // A few hubs, while most vertices are below the average degree of 10.
+    std::sort(degree.begin(), degree.end());
+    BOOST_CHECK(degree.back() > 1000);
+    BOOST_CHECK(degree[n/2] < 10);
+
+    BOOST_CHECK_THROW(power_law_edges(10, 10, 1.0, rows, cols, vals, 1),
+                      InvalidValueException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -102,4 +102,41 @@ BOOST_AUTO_TEST_CASE(matrix_build_test_iterators)
     }
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_build_test_unsorted_duplicates)
+{
+    IndexArrayType i = {2, 0, 1, 2, 0, 1, 0, 2};
+    IndexArrayType j = {1, 3, 0, 1, 1, 0, 3, 0};
+    std::vector<double>       v = {9, 1, 4, 2, 5, 3, 7, 8};
+
+    std::vector<std::vector<double> > mat = {{0, 5, 0, 8},
+                                             {7, 0, 0, 0},
+                                             {8, 11, 0, 0}};
+
+    Matrix<double, DirectedMatrixTag> m1(3, 4);
+    m1.build(i, j, v, Plus<double>());
+    BOOST_CHECK_EQUAL(m1.nvals(), 5);
+
+    Matrix<double, DirectedMatrixTag> answer(mat, 0.);
+    BOOST_CHECK_EQUAL(m1, answer);
+
+    // Building into a matrix with stored values combines with them too
+    IndexArrayType i2 = {1, 2};
+    IndexArrayType j2 = {0, 3};
+    std::vector<double> v2 = {2, 1};
+    m1.build(i2, j2, v2, Plus<double>());
+
+    mat[1][0] = 9;
+    mat[2][3] = 1;
+    Matrix<double, DirectedMatrixTag> answer2(mat, 0.);
+    BOOST_CHECK_EQUAL(m1, answer2);
+
+    // Out of bounds index leaves the matrix alone
+    IndexArrayType i3 = {0, 3};
+    IndexArrayType j3 = {0, 0};
+    std::vector<double> v3 = {1, 1};
+    BOOST_CHECK_THROW(m1.build(i3, j3, v3), IndexOutOfBoundsException);
+    BOOST_CHECK_EQUAL(m1, answer2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
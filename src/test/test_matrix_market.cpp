@@ -0,0 +1,259 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#define GRAPHBLAS_LOGGING_LEVEL 0
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <graphblas/graphblas.hpp>
+#include <graphblas/io/matrix_market.hpp>
+#include <graphblas/io/edge_list.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE matrix_market_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    static char const *TEST_FILE = "test_matrix_market.mtx";
+
+    void write_file(std::string const &contents)
+    {
+        std::ofstream os(TEST_FILE);
+        os << contents;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(mm_coordinate_real_general)
+{
+    write_file("%%MatrixMarket matrix coordinate real general\n"
+               "% a comment\n"
+               "%\n"
+               "3 4 5\n"
+               "1 2 1.5\n"
+               "3 1 -2e1\n"
+               "1 4 .25\n"
+               "\n"
+               "2 2 3\r\n"
+               "3 4 0.1");
+
+    io::MatrixMarketHeader header(io::read_matrix_market_header(TEST_FILE));
+    BOOST_CHECK_EQUAL(header.nrows, 3);
+    BOOST_CHECK_EQUAL(header.ncols, 4);
+    BOOST_CHECK_EQUAL(header.nentries, 5);
+    BOOST_CHECK(header.coordinate);
+
+    std::vector<std::vector<double> > mat = {{0, 1.5, 0, 0.25},
+                                             {0, 3,   0, 0},
+                                             {-20, 0, 0, 0.1}};
+    Matrix<double> answer(mat, 0.);
+
+    Matrix<double> A(3, 4);
+    io::read_matrix_market(TEST_FILE, A);
+    BOOST_CHECK_EQUAL(A, answer);
+
+    Matrix<double> B(4, 3);
+    BOOST_CHECK_THROW(io::read_matrix_market(TEST_FILE, B), DimensionException);
+    std::remove(TEST_FILE);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(mm_coordinate_pattern_symmetric)
+{
+    write_file("%%MatrixMarket matrix coordinate pattern symmetric\n"
+               "3 3 3\n"
+               "2 1\n"
+               "3 3\n"
+               "3 1\n");
+
+    std::vector<std::vector<bool> > mat = {{false, true,  true},
+                                           {true,  false, false},
+                                           {true,  false, true}};
+    Matrix<bool> answer(mat, false);
+
+    Matrix<bool> A(3, 3);
+    io::read_matrix_market(TEST_FILE, A);
+    BOOST_CHECK_EQUAL(A, answer);
+    std::remove(TEST_FILE);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(mm_coordinate_integer_skew)
+{
+    write_file("%%MatrixMarket matrix coordinate integer skew-symmetric\n"
+               "2 2 1\n"
+               "2 1 7\n");
+
+    std::vector<std::vector<int> > mat = {{0, -7},
+                                          {7,  0}};
+    Matrix<int> answer(mat, 0);
+
+    Matrix<int> A(2, 2);
+    io::read_matrix_market(TEST_FILE, A);
+    BOOST_CHECK_EQUAL(A, answer);
+    std::remove(TEST_FILE);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(mm_array)
+{
+    write_file("%%MatrixMarket matrix array real general\n"
+               "2 3\n"
+               "1\n2\n3\n4\n5\n6\n");
+
+    std::vector<std::vector<double> > mat = {{1, 3, 5},
+                                             {2, 4, 6}};
+    Matrix<double> A(2, 3);
+    io::read_matrix_market(TEST_FILE, A);
+    BOOST_CHECK_EQUAL(A, Matrix<double>(mat));
+
+    write_file("%%MatrixMarket matrix array real symmetric\n"
+               "2 2\n"
+               "1\n2\n3\n");
+
+    std::vector<std::vector<double> > sym = {{1, 2},
+                                             {2, 3}};
+    Matrix<double> S(2, 2);
+    io::read_matrix_market(TEST_FILE, S);
+    BOOST_CHECK_EQUAL(S, Matrix<double>(sym));
+    std::remove(TEST_FILE);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(mm_bad_files)
+{
+    Matrix<double> A(2, 2);
+
+    write_file("%%MatrixMarket matrix coordinate complex general\n"
+               "2 2 1\n"
+               "1 1 1 0\n");
+    BOOST_CHECK_THROW(io::read_matrix_market(TEST_FILE, A),
+                      InvalidValueException);
+
+    write_file("%%MatrixMarket matrix coordinate real general\n"
+               "2 2 2\n"
+               "1 1 1\n");
+    BOOST_CHECK_THROW(io::read_matrix_market(TEST_FILE, A),
+                      InvalidValueException);
+
+    write_file("%%MatrixMarket matrix coordinate real general\n"
+               "2 2 1\n"
+               "3 1 1\n");
+    BOOST_CHECK_THROW(io::read_matrix_market(TEST_FILE, A),
+                      InvalidValueException);
+
+    write_file("1 2 3\n");
+    BOOST_CHECK_THROW(io::read_matrix_market(TEST_FILE, A),
+                      InvalidValueException);
+
+    write_file("%%MatrixMarket matrix coordinate real general\n"
+               "2 2 1\n"
+               "1 1 1 2\n");
+    BOOST_CHECK_THROW(io::read_matrix_market(TEST_FILE, A),
+                      InvalidValueException);
+
+    write_file("%%MatrixMarket matrix coordinate real skew-symmetric\n"
+               "2 2 1\n"
+               "1 1 3\n");
+    BOOST_CHECK_THROW(io::read_matrix_market(TEST_FILE, A),
+                      InvalidValueException);
+    std::remove(TEST_FILE);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(mm_many_lines)
+{
+    // Enough lines to be split into several chunks
+    std::string contents("%%MatrixMarket matrix coordinate integer general\n"
+                         "1000 1000 1000\n");
+    for (IndexType idx = 0; idx < 1000; ++idx)
+    {
+        contents += std::to_string(idx + 1) + " " +
+            std::to_string((idx*7) % 1000 + 1) + " " +
+            std::to_string(idx) + "\n";
+    }
+    write_file(contents);
+
+    Matrix<int64_t> A(1000, 1000);
+    io::read_matrix_market(TEST_FILE, A);
+    BOOST_CHECK_EQUAL(A.nvals(), 1000);
+    for (IndexType idx = 0; idx < 1000; ++idx)
+    {
+        BOOST_CHECK_EQUAL(A.extractElement(idx, (idx*7) % 1000), idx);
+    }
+    std::remove(TEST_FILE);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(edge_list)
+{
+    write_file("# comment\n"
+               "0\t1\n"
+               "1\t2\r\n"
+               "\n"
+               "3 0\n");
+
+    IndexArrayType rows, cols;
+    std::vector<int> vals;
+    IndexType num_vertices(io::read_edge_list(TEST_FILE, rows, cols, vals));
+    BOOST_CHECK_EQUAL(num_vertices, 4);
+    IndexArrayType answer_rows = {0, 1, 3};
+    IndexArrayType answer_cols = {1, 2, 0};
+    BOOST_CHECK_EQUAL_COLLECTIONS(rows.begin(), rows.end(),
+                                  answer_rows.begin(), answer_rows.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(cols.begin(), cols.end(),
+                                  answer_cols.begin(), answer_cols.end());
+    BOOST_CHECK_EQUAL(vals.size(), 3);
+    BOOST_CHECK_EQUAL(vals[2], 1);
+
+    write_file("0 1 2.5\n"
+               "2 0 -1\n");
+    Matrix<double> A(3, 3);
+    BOOST_CHECK_EQUAL(io::read_edge_list(TEST_FILE, A), 3);
+    BOOST_CHECK_EQUAL(A.nvals(), 2);
+    BOOST_CHECK_EQUAL(A.extractElement(0, 1), 2.5);
+    BOOST_CHECK_EQUAL(A.extractElement(2, 0), -1);
+
+    write_file("0 x\n");
+    BOOST_CHECK_THROW(io::read_edge_list(TEST_FILE, A), InvalidValueException);
+
+    write_file("0 1 2.5 7\n");
+    BOOST_CHECK_THROW(io::read_edge_list(TEST_FILE, A), InvalidValueException);
+    std::remove(TEST_FILE);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
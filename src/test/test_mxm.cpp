@@ -512,6 +512,145 @@ BOOST_AUTO_TEST_CASE(test_mxm_reg_sparse)
     }
 }
 
+//****************************************************************************
+// Very sparse operands (few multiplies per output position)
+BOOST_AUTO_TEST_CASE(test_mxm_reg_very_sparse)
+{
+    std::vector<std::vector<int> > L_dense =
+        {{0, 0, 0, 0, 0, 0, 0, 0},
+         {1, 0, 0, 0, 0, 0, 0, 0},
+         {1, 1, 0, 0, 0, 0, 0, 0},
+         {0, 0, 0, 0, 0, 0, 0, 0},
+         {0, 0, 0, 1, 0, 0, 0, 0},
+         {0, 0, 2, 0, 3, 0, 0, 0},
+         {0, 0, 0, 0, 0, 0, 0, 0},
+         {4, 0, 0, 0, 0, 5, 0, 0}};
+    IndexType const N = L_dense.size();
+
+    std::vector<std::vector<int> > LL_dense(N, std::vector<int>(N, 0));
+    std::vector<std::vector<int> > LLT_dense(N, std::vector<int>(N, 0));
+    for (IndexType i = 0; i < N; ++i)
+    {
+        for (IndexType j = 0; j < N; ++j)
+        {
+            for (IndexType k = 0; k < N; ++k)
+            {
+                LL_dense[i][j] += L_dense[i][k] * L_dense[k][j];
+                LLT_dense[i][j] += L_dense[i][k] * L_dense[j][k];
+            }
+        }
+    }
+
+    GraphBLAS::Matrix<int> L(L_dense, 0);
+    GraphBLAS::Matrix<int> LL(LL_dense, 0);
+    GraphBLAS::Matrix<int> LLT(LLT_dense, 0);
+
+    GraphBLAS::Matrix<int> C(N, N);
+    GraphBLAS::mxm(C,
+                   GraphBLAS::NoMask(),
+                   GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<int>(), L, L);
+    BOOST_CHECK_EQUAL(C, LL);
+
+    GraphBLAS::mxm(C,
+                   GraphBLAS::NoMask(),
+                   GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<int>(),
+                   L, GraphBLAS::transpose(L));
+    BOOST_CHECK_EQUAL(C, LLT);
+
+    GraphBLAS::mxm(C,
+                   GraphBLAS::NoMask(),
+                   GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<int>(),
+                   GraphBLAS::transpose(L), GraphBLAS::transpose(L));
+    GraphBLAS::transpose(C, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(), C);
+    BOOST_CHECK_EQUAL(C, LL);
+}
+
+//****************************************************************************
+// Masks that select few and many of the positions of a very sparse product
+BOOST_AUTO_TEST_CASE(test_mxm_masked_very_sparse)
+{
+    std::vector<std::vector<int> > L_dense =
+        {{0, 0, 0, 0, 0, 0, 0, 0},
+         {1, 0, 0, 0, 0, 0, 0, 0},
+         {1, 1, 0, 0, 0, 0, 0, 0},
+         {0, 0, 0, 0, 0, 0, 0, 0},
+         {0, 0, 0, 1, 0, 0, 0, 0},
+         {0, 0, 2, 0, 3, 0, 0, 0},
+         {0, 0, 0, 0, 0, 0, 0, 0},
+         {4, 0, 0, 0, 0, 5, 0, 0}};
+    IndexType const N = L_dense.size();
+
+    std::vector<std::vector<int> > LLT_dense(N, std::vector<int>(N, 0));
+    for (IndexType i = 0; i < N; ++i)
+        for (IndexType j = 0; j < N; ++j)
+            for (IndexType k = 0; k < N; ++k)
+                LLT_dense[i][j] += L_dense[i][k] * L_dense[j][k];
+
+    // Few mask values (one stored false), and every position but a few
+    std::vector<std::vector<bool> > few_dense(N, std::vector<bool>(N, false));
+    few_dense[2][1] = true;
+    few_dense[7][7] = true;
+    few_dense[5][5] = true;
+    std::vector<std::vector<bool> > many_dense(N, std::vector<bool>(N, true));
+    many_dense[2][1] = false;
+    many_dense[7][7] = false;
+    many_dense[5][0] = false;
+
+    std::vector<std::vector<std::vector<bool> > > masks = {few_dense,
+                                                           many_dense};
+    GraphBLAS::Matrix<int> L(L_dense, 0);
+    for (auto &mask_dense : masks)
+    {
+        // A stored false is not part of the mask
+        mask_dense[3][3] = false;
+        GraphBLAS::Matrix<bool> M(mask_dense, false);
+        M.setElement(3, 3, false);
+
+        std::vector<std::vector<int> > ans_dense(N, std::vector<int>(N, 9));
+        std::vector<std::vector<int> > scmp_ans_dense(N, std::vector<int>(N, 9));
+        for (IndexType i = 0; i < N; ++i)
+        {
+            for (IndexType j = 0; j < N; ++j)
+            {
+                if (mask_dense[i][j])
+                    ans_dense[i][j] = LLT_dense[i][j];
+                else
+                    scmp_ans_dense[i][j] = LLT_dense[i][j];
+            }
+        }
+        GraphBLAS::Matrix<int> answer(ans_dense, 0);
+        GraphBLAS::Matrix<int> scmp_answer(scmp_ans_dense, 0);
+
+        std::vector<std::vector<int> > nines(N, std::vector<int>(N, 9));
+        GraphBLAS::Matrix<int> C(nines, 0);
+        GraphBLAS::mxm(C, M,
+                       GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<int>(),
+                       L, GraphBLAS::transpose(L));
+        BOOST_CHECK_EQUAL(C, answer);
+
+        GraphBLAS::Matrix<int> LT(N, N);
+        GraphBLAS::transpose(LT, GraphBLAS::NoMask(),
+                             GraphBLAS::NoAccumulate(), L);
+        GraphBLAS::Matrix<int> C2(nines, 0);
+        GraphBLAS::mxm(C2, M,
+                       GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<int>(),
+                       L, LT);
+        BOOST_CHECK_EQUAL(C2, answer);
+
+        GraphBLAS::Matrix<int> C3(nines, 0);
+        GraphBLAS::mxm(C3, GraphBLAS::complement(M),
+                       GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<int>(),
+                       L, GraphBLAS::transpose(L));
+        BOOST_CHECK_EQUAL(C3, scmp_answer);
+    }
+}
+
 //****************************************************************************
 BOOST_AUTO_TEST_CASE(test_mxm_stored_zero_result)
 {
@@ -1893,4 +2032,180 @@ BOOST_AUTO_TEST_CASE(test_a_equals_c_transpose3)
     BOOST_CHECK_EQUAL(result, answer);
 }
 
+//****************************************************************************
+// mxm_reduce
+//****************************************************************************
+
+namespace
+{
+    // Reference result: reduce(accum, PlusMonoid, C) with C<Mask> = A*B
+    template <typename MaskT, typename AMatrixT, typename BMatrixT>
+    double mxm_then_reduce(MaskT const &Mask,
+                           AMatrixT const &A, BMatrixT const &B)
+    {
+        Matrix<double, DirectedMatrixTag> C(A.nrows(), B.ncols());
+        mxm(C, Mask, GraphBLAS::NoAccumulate(),
+            GraphBLAS::ArithmeticSemiring<double>(), A, B);
+        double sum = 0;
+        reduce(sum, GraphBLAS::NoAccumulate(),
+               GraphBLAS::PlusMonoid<double>(), C);
+        return sum;
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxm_reduce_masked)
+{
+    Matrix<double, DirectedMatrixTag> mA(mA_dense_3x3, 0.);
+    Matrix<double, DirectedMatrixTag> mB(mB_dense_3x4, 0.);
+    Matrix<bool, DirectedMatrixTag> M(3, 4);
+    M.build(IndexArrayType{0, 1, 2, 2}, IndexArrayType{1, 3, 0, 2},
+            std::vector<bool>{true, true, false, true});
+
+    double sum = 0;
+    mxm_reduce(sum, M, GraphBLAS::NoAccumulate(),
+               GraphBLAS::PlusMonoid<double>(),
+               GraphBLAS::ArithmeticSemiring<double>(), mA, mB);
+    BOOST_CHECK_EQUAL(sum, mxm_then_reduce(M, mA, mB));
+
+    // with an accumulator and transposed operands
+    double acc = 10;
+    mxm_reduce(acc, transpose(M), GraphBLAS::Plus<double>(),
+               GraphBLAS::PlusMonoid<double>(),
+               GraphBLAS::ArithmeticSemiring<double>(),
+               transpose(mB), transpose(mA));
+    BOOST_CHECK_EQUAL(acc,
+                      10 + mxm_then_reduce(transpose(M),
+                                           transpose(mB), transpose(mA)));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxm_reduce_nomask_and_complement)
+{
+    Matrix<double, DirectedMatrixTag> mA(mA_dense_3x3, 0.);
+    Matrix<double, DirectedMatrixTag> mB(mB_dense_3x4, 0.);
+    Matrix<bool, DirectedMatrixTag> M(3, 4);
+    M.build(IndexArrayType{0, 1, 2}, IndexArrayType{0, 1, 2},
+            std::vector<bool>{true, true, true});
+
+    double sum = 0;
+    mxm_reduce(sum, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+               GraphBLAS::PlusMonoid<double>(),
+               GraphBLAS::ArithmeticSemiring<double>(), mA, mB);
+    BOOST_CHECK_EQUAL(sum, mxm_then_reduce(GraphBLAS::NoMask(), mA, mB));
+
+    mxm_reduce(sum, complement(M), GraphBLAS::NoAccumulate(),
+               GraphBLAS::PlusMonoid<double>(),
+               GraphBLAS::ArithmeticSemiring<double>(), mA, mB);
+    BOOST_CHECK_EQUAL(sum, mxm_then_reduce(complement(M), mA, mB));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxm_reduce_apply_op)
+{
+    Matrix<double, DirectedMatrixTag> mA(mA_dense_3x3, 0.);
+    Matrix<double, DirectedMatrixTag> mB(mB_dense_3x4, 0.);
+
+    Matrix<double, DirectedMatrixTag> C(3, 4);
+    mxm(C, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+        GraphBLAS::ArithmeticSemiring<double>(), mA, mB);
+    double answer = std::numeric_limits<double>::max();
+    for (IndexType i = 0; i < 3; ++i)
+        for (IndexType j = 0; j < 4; ++j)
+            if (C.hasElement(i, j))
+                answer = std::min(answer, -C.extractElement(i, j));
+
+    double result = 0;
+    mxm_reduce(result, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+               GraphBLAS::MinMonoid<double>(),
+               GraphBLAS::AdditiveInverse<double>(),
+               GraphBLAS::ArithmeticSemiring<double>(), mA, mB);
+    BOOST_CHECK_EQUAL(result, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxm_reduce_bad_dimensions)
+{
+    Matrix<double, DirectedMatrixTag> mA(mA_dense_3x3, 0.);
+    Matrix<double, DirectedMatrixTag> mB(mB_dense_3x4, 0.);
+    Matrix<bool, DirectedMatrixTag> M(4, 3);
+
+    double sum = 0;
+    BOOST_CHECK_THROW(
+        (mxm_reduce(sum, M, GraphBLAS::NoAccumulate(),
+                    GraphBLAS::PlusMonoid<double>(),
+                    GraphBLAS::ArithmeticSemiring<double>(), mA, mB)),
+        DimensionException);
+    BOOST_CHECK_THROW(
+        (mxm_reduce(sum, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                    GraphBLAS::PlusMonoid<double>(),
+                    GraphBLAS::ArithmeticSemiring<double>(), mB, mB)),
+        DimensionException);
+}
+
+//****************************************************************************
+// C += A*B and C<M> += A*B are written row by row into C (without a Z
+// matrix); compare with computing the product separately.
+BOOST_AUTO_TEST_CASE(test_mxm_accum_in_place)
+{
+    Matrix<double, DirectedMatrixTag> mA(mA_sparse_3x3, 0.);
+    Matrix<double, DirectedMatrixTag> mB(mB_sparse_3x4, 0.);
+    Matrix<double, DirectedMatrixTag> C0(mB_dense_3x4, 0.);
+    Matrix<bool, DirectedMatrixTag> M(
+        std::vector<std::vector<bool> >({{true, false, false, true},
+                                         {false, true, false, false},
+                                         {false, false, false, true}}),
+        false);
+
+    Matrix<double, DirectedMatrixTag> T(3, 4), answer(3, 4);
+    mxm(T, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+        GraphBLAS::ArithmeticSemiring<double>(), mA, mB);
+    eWiseAdd(answer, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+             GraphBLAS::Plus<double>(), C0, T);
+
+    Matrix<double, DirectedMatrixTag> C(C0);
+    mxm(C, GraphBLAS::NoMask(), GraphBLAS::Plus<double>(),
+        GraphBLAS::ArithmeticSemiring<double>(), mA, mB);
+    BOOST_CHECK_EQUAL(C, answer);
+
+    // Compressed storage goes through Z
+    Matrix<double, CsrStorageTag, DirectedMatrixTag> Ccsr(mB_dense_3x4, 0.);
+    mxm(Ccsr, GraphBLAS::NoMask(), GraphBLAS::Plus<double>(),
+        GraphBLAS::ArithmeticSemiring<double>(), mA, mB);
+    Matrix<double, CsrStorageTag, DirectedMatrixTag> answer_csr(3, 4);
+    eWiseAdd(answer_csr, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+             GraphBLAS::Plus<double>(), C0, T);
+    BOOST_CHECK_EQUAL(Ccsr, answer_csr);
+
+    // Masked, with and without replace
+    for (bool replace_flag : {false, true})
+    {
+        Matrix<double, DirectedMatrixTag> expected(C0);
+        eWiseAdd(expected, M, GraphBLAS::NoAccumulate(),
+                 GraphBLAS::Plus<double>(), C0, T, replace_flag);
+
+        Matrix<double, DirectedMatrixTag> Cm(C0);
+        mxm(Cm, M, GraphBLAS::Plus<double>(),
+            GraphBLAS::ArithmeticSemiring<double>(), mA, mB, replace_flag);
+        BOOST_CHECK_EQUAL(Cm, expected);
+    }
+
+    // C is also an operand: the product is not computed into C
+    Matrix<double, DirectedMatrixTag> AA(3, 3);
+    mxm(AA, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+        GraphBLAS::ArithmeticSemiring<double>(), mA, mA);
+    Matrix<double, DirectedMatrixTag> Ca(mA);
+    mxm(Ca, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+        GraphBLAS::ArithmeticSemiring<double>(), Ca, Ca);
+    BOOST_CHECK_EQUAL(Ca, AA);
+
+    Matrix<double, DirectedMatrixTag> ATA(3, 3);
+    mxm(ATA, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+        GraphBLAS::ArithmeticSemiring<double>(), mA, transpose(mA));
+    Ca = mA;
+    mxm(Ca, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+        GraphBLAS::ArithmeticSemiring<double>(), Ca, transpose(Ca));
+    BOOST_CHECK_EQUAL(Ca, ATA);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
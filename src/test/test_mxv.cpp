@@ -773,5 +773,82 @@ BOOST_AUTO_TEST_CASE(mxv_reg)
     BOOST_CHECK_EQUAL(result, ans4);
 }
 
+//****************************************************************************
+// Sparse (one value) and dense input vectors, so that both the push and the
+// pull directions are exercised
+BOOST_AUTO_TEST_CASE(test_mxv_push_and_pull)
+{
+    std::vector<std::vector<int> > A_dense =
+        {{0, 0, 0, 0, 0, 0, 0, 0},
+         {1, 0, 0, 0, 0, 0, 0, 0},
+         {1, 1, 0, 0, 0, 0, 0, 0},
+         {0, 0, 0, 0, 0, 0, 0, 0},
+         {0, 0, 0, 1, 0, 0, 0, 0},
+         {0, 0, 2, 0, 3, 0, 0, 0},
+         {0, 0, 0, 0, 0, 0, 0, 0},
+         {4, 0, 0, 0, 0, 5, 0, 0}};
+    GraphBLAS::IndexType const N = A_dense.size();
+    GraphBLAS::Matrix<int> A(A_dense, 0);
+
+    std::vector<std::vector<int> > u_inputs =
+        {{0, 0, 0, 0, 0, 2, 0, 0},
+         {1, 2, 3, 4, 5, 6, 7, 8}};
+    // A single mask value makes pull the cheaper direction
+    std::vector<bool> mask_dense = {false, true, false, false,
+                                     false, false, false, false};
+    GraphBLAS::Vector<bool> mask(mask_dense, false);
+
+    for (auto &u_dense : u_inputs)
+    {
+        GraphBLAS::Vector<int> u(u_dense, 0);
+
+        std::vector<int> ans(N, 0), ansT(N, 0);
+        std::vector<int> masked(N, 0), scmp(N, 0), maskedT(N, 0), scmpT(N, 0);
+        for (GraphBLAS::IndexType j = 0; j < N; ++j)
+        {
+            for (GraphBLAS::IndexType k = 0; k < N; ++k)
+            {
+                ans[j] += A_dense[j][k] * u_dense[k];
+                ansT[j] += A_dense[k][j] * u_dense[k];
+            }
+            (mask_dense[j] ? masked : scmp)[j] = ans[j];
+            (mask_dense[j] ? maskedT : scmpT)[j] = ansT[j];
+        }
+
+        GraphBLAS::Vector<int> w(N);
+        GraphBLAS::mxv(w, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<int>(), A, u);
+        BOOST_CHECK_EQUAL(w, GraphBLAS::Vector<int>(ans, 0));
+
+        GraphBLAS::mxv(w, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<int>(),
+                       GraphBLAS::transpose(A), u);
+        BOOST_CHECK_EQUAL(w, GraphBLAS::Vector<int>(ansT, 0));
+
+        w.clear();
+        GraphBLAS::mxv(w, mask, GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<int>(), A, u);
+        BOOST_CHECK_EQUAL(w, GraphBLAS::Vector<int>(masked, 0));
+
+        w.clear();
+        GraphBLAS::mxv(w, GraphBLAS::complement(mask),
+                       GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<int>(), A, u);
+        BOOST_CHECK_EQUAL(w, GraphBLAS::Vector<int>(scmp, 0));
+
+        w.clear();
+        GraphBLAS::mxv(w, mask, GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<int>(),
+                       GraphBLAS::transpose(A), u);
+        BOOST_CHECK_EQUAL(w, GraphBLAS::Vector<int>(maskedT, 0));
+
+        w.clear();
+        GraphBLAS::mxv(w, GraphBLAS::complement(mask),
+                       GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<int>(),
+                       GraphBLAS::transpose(A), u);
+        BOOST_CHECK_EQUAL(w, GraphBLAS::Vector<int>(scmpT, 0));
+    }
+}
 
 BOOST_AUTO_TEST_SUITE_END()
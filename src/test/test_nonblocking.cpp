@@ -0,0 +1,327 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#define GRAPHBLAS_LOGGING_LEVEL 0
+
+#include <iostream>
+#include <graphblas/graphblas.hpp>
+#include <algorithms/page_rank.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE nonblocking_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    // Every test runs in nonblocking mode and goes back to blocking after.
+    struct NonblockingFixture
+    {
+        NonblockingFixture()  { setExecutionMode(NONBLOCKING); }
+        ~NonblockingFixture() { setExecutionMode(BLOCKING); }
+    };
+
+    // Counts how many values it has been applied to.
+    struct CountingIdentity
+    {
+        typedef double result_type;
+        inline double operator()(double input) { ++calls; return input; }
+
+        static int calls;
+    };
+    int CountingIdentity::calls = 0;
+
+    std::size_t num_pending() { return detail::pending_queue().size(); }
+
+    //  1 1 0
+    //  0 1 1
+    //  1 0 1
+    Matrix<double> make_matrix()
+    {
+        IndexArrayType i = {0, 0, 1, 1, 2, 2};
+        IndexArrayType j = {0, 1, 1, 2, 0, 2};
+        std::vector<double> v = {1, 2, 3, 4, 5, 6};
+        Matrix<double> m(3, 3);
+        m.build(i, j, v);
+        return m;
+    }
+}
+
+BOOST_FIXTURE_TEST_SUITE(BOOST_TEST_MODULE, NonblockingFixture)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_mode_switch)
+{
+    BOOST_CHECK(getExecutionMode() == NONBLOCKING);
+
+    Matrix<double> mA(make_matrix());
+    Matrix<double> mC(3, 3);
+    mxm(mC, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), mA, mA);
+    BOOST_CHECK_EQUAL(num_pending(), 1);
+
+    setExecutionMode(BLOCKING);
+    BOOST_CHECK(getExecutionMode() == BLOCKING);
+    BOOST_CHECK_EQUAL(num_pending(), 0);
+
+    mxm(mC, NoMask(), Plus<double>(), ArithmeticSemiring<double>(), mA, mA);
+    BOOST_CHECK_EQUAL(num_pending(), 0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_deferred_until_read)
+{
+    Matrix<double> mA(make_matrix());
+    Matrix<double> mC(3, 3);
+
+    mxm(mC, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), mA, mA);
+    BOOST_CHECK_EQUAL(num_pending(), 1);
+    BOOST_CHECK_EQUAL(mC.nrows(), 3);
+    BOOST_CHECK_EQUAL(num_pending(), 1);
+
+    BOOST_CHECK_EQUAL(mC.nvals(), 9);
+    BOOST_CHECK_EQUAL(num_pending(), 0);
+    BOOST_CHECK_EQUAL(mC.extractElement(0, 0), 1.0);
+    BOOST_CHECK_EQUAL(mC.extractElement(0, 2), 8.0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_matches_blocking)
+{
+    Matrix<double> mA(make_matrix());
+
+    Matrix<double> mB(3, 3), mC(3, 3), mD(3, 3);
+    mxm(mB, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        mA, transpose(mA));
+    apply(mC, complement(mA), NoAccumulate(), AdditiveInverse<double>(), mB,
+          true);
+    eWiseAdd(mD, NoMask(), NoAccumulate(), Plus<double>(), mA, mC);
+    eWiseMult(mD, mA, Plus<double>(), Times<double>(), mD, mB);
+    double sum = 0;
+    reduce(sum, NoAccumulate(), PlusMonoid<double>(), mD);
+    BOOST_CHECK_EQUAL(num_pending(), 0);
+
+    setExecutionMode(BLOCKING);
+    Matrix<double> mB2(3, 3), mC2(3, 3), mD2(3, 3);
+    mxm(mB2, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        mA, transpose(mA));
+    apply(mC2, complement(mA), NoAccumulate(), AdditiveInverse<double>(), mB2,
+          true);
+    eWiseAdd(mD2, NoMask(), NoAccumulate(), Plus<double>(), mA, mC2);
+    eWiseMult(mD2, mA, Plus<double>(), Times<double>(), mD2, mB2);
+    double sum2 = 0;
+    reduce(sum2, NoAccumulate(), PlusMonoid<double>(), mD2);
+
+    BOOST_CHECK_EQUAL(sum, sum2);
+    BOOST_CHECK_EQUAL(mB, mB2);
+    BOOST_CHECK_EQUAL(mC, mC2);
+    BOOST_CHECK_EQUAL(mD, mD2);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_vector_ops)
+{
+    Matrix<double> mA(make_matrix());
+    std::vector<double> u_dense = {1, 2, 3};
+    Vector<double> u(u_dense);
+
+    Vector<double> w(3), w2(3);
+    vxm(w, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), u, mA);
+    mxv(w2, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), mA, u);
+    eWiseAdd(w, NoMask(), Plus<double>(), Times<double>(), w, w2);
+    BOOST_CHECK_EQUAL(num_pending(), 3);
+
+    double sum = 0;
+    reduce(sum, NoAccumulate(), PlusMonoid<double>(), w);
+    BOOST_CHECK_EQUAL(num_pending(), 0);
+
+    // vxm: {16, 8, 26}; mxv: {5, 18, 23}; w + w .* w2 = {96, 152, 624}
+    BOOST_CHECK_EQUAL(sum, 872.0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_read_runs_only_dependencies)
+{
+    Matrix<double> mA(make_matrix());
+    Matrix<double> mB(3, 3), mC(3, 3);
+
+    apply(mB, NoMask(), NoAccumulate(), AdditiveInverse<double>(), mA);
+    transpose(mC, NoMask(), NoAccumulate(), mA);
+    BOOST_CHECK_EQUAL(num_pending(), 2);
+
+    BOOST_CHECK_EQUAL(mC.extractElement(1, 0), 2.0);
+    BOOST_CHECK_EQUAL(num_pending(), 1);
+
+    BOOST_CHECK_EQUAL(mB.extractElement(0, 1), -2.0);
+    BOOST_CHECK_EQUAL(num_pending(), 0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_overwritten_output_not_computed)
+{
+    Matrix<double> mA(make_matrix());
+    Matrix<double> mC(3, 3);
+
+    CountingIdentity::calls = 0;
+    apply(mC, NoMask(), NoAccumulate(), CountingIdentity(), mA);
+    apply(mC, NoMask(), NoAccumulate(), AdditiveInverse<double>(), mA);
+    BOOST_CHECK_EQUAL(num_pending(), 1);
+
+    BOOST_CHECK_EQUAL(mC.extractElement(2, 2), -6.0);
+    BOOST_CHECK_EQUAL(CountingIdentity::calls, 0);
+
+    // An accumulating (or masked, non-replacing) write reads the old value.
+    apply(mC, NoMask(), NoAccumulate(), CountingIdentity(), mA);
+    apply(mC, NoMask(), Plus<double>(), AdditiveInverse<double>(), mA);
+    BOOST_CHECK_EQUAL(num_pending(), 2);
+    BOOST_CHECK_EQUAL(mC.extractElement(2, 2), 0.0);
+    BOOST_CHECK_EQUAL(CountingIdentity::calls, 6);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_destroyed_temporary_not_computed)
+{
+    Matrix<double> mA(make_matrix());
+    Matrix<double> mC(3, 3);
+
+    CountingIdentity::calls = 0;
+    {
+        Matrix<double> mT(3, 3);
+        apply(mT, NoMask(), NoAccumulate(), CountingIdentity(), mA);
+        BOOST_CHECK_EQUAL(num_pending(), 1);
+    }
+    BOOST_CHECK_EQUAL(num_pending(), 0);
+    BOOST_CHECK_EQUAL(CountingIdentity::calls, 0);
+
+    // A temporary that is read by a pending operation is computed first.
+    {
+        Matrix<double> mT(3, 3);
+        apply(mT, NoMask(), NoAccumulate(), CountingIdentity(), mA);
+        eWiseAdd(mC, NoMask(), NoAccumulate(), Plus<double>(), mT, mA);
+    }
+    BOOST_CHECK_EQUAL(num_pending(), 0);
+    BOOST_CHECK_EQUAL(CountingIdentity::calls, 6);
+    BOOST_CHECK_EQUAL(mC.extractElement(1, 2), 8.0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_input_modified_after_use)
+{
+    Matrix<double> mA(make_matrix());
+    Matrix<double> mC(3, 3);
+
+    apply(mC, NoMask(), NoAccumulate(), Identity<double>(), mA);
+    mA.setElement(0, 0, 100.0);
+    BOOST_CHECK_EQUAL(num_pending(), 0);
+    BOOST_CHECK_EQUAL(mC.extractElement(0, 0), 1.0);
+
+    apply(mC, NoMask(), NoAccumulate(), Identity<double>(), mA);
+    mA.clear();
+    BOOST_CHECK_EQUAL(mC.extractElement(0, 0), 100.0);
+
+    Vector<double> w(3);
+    reduce(w, NoMask(), NoAccumulate(), Plus<double>(), mC);
+    mC = make_matrix();
+    BOOST_CHECK_EQUAL(w.extractElement(0), 102.0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_copy_and_wait)
+{
+    Matrix<double> mA(make_matrix());
+    Matrix<double> mC(3, 3);
+
+    transpose(mC, NoMask(), NoAccumulate(), mA);
+    Matrix<double> mD(mC);
+    BOOST_CHECK_EQUAL(num_pending(), 0);
+    BOOST_CHECK_EQUAL(mD.extractElement(2, 1), 4.0);
+
+    Vector<double> w(3);
+    assign(w, NoMask(), NoAccumulate(), 1.0, AllIndices());
+    assign(mC, NoMask(), NoAccumulate(), 7.0, AllIndices(), AllIndices());
+    BOOST_CHECK_EQUAL(num_pending(), 2);
+    wait();
+    BOOST_CHECK_EQUAL(num_pending(), 0);
+    BOOST_CHECK_EQUAL(w.nvals(), 3);
+    BOOST_CHECK_EQUAL(mC.nvals(), 9);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_move_and_swap)
+{
+    Matrix<double> mA(make_matrix());
+    Matrix<double> mC(3, 3);
+    Matrix<double> mD(3, 3);
+
+    // a pending result moves with its contents
+    transpose(mC, NoMask(), NoAccumulate(), mA);
+    mD = std::move(mC);
+    BOOST_CHECK_EQUAL(num_pending(), 0);
+    BOOST_CHECK_EQUAL(mD.extractElement(2, 1), 4.0);
+    BOOST_CHECK_EQUAL(mC.nvals(), 0);
+
+    // an operation that reads a swapped matrix sees its old contents
+    Vector<double> w(3);
+    reduce(w, NoMask(), NoAccumulate(), Plus<double>(), mD);
+    swap(mC, mD);
+    BOOST_CHECK_EQUAL(num_pending(), 0);
+    BOOST_CHECK_EQUAL(w.extractElement(0), 6.0);
+    BOOST_CHECK_EQUAL(mC.extractElement(2, 1), 4.0);
+    BOOST_CHECK_EQUAL(mD.nvals(), 0);
+
+    Matrix<double> mE(std::move(mC));
+    BOOST_CHECK_EQUAL(mE.nvals(), 6);
+    BOOST_CHECK_EQUAL(mC.nrows(), 3);
+    BOOST_CHECK_EQUAL(mC.nvals(), 0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_page_rank)
+{
+    IndexArrayType i = {0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                        4, 4, 4, 5, 6, 6, 6, 8, 8};
+    IndexArrayType j = {3, 3, 6, 4, 5, 6, 8, 0, 1, 4, 6,
+                        2, 3, 8, 2, 1, 2, 3, 2, 4};
+    std::vector<double> v(i.size(), 1.0);
+    Matrix<double> m1(9, 9);
+    m1.build(i, j, v);
+
+    Vector<double> rank(9);
+    algorithms::page_rank(m1, rank);
+
+    setExecutionMode(BLOCKING);
+    Vector<double> answer(9);
+    algorithms::page_rank(m1, answer);
+
+    BOOST_CHECK_EQUAL(rank, answer);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,167 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#define GRAPHBLAS_LOGGING_LEVEL 0
+#define GRAPHBLAS_TRACE 1
+
+#include <iostream>
+#include <sstream>
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE trace_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    std::string trace_string()
+    {
+        std::ostringstream oss;
+        write_trace(oss);
+        return oss.str();
+    }
+
+    std::size_t count(std::string const &str, std::string const &sub)
+    {
+        std::size_t n(0);
+        for (std::size_t pos = str.find(sub); pos != std::string::npos;
+             pos = str.find(sub, pos + 1))
+        {
+            ++n;
+        }
+        return n;
+    }
+
+    Matrix<double> triangle()
+    {
+        IndexArrayType i = {0, 1, 1, 2, 2, 0};
+        IndexArrayType j = {1, 0, 2, 1, 0, 2};
+        std::vector<double> v(i.size(), 1);
+        Matrix<double> A(3, 3);
+        A.build(i, j, v);
+        return A;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(trace_test_records_operations)
+{
+    clear_trace();
+
+    Matrix<double> A(triangle());
+    Matrix<double> C(3, 3);
+    mxm(C, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, A);
+
+    Vector<double> w(3);
+    reduce(w, NoMask(), NoAccumulate(), PlusMonoid<double>(), A);
+
+    double sum(0);
+    reduce(sum, NoAccumulate(), PlusMonoid<double>(), w);
+    BOOST_CHECK_EQUAL(sum, 6.0);
+
+    std::string trace(trace_string());
+    BOOST_CHECK_EQUAL(trace.find("{\"traceEvents\": ["), 0);
+    BOOST_CHECK_EQUAL(count(trace, "\"ph\": \"X\""), 3);
+
+    // mxm: operands, flags, output and kernel
+    BOOST_CHECK(trace.find(
+        "{\"name\": \"mxm\"") != std::string::npos);
+    BOOST_CHECK(trace.find(
+        "\"mask\": \"none\", \"accum\": false, \"replace\": false, "
+        "\"deferred\": false, "
+        "\"inputs\": [{\"nrows\": 3, \"ncols\": 3, \"nvals\": 6}, "
+        "{\"nrows\": 3, \"ncols\": 3, \"nvals\": 6}], "
+        "\"output\": {\"nrows\": 3, \"ncols\": 3, \"nvals\": 9}, "
+        "\"kernel\": \"mxm_") != std::string::npos);
+
+    BOOST_CHECK(trace.find(
+        "\"inputs\": [{\"nrows\": 3, \"ncols\": 3, \"nvals\": 6}], "
+        "\"output\": {\"size\": 3, \"nvals\": 3}") != std::string::npos);
+    BOOST_CHECK(trace.find(
+        "{\"name\": \"reduce_vector_to_scalar\"") != std::string::npos);
+    BOOST_CHECK(trace.find("\"output\": \"scalar\"") != std::string::npos);
+
+    clear_trace();
+    BOOST_CHECK_EQUAL(count(trace_string(), "\"ph\""), 0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(trace_test_masks_and_views)
+{
+    clear_trace();
+
+    Matrix<double> A(triangle());
+    Matrix<double> C(3, 3);
+    Matrix<bool> M(3, 3);
+    M.setElement(0, 0, true);
+
+    eWiseAdd(C, M, Plus<double>(), Plus<double>(), A, transpose(A), true);
+    apply(C, complement(M), NoAccumulate(), AdditiveInverse<double>(), A);
+
+    std::string trace(trace_string());
+    BOOST_CHECK(trace.find(
+        "\"mask\": \"mask\", \"mask_nvals\": 1, \"accum\": true, "
+        "\"replace\": true") != std::string::npos);
+    BOOST_CHECK(trace.find(
+        "{\"nrows\": 3, \"ncols\": 3, \"nvals\": 6, \"transpose\": true}")
+                != std::string::npos);
+    BOOST_CHECK(trace.find(
+        "\"mask\": \"complement\", \"mask_nvals\": 1") != std::string::npos);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(trace_test_nonblocking)
+{
+    clear_trace();
+    setExecutionMode(NONBLOCKING);
+
+    Matrix<double> A(triangle());
+    Matrix<double> C(3, 3);
+    mxm(C, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, A);
+
+    // Not run (or traced) until it is needed
+    BOOST_CHECK_EQUAL(count(trace_string(), "\"ph\""), 0);
+    BOOST_CHECK_EQUAL(C.nvals(), 9);
+
+    std::string trace(trace_string());
+    BOOST_CHECK_EQUAL(count(trace, "\"ph\""), 1);
+    BOOST_CHECK(trace.find("\"deferred\": true") != std::string::npos);
+    BOOST_CHECK(trace.find(
+        "\"output\": {\"nrows\": 3, \"ncols\": 3, \"nvals\": 9}")
+                != std::string::npos);
+
+    setExecutionMode(BLOCKING);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
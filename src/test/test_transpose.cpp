@@ -368,4 +368,41 @@ BOOST_AUTO_TEST_CASE(test_transpose_nonsquare_trans)
     }
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_transpose_large)
+{
+    // Enough entries per column for the rows to be split between threads
+    IndexType const NROWS = 500, NCOLS = 300;
+    IndexArrayType i, j;
+    std::vector<int> v;
+    for (IndexType row = 0; row < NROWS; ++row)
+    {
+        for (IndexType col = (row * 7) % 13; col < NCOLS; col += 3 + row % 5)
+        {
+            i.push_back(row);
+            j.push_back(col);
+            v.push_back((int)(row * NCOLS + col));
+        }
+    }
+    Matrix<int, DirectedMatrixTag> A(NROWS, NCOLS);
+    A.build(i, j, v);
+
+    std::vector<double> vd(v.begin(), v.end());
+    Matrix<double, DirectedMatrixTag> answer(NCOLS, NROWS);
+    answer.build(j, i, vd);
+
+    Matrix<double, DirectedMatrixTag> C(NCOLS, NROWS);
+    transpose(C, NoMask(), NoAccumulate(), A);
+    BOOST_CHECK_EQUAL(C.nvals(), i.size());
+    BOOST_CHECK_EQUAL(C, answer);
+
+    // Transposing back gives A
+    Matrix<int, DirectedMatrixTag> B(NROWS, NCOLS);
+    transpose(B, NoMask(), NoAccumulate(), C);
+    BOOST_CHECK_EQUAL(B, A);
+
+    transpose(B, NoMask(), NoAccumulate(), transpose(A));
+    BOOST_CHECK_EQUAL(B, A);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -287,4 +287,25 @@ BOOST_AUTO_TEST_CASE(test_triangle_counting_newGBTL)
     BOOST_CHECK_EQUAL(result, 4);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_four_cycle_count)
+{
+    std::vector<double> ar={0, 0, 0, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 4, 4, 4};
+    std::vector<double> ac={1, 2, 3, 0, 2, 4, 0, 1, 3, 4, 0, 2, 4, 1, 2, 3};
+    std::vector<double> av={1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+    Matrix<double, DirectedMatrixTag> testtriangle(5,5);
+    testtriangle.build(ar.begin(), ac.begin(), av.begin(), av.size());
+
+    IndexType result = four_cycle_count(testtriangle);
+    BOOST_CHECK_EQUAL(result, 5);
+
+    // A 4-cycle with no chords
+    Matrix<double, DirectedMatrixTag> square(4,4);
+    square.build(IndexArrayType{0, 1, 1, 2, 2, 3, 3, 0},
+                 IndexArrayType{1, 0, 2, 1, 3, 2, 0, 3},
+                 std::vector<double>(8, 1));
+    result = four_cycle_count(square);
+    BOOST_CHECK_EQUAL(result, 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -654,5 +654,82 @@ BOOST_AUTO_TEST_CASE(test_vxm_scmp_masked_a_transpose)
     BOOST_CHECK_EQUAL(result, answer);
 }
 
+//****************************************************************************
+// Sparse (one value) and dense input vectors, so that both the push and the
+// pull directions are exercised
+BOOST_AUTO_TEST_CASE(test_vxm_push_and_pull)
+{
+    std::vector<std::vector<int> > A_dense =
+        {{0, 0, 0, 0, 0, 0, 0, 0},
+         {1, 0, 0, 0, 0, 0, 0, 0},
+         {1, 1, 0, 0, 0, 0, 0, 0},
+         {0, 0, 0, 0, 0, 0, 0, 0},
+         {0, 0, 0, 1, 0, 0, 0, 0},
+         {0, 0, 2, 0, 3, 0, 0, 0},
+         {0, 0, 0, 0, 0, 0, 0, 0},
+         {4, 0, 0, 0, 0, 5, 0, 0}};
+    GraphBLAS::IndexType const N = A_dense.size();
+    GraphBLAS::Matrix<int> A(A_dense, 0);
+
+    std::vector<std::vector<int> > u_inputs =
+        {{0, 0, 0, 0, 0, 2, 0, 0},
+         {1, 2, 3, 4, 5, 6, 7, 8}};
+    // A single mask value makes pull the cheaper direction
+    std::vector<bool> mask_dense = {false, true, false, false,
+                                     false, false, false, false};
+    GraphBLAS::Vector<bool> mask(mask_dense, false);
+
+    for (auto &u_dense : u_inputs)
+    {
+        GraphBLAS::Vector<int> u(u_dense, 0);
+
+        std::vector<int> ans(N, 0), ansT(N, 0);
+        std::vector<int> masked(N, 0), scmp(N, 0), maskedT(N, 0), scmpT(N, 0);
+        for (GraphBLAS::IndexType j = 0; j < N; ++j)
+        {
+            for (GraphBLAS::IndexType k = 0; k < N; ++k)
+            {
+                ans[j] += u_dense[k] * A_dense[k][j];
+                ansT[j] += u_dense[k] * A_dense[j][k];
+            }
+            (mask_dense[j] ? masked : scmp)[j] = ans[j];
+            (mask_dense[j] ? maskedT : scmpT)[j] = ansT[j];
+        }
+
+        GraphBLAS::Vector<int> w(N);
+        GraphBLAS::vxm(w, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<int>(), u, A);
+        BOOST_CHECK_EQUAL(w, GraphBLAS::Vector<int>(ans, 0));
+
+        GraphBLAS::vxm(w, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<int>(),
+                       u, GraphBLAS::transpose(A));
+        BOOST_CHECK_EQUAL(w, GraphBLAS::Vector<int>(ansT, 0));
+
+        w.clear();
+        GraphBLAS::vxm(w, mask, GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<int>(), u, A);
+        BOOST_CHECK_EQUAL(w, GraphBLAS::Vector<int>(masked, 0));
+
+        w.clear();
+        GraphBLAS::vxm(w, GraphBLAS::complement(mask),
+                       GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<int>(), u, A);
+        BOOST_CHECK_EQUAL(w, GraphBLAS::Vector<int>(scmp, 0));
+
+        w.clear();
+        GraphBLAS::vxm(w, mask, GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<int>(),
+                       u, GraphBLAS::transpose(A));
+        BOOST_CHECK_EQUAL(w, GraphBLAS::Vector<int>(maskedT, 0));
+
+        w.clear();
+        GraphBLAS::vxm(w, GraphBLAS::complement(mask),
+                       GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<int>(),
+                       u, GraphBLAS::transpose(A));
+        BOOST_CHECK_EQUAL(w, GraphBLAS::Vector<int>(scmpT, 0));
+    }
+}
 
 BOOST_AUTO_TEST_SUITE_END()